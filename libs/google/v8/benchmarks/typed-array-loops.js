@@ -0,0 +1,116 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Microbenchmark for loops that index arrays and typed arrays with a simple
+// induction variable, the pattern targeted by bounds check hoisting.  The
+// typed array kernels read the length once, since the length of a typed
+// array is an accessor call.  It is not part of the benchmark suite; run it
+// with
+//
+//   d8 base.js typed-array-loops.js run-micro.js
+
+var TypedArrayLoops = new BenchmarkSuite('TypedArrayLoops', 100000, [
+  new Benchmark('TypedArrayLoops',
+                runTypedArrayLoops,
+                setupTypedArrayLoops,
+                tearDownTypedArrayLoops)
+]);
+
+var kLoopsLength = 4096;
+var loopsFloats = null;
+var loopsResult = null;
+var loopsInts = null;
+var loopsArray = null;
+
+function setupTypedArrayLoops() {
+  loopsFloats = new Float64Array(kLoopsLength);
+  loopsResult = new Float64Array(kLoopsLength);
+  loopsInts = new Int32Array(kLoopsLength);
+  loopsArray = new Array(kLoopsLength);
+  for (var i = 0; i < kLoopsLength; i++) {
+    loopsFloats[i] = i * 0.5;
+    loopsInts[i] = i & 0xff;
+    loopsArray[i] = i;
+  }
+}
+
+function tearDownTypedArrayLoops() {
+  loopsFloats = null;
+  loopsResult = null;
+  loopsInts = null;
+  loopsArray = null;
+}
+
+function dotProduct(a, b) {
+  var sum = 0;
+  for (var i = 0, n = a.length; i < n; i++) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+function saxpy(alpha, x, y) {
+  for (var i = 0, n = x.length; i < n; i++) {
+    y[i] = alpha * x[i] + y[i];
+  }
+}
+
+function stencil(src, dst) {
+  for (var i = 1, n = src.length - 1; i < n; i++) {
+    dst[i] = (src[i - 1] + src[i] + src[i + 1]) >> 2;
+  }
+}
+
+function reverseSum(a) {
+  var sum = 0;
+  for (var i = a.length - 1; i >= 0; i--) {
+    sum = (sum + a[i]) | 0;
+  }
+  return sum;
+}
+
+function runTypedArrayLoops() {
+  var ints = new Int32Array(kLoopsLength);
+  for (var i = 0; i < kLoopsLength; i++) loopsResult[i] = 0;
+  for (var n = 0; n < 10; n++) {
+    var result = dotProduct(loopsFloats, loopsFloats);
+    if (result != 5724526080) {
+      throw new Error('Bad dot product: ' + result);
+    }
+    saxpy(2, loopsFloats, loopsResult);
+    if (loopsResult[kLoopsLength - 1] != (n + 1) * (kLoopsLength - 1)) {
+      throw new Error('Bad saxpy');
+    }
+    stencil(loopsInts, ints);
+    if (reverseSum(ints) != 389953) {
+      throw new Error('Bad stencil');
+    }
+    if (reverseSum(loopsArray) != (kLoopsLength - 1) * kLoopsLength / 2) {
+      throw new Error('Bad reverse sum');
+    }
+  }
+}
@@ -3634,7 +3634,6 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   ParameterCount count(arg_count);
   __ InvokeFunction(r1, count, CALL_FUNCTION,
                     NullCallWrapper(), CALL_AS_METHOD);
-  __ ldr(cp, MemOperand(fp, StandardFrameConstants::kContextOffset));
   __ jmp(&done);
 
   __ bind(&runtime);
@@ -3642,6 +3641,10 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   __ CallRuntime(Runtime::kCall, args->length());
   __ bind(&done);
 
+  // Record the return site before restoring the context so that a caller
+  // inlined into optimized code resumes here with its own context.
+  PrepareForBailoutForId(expr->ReturnId(), TOS_REG);
+  __ ldr(cp, MemOperand(fp, StandardFrameConstants::kContextOffset));
   context()->Plug(r0);
 }
 
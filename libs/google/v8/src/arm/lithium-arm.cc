@@ -818,9 +818,11 @@ void LChunkBuilder::DoBasicBlock(HBasicBlock* block, HBasicBlock* next_block) {
     if (pred->end()->SecondSuccessor() == NULL) {
       ASSERT(pred->end()->FirstSuccessor() == block);
     } else {
-      if (pred->end()->FirstSuccessor()->block_id() > block->block_id() ||
-          pred->end()->SecondSuccessor()->block_id() > block->block_id()) {
-        last_environment = last_environment->Copy();
+      for (HSuccessorIterator it(pred->end()); !it.Done(); it.Advance()) {
+        if (it.Current()->block_id() > block->block_id()) {
+          last_environment = last_environment->Copy();
+          break;
+        }
       }
     }
     block->UpdateEnvironment(last_environment);
@@ -1741,6 +1743,13 @@ LInstruction* LChunkBuilder::DoIsStringAndBranch(HIsStringAndBranch* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoIsInternalizedStringAndBranch(
+    HIsInternalizedStringAndBranch* instr) {
+  Abort("Unsupported switch statement");
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoIsSmiAndBranch(HIsSmiAndBranch* instr) {
   ASSERT(instr->value()->representation().IsTagged());
   return new(zone()) LIsSmiAndBranch(Use(instr->value()));
@@ -1826,6 +1835,13 @@ LInstruction* LChunkBuilder::DoValueOf(HValueOf* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoVectorLoop(HVectorLoop* instr) {
+  // Loops are only vectorized on x64.
+  UNREACHABLE();
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoDateField(HDateField* instr) {
   LOperand* object = UseFixed(instr->value(), r0);
   LDateField* result =
@@ -2381,14 +2397,6 @@ LInstruction* LChunkBuilder::DoStringLength(HStringLength* instr) {
 }
 
 
-LInstruction* LChunkBuilder::DoAllocateObject(HAllocateObject* instr) {
-  info()->MarkAsDeferredCalling();
-  LAllocateObject* result =
-      new(zone()) LAllocateObject(TempRegister(), TempRegister());
-  return AssignPointerMap(DefineAsRegister(result));
-}
-
-
 LInstruction* LChunkBuilder::DoAllocate(HAllocate* instr) {
   info()->MarkAsDeferredCalling();
   LOperand* size = instr->size()->IsConstant()
@@ -2453,6 +2461,42 @@ LInstruction* LChunkBuilder::DoUnknownOSRValue(HUnknownOSRValue* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoSwitchTable(HSwitchTable* instr) {
+  Abort("Unsupported switch statement");
+  return NULL;
+}
+
+
+LInstruction* LChunkBuilder::DoEnterTry(HEnterTry* instr) {
+  Abort("Unsupported try statement");
+  return NULL;
+}
+
+
+LInstruction* LChunkBuilder::DoLeaveTry(HLeaveTry* instr) {
+  Abort("Unsupported try statement");
+  return NULL;
+}
+
+
+LInstruction* LChunkBuilder::DoCatchEntry(HCatchEntry* instr) {
+  Abort("Unsupported try statement");
+  return NULL;
+}
+
+
+LInstruction* LChunkBuilder::DoStoreTrySlot(HStoreTrySlot* instr) {
+  Abort("Unsupported try statement");
+  return NULL;
+}
+
+
+LInstruction* LChunkBuilder::DoLoadTrySlot(HLoadTrySlot* instr) {
+  Abort("Unsupported try statement");
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoCallStub(HCallStub* instr) {
   argument_count_ -= instr->argument_count();
   return MarkAsCall(DefineFixed(new(zone()) LCallStub, r0), instr);
@@ -277,6 +277,9 @@ class SmallMapList {
   bool is_empty() const { return list_.is_empty(); }
   int length() const { return list_.length(); }
 
+  // Removes the i'th map without dereferencing any handles.
+  void RemoveAt(int i) { list_.RemoveElement(list_.at(i)); }
+
   void AddMapIfMissing(Handle<Map> map, Zone* zone) {
     map = Map::CurrentMapForDeprecated(map);
     for (int i = 0; i < length(); ++i) {
@@ -819,6 +822,8 @@ class ForStatement: public IterationStatement {
   virtual BailoutId ContinueId() const { return continue_id_; }
   virtual BailoutId StackCheckId() const { return body_id_; }
   BailoutId BodyId() const { return body_id_; }
+  // Just before the condition is tested.
+  BailoutId ConditionId() const { return condition_id_; }
 
   bool is_fast_smi_loop() { return loop_variable_ != NULL; }
   Variable* loop_variable() { return loop_variable_; }
@@ -833,7 +838,8 @@ class ForStatement: public IterationStatement {
         may_have_function_literal_(true),
         loop_variable_(NULL),
         continue_id_(GetNextId(isolate)),
-        body_id_(GetNextId(isolate)) {
+        body_id_(GetNextId(isolate)),
+        condition_id_(GetNextId(isolate)) {
   }
 
  private:
@@ -845,6 +851,7 @@ class ForStatement: public IterationStatement {
   Variable* loop_variable_;
   const BailoutId continue_id_;
   const BailoutId body_id_;
+  const BailoutId condition_id_;
 };
 
 
@@ -1113,11 +1120,20 @@ class TryStatement: public Statement {
   Block* try_block() const { return try_block_; }
   ZoneList<Label*>* escaping_targets() const { return escaping_targets_; }
 
+  // Bailout point at the handler entry, with the exception in the result
+  // register.
+  BailoutId HandlerId() const { return handler_id_; }
+  // Bailout point after the try statement completed normally.  For a
+  // try-finally this is where the finally block returns to.
+  BailoutId ContinuationId() const { return continuation_id_; }
+
  protected:
-  TryStatement(int index, Block* try_block)
+  TryStatement(Isolate* isolate, int index, Block* try_block)
       : index_(index),
         try_block_(try_block),
-        escaping_targets_(NULL) { }
+        escaping_targets_(NULL),
+        handler_id_(GetNextId(isolate)),
+        continuation_id_(GetNextId(isolate)) { }
 
  private:
   // Unique (per-function) index of this handler.  This is not an AST ID.
@@ -1125,6 +1141,8 @@ class TryStatement: public Statement {
 
   Block* try_block_;
   ZoneList<Label*>* escaping_targets_;
+  const BailoutId handler_id_;
+  const BailoutId continuation_id_;
 };
 
 
@@ -1137,12 +1155,13 @@ class TryCatchStatement: public TryStatement {
   Block* catch_block() const { return catch_block_; }
 
  protected:
-  TryCatchStatement(int index,
+  TryCatchStatement(Isolate* isolate,
+                    int index,
                     Block* try_block,
                     Scope* scope,
                     Variable* variable,
                     Block* catch_block)
-      : TryStatement(index, try_block),
+      : TryStatement(isolate, index, try_block),
         scope_(scope),
         variable_(variable),
         catch_block_(catch_block) {
@@ -1162,8 +1181,11 @@ class TryFinallyStatement: public TryStatement {
   Block* finally_block() const { return finally_block_; }
 
  protected:
-  TryFinallyStatement(int index, Block* try_block, Block* finally_block)
-      : TryStatement(index, try_block),
+  TryFinallyStatement(Isolate* isolate,
+                      int index,
+                      Block* try_block,
+                      Block* finally_block)
+      : TryStatement(isolate, index, try_block),
         finally_block_(finally_block) { }
 
  private:
@@ -1679,6 +1701,9 @@ class CallRuntime: public Expression {
 
   TypeFeedbackId CallRuntimeFeedbackId() const { return reuse(id()); }
 
+  // Bailout id for the return from a %_CallFunction target.
+  BailoutId ReturnId() const { return return_id_; }
+
  protected:
   CallRuntime(Isolate* isolate,
               Handle<String> name,
@@ -1687,12 +1712,15 @@ class CallRuntime: public Expression {
       : Expression(isolate),
         name_(name),
         function_(function),
-        arguments_(arguments) { }
+        arguments_(arguments),
+        return_id_(GetNextId(isolate)) { }
 
  private:
   Handle<String> name_;
   const Runtime::Function* function_;
   ZoneList<Expression*>* arguments_;
+
+  const BailoutId return_id_;
 };
 
 
@@ -2822,15 +2850,15 @@ class AstNodeFactory BASE_EMBEDDED {
                                           Variable* variable,
                                           Block* catch_block) {
     TryCatchStatement* stmt = new(zone_) TryCatchStatement(
-        index, try_block, scope, variable, catch_block);
+        isolate_, index, try_block, scope, variable, catch_block);
     VISIT_AND_RETURN(TryCatchStatement, stmt)
   }
 
   TryFinallyStatement* NewTryFinallyStatement(int index,
                                               Block* try_block,
                                               Block* finally_block) {
-    TryFinallyStatement* stmt =
-        new(zone_) TryFinallyStatement(index, try_block, finally_block);
+    TryFinallyStatement* stmt = new(zone_) TryFinallyStatement(
+        isolate_, index, try_block, finally_block);
     VISIT_AND_RETURN(TryFinallyStatement, stmt)
   }
 
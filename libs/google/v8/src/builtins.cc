@@ -416,6 +416,7 @@ static bool ArrayPrototypeHasNoElements(Heap* heap,
                                         JSObject* array_proto) {
   // This method depends on non writability of Object and Array prototype
   // fields.
+  if (heap->isolate()->IsArrayProtectorIntact()) return true;
   if (array_proto->elements() != heap->empty_fixed_array()) return false;
   // Object.prototype
   Object* proto = array_proto->GetPrototype();
@@ -432,6 +433,13 @@ static inline MaybeObject* EnsureJSArrayWithWritableFastElements(
     Heap* heap, Object* receiver, Arguments* args, int first_added_arg) {
   if (!receiver->IsJSArray()) return NULL;
   JSArray* array = JSArray::cast(receiver);
+  // Adding elements to the initial Array.prototype has to go through
+  // SetElement, which invalidates the array protector.
+  Isolate* isolate = heap->isolate();
+  if (args != NULL && isolate->IsArrayProtectorIntact() &&
+      isolate->IsInitialArrayOrObjectPrototype(array)) {
+    return NULL;
+  }
   HeapObject* elms = array->elements();
   Map* map = elms->map();
   if (map == heap->fixed_array_map()) {
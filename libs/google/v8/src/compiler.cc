@@ -412,6 +412,13 @@ OptimizingCompiler::Status OptimizingCompiler::OptimizeGraph() {
 
 OptimizingCompiler::Status OptimizingCompiler::GenerateAndInstallCode() {
   ASSERT(last_status() == SUCCEEDED);
+  // The array protector can be invalidated while the graph is optimized on
+  // the recompilation thread; try again later rather than disabling.
+  if (graph_->depends_on_array_protector() &&
+      !isolate()->IsArrayProtectorIntact()) {
+    info_->AbortOptimization();
+    return SetLastStatus(BAILED_OUT);
+  }
   {  // Scope for timer.
     Timer timer(this, &time_taken_to_codegen_);
     ASSERT(chunk_ != NULL);
@@ -903,8 +910,10 @@ bool Compiler::CompileLazy(CompilationInfo* info) {
 }
 
 
-void Compiler::RecompileParallel(Handle<JSFunction> closure) {
-  ASSERT(closure->IsMarkedForParallelRecompilation());
+bool Compiler::RecompileParallel(Handle<JSFunction> closure,
+                                 BailoutId osr_ast_id) {
+  bool is_osr = !osr_ast_id.IsNone();
+  ASSERT(is_osr || closure->IsMarkedForParallelRecompilation());
 
   Isolate* isolate = closure->GetIsolate();
   // Here we prepare compile data for the parallel recompilation thread, but
@@ -916,7 +925,7 @@ void Compiler::RecompileParallel(Handle<JSFunction> closure) {
     if (FLAG_trace_parallel_recompilation) {
       PrintF("  ** Compilation queue, will retry opting on next run.\n");
     }
-    return;
+    return false;
   }
 
   SmartPointer<CompilationInfo> info(new CompilationInfoWithZone(closure));
@@ -926,13 +935,14 @@ void Compiler::RecompileParallel(Handle<JSFunction> closure) {
   Handle<SharedFunctionInfo> shared = info->shared_info();
   int compiled_size = shared->end_position() - shared->start_position();
   isolate->counters()->total_compile_size()->Increment(compiled_size);
-  info->SetOptimizing(BailoutId::None());
+  info->SetOptimizing(osr_ast_id);
 
+  bool queued = false;
   {
     CompilationHandleScope handle_scope(*info);
 
     if (InstallCodeFromOptimizedCodeMap(*info)) {
-      return;
+      return false;
     }
 
     if (Parser::Parse(*info)) {
@@ -952,6 +962,7 @@ void Compiler::RecompileParallel(Handle<JSFunction> closure) {
           // This may ease the issue that GVN blocks the next scavenge.
           isolate->heap()->CollectGarbage(NEW_SPACE, "parallel recompile");
           isolate->optimizing_compiler_thread()->QueueForOptimization(compiler);
+          queued = true;
         } else if (status == OptimizingCompiler::BAILED_OUT) {
           isolate->clear_pending_exception();
           InstallFullCode(*info);
@@ -960,7 +971,8 @@ void Compiler::RecompileParallel(Handle<JSFunction> closure) {
     }
   }
 
-  if (shared->code()->back_edges_patched_for_osr()) {
+  // The caller takes care of the back edges when compiling for OSR.
+  if (!is_osr && shared->code()->back_edges_patched_for_osr()) {
     // At this point we either put the function on recompilation queue or
     // aborted optimization.  In either case we want to continue executing
     // the unoptimized code without running into OSR.  If the unoptimized
@@ -975,6 +987,7 @@ void Compiler::RecompileParallel(Handle<JSFunction> closure) {
   }
 
   if (isolate->has_pending_exception()) isolate->clear_pending_exception();
+  return queued;
 }
 
 
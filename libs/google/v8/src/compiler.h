@@ -434,6 +434,7 @@ class OptimizingCompiler: public ZoneObject {
         time_taken_to_create_graph_(0),
         time_taken_to_optimize_(0),
         time_taken_to_codegen_(0),
+        time_queued_(0),
         last_status_(FAILED) { }
 
   enum Status {
@@ -448,6 +449,10 @@ class OptimizingCompiler: public ZoneObject {
   CompilationInfo* info() const { return info_; }
   Isolate* isolate() const { return info()->isolate(); }
 
+  // Time at which the job was put on the parallel recompilation queue.
+  int64_t time_queued() const { return time_queued_; }
+  void set_time_queued(int64_t ticks) { time_queued_ = ticks; }
+
   MUST_USE_RESULT Status AbortOptimization() {
     info_->AbortOptimization();
     info_->shared_info()->DisableOptimization(info_->bailout_reason());
@@ -463,6 +468,7 @@ class OptimizingCompiler: public ZoneObject {
   int64_t time_taken_to_create_graph_;
   int64_t time_taken_to_optimize_;
   int64_t time_taken_to_codegen_;
+  int64_t time_queued_;
   Status last_status_;
 
   MUST_USE_RESULT Status SetLastStatus(Status status) {
@@ -533,7 +539,10 @@ class Compiler : public AllStatic {
   // success and false if the compilation resulted in a stack overflow.
   static bool CompileLazy(CompilationInfo* info);
 
-  static void RecompileParallel(Handle<JSFunction> function);
+  // Queues the function for optimization on the compiler thread, for the
+  // given OSR entry if there is one.  Returns whether it has been queued.
+  static bool RecompileParallel(Handle<JSFunction> function,
+                                BailoutId osr_ast_id = BailoutId::None());
 
   // Compile a shared function info object (the function is possibly lazily
   // compiled).
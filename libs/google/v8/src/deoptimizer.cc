@@ -782,6 +782,8 @@ void Deoptimizer::DoComputeOutputFrames() {
       case Translation::DOUBLE_STACK_SLOT:
       case Translation::LITERAL:
       case Translation::ARGUMENTS_OBJECT:
+      case Translation::STACK_HANDLER:
+      case Translation::FINALLY_STATE:
       case Translation::DUPLICATE:
       default:
         UNREACHABLE();
@@ -789,6 +791,8 @@ void Deoptimizer::DoComputeOutputFrames() {
     }
   }
 
+  if (!deferred_stack_handlers_.is_empty()) LinkStackHandlers();
+
   // Print some helpful diagnostic information.
   if (trace_) {
     double ms = static_cast<double>(OS::Ticks() - start) / 1000;
@@ -810,6 +814,33 @@ void Deoptimizer::DoComputeOutputFrames() {
 }
 
 
+void Deoptimizer::LinkStackHandlers() {
+  ASSERT(bailout_type_ != DEBUGGER);
+  // The handlers of the optimized frame are the innermost ones, one for
+  // each handler of the output frames.  The optimized frame is gone from
+  // the stack by now, so read their next fields from the input frame.
+  Register fp_reg = StubFailureTrampolineFrame::fp_register();
+  intptr_t input_top = input_->GetRegister(fp_reg.code()) - fp_to_sp_delta_;
+  ThreadLocalTop* top = isolate_->thread_local_top();
+  Address next = Isolate::handler(top);
+  for (int i = 0; i < deferred_stack_handlers_.length(); i++) {
+    intptr_t offset = reinterpret_cast<intptr_t>(next) - input_top +
+        StackHandlerConstants::kNextOffset;
+    ASSERT(offset >= 0 && offset < static_cast<int>(input_->GetFrameSize()));
+    next = reinterpret_cast<Address>(
+        input_->GetFrameSlot(static_cast<unsigned>(offset)));
+  }
+  // The handlers are listed outermost first.
+  for (int i = 0; i < deferred_stack_handlers_.length(); i++) {
+    StackHandlerLinkDescriptor d = deferred_stack_handlers_[i];
+    FrameDescription* frame = output_[d.frame_index()];
+    frame->SetFrameSlot(d.output_offset(), reinterpret_cast<intptr_t>(next));
+    next = reinterpret_cast<Address>(frame->GetTop() + d.output_offset());
+  }
+  top->handler_ = next;
+}
+
+
 void Deoptimizer::DoComputeArgumentsAdaptorFrame(TranslationIterator* iterator,
                                                  int frame_index) {
   JSFunction* function = JSFunction::cast(ComputeLiteral(iterator->Next()));
@@ -1745,6 +1776,94 @@ void Deoptimizer::DoTranslateCommand(TranslationIterator* iterator,
       return;
     }
 
+    case Translation::STACK_HANDLER: {
+      unsigned state = iterator->Next();
+      int offset = iterator->Next();
+      FrameDescription* frame = output_[frame_index];
+      // Frames computed for the debugger are never on the stack, so they
+      // get no handlers.
+      intptr_t value = kPlaceholder;
+      if (bailout_type_ != DEBUGGER) {
+        switch (offset) {
+          case StackHandlerConstants::kNextOffset:
+            // Linked once all output frames are known.
+            deferred_stack_handlers_.Add(
+                StackHandlerLinkDescriptor(frame_index, output_offset));
+            break;
+          case StackHandlerConstants::kCodeOffset:
+            value = reinterpret_cast<intptr_t>(
+                frame->GetFunction()->shared()->code());
+            break;
+          case StackHandlerConstants::kStateOffset:
+            value = static_cast<intptr_t>(state);
+            break;
+          case StackHandlerConstants::kContextOffset:
+            value = frame->GetContext();
+            break;
+          case StackHandlerConstants::kFPOffset:
+            value = frame->GetFp();
+            break;
+          default:
+            UNREACHABLE();
+        }
+      }
+      if (trace_) {
+        PrintF("    0x%08" V8PRIxPTR ": [top + %d] <- 0x%08" V8PRIxPTR
+               " ; stack handler + %d\n",
+               frame->GetTop() + output_offset,
+               output_offset,
+               value,
+               offset);
+      }
+      frame->SetFrameSlot(output_offset, value);
+      return;
+    }
+
+    case Translation::FINALLY_STATE: {
+      BailoutId return_id = BailoutId(iterator->Next());
+      int index = iterator->Next();
+      FrameDescription* frame = output_[frame_index];
+      ThreadLocalTop* top = isolate_->thread_local_top();
+      Object* value = NULL;
+      switch (index) {
+        case 0: {
+          // The return address of the call to the finally block, cooked as
+          // unoptimized code does it.
+          SharedFunctionInfo* shared = frame->GetFunction()->shared();
+          DeoptimizationOutputData* data = DeoptimizationOutputData::cast(
+              shared->code()->deoptimization_data());
+          unsigned pc_and_state = GetOutputInfo(data, return_id, shared);
+          unsigned pc_offset = FullCodeGenerator::PcField::decode(pc_and_state);
+          value = Smi::FromInt(pc_offset + Code::kHeaderSize - kHeapObjectTag);
+          break;
+        }
+        case 1:
+          // The result register, cleared on the normal entry.
+          value = Smi::FromInt(0);
+          break;
+        case 2:
+          value = top->pending_message_obj_;
+          break;
+        case 3:
+          value = Smi::FromInt(top->has_pending_message_);
+          break;
+        case 4:
+          value = top->pending_message_script_;
+          break;
+        default:
+          UNREACHABLE();
+      }
+      if (trace_) {
+        PrintF("    0x%08" V8PRIxPTR ": [top + %d] <- ",
+               frame->GetTop() + output_offset,
+               output_offset);
+        if (value != NULL) value->ShortPrint();
+        PrintF(" ; finally state %d\n", index);
+      }
+      frame->SetFrameSlot(output_offset, reinterpret_cast<intptr_t>(value));
+      return;
+    }
+
     case Translation::LITERAL: {
       Object* literal = ComputeLiteral(iterator->Next());
       if (trace_) {
@@ -2024,6 +2143,12 @@ bool Deoptimizer::DoOsrTranslateCommand(TranslationIterator* iterator,
       UNREACHABLE();
       return false;
     }
+
+    case Translation::STACK_HANDLER:
+    case Translation::FINALLY_STATE:
+      // Loops in try statements have no OSR entries.
+      UNREACHABLE();
+      return false;
   }
 
   if (!duplicate) *input_offset -= kPointerSize;
@@ -2063,6 +2188,41 @@ void Deoptimizer::PatchInterruptCode(Code* unoptimized_code,
 }
 
 
+void Deoptimizer::PatchInterruptCodeForOsrEntry(Code* unoptimized_code,
+                                                BailoutId osr_ast_id,
+                                                Code* interrupt_code,
+                                                Code* replacement_code) {
+  ASSERT(unoptimized_code->kind() == Code::FUNCTION);
+  // Look up the loop depth of the OSR entry in the back edge table.
+  Address back_edge_cursor = unoptimized_code->instruction_start() +
+      unoptimized_code->back_edge_table_offset();
+  uint32_t table_length = Memory::uint32_at(back_edge_cursor);
+  back_edge_cursor += kIntSize;
+  int osr_loop_depth = -1;
+  for (uint32_t i = 0; i < table_length; ++i) {
+    if (static_cast<int>(Memory::uint32_at(back_edge_cursor)) ==
+        osr_ast_id.ToInt()) {
+      osr_loop_depth = Memory::uint8_at(back_edge_cursor + 2 * kIntSize);
+      break;
+    }
+    back_edge_cursor += FullCodeGenerator::kBackEdgeEntrySize;
+  }
+  // The unoptimized code may have been replaced in the meantime.
+  if (osr_loop_depth < 0) return;
+
+  if (!unoptimized_code->back_edges_patched_for_osr()) {
+    unoptimized_code->set_allow_osr_at_loop_nesting_level(0);
+  }
+  // Patch one loop depth at a time, like the runtime profiler does.
+  while (unoptimized_code->allow_osr_at_loop_nesting_level() <
+         osr_loop_depth) {
+    unoptimized_code->set_allow_osr_at_loop_nesting_level(
+        unoptimized_code->allow_osr_at_loop_nesting_level() + 1);
+    PatchInterruptCode(unoptimized_code, interrupt_code, replacement_code);
+  }
+}
+
+
 void Deoptimizer::RevertInterruptCode(Code* unoptimized_code,
                                       Code* interrupt_code,
                                       Code* replacement_code) {
@@ -2107,7 +2267,7 @@ void Deoptimizer::VerifyInterruptCode(Code* unoptimized_code,
   back_edge_cursor += kIntSize;
   for (uint32_t i = 0; i < table_length; ++i) {
     uint8_t loop_depth = Memory::uint8_at(back_edge_cursor + 2 * kIntSize);
-    CHECK_LE(loop_depth, Code::kMaxLoopNestingMarker);
+    CHECK_LE(loop_depth, Code::kNoOsrLoopNestingMarker);
     // Assert that all back edges for shallower loops (and only those)
     // have already been patched.
     uint32_t pc_offset = Memory::uint32_at(back_edge_cursor + kIntSize);
@@ -2484,6 +2644,28 @@ void Translation::StoreArgumentsObject(bool args_known,
 }
 
 
+void Translation::StoreStackHandler(unsigned state) {
+  // The words of the handler, from the highest address down.
+  for (int offset = StackHandlerConstants::kSize - kPointerSize;
+       offset >= 0;
+       offset -= kPointerSize) {
+    buffer_->Add(STACK_HANDLER, zone());
+    buffer_->Add(state, zone());
+    buffer_->Add(offset, zone());
+  }
+}
+
+
+void Translation::StoreFinallyState(BailoutId return_id) {
+  // The words in the order unoptimized code pushes them.
+  for (int index = 0; index < kFinallyStateSize; index++) {
+    buffer_->Add(FINALLY_STATE, zone());
+    buffer_->Add(return_id.ToInt(), zone());
+    buffer_->Add(index, zone());
+  }
+}
+
+
 void Translation::MarkDuplicate() {
   buffer_->Add(DUPLICATE, zone());
 }
@@ -2509,6 +2691,8 @@ int Translation::NumberOfOperandsFor(Opcode opcode) {
     case BEGIN:
     case ARGUMENTS_ADAPTOR_FRAME:
     case CONSTRUCT_STUB_FRAME:
+    case STACK_HANDLER:
+    case FINALLY_STATE:
       return 2;
     case JS_FRAME:
     case ARGUMENTS_OBJECT:
@@ -2557,6 +2741,10 @@ const char* Translation::StringFor(Opcode opcode) {
       return "LITERAL";
     case ARGUMENTS_OBJECT:
       return "ARGUMENTS_OBJECT";
+    case STACK_HANDLER:
+      return "STACK_HANDLER";
+    case FINALLY_STATE:
+      return "FINALLY_STATE";
     case DUPLICATE:
       return "DUPLICATE";
   }
@@ -2604,6 +2792,8 @@ SlotRef SlotRef::ComputeSlotForNextArgument(TranslationIterator* iterator,
       break;
 
     case Translation::ARGUMENTS_OBJECT:
+    case Translation::STACK_HANDLER:
+    case Translation::FINALLY_STATE:
       // This can be only emitted for local slots not for argument slots.
       break;
 
@@ -71,6 +71,22 @@ class ArgumentsObjectMaterializationDescriptor BASE_EMBEDDED {
 };
 
 
+// A stack handler in an output frame, whose next handler is only known
+// after all output frames have been computed.
+class StackHandlerLinkDescriptor BASE_EMBEDDED {
+ public:
+  StackHandlerLinkDescriptor(int frame_index, unsigned output_offset)
+      : frame_index_(frame_index), output_offset_(output_offset) { }
+
+  int frame_index() const { return frame_index_; }
+  unsigned output_offset() const { return output_offset_; }
+
+ private:
+  int frame_index_;
+  unsigned output_offset_;
+};
+
+
 class OptimizedFunctionVisitor BASE_EMBEDDED {
  public:
   virtual ~OptimizedFunctionVisitor() {}
@@ -216,6 +232,13 @@ class Deoptimizer : public Malloced {
                                  Code* interrupt_code,
                                  Code* replacement_code);
 
+  // Patch all interrupts in loops nested no deeper than the loop with the
+  // given OSR entry, as if OSR had been allowed at that loop depth.
+  static void PatchInterruptCodeForOsrEntry(Code* unoptimized_code,
+                                            BailoutId osr_ast_id,
+                                            Code* interrupt_code,
+                                            Code* replacement_code);
+
   // Patch the interrupt at the instruction before pc_after in
   // the unoptimized code to unconditionally call replacement_code.
   static void PatchInterruptCodeAt(Code* unoptimized_code,
@@ -388,6 +411,10 @@ class Deoptimizer : public Malloced {
   bool DoOsrTranslateCommand(TranslationIterator* iterator,
                              int* input_offset);
 
+  // Link the stack handlers of the output frames into the handler chain, in
+  // place of the ones linked by the optimized frame.
+  void LinkStackHandlers();
+
   unsigned ComputeInputFrameSize() const;
   unsigned ComputeFixedSize(JSFunction* function) const;
 
@@ -447,6 +474,7 @@ class Deoptimizer : public Malloced {
   List<Object*> deferred_arguments_objects_values_;
   List<ArgumentsObjectMaterializationDescriptor> deferred_arguments_objects_;
   List<HeapNumberMaterializationDescriptor> deferred_heap_numbers_;
+  List<StackHandlerLinkDescriptor> deferred_stack_handlers_;
 
   bool trace_;
 
@@ -681,6 +709,11 @@ class Translation BASE_EMBEDDED {
     DOUBLE_STACK_SLOT,
     LITERAL,
     ARGUMENTS_OBJECT,
+    // A word of a stack handler linked by a try statement of the frame.
+    STACK_HANDLER,
+    // A word of the state saved by unoptimized code on entry to a finally
+    // block.
+    FINALLY_STATE,
 
     // A prefix indicating that the next command is a duplicate of the one
     // that follows it.
@@ -716,6 +749,8 @@ class Translation BASE_EMBEDDED {
   void StoreDoubleStackSlot(int index);
   void StoreLiteral(int literal_id);
   void StoreArgumentsObject(bool args_known, int args_index, int args_length);
+  void StoreStackHandler(unsigned state);
+  void StoreFinallyState(BailoutId return_id);
   void MarkDuplicate();
 
   Zone* zone() const { return zone_; }
@@ -729,6 +764,9 @@ class Translation BASE_EMBEDDED {
   // A literal id which refers to the JSFunction itself.
   static const int kSelfLiteralId = -239;
 
+  // The number of stack words, and commands, of a finally state.
+  static const int kFinallyStateSize = 5;
+
  private:
   TranslationBuffer* buffer_;
   int index_;
@@ -42,7 +42,8 @@ enum InterruptFlag {
   PREEMPT = 1 << 3,
   TERMINATE = 1 << 4,
   GC_REQUEST = 1 << 5,
-  FULL_DEOPT = 1 << 6
+  FULL_DEOPT = 1 << 6,
+  INSTALL_CODE = 1 << 7
 };
 
 
@@ -201,6 +202,8 @@ class StackGuard {
   void RequestGC();
   bool IsFullDeopt();
   void FullDeopt();
+  bool IsInstallCodeRequest();
+  void RequestInstallCode();
   void Continue(InterruptFlag after_what);
 
   // This provides an asynchronous read of the stack limits for the current
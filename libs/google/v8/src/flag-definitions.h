@@ -134,6 +134,15 @@ public:
 #else
 # define ENABLE_32DREGS_DEFAULT false
 #endif
+#if defined(V8_TARGET_ARCH_IA32) || defined(V8_TARGET_ARCH_X64)
+# define OPTIMIZE_TRY_STATEMENTS_DEFAULT true
+# define LOWER_SWITCH_STATEMENTS_DEFAULT true
+# define USE_ALLOCATION_FOLDING_DEFAULT true
+#else
+# define OPTIMIZE_TRY_STATEMENTS_DEFAULT false
+# define LOWER_SWITCH_STATEMENTS_DEFAULT false
+# define USE_ALLOCATION_FOLDING_DEFAULT false
+#endif
 
 #define DEFINE_bool(nam, def, cmt) FLAG(BOOL, bool, nam, def, cmt)
 #define DEFINE_int(nam, def, cmt) FLAG(INT, int, nam, def, cmt)
@@ -210,6 +219,10 @@ DEFINE_bool(use_range, true, "use hydrogen range analysis")
 DEFINE_bool(eliminate_dead_phis, true, "eliminate dead phis")
 DEFINE_bool(use_gvn, true, "use hydrogen global value numbering")
 DEFINE_bool(use_canonicalizing, true, "use hydrogen instruction canonicalizing")
+DEFINE_bool(load_elimination, true, "use redundant load and store elimination")
+DEFINE_bool(check_elimination, true, "use redundant check elimination")
+DEFINE_bool(use_allocation_folding, USE_ALLOCATION_FOLDING_DEFAULT,
+            "fold dominated new space allocations into their dominator")
 DEFINE_bool(use_inlining, true, "use function inlining")
 DEFINE_int(max_inlined_source_size, 600,
            "maximum source size in bytes considered for a single inlining")
@@ -218,6 +231,17 @@ DEFINE_int(max_inlined_nodes, 196,
 DEFINE_int(max_inlined_nodes_cumulative, 196,
            "maximum cumulative number of AST nodes considered for inlining")
 DEFINE_bool(loop_invariant_code_motion, true, "loop invariant code motion")
+DEFINE_bool(loop_peeling, true, "peel the first iteration of innermost loops")
+DEFINE_int(max_peeled_loop_nodes, 48,
+           "maximum number of AST nodes considered for loop peeling")
+DEFINE_bool(loop_unrolling, true, "unroll innermost counted loops")
+DEFINE_int(loop_unrolling_factor, 4,
+           "maximum number of body copies in an unrolled loop")
+DEFINE_int(max_unrolled_loop_nodes, 96,
+           "maximum number of AST nodes in all copies of an unrolled loop")
+DEFINE_bool(vectorize_loops, true,
+            "use packed SSE2 operations for simple loops over typed arrays "
+            "(x64 only)")
 DEFINE_bool(fast_math, true, "faster (but maybe less accurate) math functions")
 DEFINE_bool(collect_megamorphic_maps_from_stub_cache,
             true,
@@ -230,6 +254,13 @@ DEFINE_bool(trace_alloc, false, "trace register allocator")
 DEFINE_bool(trace_all_uses, false, "trace all use positions")
 DEFINE_bool(trace_range, false, "trace range analysis")
 DEFINE_bool(trace_gvn, false, "trace global value numbering")
+DEFINE_bool(trace_load_elimination, false, "trace load elimination")
+DEFINE_bool(trace_check_elimination, false, "trace check elimination")
+DEFINE_bool(trace_allocation_folding, false, "trace allocation folding")
+DEFINE_bool(trace_bounds_checks_hoisting, false,
+            "trace array bounds checks hoisting")
+DEFINE_bool(trace_loop_unrolling, false, "trace loop peeling and unrolling")
+DEFINE_bool(trace_vectorization, false, "trace vectorized loops")
 DEFINE_bool(trace_representation, false, "trace representation types")
 DEFINE_bool(trace_track_allocation_sites, false,
             "trace the tracking of allocation sites")
@@ -250,6 +281,8 @@ DEFINE_bool(use_osr, true, "use on-stack replacement")
 DEFINE_bool(idefs, false, "use informative definitions")
 DEFINE_bool(array_bounds_checks_elimination, true,
             "perform array bounds checks elimination")
+DEFINE_bool(array_bounds_checks_hoisting, true,
+            "perform array bounds checks hoisting out of loops")
 DEFINE_bool(array_index_dehoisting, true,
             "perform array index dehoisting")
 DEFINE_bool(dead_code_elimination, true, "use dead code elimination")
@@ -272,10 +305,17 @@ DEFINE_bool(cache_optimized_code, true,
 DEFINE_bool(inline_construct, true, "inline constructor calls")
 DEFINE_bool(inline_arguments, true, "inline functions with arguments object")
 DEFINE_bool(inline_accessors, true, "inline JavaScript accessors")
+DEFINE_bool(inline_array_builtins, true,
+            "inline Array.prototype.forEach, map, filter and reduce")
 DEFINE_int(loop_weight, 1, "loop weight for representation inference")
 
 DEFINE_bool(optimize_for_in, true,
             "optimize functions containing for-in loops")
+DEFINE_bool(optimize_try_statements, OPTIMIZE_TRY_STATEMENTS_DEFAULT,
+            "optimize functions containing try/catch and try/finally")
+DEFINE_bool(lower_switch_statements, LOWER_SWITCH_STATEMENTS_DEFAULT,
+            "dispatch switch statements through jump tables and binary "
+            "search instead of a linear chain of comparisons")
 DEFINE_bool(opt_safe_uint32_operations, true,
             "allow uint32 values on optimize frames if they are used only in "
             "safe operations")
@@ -284,9 +324,15 @@ DEFINE_bool(parallel_recompilation, false,
             "optimizing hot functions asynchronously on a separate thread")
 DEFINE_bool(trace_parallel_recompilation, false, "track parallel recompilation")
 DEFINE_int(parallel_recompilation_queue_length, 3,
-           "the length of the parallel compilation queue")
+           "the length of the parallel compilation queue per compiler thread")
 DEFINE_int(parallel_recompilation_delay, 0,
            "artificial compilation delay in ms")
+DEFINE_int(parallel_recompilation_threads, 0,
+           "number of parallel compiler threads "
+           "(0 means one per spare core)")
+DEFINE_bool(concurrent_osr, true,
+            "compile code for on-stack replacement on the parallel "
+            "recompilation threads")
 DEFINE_bool(omit_prototype_checks_for_leaf_maps, true,
             "do not emit prototype checks if all prototypes have leaf maps, "
             "deoptimize the optimized code if the layout of the maps changes.")
@@ -331,6 +377,10 @@ DEFINE_bool(enable_sse3, true,
             "enable use of SSE3 instructions if available")
 DEFINE_bool(enable_sse4_1, true,
             "enable use of SSE4.1 instructions if available")
+DEFINE_bool(enable_avx, true,
+            "enable use of AVX instructions if available (X64 only)")
+DEFINE_bool(enable_fma3, true,
+            "enable use of FMA3 instructions if available (X64 only)")
 DEFINE_bool(enable_cmov, true,
             "enable use of CMOV instruction if available")
 DEFINE_bool(enable_rdtsc, true,
@@ -697,11 +697,11 @@ int StubFrame::GetNumberOfIncomingArguments() const {
 
 
 void OptimizedFrame::Iterate(ObjectVisitor* v) const {
-#ifdef DEBUG
-  // Make sure that optimized frames do not contain any stack handlers.
-  StackHandlerIterator it(this, top_handler());
-  ASSERT(it.done());
-#endif
+  // The stack handlers of try statements live in spill slots that are not
+  // in the safepoint tables.
+  for (StackHandlerIterator it(this, top_handler()); !it.done(); it.Advance()) {
+    it.handler()->Iterate(v, LookupCode());
+  }
 
   IterateCompiledFrame(v);
 }
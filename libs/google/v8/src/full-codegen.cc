@@ -480,7 +480,9 @@ void FullCodeGenerator::RecordBackEdge(BailoutId ast_id) {
   // The pc offset does not need to be encoded and packed together with a state.
   ASSERT(masm_->pc_offset() > 0);
   ASSERT(loop_depth() > 0);
-  uint8_t depth = Min(loop_depth(), Code::kMaxLoopNestingMarker);
+  uint8_t depth = try_depth() > 0
+      ? Code::kNoOsrLoopNestingMarker
+      : Min(loop_depth(), Code::kMaxLoopNestingMarker);
   BackEdgeEntry entry =
       { ast_id, static_cast<unsigned>(masm_->pc_offset()), depth };
   back_edges_.Add(entry, zone());
@@ -1370,6 +1372,7 @@ void FullCodeGenerator::VisitForStatement(ForStatement* stmt) {
   // Check stack before looping.
   EmitBackEdgeBookkeeping(stmt, &body);
 
+  PrepareForBailoutForId(stmt->ConditionId(), NO_REGISTERS);
   __ bind(&test);
   if (stmt->cond() != NULL) {
     VisitForControl(stmt->cond(),
@@ -1395,11 +1398,14 @@ void FullCodeGenerator::VisitTryCatchStatement(TryCatchStatement* stmt) {
   // and control is passed to the catch block with the exception in the
   // result register.
 
+  increment_try_depth();
   Label try_entry, handler_entry, exit;
   __ jmp(&try_entry);
   __ bind(&handler_entry);
   handler_table()->set(stmt->index(), Smi::FromInt(handler_entry.pos()));
   // Exception handler code, the exception is in the result register.
+  // Optimized code deoptimizes to this point when it catches an exception.
+  PrepareForBailoutForId(stmt->HandlerId(), TOS_REG);
   // Extend the context before executing the catch block.
   { Comment cmnt(masm_, "[ Extend catch context");
     __ Push(stmt->variable()->name());
@@ -1430,6 +1436,8 @@ void FullCodeGenerator::VisitTryCatchStatement(TryCatchStatement* stmt) {
   }
   __ PopTryHandler();
   __ bind(&exit);
+  PrepareForBailoutForId(stmt->ContinuationId(), NO_REGISTERS);
+  decrement_try_depth();
 }
 
 
@@ -1457,6 +1465,7 @@ void FullCodeGenerator::VisitTryFinallyStatement(TryFinallyStatement* stmt) {
   // exception) in the result register (rax/eax/r0), both of which must
   // be preserved. The return address isn't GC-safe, so it should be
   // cooked before GC.
+  increment_try_depth();
   Label try_entry, handler_entry, finally_entry;
 
   // Jump to try-handler setup and try-block code.
@@ -1467,6 +1476,7 @@ void FullCodeGenerator::VisitTryFinallyStatement(TryFinallyStatement* stmt) {
   // is thrown.  The exception is in the result register, and must be
   // preserved by the finally block.  Call the finally block and then
   // rethrow the exception if it returns.
+  PrepareForBailoutForId(stmt->HandlerId(), TOS_REG);
   __ Call(&finally_entry);
   __ push(result_register());
   __ CallRuntime(Runtime::kReThrow, 1);
@@ -1492,6 +1502,10 @@ void FullCodeGenerator::VisitTryFinallyStatement(TryFinallyStatement* stmt) {
   // stack.
   ClearAccumulator();
   __ Call(&finally_entry);
+  // Optimized code runs the finally block inline.  When it deoptimizes in
+  // there, the finally block returns to this point.
+  PrepareForBailoutForId(stmt->ContinuationId(), NO_REGISTERS);
+  decrement_try_depth();
 }
 
 
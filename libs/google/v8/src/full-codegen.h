@@ -87,6 +87,7 @@ class FullCodeGenerator: public AstVisitor {
         scope_(info->scope()),
         nesting_stack_(NULL),
         loop_depth_(0),
+        try_depth_(0),
         globals_(NULL),
         context_(NULL),
         bailout_entries_(info->HasDeoptimizationSupport()
@@ -581,6 +582,15 @@ class FullCodeGenerator: public AstVisitor {
     loop_depth_--;
   }
 
+  // Try statement nesting counter.  Loops inside try statements are not
+  // entered by OSR.
+  int try_depth() { return try_depth_; }
+  void increment_try_depth() { try_depth_++; }
+  void decrement_try_depth() {
+    ASSERT(try_depth_ > 0);
+    try_depth_--;
+  }
+
   MacroAssembler* masm() { return masm_; }
 
   class ExpressionContext;
@@ -829,6 +839,7 @@ class FullCodeGenerator: public AstVisitor {
   Label return_label_;
   NestedStatement* nesting_stack_;
   int loop_depth_;
+  int try_depth_;
   ZoneList<Handle<Object> >* globals_;
   Handle<FixedArray> modules_;
   int module_index_;
@@ -2932,6 +2932,14 @@ bool Heap::CreateInitialObjects() {
   }
   set_observation_state(JSObject::cast(obj));
 
+  // Allocate the protector cell guarding the elements-free prototype chain
+  // of arrays, see Isolate::IsArrayProtectorIntact.
+  { MaybeObject* maybe_obj = AllocateJSGlobalPropertyCell(
+        Smi::FromInt(Isolate::kArrayProtectorValid));
+    if (!maybe_obj->ToObject(&obj)) return false;
+  }
+  set_array_protector(JSGlobalPropertyCell::cast(obj));
+
   // Handling of script id generation is in FACTORY->NewScript.
   set_last_script_id(undefined_value());
 
@@ -3818,6 +3826,7 @@ MaybeObject* Heap::CreateCode(const CodeDesc& desc,
   code->set_prologue_offset(kPrologueOffsetNotSet);
   if (code->kind() == Code::OPTIMIZED_FUNCTION) {
     code->set_marked_for_deoptimization(false);
+    code->set_depends_on_array_protector(false);
   }
   // Allow self references to created code object by patching the handle to
   // point to the newly allocated Code object.
@@ -167,6 +167,7 @@ namespace internal {
   V(Smi, getter_stub_deopt_pc_offset, GetterStubDeoptPCOffset)                 \
   V(Smi, setter_stub_deopt_pc_offset, SetterStubDeoptPCOffset)                 \
   V(JSObject, observation_state, ObservationState)                             \
+  V(JSGlobalPropertyCell, array_protector, ArrayProtector)                     \
   V(Map, external_map, ExternalMap)
 
 #define ROOT_LIST(V)                                  \
@@ -1572,6 +1572,9 @@ void HCheckInstanceType::GetCheckInterval(InstanceType* first,
     case IS_JS_ARRAY:
       *first = *last = JS_ARRAY_TYPE;
       return;
+    case IS_JS_FUNCTION:
+      *first = *last = JS_FUNCTION_TYPE;
+      return;
     default:
       UNREACHABLE();
   }
@@ -1635,6 +1638,7 @@ const char* HCheckInstanceType::GetCheckName() {
   switch (check_) {
     case IS_SPEC_OBJECT: return "object";
     case IS_JS_ARRAY: return "array";
+    case IS_JS_FUNCTION: return "function";
     case IS_STRING: return "string";
     case IS_INTERNALIZED_STRING: return "internalized_string";
   }
@@ -2069,6 +2073,26 @@ void HEnterInlined::PrintDataTo(StringStream* stream) {
 }
 
 
+void HStoreTrySlot::PrintDataTo(StringStream* stream) {
+  stream->Add("[%d] = ", slot());
+  value()->PrintNameTo(stream);
+}
+
+
+void HLoadTrySlot::PrintDataTo(StringStream* stream) {
+  stream->Add("[%d]", slot());
+}
+
+
+void HEnterTry::PrintDataTo(StringStream* stream) {
+  stream->Add("%s #%d try B%d landing B%d",
+              kind() == StackHandler::CATCH ? "catch" : "finally",
+              handler_index(),
+              SuccessorAt(0)->block_id(),
+              SuccessorAt(1)->block_id());
+}
+
+
 static bool IsInteger32(double value) {
   double roundtrip_value = static_cast<double>(static_cast<int32_t>(value));
   return BitCast<int64_t>(roundtrip_value) == BitCast<int64_t>(value);
@@ -2439,6 +2463,13 @@ void HCompareObjectEqAndBranch::PrintDataTo(StringStream* stream) {
 }
 
 
+void HSwitchTable::PrintDataTo(StringStream* stream) {
+  value()->PrintNameTo(stream);
+  stream->Add(" [%d..%d]", min_value(), min_value() + size() - 1);
+  HControlInstruction::PrintDataTo(stream);
+}
+
+
 void HGoto::PrintDataTo(StringStream* stream) {
   stream->Add("B%d", SuccessorAt(0)->block_id());
 }
@@ -2616,6 +2647,18 @@ void HCheckMaps::FinalizeUniqueValueId() {
 }
 
 
+void HCheckMaps::NarrowToMaps(ZoneList<UniqueValueId>* maps) {
+  ASSERT_EQ(map_set_.length(), map_unique_ids_.length());
+  for (int i = map_unique_ids_.length() - 1; i >= 0; i--) {
+    if (!maps->Contains(map_unique_ids_[i])) {
+      map_set_.RemoveAt(i);
+      map_unique_ids_.Remove(i);
+    }
+  }
+  ASSERT(!map_set_.is_empty());
+}
+
+
 void HLoadNamedFieldPolymorphic::FinalizeUniqueValueId() {
   if (!types_unique_ids_.is_empty()) return;
   Zone* zone = block()->zone();
@@ -2689,6 +2732,8 @@ void HLoadKeyed::PrintDataTo(StringStream* stream) {
 
   if (RequiresHoleCheck()) {
     stream->Add(" check_hole");
+  } else if (hole_mode() == CONVERT_HOLE_TO_UNDEFINED) {
+    stream->Add(" convert_hole");
   }
 }
 
@@ -2702,6 +2747,10 @@ bool HLoadKeyed::UsesMustHandleHole() const {
     return false;
   }
 
+  if (hole_mode() == CONVERT_HOLE_TO_UNDEFINED) {
+    return false;
+  }
+
   if (hole_mode() == ALLOW_RETURN_HOLE) {
     if (IsFastDoubleElementsKind(elements_kind())) {
       return AllUsesCanTreatHoleAsNaN();
@@ -2749,6 +2798,10 @@ bool HLoadKeyed::RequiresHoleCheck() const {
     return false;
   }
 
+  if (hole_mode() == CONVERT_HOLE_TO_UNDEFINED) {
+    return false;
+  }
+
   return !UsesMustHandleHole();
 }
 
@@ -2853,6 +2906,27 @@ void HStoreKeyedGeneric::PrintDataTo(StringStream* stream) {
 }
 
 
+void HVectorLoop::PrintDataTo(StringStream* stream) {
+  static const char* const kOpNames[] = {
+    "a0", "a1", "a2", "s0", "s1", "+", "-", "*", "/"
+  };
+  stream->Add("%s [", ElementsKindToString(elements_kind()));
+  index()->PrintNameTo(stream);
+  stream->Add(", ");
+  limit()->PrintNameTo(stream);
+  stream->Add(") ");
+  for (int i = 0; i < program_length(); ++i) {
+    stream->Add(i == 0 ? "%s" : " %s", kOpNames[program_at(i)]);
+  }
+  stream->Add(" out ");
+  store_pointer()->PrintNameTo(stream);
+  for (int i = 3; i < OperandCount(); ++i) {
+    stream->Add(" ");
+    OperandAt(i)->PrintNameTo(stream);
+  }
+}
+
+
 void HTransitionElementsKind::PrintDataTo(StringStream* stream) {
   object()->PrintNameTo(stream);
   ElementsKind from_kind = original_map()->elements_kind();
@@ -3034,19 +3108,74 @@ HType HStringCharFromCode::CalculateInferredType() {
 }
 
 
-HType HAllocateObject::CalculateInferredType() {
-  return HType::JSObject();
+HType HAllocate::CalculateInferredType() {
+  return type_;
 }
 
 
-HType HAllocate::CalculateInferredType() {
-  return type_;
+void HAllocate::SetSideEffectDominator(GVNFlag side_effect,
+                                       HValue* dominator) {
+  ASSERT(side_effect == kChangesNewSpacePromotion);
+  if (!FLAG_use_allocation_folding || !dominator->IsAllocate()) return;
+
+  // Only fold constant-size new space allocations that directly follow
+  // each other in the same block, so that no allocation is hoisted out of
+  // a branch and the folded size is known at compile time.
+  HAllocate* dominator_allocate = HAllocate::cast(dominator);
+  HValue* dominator_size = dominator_allocate->size();
+  HValue* current_size = size();
+  if (dominator_allocate->block() != block() ||
+      !GuaranteedInNewSpace() || MustAllocateDoubleAligned() ||
+      !current_size->IsInteger32Constant() ||
+      !dominator_allocate->GuaranteedInNewSpace() ||
+      dominator_allocate->MustAllocateDoubleAligned() ||
+      !dominator_size->IsInteger32Constant()) {
+    if (FLAG_trace_allocation_folding) {
+      PrintF("#%d (%s) cannot fold into #%d (%s)\n",
+             id(), Mnemonic(), dominator->id(), dominator->Mnemonic());
+    }
+    return;
+  }
+
+  int32_t dominator_size_constant = dominator_size->GetInteger32Constant();
+  int32_t current_size_constant = current_size->GetInteger32Constant();
+  int32_t new_dominator_size = dominator_size_constant + current_size_constant;
+  if (new_dominator_size > Page::kMaxNonCodeHeapObjectSize) {
+    if (FLAG_trace_allocation_folding) {
+      PrintF("#%d (%s) cannot fold into #%d (%s) due to size: %d\n",
+             id(), Mnemonic(), dominator->id(), dominator->Mnemonic(),
+             new_dominator_size);
+    }
+    return;
+  }
+
+  Zone* zone = block()->zone();
+  HConstant* new_dominator_size_constant =
+      new(zone) HConstant(new_dominator_size, Representation::Integer32());
+  new_dominator_size_constant->InsertBefore(dominator_allocate);
+  dominator_allocate->UpdateSize(new_dominator_size_constant);
+  if (dominator_allocate->folded_offset_ == 0) {
+    dominator_allocate->folded_offset_ = dominator_size_constant;
+  }
+
+  HInstruction* inner_object = new(zone) HInnerAllocatedObject(
+      dominator_allocate, dominator_size_constant, type());
+  inner_object->InsertBefore(this);
+  DeleteAndReplaceWith(inner_object);
+
+  if (FLAG_trace_allocation_folding) {
+    PrintF("#%d (%s) folded into #%d (%s)\n",
+           id(), Mnemonic(), dominator->id(), dominator->Mnemonic());
+  }
 }
 
 
 void HAllocate::PrintDataTo(StringStream* stream) {
   size()->PrintNameTo(stream);
   if (!GuaranteedInNewSpace()) stream->Add(" (pretenure)");
+  if (MustPrefillWithFiller()) {
+    stream->Add(" (folded from %d)", folded_offset());
+  }
 }
 
 
@@ -48,6 +48,7 @@ class HEnvironment;
 class HInferRepresentation;
 class HInstruction;
 class HLoopInformation;
+class HTryRegion;
 class HValue;
 class LInstruction;
 class LChunkBuilder;
@@ -65,7 +66,6 @@ class LChunkBuilder;
   V(AccessArgumentsAt)                         \
   V(Add)                                       \
   V(Allocate)                                  \
-  V(AllocateObject)                            \
   V(ApplyArguments)                            \
   V(ArgumentsElements)                         \
   V(ArgumentsLength)                           \
@@ -86,6 +86,7 @@ class LChunkBuilder;
   V(CallNewArray)                              \
   V(CallRuntime)                               \
   V(CallStub)                                  \
+  V(CatchEntry)                                \
   V(Change)                                    \
   V(CheckFunction)                             \
   V(CheckInstanceType)                         \
@@ -110,6 +111,7 @@ class LChunkBuilder;
   V(DummyUse)                                  \
   V(ElementsKind)                              \
   V(EnterInlined)                              \
+  V(EnterTry)                                  \
   V(FixedArrayBaseLength)                      \
   V(ForceRepresentation)                       \
   V(FunctionLiteral)                           \
@@ -127,12 +129,14 @@ class LChunkBuilder;
   V(InstanceSize)                              \
   V(InvokeFunction)                            \
   V(IsConstructCallAndBranch)                  \
+  V(IsInternalizedStringAndBranch)             \
   V(IsNilAndBranch)                            \
   V(IsObjectAndBranch)                         \
   V(IsStringAndBranch)                         \
   V(IsSmiAndBranch)                            \
   V(IsUndetectableAndBranch)                   \
   V(LeaveInlined)                              \
+  V(LeaveTry)                                  \
   V(LoadContextSlot)                           \
   V(LoadExternalArrayPointer)                  \
   V(LoadFunctionPrototype)                     \
@@ -143,6 +147,7 @@ class LChunkBuilder;
   V(LoadNamedField)                            \
   V(LoadNamedFieldPolymorphic)                 \
   V(LoadNamedGeneric)                          \
+  V(LoadTrySlot)                               \
   V(MapEnumLength)                             \
   V(MathFloorOfDiv)                            \
   V(MathMinMax)                                \
@@ -172,12 +177,14 @@ class LChunkBuilder;
   V(StoreKeyedGeneric)                         \
   V(StoreNamedField)                           \
   V(StoreNamedGeneric)                         \
+  V(StoreTrySlot)                              \
   V(StringAdd)                                 \
   V(StringCharCodeAt)                          \
   V(StringCharFromCode)                        \
   V(StringCompareAndBranch)                    \
   V(StringLength)                              \
   V(Sub)                                       \
+  V(SwitchTable)                               \
   V(ThisFunction)                              \
   V(Throw)                                     \
   V(ToFastProperties)                          \
@@ -189,6 +196,7 @@ class LChunkBuilder;
   V(UnknownOSRValue)                           \
   V(UseConst)                                  \
   V(ValueOf)                                   \
+  V(VectorLoop)                                \
   V(ForInPrepareMap)                           \
   V(ForInCacheArray)                           \
   V(CheckMapValue)                             \
@@ -1785,7 +1793,8 @@ class HSimulate: public HInstruction {
         values_(2, zone),
         assigned_indexes_(2, zone),
         zone_(zone),
-        removable_(removable) {}
+        removable_(removable),
+        try_region_(NULL) {}
   virtual ~HSimulate() {}
 
   virtual void PrintDataTo(StringStream* stream);
@@ -1797,6 +1806,10 @@ class HSimulate: public HInstruction {
     ast_id_ = id;
   }
 
+  // The try statements around the ast id in the unoptimized code.
+  HTryRegion* try_region() const { return try_region_; }
+  void set_try_region(HTryRegion* region) { try_region_ = region; }
+
   int pop_count() const { return pop_count_; }
   const ZoneList<HValue*>* values() const { return &values_; }
   int GetAssignedIndexAt(int index) const {
@@ -1849,6 +1862,7 @@ class HSimulate: public HInstruction {
   ZoneList<int> assigned_indexes_;
   Zone* zone_;
   RemovableSimulate removable_;
+  HTryRegion* try_region_;
 };
 
 
@@ -1959,6 +1973,143 @@ class HLeaveInlined: public HTemplateInstruction<0> {
 };
 
 
+// Links the stack handler of a try statement into the handler chain and
+// enters the try block.  The handler lives in the spill slots of the
+// optimized frame and passes exceptions thrown in the try block on to the
+// landing pad, which deoptimizes to the handler code of the unoptimized
+// function.
+class HEnterTry: public HTemplateControlInstruction<2, 0> {
+ public:
+  HEnterTry(StackHandler::Kind kind,
+            int handler_index,
+            int handler_height,
+            BailoutId finally_return_id,
+            HBasicBlock* try_entry,
+            HBasicBlock* landing_pad)
+      : kind_(kind),
+        handler_index_(handler_index),
+        handler_height_(handler_height),
+        finally_return_id_(finally_return_id) {
+    SetSuccessorAt(0, try_entry);
+    SetSuccessorAt(1, landing_pad);
+  }
+
+  StackHandler::Kind kind() const { return kind_; }
+  // The handler table index of the try statement in the unoptimized code.
+  int handler_index() const { return handler_index_; }
+  // The expression stack height below the handler in the unoptimized frame.
+  int handler_height() const { return handler_height_; }
+  BailoutId finally_return_id() const { return finally_return_id_; }
+  unsigned handler_state() const {
+    return StackHandler::IndexField::encode(handler_index_) |
+        StackHandler::KindField::encode(kind_);
+  }
+
+  HBasicBlock* try_entry() { return SuccessorAt(0); }
+  HBasicBlock* landing_pad() { return SuccessorAt(1); }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return Representation::None();
+  }
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  DECLARE_CONCRETE_INSTRUCTION(EnterTry)
+
+ private:
+  StackHandler::Kind kind_;
+  int handler_index_;
+  int handler_height_;
+  BailoutId finally_return_id_;
+};
+
+
+// Unlinks the stack handler of a try statement on the way out of its try
+// block.
+class HLeaveTry: public HTemplateInstruction<0> {
+ public:
+  explicit HLeaveTry(HEnterTry* entry) : entry_(entry) { }
+
+  HEnterTry* entry() const { return entry_; }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return Representation::None();
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(LeaveTry)
+
+ private:
+  HEnterTry* entry_;
+};
+
+
+// The exception caught by a try statement, defined at the start of its
+// landing pad.
+class HCatchEntry: public HTemplateInstruction<0> {
+ public:
+  explicit HCatchEntry(HEnterTry* entry) : entry_(entry) {
+    set_representation(Representation::Tagged());
+  }
+
+  HEnterTry* entry() const { return entry_; }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return Representation::None();
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(CatchEntry)
+
+ private:
+  HEnterTry* entry_;
+};
+
+
+// Keeps a stack-allocated variable that is assigned in a try block in its
+// try slot, so the landing pad finds its current value.
+class HStoreTrySlot: public HTemplateInstruction<1> {
+ public:
+  HStoreTrySlot(int slot, HValue* value) : slot_(slot) {
+    SetOperandAt(0, value);
+  }
+
+  int slot() const { return slot_; }
+  HValue* value() { return OperandAt(0); }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return Representation::Tagged();
+  }
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  DECLARE_CONCRETE_INSTRUCTION(StoreTrySlot)
+
+ private:
+  int slot_;
+};
+
+
+// The value of a variable in its try slot, defined in a landing pad.
+class HLoadTrySlot: public HTemplateInstruction<0> {
+ public:
+  explicit HLoadTrySlot(int slot) : slot_(slot) {
+    set_representation(Representation::Tagged());
+  }
+
+  int slot() const { return slot_; }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return Representation::None();
+  }
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  DECLARE_CONCRETE_INSTRUCTION(LoadTrySlot)
+
+ private:
+  int slot_;
+};
+
+
 class HPushArgument: public HUnaryOperation {
  public:
   explicit HPushArgument(HValue* value) : HUnaryOperation(value) {
@@ -2665,6 +2816,11 @@ class HCheckMaps: public HTemplateInstruction<2> {
 
   HValue* value() { return OperandAt(0); }
   SmallMapList* map_set() { return &map_set_; }
+  ZoneList<UniqueValueId>* map_unique_ids() { return &map_unique_ids_; }
+
+  // Removes the maps whose unique ids are not in the given list.  Does not
+  // dereference any handles, so it is safe on the optimizer thread.
+  void NarrowToMaps(ZoneList<UniqueValueId>* maps);
 
   virtual void FinalizeUniqueValueId();
 
@@ -2749,12 +2905,24 @@ class HCheckFunction: public HUnaryOperation {
 
 class HCheckInstanceType: public HUnaryOperation {
  public:
+  enum Check {
+    IS_SPEC_OBJECT,
+    IS_JS_ARRAY,
+    IS_JS_FUNCTION,
+    IS_STRING,
+    IS_INTERNALIZED_STRING,
+    LAST_INTERVAL_CHECK = IS_JS_FUNCTION
+  };
+
   static HCheckInstanceType* NewIsSpecObject(HValue* value, Zone* zone) {
     return new(zone) HCheckInstanceType(value, IS_SPEC_OBJECT);
   }
   static HCheckInstanceType* NewIsJSArray(HValue* value, Zone* zone) {
     return new(zone) HCheckInstanceType(value, IS_JS_ARRAY);
   }
+  static HCheckInstanceType* NewIsJSFunction(HValue* value, Zone* zone) {
+    return new(zone) HCheckInstanceType(value, IS_JS_FUNCTION);
+  }
   static HCheckInstanceType* NewIsString(HValue* value, Zone* zone) {
     return new(zone) HCheckInstanceType(value, IS_STRING);
   }
@@ -2771,6 +2939,7 @@ class HCheckInstanceType: public HUnaryOperation {
 
   virtual HValue* Canonicalize();
 
+  Check check() const { return check_; }
   bool is_interval_check() const { return check_ <= LAST_INTERVAL_CHECK; }
   void GetCheckInterval(InstanceType* first, InstanceType* last);
   void GetCheckMaskAndTag(uint8_t* mask, uint8_t* tag);
@@ -2787,14 +2956,6 @@ class HCheckInstanceType: public HUnaryOperation {
   }
 
  private:
-  enum Check {
-    IS_SPEC_OBJECT,
-    IS_JS_ARRAY,
-    IS_STRING,
-    IS_INTERNALIZED_STRING,
-    LAST_INTERVAL_CHECK = IS_JS_ARRAY
-  };
-
   const char* GetCheckName();
 
   HCheckInstanceType(HValue* value, Check check)
@@ -3898,6 +4059,70 @@ class HCompareObjectEqAndBranch: public HTemplateControlInstruction<2, 2> {
 };
 
 
+// Dispatches on an integer value through a table that covers the range
+// [min_value, min_value + size).  Each entry holds the index of its target
+// among the successors.  Successor 0 is taken for values outside the range
+// and for entries that were not set.
+class HSwitchTable: public HControlInstruction {
+ public:
+  HSwitchTable(HValue* value,
+               int min_value,
+               int size,
+               HBasicBlock* default_target,
+               Zone* zone)
+      : value_(NULL),
+        min_value_(min_value),
+        entries_(size, zone),
+        successors_(4, zone) {
+    SetOperandAt(0, value);
+    entries_.AddBlock(0, size, zone);
+    successors_.Add(default_target, zone);
+  }
+
+  HValue* value() { return OperandAt(0); }
+  int min_value() const { return min_value_; }
+  int size() const { return entries_.length(); }
+  // The successor index for the value min_value() + index.
+  int EntryAt(int index) const { return entries_[index]; }
+
+  int AddTarget(HBasicBlock* block, Zone* zone) {
+    successors_.Add(block, zone);
+    return successors_.length() - 1;
+  }
+  void SetEntry(int index, int successor_index) {
+    entries_[index] = successor_index;
+  }
+
+  virtual int OperandCount() { return 1; }
+  virtual HValue* OperandAt(int index) const { return value_; }
+  virtual int SuccessorCount() { return successors_.length(); }
+  virtual HBasicBlock* SuccessorAt(int i) { return successors_[i]; }
+  virtual void SetSuccessorAt(int i, HBasicBlock* block) {
+    successors_[i] = block;
+  }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return Representation::Integer32();
+  }
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  DECLARE_CONCRETE_INSTRUCTION(SwitchTable)
+
+ protected:
+  virtual void InternalSetOperandAt(int index, HValue* value) {
+    ASSERT(index == 0);
+    value_ = value;
+  }
+
+ private:
+  HValue* value_;
+  int min_value_;
+  ZoneList<int> entries_;
+  ZoneList<HBasicBlock*> successors_;
+};
+
+
 class HCompareConstantEqAndBranch: public HUnaryControlInstruction {
  public:
   HCompareConstantEqAndBranch(HValue* left, int right, Token::Value op)
@@ -3971,6 +4196,19 @@ class HIsStringAndBranch: public HUnaryControlInstruction {
 };
 
 
+class HIsInternalizedStringAndBranch: public HUnaryControlInstruction {
+ public:
+  explicit HIsInternalizedStringAndBranch(HValue* value)
+    : HUnaryControlInstruction(value, NULL, NULL) { }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    return Representation::Tagged();
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(IsInternalizedStringAndBranch)
+};
+
+
 class HIsSmiAndBranch: public HUnaryControlInstruction {
  public:
   explicit HIsSmiAndBranch(HValue* value)
@@ -4849,48 +5087,6 @@ class HLoadGlobalGeneric: public HTemplateInstruction<2> {
 };
 
 
-class HAllocateObject: public HTemplateInstruction<1> {
- public:
-  HAllocateObject(HValue* context, Handle<JSFunction> constructor)
-      : constructor_(constructor) {
-    SetOperandAt(0, context);
-    set_representation(Representation::Tagged());
-    SetGVNFlag(kChangesNewSpacePromotion);
-    constructor_initial_map_ = constructor->has_initial_map()
-        ? Handle<Map>(constructor->initial_map())
-        : Handle<Map>::null();
-    // If slack tracking finished, the instance size and property counts
-    // remain unchanged so that we can allocate memory for the object.
-    ASSERT(!constructor->shared()->IsInobjectSlackTrackingInProgress());
-  }
-
-  // Maximum instance size for which allocations will be inlined.
-  static const int kMaxSize = 64 * kPointerSize;
-
-  HValue* context() { return OperandAt(0); }
-  Handle<JSFunction> constructor() { return constructor_; }
-  Handle<Map> constructor_initial_map() { return constructor_initial_map_; }
-
-  virtual Representation RequiredInputRepresentation(int index) {
-    return Representation::Tagged();
-  }
-  virtual Handle<Map> GetMonomorphicJSObjectMap() {
-    ASSERT(!constructor_initial_map_.is_null());
-    return constructor_initial_map_;
-  }
-  virtual HType CalculateInferredType();
-
-  DECLARE_CONCRETE_INSTRUCTION(AllocateObject)
-
- private:
-  // TODO(svenpanne) Might be safe, but leave it out until we know for sure.
-  //  virtual bool IsDeletable() const { return true; }
-
-  Handle<JSFunction> constructor_;
-  Handle<Map> constructor_initial_map_;
-};
-
-
 class HAllocate: public HTemplateInstruction<2> {
  public:
   enum Flags {
@@ -4902,13 +5098,21 @@ class HAllocate: public HTemplateInstruction<2> {
 
   HAllocate(HValue* context, HValue* size, HType type, Flags flags)
       : type_(type),
-        flags_(flags) {
+        flags_(flags),
+        folded_offset_(0),
+        known_initial_map_(Handle<Map>::null()) {
     SetOperandAt(0, context);
     SetOperandAt(1, size);
     set_representation(Representation::Tagged());
+    SetFlag(kTrackSideEffectDominators);
     SetGVNFlag(kChangesNewSpacePromotion);
+    SetGVNFlag(kDependsOnNewSpacePromotion);
   }
 
+  // Maximum instance size for which inlined constructors allocate the
+  // receiver in optimized code.
+  static const int kMaxInlineSize = 64 * kPointerSize;
+
   static Flags DefaultFlags() {
     return CAN_ALLOCATE_IN_NEW_SPACE;
   }
@@ -4935,6 +5139,15 @@ class HAllocate: public HTemplateInstruction<2> {
 
   virtual HType CalculateInferredType();
 
+  // The receiver of an inlined constructor is allocated with the
+  // constructor's initial map.
+  virtual Handle<Map> GetMonomorphicJSObjectMap() {
+    return known_initial_map_;
+  }
+  void set_known_initial_map(Handle<Map> known_initial_map) {
+    known_initial_map_ = known_initial_map;
+  }
+
   bool CanAllocateInNewSpace() const {
     return (flags_ & CAN_ALLOCATE_IN_NEW_SPACE) != 0;
   }
@@ -4960,6 +5173,18 @@ class HAllocate: public HTemplateInstruction<2> {
     return (flags_ & ALLOCATE_DOUBLE_ALIGNED) != 0;
   }
 
+  // Allocations that dominated allocations have been folded into fill the
+  // space behind their own object with fillers, so that the heap stays
+  // iterable until the inner objects have been initialized.
+  bool MustPrefillWithFiller() const { return folded_offset_ > 0; }
+  int folded_offset() const { return folded_offset_; }
+
+  void UpdateSize(HValue* size) {
+    SetOperandAt(1, size);
+  }
+
+  virtual void SetSideEffectDominator(GVNFlag side_effect, HValue* dominator);
+
   virtual void PrintDataTo(StringStream* stream);
 
   DECLARE_CONCRETE_INSTRUCTION(Allocate)
@@ -4967,16 +5192,22 @@ class HAllocate: public HTemplateInstruction<2> {
  private:
   HType type_;
   Flags flags_;
+  int folded_offset_;
+  Handle<Map> known_initial_map_;
 };
 
 
 class HInnerAllocatedObject: public HTemplateInstruction<1> {
  public:
-  HInnerAllocatedObject(HValue* value, int offset)
-      : offset_(offset) {
+  HInnerAllocatedObject(HValue* value,
+                        int offset,
+                        HType type = HType::Tagged())
+      : offset_(offset),
+        type_(type) {
     ASSERT(value->IsAllocate());
     SetOperandAt(0, value);
     set_representation(Representation::Tagged());
+    set_type(type);
   }
 
   HValue* base_object() { return OperandAt(0); }
@@ -4986,12 +5217,15 @@ class HInnerAllocatedObject: public HTemplateInstruction<1> {
     return Representation::Tagged();
   }
 
+  virtual HType CalculateInferredType() { return type_; }
+
   virtual void PrintDataTo(StringStream* stream);
 
   DECLARE_CONCRETE_INSTRUCTION(InnerAllocatedObject)
 
  private:
   int offset_;
+  HType type_;
 };
 
 
@@ -5010,7 +5244,6 @@ inline bool ReceiverObjectNeedsWriteBarrier(HValue* object,
         new_space_dominator);
   }
   if (object != new_space_dominator) return true;
-  if (object->IsAllocateObject()) return false;
   if (object->IsAllocate()) {
     return !HAllocate::cast(object)->GuaranteedInNewSpace();
   }
@@ -5395,7 +5628,10 @@ class ArrayInstructionInterface {
 
 enum LoadKeyedHoleMode {
   NEVER_RETURN_HOLE,
-  ALLOW_RETURN_HOLE
+  ALLOW_RETURN_HOLE,
+  // Only valid while the array protector is intact, see
+  // Isolate::IsArrayProtectorIntact.
+  CONVERT_HOLE_TO_UNDEFINED
 };
 
 
@@ -5511,7 +5747,8 @@ class HLoadKeyed
 
     if (IsDehoisted() && index_offset() != other_load->index_offset())
       return false;
-    return elements_kind() == other_load->elements_kind();
+    return elements_kind() == other_load->elements_kind() &&
+        hole_mode() == other_load->hole_mode();
   }
 
  private:
@@ -5522,8 +5759,8 @@ class HLoadKeyed
   // Establish some checks around our packed fields
   enum LoadKeyedBits {
     kBitsForElementsKind = 5,
-    kBitsForHoleMode = 1,
-    kBitsForIndexOffset = 25,
+    kBitsForHoleMode = 2,
+    kBitsForIndexOffset = 24,
     kBitsForIsDehoisted = 1,
 
     kStartElementsKind = 0,
@@ -5532,8 +5769,9 @@ class HLoadKeyed
     kStartIsDehoisted = kStartIndexOffset + kBitsForIndexOffset
   };
 
-  STATIC_ASSERT((kBitsForElementsKind + kBitsForIndexOffset +
-                 kBitsForIsDehoisted) <= sizeof(uint32_t)*8);
+  STATIC_ASSERT((kBitsForElementsKind + kBitsForHoleMode +
+                 kBitsForIndexOffset + kBitsForIsDehoisted) <=
+                sizeof(uint32_t)*8);
   STATIC_ASSERT(kElementsKindCount <= (1 << kBitsForElementsKind));
   class ElementsKindField:
     public BitField<ElementsKind, kStartElementsKind, kBitsForElementsKind>
@@ -5856,6 +6094,89 @@ class HStoreKeyedGeneric: public HTemplateInstruction<4> {
 };
 
 
+// Runs the iterations [index, limit) of a loop
+//
+//   for (...; i < n; i++) out[i] = e;
+//
+// over external arrays of a single elements kind for as long as whole
+// vectors of elements fit, and returns the index of the first iteration it
+// did not run.  e is given as a postfix program over the elements at i of
+// up to kMaxLoads arrays and kMaxScalars loop invariant values.
+class HVectorLoop: public HTemplateInstruction<8> {
+ public:
+  enum Op {
+    kLoad0, kLoad1, kLoad2,
+    kScalar0, kScalar1,
+    kAdd, kSub, kMul, kDiv
+  };
+
+  static const int kMaxLoads = 3;
+  static const int kMaxScalars = 2;
+  static const int kMaxProgramLength = 15;
+  static const int kMaxStackDepth = 8;
+
+  // Unused load operands must be given the store pointer and unused scalars
+  // a constant zero.
+  HVectorLoop(HValue* index,
+              HValue* limit,
+              HValue* store_pointer,
+              HValue** load_pointers,
+              HValue** scalars,
+              ElementsKind elements_kind)
+      : elements_kind_(elements_kind), program_length_(0) {
+    ASSERT(IsExternalArrayElementsKind(elements_kind));
+    SetOperandAt(0, index);
+    SetOperandAt(1, limit);
+    SetOperandAt(2, store_pointer);
+    for (int i = 0; i < kMaxLoads; ++i) {
+      SetOperandAt(3 + i, load_pointers[i]);
+    }
+    for (int i = 0; i < kMaxScalars; ++i) {
+      SetOperandAt(3 + kMaxLoads + i, scalars[i]);
+    }
+    set_representation(Representation::Integer32());
+    SetGVNFlag(kDependsOnSpecializedArrayElements);
+    SetGVNFlag(kChangesSpecializedArrayElements);
+  }
+
+  virtual Representation RequiredInputRepresentation(int index) {
+    if (index < 2) return Representation::Integer32();
+    if (index < 3 + kMaxLoads) return Representation::External();
+    return scalar_representation();
+  }
+
+  HValue* index() { return OperandAt(0); }
+  HValue* limit() { return OperandAt(1); }
+  HValue* store_pointer() { return OperandAt(2); }
+  HValue* load_pointer(int i) { return OperandAt(3 + i); }
+  HValue* scalar(int i) { return OperandAt(3 + kMaxLoads + i); }
+  ElementsKind elements_kind() const { return elements_kind_; }
+
+  // Int32 kernels compute in 32-bit lanes, all others in double lanes.
+  Representation scalar_representation() const {
+    return elements_kind_ == EXTERNAL_INT_ELEMENTS
+        ? Representation::Integer32()
+        : Representation::Double();
+  }
+
+  int program_length() const { return program_length_; }
+  Op program_at(int i) const { return program_[i]; }
+  void AddOp(Op op) {
+    ASSERT(program_length_ < kMaxProgramLength);
+    program_[program_length_++] = op;
+  }
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  DECLARE_CONCRETE_INSTRUCTION(VectorLoop)
+
+ private:
+  ElementsKind elements_kind_;
+  int program_length_;
+  Op program_[kMaxProgramLength];
+};
+
+
 class HTransitionElementsKind: public HTemplateInstruction<2> {
  public:
   HTransitionElementsKind(HValue* context,
@@ -5891,6 +6212,12 @@ class HTransitionElementsKind: public HTemplateInstruction<2> {
   HValue* context() { return OperandAt(1); }
   Handle<Map> original_map() { return original_map_; }
   Handle<Map> transitioned_map() { return transitioned_map_; }
+  UniqueValueId original_map_unique_id() const {
+    return original_map_unique_id_;
+  }
+  UniqueValueId transitioned_map_unique_id() const {
+    return transitioned_map_unique_id_;
+  }
   ElementsKind from_kind() { return from_kind_; }
   ElementsKind to_kind() { return to_kind_; }
 
@@ -71,10 +71,12 @@ HBasicBlock::HBasicBlock(HGraph* graph)
       last_instruction_index_(-1),
       deleted_phis_(4, graph->zone()),
       parent_loop_header_(NULL),
+      try_region_(NULL),
       is_inline_return_target_(false),
       is_deoptimizing_(false),
       dominates_loop_successors_(false),
-      is_osr_entry_(false) { }
+      is_osr_entry_(false),
+      is_landing_pad_(false) { }
 
 
 Isolate* HBasicBlock::isolate() const {
@@ -157,6 +159,7 @@ HSimulate* HBasicBlock::CreateSimulate(BailoutId ast_id,
 
   HSimulate* instr =
       new(zone()) HSimulate(ast_id, pop_count, zone(), removable);
+  instr->set_try_region(graph()->try_region());
   // Order of pushed values: newest (top of stack) first. This allows
   // HSimulate::MergeInto() to easily append additional pushed values
   // that are older (from further down the stack).
@@ -237,6 +240,7 @@ void HBasicBlock::SetJoinId(BailoutId ast_id) {
             predecessor->last_environment()->closure()->shared()
               ->VerifyBailoutId(ast_id)));
     simulate->set_ast_id(ast_id);
+    simulate->set_try_region(graph()->try_region());
     predecessor->last_environment()->set_ast_id(ast_id);
   }
 }
@@ -426,6 +430,26 @@ void HBasicBlock::Verify() {
 #endif
 
 
+HTryRegion* HTryRegion::HandlerRegion() {
+  HTryRegion* current = this;
+  while (current != NULL && current->kind() != TRY_BLOCK) {
+    current = current->outer();
+  }
+  return current;
+}
+
+
+int HTryRegion::HandlerCount() {
+  int count = 0;
+  for (HTryRegion* current = this;
+       current != NULL;
+       current = current->outer()) {
+    if (current->kind() == TRY_BLOCK) count++;
+  }
+  return count;
+}
+
+
 void HLoopInformation::RegisterBackEdge(HBasicBlock* block) {
   this->back_edges_.Add(block, block->zone());
   AddBlock(block);
@@ -2098,12 +2122,15 @@ HGraph::HGraph(CompilationInfo* info)
       values_(16, info->zone()),
       phi_list_(NULL),
       uint32_instructions_(NULL),
+      try_region_(NULL),
+      try_slot_variables_(0, info->zone()),
       info_(info),
       zone_(info->zone()),
+      has_landing_pads_(false),
       is_recursive_(false),
       use_optimistic_licm_(false),
       has_soft_deoptimize_(false),
-      depends_on_empty_array_proto_elements_(false),
+      depends_on_array_protector_(false),
       type_change_checksum_(0) {
   if (info->IsStub()) {
     HydrogenCodeStub* stub = info->code_stub();
@@ -2123,11 +2150,21 @@ HGraph::HGraph(CompilationInfo* info)
 
 HBasicBlock* HGraph::CreateBasicBlock() {
   HBasicBlock* result = new(zone()) HBasicBlock(this);
+  result->set_try_region(try_region_);
   blocks_.Add(result, zone());
   return result;
 }
 
 
+int HGraph::GetTrySlot(int variable_index) {
+  for (int i = 0; i < try_slot_variables_.length(); i++) {
+    if (try_slot_variables_[i] == variable_index) return i;
+  }
+  try_slot_variables_.Add(variable_index, zone());
+  return try_slot_variables_.length() - 1;
+}
+
+
 void HGraph::FinalizeUniqueValueIds() {
   AssertNoAllocation no_gc;
   ASSERT(!isolate()->optimizing_compiler_thread()->IsOptimizerThread());
@@ -2466,6 +2503,46 @@ void HGraph::OrderBlocks() {
     blocks_.Add(b, zone());
     b->set_block_id(index++);
   }
+  if (has_landing_pads()) OrderLandingPads();
+}
+
+
+static int CompareLandingPadDepth(HBasicBlock* const* a,
+                                  HBasicBlock* const* b) {
+  // Deeper landing pads first, the order is stable otherwise.
+  int depth_a = (*a)->try_region() == NULL
+      ? 0 : (*a)->try_region()->HandlerCount();
+  int depth_b = (*b)->try_region() == NULL
+      ? 0 : (*b)->try_region()->HandlerCount();
+  if (depth_a != depth_b) return depth_b - depth_a;
+  return (*a)->block_id() - (*b)->block_id();
+}
+
+
+// Landing pads are only entered by unwinding, so the values they use are
+// live in every block of the corresponding try block.  The register
+// allocator computes liveness in reverse block order, so the landing pads
+// go last, with the landing pad of an enclosing try statement after the
+// ones nested in its try block.
+void HGraph::OrderLandingPads() {
+  ZoneList<HBasicBlock*> landing_pads(4, zone());
+  int length = 0;
+  for (int i = 0; i < blocks_.length(); ++i) {
+    HBasicBlock* block = blocks_[i];
+    if (block->IsLandingPad()) {
+      landing_pads.Add(block, zone());
+    } else {
+      blocks_[length++] = block;
+    }
+  }
+  landing_pads.Sort(CompareLandingPadDepth);
+  blocks_.Rewind(length);
+  for (int i = 0; i < landing_pads.length(); ++i) {
+    blocks_.Add(landing_pads[i], zone());
+  }
+  for (int i = 0; i < blocks_.length(); ++i) {
+    blocks_[i]->set_block_id(i);
+  }
 }
 
 
@@ -3675,6 +3752,32 @@ void HGlobalValueNumberer::AnalyzeGraph() {
     HInstruction* instr = block->first();
     while (instr != NULL) {
       HInstruction* next = instr->next();
+      // Side-effect dominators are tracked before the instruction's own
+      // side effects are recorded, so that an instruction that both
+      // changes and depends on a side effect sees the previous one.
+      if (instr->CheckFlag(HValue::kTrackSideEffectDominators)) {
+        for (int i = 0; i < kNumberOfTrackedSideEffects; i++) {
+          HValue* other = dominators->at(i);
+          GVNFlag changes_flag = HValue::ChangesFlagFromInt(i);
+          GVNFlag depends_on_flag = HValue::DependsOnFlagFromInt(i);
+          if (instr->DependsOnFlags().Contains(depends_on_flag) &&
+              (other != NULL)) {
+            TRACE_GVN_5("Side-effect #%d in %d (%s) is dominated by %d (%s)\n",
+                        i,
+                        instr->id(),
+                        instr->Mnemonic(),
+                        other->id(),
+                        other->Mnemonic());
+            instr->SetSideEffectDominator(changes_flag, other);
+          }
+        }
+        // The instruction may have been replaced, e.g. by folding it into
+        // its dominator.
+        if (!instr->IsLinked()) {
+          instr = next;
+          continue;
+        }
+      }
       GVNFlagSet flags = instr->ChangesFlags();
       if (!flags.IsEmpty()) {
         // Clear all instructions in the map that are affected by side effects.
@@ -3700,24 +3803,6 @@ void HGlobalValueNumberer::AnalyzeGraph() {
           map->Add(instr, zone());
         }
       }
-      if (instr->IsLinked() &&
-          instr->CheckFlag(HValue::kTrackSideEffectDominators)) {
-        for (int i = 0; i < kNumberOfTrackedSideEffects; i++) {
-          HValue* other = dominators->at(i);
-          GVNFlag changes_flag = HValue::ChangesFlagFromInt(i);
-          GVNFlag depends_on_flag = HValue::DependsOnFlagFromInt(i);
-          if (instr->DependsOnFlags().Contains(depends_on_flag) &&
-              (other != NULL)) {
-            TRACE_GVN_5("Side-effect #%d in %d (%s) is dominated by %d (%s)\n",
-                        i,
-                        instr->id(),
-                        instr->Mnemonic(),
-                        other->id(),
-                        other->Mnemonic());
-            instr->SetSideEffectDominator(changes_flag, other);
-          }
-        }
-      }
       instr = next;
     }
 
@@ -3750,2254 +3835,3895 @@ void HGlobalValueNumberer::AnalyzeGraph() {
 }
 
 
-void HInferRepresentation::AddToWorklist(HValue* current) {
-  if (current->representation().IsTagged()) return;
-  if (!current->CheckFlag(HValue::kFlexibleRepresentation)) return;
-  if (in_worklist_.Contains(current->id())) return;
-  worklist_.Add(current, zone());
-  in_worklist_.Add(current->id());
-}
+// Alias analysis for object values based on where they were allocated.
+// Distinct fresh allocations never alias each other, nor anything that
+// existed before they were allocated.
+class HAliasAnalyzer : public AllStatic {
+ public:
+  enum Aliasing { kMustAlias, kMayAlias, kNoAlias };
+
+  static Aliasing Query(HValue* a, HValue* b) {
+    if (a == b) return kMustAlias;
+    if (IsFreshAllocation(a) && IsFreshAllocation(b)) {
+      if (a->IsInnerAllocatedObject() && b->IsInnerAllocatedObject()) {
+        HInnerAllocatedObject* inner_a = HInnerAllocatedObject::cast(a);
+        HInnerAllocatedObject* inner_b = HInnerAllocatedObject::cast(b);
+        if (inner_a->base_object() == inner_b->base_object() &&
+            inner_a->offset() == inner_b->offset()) {
+          return kMustAlias;
+        }
+      }
+      return kNoAlias;
+    }
+    if (IsFreshAllocation(a) && ExistsBeforeAllocation(b, a)) return kNoAlias;
+    if (IsFreshAllocation(b) && ExistsBeforeAllocation(a, b)) return kNoAlias;
+    return kMayAlias;
+  }
 
+ private:
+  static bool IsFreshAllocation(HValue* value) {
+    return value->IsAllocate() || value->IsInnerAllocatedObject();
+  }
 
-void HInferRepresentation::Analyze() {
-  HPhase phase("H_Infer representations", graph_);
+  // Returns true if the given value was computed before the given fresh
+  // allocation was executed, so that it cannot refer to the new object.
+  static bool ExistsBeforeAllocation(HValue* value, HValue* allocation) {
+    if (allocation->IsInnerAllocatedObject()) {
+      allocation = HInnerAllocatedObject::cast(allocation)->base_object();
+    }
+    if (value->IsParameter() || value->IsConstant()) return true;
+    return value->block() != allocation->block() &&
+        value->block()->Dominates(allocation->block());
+  }
+};
 
-  // (1) Initialize bit vectors and count real uses. Each phi gets a
-  // bit-vector of length <number of phis>.
-  const ZoneList<HPhi*>* phi_list = graph_->phi_list();
-  int phi_count = phi_list->length();
-  ZoneList<BitVector*> connected_phis(phi_count, graph_->zone());
-  for (int i = 0; i < phi_count; ++i) {
-    phi_list->at(i)->InitRealUses(i);
-    BitVector* connected_set = new(zone()) BitVector(phi_count, graph_->zone());
-    connected_set->Add(i);
-    connected_phis.Add(connected_set, zone());
+
+// Redundant load and store elimination for named fields.
+//
+// The dominator tree is walked while keeping a table of the values known to
+// be held by object fields (identified by the object and the field offset).
+// The table is filled in by loads and stores and invalidated by instructions
+// with side effects.  A load from a field with a known value is replaced by
+// that value, and a store of the value a field is already known to hold is
+// removed.  Unlike GVN, a store only invalidates fields of objects that may
+// alias its receiver, and the stored value is forwarded to later loads.
+// The table is propagated to dominated blocks with a single predecessor and
+// starts out empty at merges and loop headers.
+class HLoadEliminationTable : public ZoneObject {
+ public:
+  explicit HLoadEliminationTable(Zone* zone)
+      : fields_(kMaxTrackedFields, zone),
+        maps_(kMaxTrackedObjects, zone) { }
+
+  HLoadEliminationTable(const HLoadEliminationTable* other, Zone* zone)
+      : fields_(kMaxTrackedFields, zone),
+        maps_(kMaxTrackedObjects, zone) {
+    fields_.AddAll(other->fields_, zone);
+    maps_.AddAll(other->maps_, zone);
   }
 
-  // (2) Do a fixed point iteration to find the set of connected phis.  A
-  // phi is connected to another phi if its value is used either directly or
-  // indirectly through a transitive closure of the def-use relation.
-  bool change = true;
-  while (change) {
-    change = false;
-    // We normally have far more "forward edges" than "backward edges",
-    // so we terminate faster when we walk backwards.
-    for (int i = phi_count - 1; i >= 0; --i) {
-      HPhi* phi = phi_list->at(i);
-      for (HUseIterator it(phi->uses()); !it.Done(); it.Advance()) {
-        HValue* use = it.value();
-        if (use->IsPhi()) {
-          int id = HPhi::cast(use)->phi_id();
-          if (connected_phis[i]->UnionIsChanged(*connected_phis[id]))
-            change = true;
-        }
+  HLoadEliminationTable* Copy(Zone* zone) const {
+    return new(zone) HLoadEliminationTable(this, zone);
+  }
+
+  // Returns the value known to be held by the field at the given offset of
+  // the given object, or NULL if the value is unknown.
+  HValue* Lookup(HValue* object, int offset) {
+    for (int i = 0; i < fields_.length(); i++) {
+      if (fields_[i].object == object && fields_[i].offset == offset) {
+        return fields_[i].value;
       }
     }
+    return NULL;
   }
 
-  // Set truncation flags for groups of connected phis. This is a conservative
-  // approximation; the flag will be properly re-computed after representations
-  // have been determined.
-  if (phi_count > 0) {
-    BitVector* done = new(zone()) BitVector(phi_count, graph_->zone());
-    for (int i = 0; i < phi_count; ++i) {
-      if (done->Contains(i)) continue;
-
-      // Check if all uses of all connected phis in this group are truncating.
-      bool all_uses_everywhere_truncating = true;
-      for (BitVector::Iterator it(connected_phis.at(i));
-           !it.Done();
-           it.Advance()) {
-        int index = it.Current();
-        all_uses_everywhere_truncating &=
-            phi_list->at(index)->CheckFlag(HInstruction::kTruncatingToInt32);
-        done->Add(index);
+  // Records the value of a field.  The entry is invalidated by instructions
+  // that change any of the given side effects.
+  void Insert(HValue* object, int offset, HValue* value,
+              GVNFlagSet depends_on, Zone* zone) {
+    for (int i = 0; i < fields_.length(); i++) {
+      if (fields_[i].object == object && fields_[i].offset == offset) {
+        fields_[i].value = value;
+        fields_[i].depends_on = depends_on;
+        return;
       }
-      if (all_uses_everywhere_truncating) {
-        continue;  // Great, nothing to do.
+    }
+    if (fields_.length() == kMaxTrackedFields) fields_.Remove(0);
+    TrackedField field = { object, offset, value, depends_on };
+    fields_.Add(field, zone);
+  }
+
+  // Forgets the fields at the given offset of all objects that may alias the
+  // given object.
+  void KillFieldsAliasing(HValue* object, int offset) {
+    for (int i = fields_.length() - 1; i >= 0; i--) {
+      if (fields_[i].offset == offset &&
+          Query(fields_[i].object, object) != HAliasAnalyzer::kNoAlias) {
+        RemoveField(i);
       }
-      // Clear truncation flag of this group of connected phis.
-      for (BitVector::Iterator it(connected_phis.at(i));
-           !it.Done();
-           it.Advance()) {
-        int index = it.Current();
-        phi_list->at(index)->ClearFlag(HInstruction::kTruncatingToInt32);
+    }
+  }
+
+  // Forgets everything that depends on the given side effects of objects
+  // that may alias the given object.
+  void KillObjectsAliasing(HValue* object, GVNFlagSet depends_on) {
+    for (int i = fields_.length() - 1; i >= 0; i--) {
+      if (fields_[i].depends_on.ContainsAnyOf(depends_on) &&
+          Query(fields_[i].object, object) != HAliasAnalyzer::kNoAlias) {
+        RemoveField(i);
       }
     }
+    if (DependsOnMaps(depends_on)) KillMapsAliasing(object);
   }
 
-  // Simplify constant phi inputs where possible.
-  // This step uses kTruncatingToInt32 flags of phis.
-  for (int i = 0; i < phi_count; ++i) {
-    phi_list->at(i)->SimplifyConstantInputs();
+  // Forgets everything that depends on the given side effects.
+  void Kill(GVNFlagSet depends_on) {
+    for (int i = fields_.length() - 1; i >= 0; i--) {
+      if (fields_[i].depends_on.ContainsAnyOf(depends_on)) RemoveField(i);
+    }
+    if (DependsOnMaps(depends_on)) maps_.Rewind(0);
   }
 
-  // Use the phi reachability information from step 2 to
-  // push information about values which can't be converted to integer
-  // without deoptimization through the phi use-def chains, avoiding
-  // unnecessary deoptimizations later.
-  for (int i = 0; i < phi_count; ++i) {
-    HPhi* phi = phi_list->at(i);
-    bool cti = phi->AllOperandsConvertibleToInteger();
-    if (cti) continue;
+  // Records that the object's map is one of the given maps.
+  void SetKnownMaps(HValue* object, ZoneList<UniqueValueId>* maps,
+                    Zone* zone) {
+    for (int i = 0; i < maps_.length(); i++) {
+      if (maps_[i].object == object) {
+        maps_[i].maps = maps;
+        return;
+      }
+    }
+    if (maps_.length() == kMaxTrackedObjects) maps_.Remove(0);
+    TrackedMaps entry = { object, maps };
+    maps_.Add(entry, zone);
+  }
 
-    for (BitVector::Iterator it(connected_phis.at(i));
-         !it.Done();
-         it.Advance()) {
-      HPhi* phi = phi_list->at(it.Current());
-      phi->set_is_convertible_to_integer(false);
+  void KillMapsAliasing(HValue* object) {
+    for (int i = maps_.length() - 1; i >= 0; i--) {
+      if (Query(maps_[i].object, object) != HAliasAnalyzer::kNoAlias) {
+        maps_[i] = maps_.last();
+        maps_.RemoveLast();
+      }
     }
   }
 
-  // Use the phi reachability information from step 2 to
-  // sum up the non-phi use counts of all connected phis.
-  for (int i = 0; i < phi_count; ++i) {
-    HPhi* phi = phi_list->at(i);
-    for (BitVector::Iterator it(connected_phis.at(i));
-         !it.Done();
-         it.Advance()) {
-      int index = it.Current();
-      HPhi* it_use = phi_list->at(index);
-      if (index != i) phi->AddNonPhiUsesFrom(it_use);  // Don't count twice.
+  // Alias analysis for two object values.  In addition to the allocation
+  // based rules, objects known to have disjoint sets of maps are different.
+  HAliasAnalyzer::Aliasing Query(HValue* a, HValue* b) {
+    HAliasAnalyzer::Aliasing result = HAliasAnalyzer::Query(a, b);
+    if (result != HAliasAnalyzer::kMayAlias) return result;
+    ZoneList<UniqueValueId>* maps_a = KnownMaps(a);
+    ZoneList<UniqueValueId>* maps_b = KnownMaps(b);
+    if (maps_a != NULL && maps_b != NULL && !Intersect(maps_a, maps_b)) {
+      return HAliasAnalyzer::kNoAlias;
     }
+    return HAliasAnalyzer::kMayAlias;
   }
 
-  // Initialize work list
-  for (int i = 0; i < graph_->blocks()->length(); ++i) {
-    HBasicBlock* block = graph_->blocks()->at(i);
-    const ZoneList<HPhi*>* phis = block->phis();
-    for (int j = 0; j < phis->length(); ++j) {
-      AddToWorklist(phis->at(j));
+ private:
+  struct TrackedField {
+    HValue* object;
+    int offset;
+    HValue* value;
+    GVNFlagSet depends_on;
+  };
+
+  struct TrackedMaps {
+    HValue* object;
+    ZoneList<UniqueValueId>* maps;
+  };
+
+  // Bounds the cost of copying and searching the table.
+  static const int kMaxTrackedFields = 32;
+  static const int kMaxTrackedObjects = 16;
+
+  static bool DependsOnMaps(GVNFlagSet depends_on) {
+    return depends_on.Contains(kDependsOnMaps) ||
+        depends_on.Contains(kDependsOnElementsKind);
+  }
+
+  static bool Intersect(ZoneList<UniqueValueId>* a,
+                        ZoneList<UniqueValueId>* b) {
+    for (int i = 0; i < a->length(); i++) {
+      for (int j = 0; j < b->length(); j++) {
+        if (a->at(i) == b->at(j)) return true;
+      }
     }
+    return false;
+  }
 
-    HInstruction* current = block->first();
-    while (current != NULL) {
-      AddToWorklist(current);
-      current = current->next();
+  ZoneList<UniqueValueId>* KnownMaps(HValue* object) {
+    for (int i = 0; i < maps_.length(); i++) {
+      if (maps_[i].object == object) return maps_[i].maps;
     }
+    return NULL;
   }
 
-  // Do a fixed point iteration, trying to improve representations
-  while (!worklist_.is_empty()) {
-    HValue* current = worklist_.RemoveLast();
-    in_worklist_.Remove(current->id());
-    current->InferRepresentation(this);
+  void RemoveField(int index) {
+    fields_[index] = fields_.last();
+    fields_.RemoveLast();
   }
 
-  // Lastly: any instruction that we don't have representation information
-  // for defaults to Tagged.
-  for (int i = 0; i < graph_->blocks()->length(); ++i) {
-    HBasicBlock* block = graph_->blocks()->at(i);
-    const ZoneList<HPhi*>* phis = block->phis();
-    for (int j = 0; j < phis->length(); ++j) {
-      HPhi* phi = phis->at(j);
-      if (phi->representation().IsNone()) {
-        phi->ChangeRepresentation(Representation::Tagged());
-      }
+  ZoneList<TrackedField> fields_;
+  ZoneList<TrackedMaps> maps_;
+};
+
+
+class HLoadEliminator BASE_EMBEDDED {
+ public:
+  explicit HLoadEliminator(HGraph* graph) : graph_(graph) { }
+
+  void Process();
+
+ private:
+  void ProcessBlock(HBasicBlock* block, HLoadEliminationTable* table);
+  void ProcessInstruction(HInstruction* instr, HLoadEliminationTable* table);
+  void ProcessLoad(HLoadNamedField* load, HLoadEliminationTable* table);
+  void ProcessStore(HStoreNamedField* store, HLoadEliminationTable* table);
+
+  Zone* zone() const { return graph_->zone(); }
+
+  HGraph* graph_;
+};
+
+
+void HLoadEliminator::Process() {
+  HPhase phase("H_Load elimination", graph_);
+  ProcessBlock(graph_->entry_block(),
+               new(zone()) HLoadEliminationTable(zone()));
+}
+
+
+// This method is recursive, so the per-instruction work is kept in
+// ProcessInstruction() to keep its stack frame small.
+void HLoadEliminator::ProcessBlock(HBasicBlock* block,
+                                   HLoadEliminationTable* table) {
+  HInstruction* instr = block->first();
+  while (instr != NULL) {
+    HInstruction* next = instr->next();
+    ProcessInstruction(instr, table);
+    instr = next;
+  }
+
+  const ZoneList<HBasicBlock*>* dominated = block->dominated_blocks();
+  for (int i = 0; i < dominated->length(); ++i) {
+    HBasicBlock* child = dominated->at(i);
+    HLoadEliminationTable* child_table;
+    if (child->predecessors()->length() != 1) {
+      child_table = new(zone()) HLoadEliminationTable(zone());
+    } else if (i == dominated->length() - 1) {
+      // No need to copy the table for the last child in the dominator tree.
+      child_table = table;
+    } else {
+      child_table = table->Copy(zone());
+    }
+    ProcessBlock(child, child_table);
+  }
+}
+
+
+void HLoadEliminator::ProcessInstruction(HInstruction* instr,
+                                         HLoadEliminationTable* table) {
+  if (instr->IsLoadNamedField()) {
+    ProcessLoad(HLoadNamedField::cast(instr), table);
+  } else if (instr->IsStoreNamedField()) {
+    ProcessStore(HStoreNamedField::cast(instr), table);
+  } else if (instr->IsCheckMaps()) {
+    HCheckMaps* check = HCheckMaps::cast(instr);
+    ZoneList<UniqueValueId>* maps = check->map_unique_ids();
+    if (!maps->is_empty() && maps->length() == check->map_set()->length()) {
+      table->SetKnownMaps(check->value(), maps, zone());
+    }
+  } else if (instr->IsTransitionElementsKind()) {
+    // Only the elements kind, map and elements pointer of the transitioned
+    // object change.
+    HTransitionElementsKind* transition =
+        HTransitionElementsKind::cast(instr);
+    table->KillFieldsAliasing(transition->object(), HeapObject::kMapOffset);
+    table->KillObjectsAliasing(
+        transition->object(),
+        HValue::ConvertChangesToDependsFlags(instr->ChangesFlags()));
+  } else {
+    GVNFlagSet changes = instr->ChangesFlags();
+    if (!changes.IsEmpty()) {
+      table->Kill(HValue::ConvertChangesToDependsFlags(changes));
     }
-    for (HInstruction* current = block->first();
-         current != NULL; current = current->next()) {
-      if (current->representation().IsNone() &&
-          current->CheckFlag(HInstruction::kFlexibleRepresentation)) {
-        current->ChangeRepresentation(Representation::Tagged());
-      }
+  }
+}
+
+
+void HLoadEliminator::ProcessLoad(HLoadNamedField* load,
+                                  HLoadEliminationTable* table) {
+  HValue* object = load->object();
+  HValue* known = table->Lookup(object, load->offset());
+  if (known != NULL &&
+      known->representation().Equals(load->representation())) {
+    if (FLAG_trace_load_elimination) {
+      PrintF("[load elimination: replacing load %d with %d]\n",
+             load->id(), known->id());
     }
+    load->DeleteAndReplaceWith(known);
+    return;
   }
+  table->Insert(object, load->offset(), load, load->DependsOnFlags(), zone());
 }
 
 
-void HGraph::MergeRemovableSimulates() {
-  HPhase phase("H_Merge removable simulates", this);
-  ZoneList<HSimulate*> mergelist(2, zone());
-  for (int i = 0; i < blocks()->length(); ++i) {
-    HBasicBlock* block = blocks()->at(i);
-    // Make sure the merge list is empty at the start of a block.
-    ASSERT(mergelist.is_empty());
-    // Nasty heuristic: Never remove the first simulate in a block. This
-    // just so happens to have a beneficial effect on register allocation.
-    bool first = true;
-    for (HInstruction* current = block->first();
-         current != NULL; current = current->next()) {
-      if (current->IsLeaveInlined()) {
-        // Never fold simulates from inlined environments into simulates
-        // in the outer environment.
-        // (Before each HEnterInlined, there is a non-foldable HSimulate
-        // anyway, so we get the barrier in the other direction for free.)
-        // Simply remove all accumulated simulates without merging.  This
-        // is safe because simulates after instructions with side effects
-        // are never added to the merge list.
-        while (!mergelist.is_empty()) {
-          mergelist.RemoveLast()->DeleteAndReplaceWith(NULL);
-        }
-        continue;
-      }
-      // Skip the non-simulates and the first simulate.
-      if (!current->IsSimulate()) continue;
-      if (first) {
-        first = false;
-        continue;
-      }
-      HSimulate* current_simulate = HSimulate::cast(current);
-      if ((current_simulate->previous()->HasObservableSideEffects() &&
-           !current_simulate->next()->IsSimulate()) ||
-          !current_simulate->is_candidate_for_removal()) {
-        // This simulate is not suitable for folding.
-        // Fold the ones accumulated so far.
-        current_simulate->MergeWith(&mergelist);
-        continue;
-      } else {
-        // Accumulate this simulate for folding later on.
-        mergelist.Add(current_simulate, zone());
-      }
+void HLoadEliminator::ProcessStore(HStoreNamedField* store,
+                                   HLoadEliminationTable* table) {
+  HValue* object = store->object();
+  HValue* value = store->value();
+  int offset = store->offset();
+  bool changes_map = store->CheckGVNFlag(kChangesMaps);
+  if (!changes_map && table->Lookup(object, offset) == value) {
+    if (FLAG_trace_load_elimination) {
+      PrintF("[load elimination: removing redundant store %d]\n",
+             store->id());
     }
+    store->DeleteAndReplaceWith(NULL);
+    return;
+  }
 
-    if (!mergelist.is_empty()) {
-      // Merge the accumulated simulates at the end of the block.
-      HSimulate* last = mergelist.RemoveLast();
-      last->MergeWith(&mergelist);
+  table->KillFieldsAliasing(object, offset);
+  if (changes_map) {
+    table->KillFieldsAliasing(object, HeapObject::kMapOffset);
+    table->KillMapsAliasing(object);
+    if (!store->transition().is_null()) {
+      ZoneList<UniqueValueId>* maps =
+          new(zone()) ZoneList<UniqueValueId>(1, zone());
+      maps->Add(store->transition_unique_id(), zone());
+      table->SetKnownMaps(object, maps, zone());
     }
   }
+  GVNFlagSet depends_on =
+      HValue::ConvertChangesToDependsFlags(store->ChangesFlags());
+  depends_on.Add(kDependsOnMaps);
+  table->Insert(object, offset, value, depends_on, zone());
 }
 
 
-void HGraph::InitializeInferredTypes() {
-  HPhase phase("H_Inferring types", this);
-  InitializeInferredTypes(0, this->blocks_.length() - 1);
-}
+// Elimination of redundant map, smi and instance type checks.
+//
+// The blocks are visited in reverse postorder while keeping a table of the
+// maps each value is known to have and of the type checks it is known to
+// pass.  A check whose outcome is implied by the table is removed, and a map
+// check is narrowed to the maps the value can actually have.  Known maps are
+// invalidated by instructions that change maps or elements kinds, whereas
+// type facts hold for the whole lifetime of a value.  At merges only what is
+// known in all predecessors is kept, and a loop header inherits the table of
+// its pre-header, minus the known maps if the loop may change maps.
+class HCheckTable : public ZoneObject {
+ public:
+  enum Fact {
+    kIsSmi = 1 << 0,
+    kIsHeapObject = 1 << 1,
+    kIsSpecObject = 1 << 2,
+    kIsJSArray = 1 << 3,
+    kIsString = 1 << 4,
+    kIsInternalizedString = 1 << 5,
+    kIsJSFunction = 1 << 6
+  };
 
+  explicit HCheckTable(Zone* zone) : entries_(kMaxTrackedValues, zone) { }
 
-void HGraph::InitializeInferredTypes(int from_inclusive, int to_inclusive) {
-  for (int i = from_inclusive; i <= to_inclusive; ++i) {
-    HBasicBlock* block = blocks_[i];
+  HCheckTable(const HCheckTable* other, Zone* zone)
+      : entries_(kMaxTrackedValues, zone) {
+    entries_.AddAll(other->entries_, zone);
+  }
 
-    const ZoneList<HPhi*>* phis = block->phis();
-    for (int j = 0; j < phis->length(); j++) {
-      phis->at(j)->UpdateInferredType();
-    }
+  HCheckTable* Copy(Zone* zone) const {
+    return new(zone) HCheckTable(this, zone);
+  }
 
-    HInstruction* current = block->first();
-    while (current != NULL) {
-      current->UpdateInferredType();
-      current = current->next();
-    }
+  // Returns the facts known about the given value, including the ones
+  // implied by its type.
+  int Facts(HValue* value) {
+    Entry* entry = Find(value);
+    int facts = IntrinsicFacts(value);
+    return entry == NULL ? facts : (facts | entry->facts);
+  }
 
-    if (block->IsLoopHeader()) {
-      HBasicBlock* last_back_edge =
-          block->loop_information()->GetLastBackEdge();
-      InitializeInferredTypes(i + 1, last_back_edge->block_id());
-      // Skip all blocks already processed by the recursive call.
-      i = last_back_edge->block_id();
-      // Update phis of the loop header now after the whole loop body is
-      // guaranteed to be processed.
-      ZoneList<HValue*> worklist(block->phis()->length(), zone());
-      for (int j = 0; j < block->phis()->length(); ++j) {
-        worklist.Add(block->phis()->at(j), zone());
+  // Returns the maps the given value is known to have, or NULL if unknown.
+  ZoneList<UniqueValueId>* Maps(HValue* value) {
+    Entry* entry = Find(value);
+    return entry == NULL ? NULL : entry->maps;
+  }
+
+  void AddFacts(HValue* value, int facts, Zone* zone) {
+    FindOrInsert(value, zone)->facts |= Implied(facts);
+  }
+
+  // Records that the value's map is one of the given maps.  The list must
+  // not be modified afterwards.
+  void SetMaps(HValue* value, ZoneList<UniqueValueId>* maps, Zone* zone) {
+    Entry* entry = FindOrInsert(value, zone);
+    entry->facts |= kIsHeapObject;
+    entry->maps = maps;
+  }
+
+  // Forgets the maps of all values that may alias the given object.
+  void KillMapsAliasing(HValue* object) {
+    for (int i = 0; i < entries_.length(); i++) {
+      if (HAliasAnalyzer::Query(entries_[i].object, object) !=
+          HAliasAnalyzer::kNoAlias) {
+        entries_[i].maps = NULL;
       }
-      InferTypes(&worklist);
     }
   }
-}
 
+  void KillMaps() {
+    for (int i = 0; i < entries_.length(); i++) entries_[i].maps = NULL;
+  }
 
-void HGraph::PropagateMinusZeroChecks(HValue* value, BitVector* visited) {
-  HValue* current = value;
-  while (current != NULL) {
-    if (visited->Contains(current->id())) return;
+  // Accounts for an elements kind transition of the given object from one
+  // map to another in the known maps of all values that may alias it.
+  void TransitionMapsAliasing(HValue* object,
+                              UniqueValueId from,
+                              UniqueValueId to,
+                              Zone* zone) {
+    for (int i = 0; i < entries_.length(); i++) {
+      ZoneList<UniqueValueId>* maps = entries_[i].maps;
+      if (maps == NULL || !maps->Contains(from)) continue;
+      if (HAliasAnalyzer::Query(entries_[i].object, object) ==
+          HAliasAnalyzer::kNoAlias) {
+        continue;
+      }
+      ZoneList<UniqueValueId>* transitioned =
+          new(zone) ZoneList<UniqueValueId>(maps->length(), zone);
+      for (int j = 0; j < maps->length(); j++) {
+        if (maps->at(j) != from) transitioned->Add(maps->at(j), zone);
+      }
+      if (!transitioned->Contains(to)) transitioned->Add(to, zone);
+      entries_[i].maps = transitioned;
+    }
+  }
 
-    // For phis, we must propagate the check to all of its inputs.
-    if (current->IsPhi()) {
-      visited->Add(current->id());
-      HPhi* phi = HPhi::cast(current);
-      for (int i = 0; i < phi->OperandCount(); ++i) {
-        PropagateMinusZeroChecks(phi->OperandAt(i), visited);
+  // Keeps only what is known both in this table and in the other one.
+  void Merge(HCheckTable* other, Zone* zone) {
+    for (int i = entries_.length() - 1; i >= 0; i--) {
+      Entry* other_entry = other->Find(entries_[i].object);
+      if (other_entry == NULL) {
+        Remove(i);
+        continue;
       }
-      break;
+      entries_[i].facts &= other_entry->facts;
+      entries_[i].maps = Union(entries_[i].maps, other_entry->maps, zone);
+      if (entries_[i].facts == 0 && entries_[i].maps == NULL) Remove(i);
     }
+  }
 
-    // For multiplication, division, and Math.min/max(), we must propagate
-    // to the left and the right side.
-    if (current->IsMul()) {
-      HMul* mul = HMul::cast(current);
-      mul->EnsureAndPropagateNotMinusZero(visited);
-      PropagateMinusZeroChecks(mul->left(), visited);
-      PropagateMinusZeroChecks(mul->right(), visited);
-    } else if (current->IsDiv()) {
-      HDiv* div = HDiv::cast(current);
-      div->EnsureAndPropagateNotMinusZero(visited);
-      PropagateMinusZeroChecks(div->left(), visited);
-      PropagateMinusZeroChecks(div->right(), visited);
-    } else if (current->IsMathMinMax()) {
-      HMathMinMax* minmax = HMathMinMax::cast(current);
-      visited->Add(minmax->id());
-      PropagateMinusZeroChecks(minmax->left(), visited);
-      PropagateMinusZeroChecks(minmax->right(), visited);
+  static int Implied(int facts) {
+    if (facts & kIsInternalizedString) facts |= kIsString;
+    if (facts & (kIsJSArray | kIsJSFunction)) facts |= kIsSpecObject;
+    if (facts & (kIsString | kIsSpecObject)) facts |= kIsHeapObject;
+    return facts;
+  }
+
+  // Returns the union of two map sets, either of which may be unknown.
+  static ZoneList<UniqueValueId>* Union(ZoneList<UniqueValueId>* a,
+                                        ZoneList<UniqueValueId>* b,
+                                        Zone* zone) {
+    if (a == NULL || b == NULL) return NULL;
+    if (a == b || IsSubset(b, a)) return a;
+    if (IsSubset(a, b)) return b;
+    ZoneList<UniqueValueId>* result =
+        new(zone) ZoneList<UniqueValueId>(a->length() + b->length(), zone);
+    result->AddAll(*a, zone);
+    for (int i = 0; i < b->length(); i++) {
+      if (!a->Contains(b->at(i))) result->Add(b->at(i), zone);
     }
+    return result;
+  }
 
-    current = current->EnsureAndPropagateNotMinusZero(visited);
+  static ZoneList<UniqueValueId>* Intersection(ZoneList<UniqueValueId>* a,
+                                               ZoneList<UniqueValueId>* b,
+                                               Zone* zone) {
+    ZoneList<UniqueValueId>* result =
+        new(zone) ZoneList<UniqueValueId>(a->length(), zone);
+    for (int i = 0; i < a->length(); i++) {
+      if (b->Contains(a->at(i))) result->Add(a->at(i), zone);
+    }
+    return result;
   }
-}
 
+  static bool IsSubset(ZoneList<UniqueValueId>* a,
+                       ZoneList<UniqueValueId>* b) {
+    for (int i = 0; i < a->length(); i++) {
+      if (!b->Contains(a->at(i))) return false;
+    }
+    return true;
+  }
 
-void HGraph::InsertRepresentationChangeForUse(HValue* value,
-                                              HValue* use_value,
-                                              int use_index,
-                                              Representation to) {
-  // Insert the representation change right before its use. For phi-uses we
-  // insert at the end of the corresponding predecessor.
-  HInstruction* next = NULL;
-  if (use_value->IsPhi()) {
-    next = use_value->block()->predecessors()->at(use_index)->end();
-  } else {
-    next = HInstruction::cast(use_value);
+ private:
+  struct Entry {
+    HValue* object;
+    int facts;
+    ZoneList<UniqueValueId>* maps;
+  };
+
+  // Bounds the cost of copying, merging and searching the table.
+  static const int kMaxTrackedValues = 64;
+
+  static int IntrinsicFacts(HValue* value) {
+    HType type = value->type();
+    if (type.IsUninitialized()) return 0;
+    if (type.IsSmi()) return kIsSmi;
+    if (type.IsJSArray()) return Implied(kIsJSArray);
+    if (type.IsString()) return Implied(kIsString);
+    if (type.IsHeapObject()) return kIsHeapObject;
+    return 0;
   }
-  // For constants we try to make the representation change at compile
-  // time. When a representation change is not possible without loss of
-  // information we treat constants like normal instructions and insert the
-  // change instructions for them.
-  HInstruction* new_value = NULL;
-  bool is_truncating = use_value->CheckFlag(HValue::kTruncatingToInt32);
-  bool deoptimize_on_undefined =
-      use_value->CheckFlag(HValue::kDeoptimizeOnUndefined);
-  if (value->IsConstant()) {
-    HConstant* constant = HConstant::cast(value);
-    // Try to create a new copy of the constant with the new representation.
-    new_value = (is_truncating && to.IsInteger32())
-        ? constant->CopyToTruncatedInt32(zone())
-        : constant->CopyToRepresentation(to, zone());
+
+  Entry* Find(HValue* value) {
+    for (int i = 0; i < entries_.length(); i++) {
+      if (entries_[i].object == value) return &entries_[i];
+    }
+    return NULL;
   }
 
-  if (new_value == NULL) {
-    new_value = new(zone()) HChange(value, to,
-                                    is_truncating, deoptimize_on_undefined);
+  Entry* FindOrInsert(HValue* value, Zone* zone) {
+    Entry* entry = Find(value);
+    if (entry != NULL) return entry;
+    if (entries_.length() == kMaxTrackedValues) entries_.Remove(0);
+    Entry new_entry = { value, 0, NULL };
+    entries_.Add(new_entry, zone);
+    return &entries_.last();
   }
 
-  new_value->InsertBefore(next);
-  use_value->SetOperandAt(use_index, new_value);
-}
+  void Remove(int index) {
+    entries_[index] = entries_.last();
+    entries_.RemoveLast();
+  }
 
+  ZoneList<Entry> entries_;
+};
 
-void HGraph::InsertRepresentationChangesForValue(HValue* value) {
-  Representation r = value->representation();
-  if (r.IsNone()) return;
-  if (value->HasNoUses()) return;
 
-  for (HUseIterator it(value->uses()); !it.Done(); it.Advance()) {
-    HValue* use_value = it.value();
-    int use_index = it.index();
-    Representation req = use_value->RequiredInputRepresentation(use_index);
-    if (req.IsNone() || req.Equals(r)) continue;
-    InsertRepresentationChangeForUse(value, use_value, use_index, req);
-  }
-  if (value->HasNoUses()) {
-    ASSERT(value->IsConstant());
-    value->DeleteAndReplaceWith(NULL);
+class HCheckEliminator BASE_EMBEDDED {
+ public:
+  explicit HCheckEliminator(HGraph* graph)
+      : graph_(graph),
+        states_(graph->blocks()->length(), graph->zone()) { }
+
+  void Process();
+
+ private:
+  HCheckTable* ComputeEntryState(HBasicBlock* block);
+  HCheckTable* ComputeLoopEntryState(HBasicBlock* header);
+  HCheckTable* ComputeMergeState(HBasicBlock* block);
+  bool LoopChangesMaps(HBasicBlock* header);
+  void ProcessInstruction(HInstruction* instr, HCheckTable* table);
+  void ProcessCheckMaps(HCheckMaps* check, HCheckTable* table);
+  void ProcessTypeCheck(HInstruction* check,
+                        HValue* value,
+                        int fact,
+                        HCheckTable* table);
+  void RemoveCheck(HInstruction* check, HValue* value);
+
+  Zone* zone() const { return graph_->zone(); }
+
+  HGraph* graph_;
+  // The table at the end of each block, indexed by block id.
+  ZoneList<HCheckTable*> states_;
+};
+
+
+void HCheckEliminator::Process() {
+  HPhase phase("H_Check elimination", graph_);
+  const ZoneList<HBasicBlock*>* blocks = graph_->blocks();
+  states_.AddBlock(NULL, blocks->length(), zone());
+  for (int i = 0; i < blocks->length(); i++) {
+    HBasicBlock* block = blocks->at(i);
+    HCheckTable* table = ComputeEntryState(block);
+    HInstruction* instr = block->first();
+    while (instr != NULL) {
+      HInstruction* next = instr->next();
+      ProcessInstruction(instr, table);
+      instr = next;
+    }
+    states_[block->block_id()] = table;
   }
+}
 
-  // The only purpose of a HForceRepresentation is to represent the value
-  // after the (possible) HChange instruction.  We make it disappear.
-  if (value->IsForceRepresentation()) {
-    value->DeleteAndReplaceWith(HForceRepresentation::cast(value)->value());
+
+HCheckTable* HCheckEliminator::ComputeEntryState(HBasicBlock* block) {
+  const ZoneList<HBasicBlock*>* predecessors = block->predecessors();
+  if (predecessors->is_empty()) return new(zone()) HCheckTable(zone());
+  if (block->IsLoopHeader()) return ComputeLoopEntryState(block);
+  if (predecessors->length() > 1) return ComputeMergeState(block);
+
+  HBasicBlock* predecessor = predecessors->at(0);
+  HCheckTable* state = states_[predecessor->block_id()];
+  if (state == NULL) return new(zone()) HCheckTable(zone());
+  // The state of a predecessor with a single successor is not needed
+  // anymore, so there is no need to copy it.
+  if (predecessor->end()->SuccessorCount() == 1) return state;
+  return state->Copy(zone());
+}
+
+
+HCheckTable* HCheckEliminator::ComputeLoopEntryState(HBasicBlock* header) {
+  // Only the pre-header has been visited; a header with several incoming
+  // forward edges (such as an OSR entry) starts out empty.
+  const ZoneList<HBasicBlock*>* predecessors = header->predecessors();
+  HBasicBlock* pre_header = NULL;
+  for (int i = 0; i < predecessors->length(); i++) {
+    HBasicBlock* predecessor = predecessors->at(i);
+    if (predecessor->block_id() >= header->block_id()) continue;
+    if (pre_header != NULL) return new(zone()) HCheckTable(zone());
+    pre_header = predecessor;
   }
+  if (pre_header == NULL || states_[pre_header->block_id()] == NULL) {
+    return new(zone()) HCheckTable(zone());
+  }
+  HCheckTable* state = states_[pre_header->block_id()]->Copy(zone());
+  if (LoopChangesMaps(header)) state->KillMaps();
+  return state;
 }
 
 
-void HGraph::InsertRepresentationChanges() {
-  HPhase phase("H_Representation changes", this);
+HCheckTable* HCheckEliminator::ComputeMergeState(HBasicBlock* block) {
+  const ZoneList<HBasicBlock*>* predecessors = block->predecessors();
+  for (int i = 0; i < predecessors->length(); i++) {
+    if (states_[predecessors->at(i)->block_id()] == NULL) {
+      return new(zone()) HCheckTable(zone());
+    }
+  }
 
-  // Compute truncation flag for phis: Initially assume that all
-  // int32-phis allow truncation and iteratively remove the ones that
-  // are used in an operation that does not allow a truncating
-  // conversion.
-  ZoneList<HPhi*> worklist(8, zone());
+  HCheckTable* state = states_[predecessors->at(0)->block_id()]->Copy(zone());
+  for (int i = 1; i < predecessors->length(); i++) {
+    state->Merge(states_[predecessors->at(i)->block_id()], zone());
+  }
 
-  for (int i = 0; i < phi_list()->length(); i++) {
-    HPhi* phi = phi_list()->at(i);
-    if (phi->representation().IsInteger32()) {
-      phi->SetFlag(HValue::kTruncatingToInt32);
+  // A phi has the facts and maps common to its inputs on all incoming edges.
+  for (int i = 0; i < block->phis()->length(); i++) {
+    HPhi* phi = block->phis()->at(i);
+    int facts = ~0;
+    ZoneList<UniqueValueId>* maps = NULL;
+    for (int j = 0; j < phi->OperandCount(); j++) {
+      HCheckTable* incoming = states_[predecessors->at(j)->block_id()];
+      HValue* operand = phi->OperandAt(j);
+      facts &= incoming->Facts(operand);
+      maps = (j == 0)
+          ? incoming->Maps(operand)
+          : HCheckTable::Union(maps, incoming->Maps(operand), zone());
     }
+    if (facts != 0) state->AddFacts(phi, facts, zone());
+    if (maps != NULL) state->SetMaps(phi, maps, zone());
   }
+  return state;
+}
 
-  for (int i = 0; i < phi_list()->length(); i++) {
-    HPhi* phi = phi_list()->at(i);
-    for (HUseIterator it(phi->uses()); !it.Done(); it.Advance()) {
-      // If a Phi is used as a non-truncating int32 or as a double,
-      // clear its "truncating" flag.
-      HValue* use = it.value();
-      Representation input_representation =
-          use->RequiredInputRepresentation(it.index());
-      if ((input_representation.IsInteger32() &&
-           !use->CheckFlag(HValue::kTruncatingToInt32)) ||
-          input_representation.IsDouble()) {
-        if (FLAG_trace_representation) {
-          PrintF("#%d Phi is not truncating because of #%d %s\n",
-                 phi->id(), it.value()->id(), it.value()->Mnemonic());
-        }
-        phi->ClearFlag(HValue::kTruncatingToInt32);
-        worklist.Add(phi, zone());
-        break;
+
+bool HCheckEliminator::LoopChangesMaps(HBasicBlock* header) {
+  int last = header->loop_information()->GetLastBackEdge()->block_id();
+  for (int i = header->block_id(); i <= last; i++) {
+    HBasicBlock* block = graph_->blocks()->at(i);
+    for (HInstruction* instr = block->first();
+         instr != NULL;
+         instr = instr->next()) {
+      if (instr->CheckGVNFlag(kChangesMaps) ||
+          instr->CheckGVNFlag(kChangesElementsKind)) {
+        return true;
       }
     }
   }
+  return false;
+}
 
-  while (!worklist.is_empty()) {
-    HPhi* current = worklist.RemoveLast();
-    for (int i = 0; i < current->OperandCount(); ++i) {
-      HValue* input = current->OperandAt(i);
-      if (input->IsPhi() &&
-          input->representation().IsInteger32() &&
-          input->CheckFlag(HValue::kTruncatingToInt32)) {
-        if (FLAG_trace_representation) {
-          PrintF("#%d Phi is not truncating because of #%d %s\n",
-                 input->id(), current->id(), current->Mnemonic());
-        }
-        input->ClearFlag(HValue::kTruncatingToInt32);
-        worklist.Add(HPhi::cast(input), zone());
-      }
+
+void HCheckEliminator::ProcessInstruction(HInstruction* instr,
+                                          HCheckTable* table) {
+  if (instr->IsCheckMaps()) {
+    ProcessCheckMaps(HCheckMaps::cast(instr), table);
+  } else if (instr->IsCheckNonSmi()) {
+    HValue* value = HCheckNonSmi::cast(instr)->value();
+    ProcessTypeCheck(instr, value, HCheckTable::kIsHeapObject, table);
+  } else if (instr->IsCheckSmi()) {
+    HValue* value = HCheckSmi::cast(instr)->value();
+    ProcessTypeCheck(instr, value, HCheckTable::kIsSmi, table);
+  } else if (instr->IsCheckInstanceType()) {
+    HCheckInstanceType* check = HCheckInstanceType::cast(instr);
+    int fact = 0;
+    switch (check->check()) {
+      case HCheckInstanceType::IS_SPEC_OBJECT:
+        fact = HCheckTable::kIsSpecObject;
+        break;
+      case HCheckInstanceType::IS_JS_ARRAY:
+        fact = HCheckTable::kIsJSArray;
+        break;
+      case HCheckInstanceType::IS_JS_FUNCTION:
+        fact = HCheckTable::kIsJSFunction;
+        break;
+      case HCheckInstanceType::IS_STRING:
+        fact = HCheckTable::kIsString;
+        break;
+      case HCheckInstanceType::IS_INTERNALIZED_STRING:
+        fact = HCheckTable::kIsInternalizedString;
+        break;
     }
+    ProcessTypeCheck(instr, check->value(), fact, table);
+  } else if (instr->IsAllocate() &&
+             instr->HasMonomorphicJSObjectType()) {
+    // The receiver of an inlined constructor gets the map loaded from the
+    // constructor at run time, which may differ from the initial map seen
+    // at compile time.
+    table->AddFacts(instr, HCheckTable::kIsSpecObject, zone());
+  } else if (instr->IsStoreNamedField()) {
+    HStoreNamedField* store = HStoreNamedField::cast(instr);
+    if (store->CheckGVNFlag(kChangesMaps)) {
+      table->KillMapsAliasing(store->object());
+      if (!store->transition().is_null()) {
+        ZoneList<UniqueValueId>* maps =
+            new(zone()) ZoneList<UniqueValueId>(1, zone());
+        maps->Add(store->transition_unique_id(), zone());
+        table->SetMaps(store->object(), maps, zone());
+      }
+    }
+  } else if (instr->IsTransitionElementsKind()) {
+    HTransitionElementsKind* transition =
+        HTransitionElementsKind::cast(instr);
+    table->TransitionMapsAliasing(transition->object(),
+                                  transition->original_map_unique_id(),
+                                  transition->transitioned_map_unique_id(),
+                                  zone());
+  } else if (instr->CheckGVNFlag(kChangesMaps) ||
+             instr->CheckGVNFlag(kChangesElementsKind)) {
+    table->KillMaps();
+  }
+}
+
+
+void HCheckEliminator::ProcessCheckMaps(HCheckMaps* check,
+                                        HCheckTable* table) {
+  HValue* value = check->value();
+  ZoneList<UniqueValueId>* checked = check->map_unique_ids();
+  if (checked->is_empty() || checked->length() != check->map_set()->length()) {
+    table->AddFacts(value, HCheckTable::kIsHeapObject, zone());
+    return;
   }
 
-  for (int i = 0; i < blocks_.length(); ++i) {
-    // Process phi instructions first.
-    const ZoneList<HPhi*>* phis = blocks_[i]->phis();
-    for (int j = 0; j < phis->length(); j++) {
-      InsertRepresentationChangesForValue(phis->at(j));
+  ZoneList<UniqueValueId>* known = table->Maps(value);
+  if (known != NULL) {
+    if (HCheckTable::IsSubset(known, checked)) {
+      RemoveCheck(check, value);
+      return;
     }
-
-    // Process normal instructions.
-    HInstruction* current = blocks_[i]->first();
-    while (current != NULL) {
-      HInstruction* next = current->next();
-      InsertRepresentationChangesForValue(current);
-      current = next;
+    ZoneList<UniqueValueId>* possible =
+        HCheckTable::Intersection(known, checked, zone());
+    if (!possible->is_empty()) {
+      if (FLAG_trace_check_elimination) {
+        PrintF("[check elimination: narrowing check %d from %d to %d maps]\n",
+               check->id(), checked->length(), possible->length());
+      }
+      check->NarrowToMaps(possible);
+      table->SetMaps(value, possible, zone());
+      return;
     }
   }
+  table->SetMaps(value, checked, zone());
 }
 
 
-void HGraph::RecursivelyMarkPhiDeoptimizeOnUndefined(HPhi* phi) {
-  if (phi->CheckFlag(HValue::kDeoptimizeOnUndefined)) return;
-  phi->SetFlag(HValue::kDeoptimizeOnUndefined);
-  for (int i = 0; i < phi->OperandCount(); ++i) {
-    HValue* input = phi->OperandAt(i);
-    if (input->IsPhi()) {
-      RecursivelyMarkPhiDeoptimizeOnUndefined(HPhi::cast(input));
-    }
+void HCheckEliminator::ProcessTypeCheck(HInstruction* check,
+                                        HValue* value,
+                                        int fact,
+                                        HCheckTable* table) {
+  if ((table->Facts(value) & fact) != 0) {
+    RemoveCheck(check, value);
+    return;
   }
+  table->AddFacts(value, fact, zone());
 }
 
 
-void HGraph::MarkDeoptimizeOnUndefined() {
-  HPhase phase("H_MarkDeoptimizeOnUndefined", this);
-  // Compute DeoptimizeOnUndefined flag for phis.
-  // Any phi that can reach a use with DeoptimizeOnUndefined set must
-  // have DeoptimizeOnUndefined set.  Currently only HCompareIDAndBranch, with
-  // double input representation, has this flag set.
-  // The flag is used by HChange tagged->double, which must deoptimize
-  // if one of its uses has this flag set.
-  for (int i = 0; i < phi_list()->length(); i++) {
-    HPhi* phi = phi_list()->at(i);
-    if (phi->representation().IsDouble()) {
-      for (HUseIterator it(phi->uses()); !it.Done(); it.Advance()) {
-        if (it.value()->CheckFlag(HValue::kDeoptimizeOnUndefined)) {
-          RecursivelyMarkPhiDeoptimizeOnUndefined(phi);
-          break;
-        }
-      }
-    }
+void HCheckEliminator::RemoveCheck(HInstruction* check, HValue* value) {
+  if (FLAG_trace_check_elimination) {
+    PrintF("[check elimination: removing redundant %s %d]\n",
+           check->Mnemonic(), check->id());
   }
+  check->DeleteAndReplaceWith(value);
 }
 
 
-// Discover instructions that can be marked with kUint32 flag allowing
-// them to produce full range uint32 values.
-class Uint32Analysis BASE_EMBEDDED {
- public:
-  explicit Uint32Analysis(Zone* zone) : zone_(zone), phis_(4, zone) { }
-
-  void Analyze(HInstruction* current);
-
-  void UnmarkUnsafePhis();
+void HInferRepresentation::AddToWorklist(HValue* current) {
+  if (current->representation().IsTagged()) return;
+  if (!current->CheckFlag(HValue::kFlexibleRepresentation)) return;
+  if (in_worklist_.Contains(current->id())) return;
+  worklist_.Add(current, zone());
+  in_worklist_.Add(current->id());
+}
 
- private:
-  bool IsSafeUint32Use(HValue* val, HValue* use);
-  bool Uint32UsesAreSafe(HValue* uint32val);
-  bool CheckPhiOperands(HPhi* phi);
-  void UnmarkPhi(HPhi* phi, ZoneList<HPhi*>* worklist);
 
-  Zone* zone_;
-  ZoneList<HPhi*> phis_;
-};
+void HInferRepresentation::Analyze() {
+  HPhase phase("H_Infer representations", graph_);
 
+  // (1) Initialize bit vectors and count real uses. Each phi gets a
+  // bit-vector of length <number of phis>.
+  const ZoneList<HPhi*>* phi_list = graph_->phi_list();
+  int phi_count = phi_list->length();
+  ZoneList<BitVector*> connected_phis(phi_count, graph_->zone());
+  for (int i = 0; i < phi_count; ++i) {
+    phi_list->at(i)->InitRealUses(i);
+    BitVector* connected_set = new(zone()) BitVector(phi_count, graph_->zone());
+    connected_set->Add(i);
+    connected_phis.Add(connected_set, zone());
+  }
 
-bool Uint32Analysis::IsSafeUint32Use(HValue* val, HValue* use) {
-  // Operations that operatate on bits are safe.
-  if (use->IsBitwise() ||
-      use->IsShl() ||
-      use->IsSar() ||
-      use->IsShr() ||
-      use->IsBitNot()) {
-    return true;
-  } else if (use->IsChange() || use->IsSimulate()) {
-    // Conversions and deoptimization have special support for unt32.
-    return true;
-  } else if (use->IsStoreKeyed()) {
-    HStoreKeyed* store = HStoreKeyed::cast(use);
-    if (store->is_external()) {
-      // Storing a value into an external integer array is a bit level
-      // operation.
-      if (store->value() == val) {
-        // Clamping or a conversion to double should have beed inserted.
-        ASSERT(store->elements_kind() != EXTERNAL_PIXEL_ELEMENTS);
-        ASSERT(store->elements_kind() != EXTERNAL_FLOAT_ELEMENTS);
-        ASSERT(store->elements_kind() != EXTERNAL_DOUBLE_ELEMENTS);
-        return true;
+  // (2) Do a fixed point iteration to find the set of connected phis.  A
+  // phi is connected to another phi if its value is used either directly or
+  // indirectly through a transitive closure of the def-use relation.
+  bool change = true;
+  while (change) {
+    change = false;
+    // We normally have far more "forward edges" than "backward edges",
+    // so we terminate faster when we walk backwards.
+    for (int i = phi_count - 1; i >= 0; --i) {
+      HPhi* phi = phi_list->at(i);
+      for (HUseIterator it(phi->uses()); !it.Done(); it.Advance()) {
+        HValue* use = it.value();
+        if (use->IsPhi()) {
+          int id = HPhi::cast(use)->phi_id();
+          if (connected_phis[i]->UnionIsChanged(*connected_phis[id]))
+            change = true;
+        }
       }
     }
   }
 
-  return false;
-}
+  // Set truncation flags for groups of connected phis. This is a conservative
+  // approximation; the flag will be properly re-computed after representations
+  // have been determined.
+  if (phi_count > 0) {
+    BitVector* done = new(zone()) BitVector(phi_count, graph_->zone());
+    for (int i = 0; i < phi_count; ++i) {
+      if (done->Contains(i)) continue;
 
+      // Check if all uses of all connected phis in this group are truncating.
+      bool all_uses_everywhere_truncating = true;
+      for (BitVector::Iterator it(connected_phis.at(i));
+           !it.Done();
+           it.Advance()) {
+        int index = it.Current();
+        all_uses_everywhere_truncating &=
+            phi_list->at(index)->CheckFlag(HInstruction::kTruncatingToInt32);
+        done->Add(index);
+      }
+      if (all_uses_everywhere_truncating) {
+        continue;  // Great, nothing to do.
+      }
+      // Clear truncation flag of this group of connected phis.
+      for (BitVector::Iterator it(connected_phis.at(i));
+           !it.Done();
+           it.Advance()) {
+        int index = it.Current();
+        phi_list->at(index)->ClearFlag(HInstruction::kTruncatingToInt32);
+      }
+    }
+  }
 
-// Iterate over all uses and verify that they are uint32 safe: either don't
-// distinguish between int32 and uint32 due to their bitwise nature or
-// have special support for uint32 values.
-// Encountered phis are optimisitically treated as safe uint32 uses,
-// marked with kUint32 flag and collected in the phis_ list. A separate
-// path will be performed later by UnmarkUnsafePhis to clear kUint32 from
-// phis that are not actually uint32-safe (it requries fix point iteration).
-bool Uint32Analysis::Uint32UsesAreSafe(HValue* uint32val) {
-  bool collect_phi_uses = false;
-  for (HUseIterator it(uint32val->uses()); !it.Done(); it.Advance()) {
-    HValue* use = it.value();
+  // Simplify constant phi inputs where possible.
+  // This step uses kTruncatingToInt32 flags of phis.
+  for (int i = 0; i < phi_count; ++i) {
+    phi_list->at(i)->SimplifyConstantInputs();
+  }
 
-    if (use->IsPhi()) {
-      if (!use->CheckFlag(HInstruction::kUint32)) {
-        // There is a phi use of this value from a phis that is not yet
-        // collected in phis_ array. Separate pass is required.
-        collect_phi_uses = true;
-      }
+  // Use the phi reachability information from step 2 to
+  // push information about values which can't be converted to integer
+  // without deoptimization through the phi use-def chains, avoiding
+  // unnecessary deoptimizations later.
+  for (int i = 0; i < phi_count; ++i) {
+    HPhi* phi = phi_list->at(i);
+    bool cti = phi->AllOperandsConvertibleToInteger();
+    if (cti) continue;
 
-      // Optimistically treat phis as uint32 safe.
-      continue;
+    for (BitVector::Iterator it(connected_phis.at(i));
+         !it.Done();
+         it.Advance()) {
+      HPhi* phi = phi_list->at(it.Current());
+      phi->set_is_convertible_to_integer(false);
     }
+  }
 
-    if (!IsSafeUint32Use(uint32val, use)) {
-      return false;
+  // Use the phi reachability information from step 2 to
+  // sum up the non-phi use counts of all connected phis.
+  for (int i = 0; i < phi_count; ++i) {
+    HPhi* phi = phi_list->at(i);
+    for (BitVector::Iterator it(connected_phis.at(i));
+         !it.Done();
+         it.Advance()) {
+      int index = it.Current();
+      HPhi* it_use = phi_list->at(index);
+      if (index != i) phi->AddNonPhiUsesFrom(it_use);  // Don't count twice.
     }
   }
 
-  if (collect_phi_uses) {
-    for (HUseIterator it(uint32val->uses()); !it.Done(); it.Advance()) {
-      HValue* use = it.value();
+  // Initialize work list
+  for (int i = 0; i < graph_->blocks()->length(); ++i) {
+    HBasicBlock* block = graph_->blocks()->at(i);
+    const ZoneList<HPhi*>* phis = block->phis();
+    for (int j = 0; j < phis->length(); ++j) {
+      AddToWorklist(phis->at(j));
+    }
 
-      // There is a phi use of this value from a phis that is not yet
-      // collected in phis_ array. Separate pass is required.
-      if (use->IsPhi() && !use->CheckFlag(HInstruction::kUint32)) {
-        use->SetFlag(HInstruction::kUint32);
-        phis_.Add(HPhi::cast(use), zone_);
-      }
+    HInstruction* current = block->first();
+    while (current != NULL) {
+      AddToWorklist(current);
+      current = current->next();
     }
   }
 
-  return true;
-}
-
+  // Do a fixed point iteration, trying to improve representations
+  while (!worklist_.is_empty()) {
+    HValue* current = worklist_.RemoveLast();
+    in_worklist_.Remove(current->id());
+    current->InferRepresentation(this);
+  }
 
-// Analyze instruction and mark it with kUint32 if all its uses are uint32
-// safe.
-void Uint32Analysis::Analyze(HInstruction* current) {
-  if (Uint32UsesAreSafe(current)) current->SetFlag(HInstruction::kUint32);
-}
-
-
-// Check if all operands to the given phi are marked with kUint32 flag.
-bool Uint32Analysis::CheckPhiOperands(HPhi* phi) {
-  if (!phi->CheckFlag(HInstruction::kUint32)) {
-    // This phi is not uint32 safe. No need to check operands.
-    return false;
-  }
-
-  for (int j = 0; j < phi->OperandCount(); j++) {
-    HValue* operand = phi->OperandAt(j);
-    if (!operand->CheckFlag(HInstruction::kUint32)) {
-      // Lazyly mark constants that fit into uint32 range with kUint32 flag.
-      if (operand->IsInteger32Constant() &&
-          operand->GetInteger32Constant() >= 0) {
-        operand->SetFlag(HInstruction::kUint32);
-        continue;
+  // Lastly: any instruction that we don't have representation information
+  // for defaults to Tagged.
+  for (int i = 0; i < graph_->blocks()->length(); ++i) {
+    HBasicBlock* block = graph_->blocks()->at(i);
+    const ZoneList<HPhi*>* phis = block->phis();
+    for (int j = 0; j < phis->length(); ++j) {
+      HPhi* phi = phis->at(j);
+      if (phi->representation().IsNone()) {
+        phi->ChangeRepresentation(Representation::Tagged());
+      }
+    }
+    for (HInstruction* current = block->first();
+         current != NULL; current = current->next()) {
+      if (current->representation().IsNone() &&
+          current->CheckFlag(HInstruction::kFlexibleRepresentation)) {
+        current->ChangeRepresentation(Representation::Tagged());
       }
-
-      // This phi is not safe, some operands are not uint32 values.
-      return false;
     }
   }
-
-  return true;
 }
 
 
-// Remove kUint32 flag from the phi itself and its operands. If any operand
-// was a phi marked with kUint32 place it into a worklist for
-// transitive clearing of kUint32 flag.
-void Uint32Analysis::UnmarkPhi(HPhi* phi, ZoneList<HPhi*>* worklist) {
-  phi->ClearFlag(HInstruction::kUint32);
-  for (int j = 0; j < phi->OperandCount(); j++) {
-    HValue* operand = phi->OperandAt(j);
-    if (operand->CheckFlag(HInstruction::kUint32)) {
-      operand->ClearFlag(HInstruction::kUint32);
-      if (operand->IsPhi()) {
-        worklist->Add(HPhi::cast(operand), zone_);
+void HGraph::MergeRemovableSimulates() {
+  HPhase phase("H_Merge removable simulates", this);
+  ZoneList<HSimulate*> mergelist(2, zone());
+  for (int i = 0; i < blocks()->length(); ++i) {
+    HBasicBlock* block = blocks()->at(i);
+    // Make sure the merge list is empty at the start of a block.
+    ASSERT(mergelist.is_empty());
+    // Nasty heuristic: Never remove the first simulate in a block. This
+    // just so happens to have a beneficial effect on register allocation.
+    bool first = true;
+    for (HInstruction* current = block->first();
+         current != NULL; current = current->next()) {
+      if (current->IsLeaveInlined()) {
+        // Never fold simulates from inlined environments into simulates
+        // in the outer environment.
+        // (Before each HEnterInlined, there is a non-foldable HSimulate
+        // anyway, so we get the barrier in the other direction for free.)
+        // Simply remove all accumulated simulates without merging.  This
+        // is safe because simulates after instructions with side effects
+        // are never added to the merge list.
+        while (!mergelist.is_empty()) {
+          mergelist.RemoveLast()->DeleteAndReplaceWith(NULL);
+        }
+        continue;
+      }
+      // Skip the non-simulates and the first simulate.
+      if (!current->IsSimulate()) continue;
+      if (first) {
+        first = false;
+        continue;
+      }
+      HSimulate* current_simulate = HSimulate::cast(current);
+      if ((current_simulate->previous()->HasObservableSideEffects() &&
+           !current_simulate->next()->IsSimulate()) ||
+          !current_simulate->is_candidate_for_removal()) {
+        // This simulate is not suitable for folding.
+        // Fold the ones accumulated so far.
+        current_simulate->MergeWith(&mergelist);
+        continue;
+      } else {
+        // Accumulate this simulate for folding later on.
+        mergelist.Add(current_simulate, zone());
       }
     }
+
+    if (!mergelist.is_empty()) {
+      // Merge the accumulated simulates at the end of the block.
+      HSimulate* last = mergelist.RemoveLast();
+      last->MergeWith(&mergelist);
+    }
   }
 }
 
 
-void Uint32Analysis::UnmarkUnsafePhis() {
-  // No phis were collected. Nothing to do.
-  if (phis_.length() == 0) return;
-
-  // Worklist used to transitively clear kUint32 from phis that
-  // are used as arguments to other phis.
-  ZoneList<HPhi*> worklist(phis_.length(), zone_);
+void HGraph::InitializeInferredTypes() {
+  HPhase phase("H_Inferring types", this);
+  InitializeInferredTypes(0, this->blocks_.length() - 1);
+}
 
-  // Phi can be used as a uint32 value if and only if
-  // all its operands are uint32 values and all its
-  // uses are uint32 safe.
 
-  // Iterate over collected phis and unmark those that
-  // are unsafe. When unmarking phi unmark its operands
-  // and add it to the worklist if it is a phi as well.
-  // Phis that are still marked as safe are shifted down
-  // so that all safe phis form a prefix of the phis_ array.
-  int phi_count = 0;
-  for (int i = 0; i < phis_.length(); i++) {
-    HPhi* phi = phis_[i];
+void HGraph::InitializeInferredTypes(int from_inclusive, int to_inclusive) {
+  for (int i = from_inclusive; i <= to_inclusive; ++i) {
+    HBasicBlock* block = blocks_[i];
 
-    if (CheckPhiOperands(phi) && Uint32UsesAreSafe(phi)) {
-      phis_[phi_count++] = phi;
-    } else {
-      UnmarkPhi(phi, &worklist);
+    const ZoneList<HPhi*>* phis = block->phis();
+    for (int j = 0; j < phis->length(); j++) {
+      phis->at(j)->UpdateInferredType();
     }
-  }
 
-  // Now phis array contains only those phis that have safe
-  // non-phi uses. Start transitively clearing kUint32 flag
-  // from phi operands of discovered non-safe phies until
-  // only safe phies are left.
-  while (!worklist.is_empty())  {
-    while (!worklist.is_empty()) {
-      HPhi* phi = worklist.RemoveLast();
-      UnmarkPhi(phi, &worklist);
+    HInstruction* current = block->first();
+    while (current != NULL) {
+      current->UpdateInferredType();
+      current = current->next();
     }
 
-    // Check if any operands to safe phies were unmarked
-    // turning a safe phi into unsafe. The same value
-    // can flow into several phis.
-    int new_phi_count = 0;
-    for (int i = 0; i < phi_count; i++) {
-      HPhi* phi = phis_[i];
-
-      if (CheckPhiOperands(phi)) {
-        phis_[new_phi_count++] = phi;
-      } else {
-        UnmarkPhi(phi, &worklist);
+    if (block->IsLoopHeader()) {
+      HBasicBlock* last_back_edge =
+          block->loop_information()->GetLastBackEdge();
+      InitializeInferredTypes(i + 1, last_back_edge->block_id());
+      // Skip all blocks already processed by the recursive call.
+      i = last_back_edge->block_id();
+      // Update phis of the loop header now after the whole loop body is
+      // guaranteed to be processed.
+      ZoneList<HValue*> worklist(block->phis()->length(), zone());
+      for (int j = 0; j < block->phis()->length(); ++j) {
+        worklist.Add(block->phis()->at(j), zone());
       }
+      InferTypes(&worklist);
     }
-    phi_count = new_phi_count;
   }
 }
 
 
-void HGraph::ComputeSafeUint32Operations() {
-  HPhase phase("H_Compute safe UInt32 operations", this);
-  if (uint32_instructions_ == NULL) return;
+void HGraph::PropagateMinusZeroChecks(HValue* value, BitVector* visited) {
+  HValue* current = value;
+  while (current != NULL) {
+    if (visited->Contains(current->id())) return;
 
-  Uint32Analysis analysis(zone());
-  for (int i = 0; i < uint32_instructions_->length(); ++i) {
-    HInstruction* current = uint32_instructions_->at(i);
-    if (current->IsLinked() && current->representation().IsInteger32()) {
-      analysis.Analyze(current);
+    // For phis, we must propagate the check to all of its inputs.
+    if (current->IsPhi()) {
+      visited->Add(current->id());
+      HPhi* phi = HPhi::cast(current);
+      for (int i = 0; i < phi->OperandCount(); ++i) {
+        PropagateMinusZeroChecks(phi->OperandAt(i), visited);
+      }
+      break;
     }
-  }
-
-  // Some phis might have been optimistically marked with kUint32 flag.
-  // Remove this flag from those phis that are unsafe and propagate
-  // this information transitively potentially clearing kUint32 flag
-  // from some non-phi operations that are used as operands to unsafe phis.
-  analysis.UnmarkUnsafePhis();
-}
 
-
-void HGraph::ComputeMinusZeroChecks() {
-  HPhase phase("H_Compute minus zero checks", this);
-  BitVector visited(GetMaximumValueID(), zone());
-  for (int i = 0; i < blocks_.length(); ++i) {
-    for (HInstruction* current = blocks_[i]->first();
-         current != NULL;
-         current = current->next()) {
-      if (current->IsChange()) {
-        HChange* change = HChange::cast(current);
-        // Propagate flags for negative zero checks upwards from conversions
-        // int32-to-tagged and int32-to-double.
-        Representation from = change->value()->representation();
-        ASSERT(from.Equals(change->from()));
-        if (from.IsInteger32()) {
-          ASSERT(change->to().IsTagged() || change->to().IsDouble());
-          ASSERT(visited.IsEmpty());
-          PropagateMinusZeroChecks(change->value(), &visited);
-          visited.Clear();
-        }
-      }
+    // For multiplication, division, and Math.min/max(), we must propagate
+    // to the left and the right side.
+    if (current->IsMul()) {
+      HMul* mul = HMul::cast(current);
+      mul->EnsureAndPropagateNotMinusZero(visited);
+      PropagateMinusZeroChecks(mul->left(), visited);
+      PropagateMinusZeroChecks(mul->right(), visited);
+    } else if (current->IsDiv()) {
+      HDiv* div = HDiv::cast(current);
+      div->EnsureAndPropagateNotMinusZero(visited);
+      PropagateMinusZeroChecks(div->left(), visited);
+      PropagateMinusZeroChecks(div->right(), visited);
+    } else if (current->IsMathMinMax()) {
+      HMathMinMax* minmax = HMathMinMax::cast(current);
+      visited->Add(minmax->id());
+      PropagateMinusZeroChecks(minmax->left(), visited);
+      PropagateMinusZeroChecks(minmax->right(), visited);
     }
+
+    current = current->EnsureAndPropagateNotMinusZero(visited);
   }
 }
 
 
-// Implementation of utility class to encapsulate the translation state for
-// a (possibly inlined) function.
-FunctionState::FunctionState(HOptimizedGraphBuilder* owner,
-                             CompilationInfo* info,
-                             TypeFeedbackOracle* oracle,
-                             InliningKind inlining_kind)
-    : owner_(owner),
-      compilation_info_(info),
-      oracle_(oracle),
-      call_context_(NULL),
-      inlining_kind_(inlining_kind),
-      function_return_(NULL),
-      test_context_(NULL),
-      entry_(NULL),
-      arguments_elements_(NULL),
-      outer_(owner->function_state()) {
-  if (outer_ != NULL) {
-    // State for an inline function.
-    if (owner->ast_context()->IsTest()) {
-      HBasicBlock* if_true = owner->graph()->CreateBasicBlock();
-      HBasicBlock* if_false = owner->graph()->CreateBasicBlock();
-      if_true->MarkAsInlineReturnTarget();
-      if_false->MarkAsInlineReturnTarget();
-      TestContext* outer_test_context = TestContext::cast(owner->ast_context());
-      Expression* cond = outer_test_context->condition();
-      TypeFeedbackOracle* outer_oracle = outer_test_context->oracle();
-      // The AstContext constructor pushed on the context stack.  This newed
-      // instance is the reason that AstContext can't be BASE_EMBEDDED.
-      test_context_ =
-          new TestContext(owner, cond, outer_oracle, if_true, if_false);
-    } else {
-      function_return_ = owner->graph()->CreateBasicBlock();
-      function_return()->MarkAsInlineReturnTarget();
-    }
-    // Set this after possibly allocating a new TestContext above.
-    call_context_ = owner->ast_context();
+void HGraph::InsertRepresentationChangeForUse(HValue* value,
+                                              HValue* use_value,
+                                              int use_index,
+                                              Representation to) {
+  // Insert the representation change right before its use. For phi-uses we
+  // insert at the end of the corresponding predecessor.
+  HInstruction* next = NULL;
+  if (use_value->IsPhi()) {
+    next = use_value->block()->predecessors()->at(use_index)->end();
+  } else {
+    next = HInstruction::cast(use_value);
+  }
+  // For constants we try to make the representation change at compile
+  // time. When a representation change is not possible without loss of
+  // information we treat constants like normal instructions and insert the
+  // change instructions for them.
+  HInstruction* new_value = NULL;
+  bool is_truncating = use_value->CheckFlag(HValue::kTruncatingToInt32);
+  bool deoptimize_on_undefined =
+      use_value->CheckFlag(HValue::kDeoptimizeOnUndefined);
+  if (value->IsConstant()) {
+    HConstant* constant = HConstant::cast(value);
+    // Try to create a new copy of the constant with the new representation.
+    new_value = (is_truncating && to.IsInteger32())
+        ? constant->CopyToTruncatedInt32(zone())
+        : constant->CopyToRepresentation(to, zone());
   }
 
-  // Push on the state stack.
-  owner->set_function_state(this);
-}
-
-
-FunctionState::~FunctionState() {
-  delete test_context_;
-  owner_->set_function_state(outer_);
-}
-
+  if (new_value == NULL) {
+    new_value = new(zone()) HChange(value, to,
+                                    is_truncating, deoptimize_on_undefined);
+  }
 
-// Implementation of utility classes to represent an expression's context in
-// the AST.
-AstContext::AstContext(HOptimizedGraphBuilder* owner, Expression::Context kind)
-    : owner_(owner),
-      kind_(kind),
-      outer_(owner->ast_context()),
-      for_typeof_(false) {
-  owner->set_ast_context(this);  // Push.
-#ifdef DEBUG
-  ASSERT(owner->environment()->frame_type() == JS_FUNCTION);
-  original_length_ = owner->environment()->length();
-#endif
+  new_value->InsertBefore(next);
+  use_value->SetOperandAt(use_index, new_value);
 }
 
 
-AstContext::~AstContext() {
-  owner_->set_ast_context(outer_);  // Pop.
-}
+void HGraph::InsertRepresentationChangesForValue(HValue* value) {
+  Representation r = value->representation();
+  if (r.IsNone()) return;
+  if (value->HasNoUses()) return;
 
+  for (HUseIterator it(value->uses()); !it.Done(); it.Advance()) {
+    HValue* use_value = it.value();
+    int use_index = it.index();
+    Representation req = use_value->RequiredInputRepresentation(use_index);
+    if (req.IsNone() || req.Equals(r)) continue;
+    InsertRepresentationChangeForUse(value, use_value, use_index, req);
+  }
+  if (value->HasNoUses()) {
+    ASSERT(value->IsConstant());
+    value->DeleteAndReplaceWith(NULL);
+  }
 
-EffectContext::~EffectContext() {
-  ASSERT(owner()->HasStackOverflow() ||
-         owner()->current_block() == NULL ||
-         (owner()->environment()->length() == original_length_ &&
-          owner()->environment()->frame_type() == JS_FUNCTION));
+  // The only purpose of a HForceRepresentation is to represent the value
+  // after the (possible) HChange instruction.  We make it disappear.
+  if (value->IsForceRepresentation()) {
+    value->DeleteAndReplaceWith(HForceRepresentation::cast(value)->value());
+  }
 }
 
 
-ValueContext::~ValueContext() {
-  ASSERT(owner()->HasStackOverflow() ||
-         owner()->current_block() == NULL ||
-         (owner()->environment()->length() == original_length_ + 1 &&
-          owner()->environment()->frame_type() == JS_FUNCTION));
-}
+void HGraph::InsertRepresentationChanges() {
+  HPhase phase("H_Representation changes", this);
 
+  // Compute truncation flag for phis: Initially assume that all
+  // int32-phis allow truncation and iteratively remove the ones that
+  // are used in an operation that does not allow a truncating
+  // conversion.
+  ZoneList<HPhi*> worklist(8, zone());
 
-void EffectContext::ReturnValue(HValue* value) {
-  // The value is simply ignored.
-}
+  for (int i = 0; i < phi_list()->length(); i++) {
+    HPhi* phi = phi_list()->at(i);
+    if (phi->representation().IsInteger32()) {
+      phi->SetFlag(HValue::kTruncatingToInt32);
+    }
+  }
 
+  for (int i = 0; i < phi_list()->length(); i++) {
+    HPhi* phi = phi_list()->at(i);
+    for (HUseIterator it(phi->uses()); !it.Done(); it.Advance()) {
+      // If a Phi is used as a non-truncating int32 or as a double,
+      // clear its "truncating" flag.
+      HValue* use = it.value();
+      Representation input_representation =
+          use->RequiredInputRepresentation(it.index());
+      if ((input_representation.IsInteger32() &&
+           !use->CheckFlag(HValue::kTruncatingToInt32)) ||
+          input_representation.IsDouble()) {
+        if (FLAG_trace_representation) {
+          PrintF("#%d Phi is not truncating because of #%d %s\n",
+                 phi->id(), it.value()->id(), it.value()->Mnemonic());
+        }
+        phi->ClearFlag(HValue::kTruncatingToInt32);
+        worklist.Add(phi, zone());
+        break;
+      }
+    }
+  }
 
-void ValueContext::ReturnValue(HValue* value) {
-  // The value is tracked in the bailout environment, and communicated
-  // through the environment as the result of the expression.
-  if (!arguments_allowed() && value->CheckFlag(HValue::kIsArguments)) {
-    owner()->Bailout("bad value context for arguments value");
+  while (!worklist.is_empty()) {
+    HPhi* current = worklist.RemoveLast();
+    for (int i = 0; i < current->OperandCount(); ++i) {
+      HValue* input = current->OperandAt(i);
+      if (input->IsPhi() &&
+          input->representation().IsInteger32() &&
+          input->CheckFlag(HValue::kTruncatingToInt32)) {
+        if (FLAG_trace_representation) {
+          PrintF("#%d Phi is not truncating because of #%d %s\n",
+                 input->id(), current->id(), current->Mnemonic());
+        }
+        input->ClearFlag(HValue::kTruncatingToInt32);
+        worklist.Add(HPhi::cast(input), zone());
+      }
+    }
   }
-  owner()->Push(value);
-}
 
+  for (int i = 0; i < blocks_.length(); ++i) {
+    // Process phi instructions first.
+    const ZoneList<HPhi*>* phis = blocks_[i]->phis();
+    for (int j = 0; j < phis->length(); j++) {
+      InsertRepresentationChangesForValue(phis->at(j));
+    }
 
-void TestContext::ReturnValue(HValue* value) {
-  BuildBranch(value);
+    // Process normal instructions.
+    HInstruction* current = blocks_[i]->first();
+    while (current != NULL) {
+      HInstruction* next = current->next();
+      InsertRepresentationChangesForValue(current);
+      current = next;
+    }
+  }
 }
 
 
-void EffectContext::ReturnInstruction(HInstruction* instr, BailoutId ast_id) {
-  ASSERT(!instr->IsControlInstruction());
-  owner()->AddInstruction(instr);
-  if (instr->HasObservableSideEffects()) {
-    owner()->AddSimulate(ast_id, REMOVABLE_SIMULATE);
+void HGraph::RecursivelyMarkPhiDeoptimizeOnUndefined(HPhi* phi) {
+  if (phi->CheckFlag(HValue::kDeoptimizeOnUndefined)) return;
+  phi->SetFlag(HValue::kDeoptimizeOnUndefined);
+  for (int i = 0; i < phi->OperandCount(); ++i) {
+    HValue* input = phi->OperandAt(i);
+    if (input->IsPhi()) {
+      RecursivelyMarkPhiDeoptimizeOnUndefined(HPhi::cast(input));
+    }
   }
 }
 
 
-void EffectContext::ReturnControl(HControlInstruction* instr,
-                                  BailoutId ast_id) {
-  ASSERT(!instr->HasObservableSideEffects());
-  HBasicBlock* empty_true = owner()->graph()->CreateBasicBlock();
-  HBasicBlock* empty_false = owner()->graph()->CreateBasicBlock();
-  instr->SetSuccessorAt(0, empty_true);
-  instr->SetSuccessorAt(1, empty_false);
-  owner()->current_block()->Finish(instr);
-  HBasicBlock* join = owner()->CreateJoin(empty_true, empty_false, ast_id);
-  owner()->set_current_block(join);
+void HGraph::MarkDeoptimizeOnUndefined() {
+  HPhase phase("H_MarkDeoptimizeOnUndefined", this);
+  // Compute DeoptimizeOnUndefined flag for phis.
+  // Any phi that can reach a use with DeoptimizeOnUndefined set must
+  // have DeoptimizeOnUndefined set.  Currently only HCompareIDAndBranch, with
+  // double input representation, has this flag set.
+  // The flag is used by HChange tagged->double, which must deoptimize
+  // if one of its uses has this flag set.
+  for (int i = 0; i < phi_list()->length(); i++) {
+    HPhi* phi = phi_list()->at(i);
+    if (phi->representation().IsDouble()) {
+      for (HUseIterator it(phi->uses()); !it.Done(); it.Advance()) {
+        if (it.value()->CheckFlag(HValue::kDeoptimizeOnUndefined)) {
+          RecursivelyMarkPhiDeoptimizeOnUndefined(phi);
+          break;
+        }
+      }
+    }
+  }
 }
 
 
-void EffectContext::ReturnContinuation(HIfContinuation* continuation,
-                                       BailoutId ast_id) {
-  HBasicBlock* true_branch = NULL;
-  HBasicBlock* false_branch = NULL;
-  continuation->Continue(&true_branch, &false_branch, NULL);
-  if (!continuation->IsTrueReachable()) {
-    owner()->set_current_block(false_branch);
-  } else if (!continuation->IsFalseReachable()) {
-    owner()->set_current_block(true_branch);
-  } else {
-    HBasicBlock* join = owner()->CreateJoin(true_branch, false_branch, ast_id);
-    owner()->set_current_block(join);
-  }
-}
+// Discover instructions that can be marked with kUint32 flag allowing
+// them to produce full range uint32 values.
+class Uint32Analysis BASE_EMBEDDED {
+ public:
+  explicit Uint32Analysis(Zone* zone) : zone_(zone), phis_(4, zone) { }
 
+  void Analyze(HInstruction* current);
 
-void ValueContext::ReturnInstruction(HInstruction* instr, BailoutId ast_id) {
-  ASSERT(!instr->IsControlInstruction());
-  if (!arguments_allowed() && instr->CheckFlag(HValue::kIsArguments)) {
-    return owner()->Bailout("bad value context for arguments object value");
-  }
-  owner()->AddInstruction(instr);
-  owner()->Push(instr);
-  if (instr->HasObservableSideEffects()) {
-    owner()->AddSimulate(ast_id, REMOVABLE_SIMULATE);
-  }
-}
+  void UnmarkUnsafePhis();
 
+ private:
+  bool IsSafeUint32Use(HValue* val, HValue* use);
+  bool Uint32UsesAreSafe(HValue* uint32val);
+  bool CheckPhiOperands(HPhi* phi);
+  void UnmarkPhi(HPhi* phi, ZoneList<HPhi*>* worklist);
 
-void ValueContext::ReturnControl(HControlInstruction* instr, BailoutId ast_id) {
-  ASSERT(!instr->HasObservableSideEffects());
-  if (!arguments_allowed() && instr->CheckFlag(HValue::kIsArguments)) {
-    return owner()->Bailout("bad value context for arguments object value");
-  }
-  HBasicBlock* materialize_false = owner()->graph()->CreateBasicBlock();
-  HBasicBlock* materialize_true = owner()->graph()->CreateBasicBlock();
-  instr->SetSuccessorAt(0, materialize_true);
-  instr->SetSuccessorAt(1, materialize_false);
-  owner()->current_block()->Finish(instr);
-  owner()->set_current_block(materialize_true);
-  owner()->Push(owner()->graph()->GetConstantTrue());
-  owner()->set_current_block(materialize_false);
-  owner()->Push(owner()->graph()->GetConstantFalse());
-  HBasicBlock* join =
-    owner()->CreateJoin(materialize_true, materialize_false, ast_id);
-  owner()->set_current_block(join);
-}
+  Zone* zone_;
+  ZoneList<HPhi*> phis_;
+};
 
 
-void ValueContext::ReturnContinuation(HIfContinuation* continuation,
-                                      BailoutId ast_id) {
-  HBasicBlock* materialize_true = NULL;
-  HBasicBlock* materialize_false = NULL;
-  continuation->Continue(&materialize_true, &materialize_false, NULL);
-  if (continuation->IsTrueReachable()) {
-    owner()->set_current_block(materialize_true);
-    owner()->Push(owner()->graph()->GetConstantTrue());
-    owner()->set_current_block(materialize_true);
-  }
-  if (continuation->IsFalseReachable()) {
-    owner()->set_current_block(materialize_false);
-    owner()->Push(owner()->graph()->GetConstantFalse());
-    owner()->set_current_block(materialize_false);
-  }
-  if (continuation->TrueAndFalseReachable()) {
-    HBasicBlock* join =
-        owner()->CreateJoin(materialize_true, materialize_false, ast_id);
-    owner()->set_current_block(join);
+bool Uint32Analysis::IsSafeUint32Use(HValue* val, HValue* use) {
+  // Operations that operatate on bits are safe.
+  if (use->IsBitwise() ||
+      use->IsShl() ||
+      use->IsSar() ||
+      use->IsShr() ||
+      use->IsBitNot()) {
+    return true;
+  } else if (use->IsChange() || use->IsSimulate()) {
+    // Conversions and deoptimization have special support for unt32.
+    return true;
+  } else if (use->IsStoreKeyed()) {
+    HStoreKeyed* store = HStoreKeyed::cast(use);
+    if (store->is_external()) {
+      // Storing a value into an external integer array is a bit level
+      // operation.
+      if (store->value() == val) {
+        // Clamping or a conversion to double should have beed inserted.
+        ASSERT(store->elements_kind() != EXTERNAL_PIXEL_ELEMENTS);
+        ASSERT(store->elements_kind() != EXTERNAL_FLOAT_ELEMENTS);
+        ASSERT(store->elements_kind() != EXTERNAL_DOUBLE_ELEMENTS);
+        return true;
+      }
+    }
   }
-}
-
 
-void TestContext::ReturnInstruction(HInstruction* instr, BailoutId ast_id) {
-  ASSERT(!instr->IsControlInstruction());
-  HOptimizedGraphBuilder* builder = owner();
-  builder->AddInstruction(instr);
-  // We expect a simulate after every expression with side effects, though
-  // this one isn't actually needed (and wouldn't work if it were targeted).
-  if (instr->HasObservableSideEffects()) {
-    builder->Push(instr);
-    builder->AddSimulate(ast_id, REMOVABLE_SIMULATE);
-    builder->Pop();
-  }
-  BuildBranch(instr);
+  return false;
 }
 
 
-void TestContext::ReturnControl(HControlInstruction* instr, BailoutId ast_id) {
-  ASSERT(!instr->HasObservableSideEffects());
-  HBasicBlock* empty_true = owner()->graph()->CreateBasicBlock();
-  HBasicBlock* empty_false = owner()->graph()->CreateBasicBlock();
-  instr->SetSuccessorAt(0, empty_true);
-  instr->SetSuccessorAt(1, empty_false);
-  owner()->current_block()->Finish(instr);
-  empty_true->Goto(if_true(), owner()->function_state());
-  empty_false->Goto(if_false(), owner()->function_state());
-  owner()->set_current_block(NULL);
-}
+// Iterate over all uses and verify that they are uint32 safe: either don't
+// distinguish between int32 and uint32 due to their bitwise nature or
+// have special support for uint32 values.
+// Encountered phis are optimisitically treated as safe uint32 uses,
+// marked with kUint32 flag and collected in the phis_ list. A separate
+// path will be performed later by UnmarkUnsafePhis to clear kUint32 from
+// phis that are not actually uint32-safe (it requries fix point iteration).
+bool Uint32Analysis::Uint32UsesAreSafe(HValue* uint32val) {
+  bool collect_phi_uses = false;
+  for (HUseIterator it(uint32val->uses()); !it.Done(); it.Advance()) {
+    HValue* use = it.value();
 
+    if (use->IsPhi()) {
+      if (!use->CheckFlag(HInstruction::kUint32)) {
+        // There is a phi use of this value from a phis that is not yet
+        // collected in phis_ array. Separate pass is required.
+        collect_phi_uses = true;
+      }
 
-void TestContext::ReturnContinuation(HIfContinuation* continuation,
-                                     BailoutId ast_id) {
-  HBasicBlock* true_branch = NULL;
-  HBasicBlock* false_branch = NULL;
-  continuation->Continue(&true_branch, &false_branch, NULL);
-  if (continuation->IsTrueReachable()) {
-    true_branch->Goto(if_true(), owner()->function_state());
-  }
-  if (continuation->IsFalseReachable()) {
-    false_branch->Goto(if_false(), owner()->function_state());
+      // Optimistically treat phis as uint32 safe.
+      continue;
+    }
+
+    if (!IsSafeUint32Use(uint32val, use)) {
+      return false;
+    }
   }
-  owner()->set_current_block(NULL);
-}
 
+  if (collect_phi_uses) {
+    for (HUseIterator it(uint32val->uses()); !it.Done(); it.Advance()) {
+      HValue* use = it.value();
 
-void TestContext::BuildBranch(HValue* value) {
-  // We expect the graph to be in edge-split form: there is no edge that
-  // connects a branch node to a join node.  We conservatively ensure that
-  // property by always adding an empty block on the outgoing edges of this
-  // branch.
-  HOptimizedGraphBuilder* builder = owner();
-  if (value != NULL && value->CheckFlag(HValue::kIsArguments)) {
-    builder->Bailout("arguments object value in a test context");
-  }
-  if (value->IsConstant()) {
-    HConstant* constant_value = HConstant::cast(value);
-    if (constant_value->BooleanValue()) {
-      builder->current_block()->Goto(if_true(), builder->function_state());
-    } else {
-      builder->current_block()->Goto(if_false(), builder->function_state());
+      // There is a phi use of this value from a phis that is not yet
+      // collected in phis_ array. Separate pass is required.
+      if (use->IsPhi() && !use->CheckFlag(HInstruction::kUint32)) {
+        use->SetFlag(HInstruction::kUint32);
+        phis_.Add(HPhi::cast(use), zone_);
+      }
     }
-    builder->set_current_block(NULL);
-    return;
   }
-  HBasicBlock* empty_true = builder->graph()->CreateBasicBlock();
-  HBasicBlock* empty_false = builder->graph()->CreateBasicBlock();
-  TypeFeedbackId test_id = condition()->test_id();
-  ToBooleanStub::Types expected(oracle()->ToBooleanTypes(test_id));
-  HBranch* test = new(zone()) HBranch(value, empty_true, empty_false, expected);
-  builder->current_block()->Finish(test);
 
-  empty_true->Goto(if_true(), builder->function_state());
-  empty_false->Goto(if_false(), builder->function_state());
-  builder->set_current_block(NULL);
+  return true;
 }
 
 
-// HOptimizedGraphBuilder infrastructure for bailing out and checking bailouts.
-#define CHECK_BAILOUT(call)                     \
-  do {                                          \
-    call;                                       \
-    if (HasStackOverflow()) return;             \
-  } while (false)
-
+// Analyze instruction and mark it with kUint32 if all its uses are uint32
+// safe.
+void Uint32Analysis::Analyze(HInstruction* current) {
+  if (Uint32UsesAreSafe(current)) current->SetFlag(HInstruction::kUint32);
+}
 
-#define CHECK_ALIVE(call)                                       \
-  do {                                                          \
-    call;                                                       \
-    if (HasStackOverflow() || current_block() == NULL) return;  \
-  } while (false)
 
+// Check if all operands to the given phi are marked with kUint32 flag.
+bool Uint32Analysis::CheckPhiOperands(HPhi* phi) {
+  if (!phi->CheckFlag(HInstruction::kUint32)) {
+    // This phi is not uint32 safe. No need to check operands.
+    return false;
+  }
 
-void HOptimizedGraphBuilder::Bailout(const char* reason) {
-  info()->set_bailout_reason(reason);
-  SetStackOverflow();
-}
+  for (int j = 0; j < phi->OperandCount(); j++) {
+    HValue* operand = phi->OperandAt(j);
+    if (!operand->CheckFlag(HInstruction::kUint32)) {
+      // Lazyly mark constants that fit into uint32 range with kUint32 flag.
+      if (operand->IsInteger32Constant() &&
+          operand->GetInteger32Constant() >= 0) {
+        operand->SetFlag(HInstruction::kUint32);
+        continue;
+      }
 
+      // This phi is not safe, some operands are not uint32 values.
+      return false;
+    }
+  }
 
-void HOptimizedGraphBuilder::VisitForEffect(Expression* expr) {
-  EffectContext for_effect(this);
-  Visit(expr);
+  return true;
 }
 
 
-void HOptimizedGraphBuilder::VisitForValue(Expression* expr,
-                                           ArgumentsAllowedFlag flag) {
-  ValueContext for_value(this, flag);
-  Visit(expr);
+// Remove kUint32 flag from the phi itself and its operands. If any operand
+// was a phi marked with kUint32 place it into a worklist for
+// transitive clearing of kUint32 flag.
+void Uint32Analysis::UnmarkPhi(HPhi* phi, ZoneList<HPhi*>* worklist) {
+  phi->ClearFlag(HInstruction::kUint32);
+  for (int j = 0; j < phi->OperandCount(); j++) {
+    HValue* operand = phi->OperandAt(j);
+    if (operand->CheckFlag(HInstruction::kUint32)) {
+      operand->ClearFlag(HInstruction::kUint32);
+      if (operand->IsPhi()) {
+        worklist->Add(HPhi::cast(operand), zone_);
+      }
+    }
+  }
 }
 
 
-void HOptimizedGraphBuilder::VisitForTypeOf(Expression* expr) {
-  ValueContext for_value(this, ARGUMENTS_NOT_ALLOWED);
-  for_value.set_for_typeof(true);
-  Visit(expr);
-}
-
+void Uint32Analysis::UnmarkUnsafePhis() {
+  // No phis were collected. Nothing to do.
+  if (phis_.length() == 0) return;
 
+  // Worklist used to transitively clear kUint32 from phis that
+  // are used as arguments to other phis.
+  ZoneList<HPhi*> worklist(phis_.length(), zone_);
 
-void HOptimizedGraphBuilder::VisitForControl(Expression* expr,
-                                             HBasicBlock* true_block,
-                                             HBasicBlock* false_block) {
-  TestContext for_test(this, expr, oracle(), true_block, false_block);
-  Visit(expr);
-}
+  // Phi can be used as a uint32 value if and only if
+  // all its operands are uint32 values and all its
+  // uses are uint32 safe.
 
+  // Iterate over collected phis and unmark those that
+  // are unsafe. When unmarking phi unmark its operands
+  // and add it to the worklist if it is a phi as well.
+  // Phis that are still marked as safe are shifted down
+  // so that all safe phis form a prefix of the phis_ array.
+  int phi_count = 0;
+  for (int i = 0; i < phis_.length(); i++) {
+    HPhi* phi = phis_[i];
 
-void HOptimizedGraphBuilder::VisitArgument(Expression* expr) {
-  CHECK_ALIVE(VisitForValue(expr));
-  Push(AddInstruction(new(zone()) HPushArgument(Pop())));
-}
-
-
-void HOptimizedGraphBuilder::VisitArgumentList(
-    ZoneList<Expression*>* arguments) {
-  for (int i = 0; i < arguments->length(); i++) {
-    CHECK_ALIVE(VisitArgument(arguments->at(i)));
+    if (CheckPhiOperands(phi) && Uint32UsesAreSafe(phi)) {
+      phis_[phi_count++] = phi;
+    } else {
+      UnmarkPhi(phi, &worklist);
+    }
   }
-}
 
+  // Now phis array contains only those phis that have safe
+  // non-phi uses. Start transitively clearing kUint32 flag
+  // from phi operands of discovered non-safe phies until
+  // only safe phies are left.
+  while (!worklist.is_empty())  {
+    while (!worklist.is_empty()) {
+      HPhi* phi = worklist.RemoveLast();
+      UnmarkPhi(phi, &worklist);
+    }
 
-void HOptimizedGraphBuilder::VisitExpressions(
-    ZoneList<Expression*>* exprs) {
-  for (int i = 0; i < exprs->length(); ++i) {
-    CHECK_ALIVE(VisitForValue(exprs->at(i)));
+    // Check if any operands to safe phies were unmarked
+    // turning a safe phi into unsafe. The same value
+    // can flow into several phis.
+    int new_phi_count = 0;
+    for (int i = 0; i < phi_count; i++) {
+      HPhi* phi = phis_[i];
+
+      if (CheckPhiOperands(phi)) {
+        phis_[new_phi_count++] = phi;
+      } else {
+        UnmarkPhi(phi, &worklist);
+      }
+    }
+    phi_count = new_phi_count;
   }
 }
 
 
-bool HOptimizedGraphBuilder::BuildGraph() {
-  if (info()->function()->is_generator()) {
-    Bailout("function is a generator");
-    return false;
-  }
-  Scope* scope = info()->scope();
-  if (scope->HasIllegalRedeclaration()) {
-    Bailout("function with illegal redeclaration");
-    return false;
-  }
-  if (scope->calls_eval()) {
-    Bailout("function calls eval");
-    return false;
-  }
-  SetUpScope(scope);
-
-  // Add an edge to the body entry.  This is warty: the graph's start
-  // environment will be used by the Lithium translation as the initial
-  // environment on graph entry, but it has now been mutated by the
-  // Hydrogen translation of the instructions in the start block.  This
-  // environment uses values which have not been defined yet.  These
-  // Hydrogen instructions will then be replayed by the Lithium
-  // translation, so they cannot have an environment effect.  The edge to
-  // the body's entry block (along with some special logic for the start
-  // block in HInstruction::InsertAfter) seals the start block from
-  // getting unwanted instructions inserted.
-  //
-  // TODO(kmillikin): Fix this.  Stop mutating the initial environment.
-  // Make the Hydrogen instructions in the initial block into Hydrogen
-  // values (but not instructions), present in the initial environment and
-  // not replayed by the Lithium translation.
-  HEnvironment* initial_env = environment()->CopyWithoutHistory();
-  HBasicBlock* body_entry = CreateBasicBlock(initial_env);
-  current_block()->Goto(body_entry);
-  body_entry->SetJoinId(BailoutId::FunctionEntry());
-  set_current_block(body_entry);
+void HGraph::ComputeSafeUint32Operations() {
+  HPhase phase("H_Compute safe UInt32 operations", this);
+  if (uint32_instructions_ == NULL) return;
 
-  // Handle implicit declaration of the function name in named function
-  // expressions before other declarations.
-  if (scope->is_function_scope() && scope->function() != NULL) {
-    VisitVariableDeclaration(scope->function());
+  Uint32Analysis analysis(zone());
+  for (int i = 0; i < uint32_instructions_->length(); ++i) {
+    HInstruction* current = uint32_instructions_->at(i);
+    if (current->IsLinked() && current->representation().IsInteger32()) {
+      analysis.Analyze(current);
+    }
   }
-  VisitDeclarations(scope->declarations());
-  AddSimulate(BailoutId::Declarations());
 
-  HValue* context = environment()->LookupContext();
-  AddInstruction(
-      new(zone()) HStackCheck(context, HStackCheck::kFunctionEntry));
+  // Some phis might have been optimistically marked with kUint32 flag.
+  // Remove this flag from those phis that are unsafe and propagate
+  // this information transitively potentially clearing kUint32 flag
+  // from some non-phi operations that are used as operands to unsafe phis.
+  analysis.UnmarkUnsafePhis();
+}
 
-  VisitStatements(info()->function()->body());
-  if (HasStackOverflow()) return false;
 
-  if (current_block() != NULL) {
-    AddReturn(graph()->GetConstantUndefined());
-    set_current_block(NULL);
+void HGraph::ComputeMinusZeroChecks() {
+  HPhase phase("H_Compute minus zero checks", this);
+  BitVector visited(GetMaximumValueID(), zone());
+  for (int i = 0; i < blocks_.length(); ++i) {
+    for (HInstruction* current = blocks_[i]->first();
+         current != NULL;
+         current = current->next()) {
+      if (current->IsChange()) {
+        HChange* change = HChange::cast(current);
+        // Propagate flags for negative zero checks upwards from conversions
+        // int32-to-tagged and int32-to-double.
+        Representation from = change->value()->representation();
+        ASSERT(from.Equals(change->from()));
+        if (from.IsInteger32()) {
+          ASSERT(change->to().IsTagged() || change->to().IsDouble());
+          ASSERT(visited.IsEmpty());
+          PropagateMinusZeroChecks(change->value(), &visited);
+          visited.Clear();
+        }
+      }
+    }
   }
-
-  // If the checksum of the number of type info changes is the same as the
-  // last time this function was compiled, then this recompile is likely not
-  // due to missing/inadequate type feedback, but rather too aggressive
-  // optimization. Disable optimistic LICM in that case.
-  Handle<Code> unoptimized_code(info()->shared_info()->code());
-  ASSERT(unoptimized_code->kind() == Code::FUNCTION);
-  Handle<TypeFeedbackInfo> type_info(
-      TypeFeedbackInfo::cast(unoptimized_code->type_feedback_info()));
-  int checksum = type_info->own_type_change_checksum();
-  int composite_checksum = graph()->update_type_change_checksum(checksum);
-  graph()->set_use_optimistic_licm(
-      !type_info->matches_inlined_type_change_checksum(composite_checksum));
-  type_info->set_inlined_type_change_checksum(composite_checksum);
-
-  return true;
 }
 
 
-// Perform common subexpression elimination and loop-invariant code motion.
-void HGraph::GlobalValueNumbering() {
-  HPhase phase("H_Global value numbering", this);
-  HGlobalValueNumberer gvn(this, info());
-  bool removed_side_effects = gvn.Analyze();
-  // Trigger a second analysis pass to further eliminate duplicate values that
-  // could only be discovered by removing side-effect-generating instructions
-  // during the first pass.
-  if (FLAG_smi_only_arrays && removed_side_effects) {
-    removed_side_effects = gvn.Analyze();
-    ASSERT(!removed_side_effects);
+// Implementation of utility class to encapsulate the translation state for
+// a (possibly inlined) function.
+FunctionState::FunctionState(HOptimizedGraphBuilder* owner,
+                             CompilationInfo* info,
+                             TypeFeedbackOracle* oracle,
+                             InliningKind inlining_kind)
+    : owner_(owner),
+      compilation_info_(info),
+      oracle_(oracle),
+      call_context_(NULL),
+      inlining_kind_(inlining_kind),
+      function_return_(NULL),
+      test_context_(NULL),
+      entry_(NULL),
+      arguments_elements_(NULL),
+      outer_(owner->function_state()) {
+  if (outer_ != NULL) {
+    // State for an inline function.
+    if (owner->ast_context()->IsTest()) {
+      HBasicBlock* if_true = owner->graph()->CreateBasicBlock();
+      HBasicBlock* if_false = owner->graph()->CreateBasicBlock();
+      if_true->MarkAsInlineReturnTarget();
+      if_false->MarkAsInlineReturnTarget();
+      TestContext* outer_test_context = TestContext::cast(owner->ast_context());
+      Expression* cond = outer_test_context->condition();
+      TypeFeedbackOracle* outer_oracle = outer_test_context->oracle();
+      // The AstContext constructor pushed on the context stack.  This newed
+      // instance is the reason that AstContext can't be BASE_EMBEDDED.
+      test_context_ =
+          new TestContext(owner, cond, outer_oracle, if_true, if_false);
+    } else {
+      function_return_ = owner->graph()->CreateBasicBlock();
+      function_return()->MarkAsInlineReturnTarget();
+    }
+    // Set this after possibly allocating a new TestContext above.
+    call_context_ = owner->ast_context();
   }
+
+  // Push on the state stack.
+  owner->set_function_state(this);
 }
 
 
-bool HGraph::Optimize(SmartArrayPointer<char>* bailout_reason) {
-  *bailout_reason = SmartArrayPointer<char>();
-  OrderBlocks();
-  AssignDominators();
+FunctionState::~FunctionState() {
+  delete test_context_;
+  owner_->set_function_state(outer_);
+}
 
-  // We need to create a HConstant "zero" now so that GVN will fold every
-  // zero-valued constant in the graph together.
-  // The constant is needed to make idef-based bounds check work: the pass
-  // evaluates relations with "zero" and that zero cannot be created after GVN.
-  GetConstant0();
 
+// Implementation of utility classes to represent an expression's context in
+// the AST.
+AstContext::AstContext(HOptimizedGraphBuilder* owner, Expression::Context kind)
+    : owner_(owner),
+      kind_(kind),
+      outer_(owner->ast_context()),
+      for_typeof_(false) {
+  owner->set_ast_context(this);  // Push.
 #ifdef DEBUG
-  // Do a full verify after building the graph and computing dominators.
-  Verify(true);
+  ASSERT(owner->environment()->frame_type() == JS_FUNCTION);
+  original_length_ = owner->environment()->length();
 #endif
+}
 
-  PropagateDeoptimizingMark();
-  if (!CheckConstPhiUses()) {
-    *bailout_reason = SmartArrayPointer<char>(StrDup(
-        "Unsupported phi use of const variable"));
-    return false;
-  }
-  EliminateRedundantPhis();
-  if (!CheckArgumentsPhiUses()) {
-    *bailout_reason = SmartArrayPointer<char>(StrDup(
-        "Unsupported phi use of arguments"));
-    return false;
-  }
-  if (FLAG_eliminate_dead_phis) EliminateUnreachablePhis();
-  CollectPhis();
 
-  if (has_osr_loop_entry()) {
-    const ZoneList<HPhi*>* phis = osr_loop_entry()->phis();
-    for (int j = 0; j < phis->length(); j++) {
-      HPhi* phi = phis->at(j);
-      osr_values()->at(phi->merged_index())->set_incoming_value(phi);
-    }
-  }
+AstContext::~AstContext() {
+  owner_->set_ast_context(outer_);  // Pop.
+}
 
-  HInferRepresentation rep(this);
-  rep.Analyze();
 
-  // Remove HSimulate instructions that have turned out not to be needed
-  // after all by folding them into the following HSimulate.
-  // This must happen after inferring representations.
-  MergeRemovableSimulates();
+EffectContext::~EffectContext() {
+  ASSERT(owner()->HasStackOverflow() ||
+         owner()->current_block() == NULL ||
+         (owner()->environment()->length() == original_length_ &&
+          owner()->environment()->frame_type() == JS_FUNCTION));
+}
 
-  MarkDeoptimizeOnUndefined();
-  InsertRepresentationChanges();
 
-  InitializeInferredTypes();
+ValueContext::~ValueContext() {
+  ASSERT(owner()->HasStackOverflow() ||
+         owner()->current_block() == NULL ||
+         (owner()->environment()->length() == original_length_ + 1 &&
+          owner()->environment()->frame_type() == JS_FUNCTION));
+}
 
-  // Must be performed before canonicalization to ensure that Canonicalize
-  // will not remove semantically meaningful ToInt32 operations e.g. BIT_OR with
-  // zero.
-  if (FLAG_opt_safe_uint32_operations) ComputeSafeUint32Operations();
 
-  if (FLAG_use_canonicalizing) Canonicalize();
+void EffectContext::ReturnValue(HValue* value) {
+  // The value is simply ignored.
+}
 
-  if (FLAG_use_gvn) GlobalValueNumbering();
 
-  if (FLAG_use_range) {
-    HRangeAnalysis rangeAnalysis(this);
-    rangeAnalysis.Analyze();
+void ValueContext::ReturnValue(HValue* value) {
+  // The value is tracked in the bailout environment, and communicated
+  // through the environment as the result of the expression.
+  if (!arguments_allowed() && value->CheckFlag(HValue::kIsArguments)) {
+    owner()->Bailout("bad value context for arguments value");
   }
-  ComputeMinusZeroChecks();
+  owner()->Push(value);
+}
 
-  // Eliminate redundant stack checks on backwards branches.
-  HStackCheckEliminator sce(this);
-  sce.Process();
 
-  if (FLAG_idefs) SetupInformativeDefinitions();
-  if (FLAG_array_bounds_checks_elimination && !FLAG_idefs) {
-    EliminateRedundantBoundsChecks();
+void TestContext::ReturnValue(HValue* value) {
+  BuildBranch(value);
+}
+
+
+void EffectContext::ReturnInstruction(HInstruction* instr, BailoutId ast_id) {
+  ASSERT(!instr->IsControlInstruction());
+  owner()->AddInstruction(instr);
+  if (instr->HasObservableSideEffects()) {
+    owner()->AddSimulate(ast_id, REMOVABLE_SIMULATE);
   }
-  if (FLAG_array_index_dehoisting) DehoistSimpleArrayIndexComputations();
-  if (FLAG_dead_code_elimination) DeadCodeElimination();
+}
 
-  RestoreActualValues();
 
-  return true;
+void EffectContext::ReturnControl(HControlInstruction* instr,
+                                  BailoutId ast_id) {
+  ASSERT(!instr->HasObservableSideEffects());
+  HBasicBlock* empty_true = owner()->graph()->CreateBasicBlock();
+  HBasicBlock* empty_false = owner()->graph()->CreateBasicBlock();
+  instr->SetSuccessorAt(0, empty_true);
+  instr->SetSuccessorAt(1, empty_false);
+  owner()->current_block()->Finish(instr);
+  HBasicBlock* join = owner()->CreateJoin(empty_true, empty_false, ast_id);
+  owner()->set_current_block(join);
 }
 
 
-void HGraph::SetupInformativeDefinitionsInBlock(HBasicBlock* block) {
-  for (int phi_index = 0; phi_index < block->phis()->length(); phi_index++) {
-    HPhi* phi = block->phis()->at(phi_index);
-    phi->AddInformativeDefinitions();
-    phi->SetFlag(HValue::kIDefsProcessingDone);
-    // We do not support phis that "redefine just one operand".
-    ASSERT(!phi->IsInformativeDefinition());
+void EffectContext::ReturnContinuation(HIfContinuation* continuation,
+                                       BailoutId ast_id) {
+  HBasicBlock* true_branch = NULL;
+  HBasicBlock* false_branch = NULL;
+  continuation->Continue(&true_branch, &false_branch, NULL);
+  if (!continuation->IsTrueReachable()) {
+    owner()->set_current_block(false_branch);
+  } else if (!continuation->IsFalseReachable()) {
+    owner()->set_current_block(true_branch);
+  } else {
+    HBasicBlock* join = owner()->CreateJoin(true_branch, false_branch, ast_id);
+    owner()->set_current_block(join);
   }
+}
 
-  for (HInstruction* i = block->first(); i != NULL; i = i->next()) {
-    i->AddInformativeDefinitions();
-    i->SetFlag(HValue::kIDefsProcessingDone);
-    i->UpdateRedefinedUsesWhileSettingUpInformativeDefinitions();
+
+void ValueContext::ReturnInstruction(HInstruction* instr, BailoutId ast_id) {
+  ASSERT(!instr->IsControlInstruction());
+  if (!arguments_allowed() && instr->CheckFlag(HValue::kIsArguments)) {
+    return owner()->Bailout("bad value context for arguments object value");
+  }
+  owner()->AddInstruction(instr);
+  owner()->Push(instr);
+  if (instr->HasObservableSideEffects()) {
+    owner()->AddSimulate(ast_id, REMOVABLE_SIMULATE);
   }
 }
 
 
-// This method is recursive, so if its stack frame is large it could
-// cause a stack overflow.
-// To keep the individual stack frames small we do the actual work inside
-// SetupInformativeDefinitionsInBlock();
-void HGraph::SetupInformativeDefinitionsRecursively(HBasicBlock* block) {
-  SetupInformativeDefinitionsInBlock(block);
-  for (int i = 0; i < block->dominated_blocks()->length(); ++i) {
-    SetupInformativeDefinitionsRecursively(block->dominated_blocks()->at(i));
+void ValueContext::ReturnControl(HControlInstruction* instr, BailoutId ast_id) {
+  ASSERT(!instr->HasObservableSideEffects());
+  if (!arguments_allowed() && instr->CheckFlag(HValue::kIsArguments)) {
+    return owner()->Bailout("bad value context for arguments object value");
   }
+  HBasicBlock* materialize_false = owner()->graph()->CreateBasicBlock();
+  HBasicBlock* materialize_true = owner()->graph()->CreateBasicBlock();
+  instr->SetSuccessorAt(0, materialize_true);
+  instr->SetSuccessorAt(1, materialize_false);
+  owner()->current_block()->Finish(instr);
+  owner()->set_current_block(materialize_true);
+  owner()->Push(owner()->graph()->GetConstantTrue());
+  owner()->set_current_block(materialize_false);
+  owner()->Push(owner()->graph()->GetConstantFalse());
+  HBasicBlock* join =
+    owner()->CreateJoin(materialize_true, materialize_false, ast_id);
+  owner()->set_current_block(join);
+}
 
-  for (HInstruction* i = block->first(); i != NULL; i = i->next()) {
-    if (i->IsBoundsCheck()) {
-      HBoundsCheck* check = HBoundsCheck::cast(i);
-      check->ApplyIndexChange();
-    }
+
+void ValueContext::ReturnContinuation(HIfContinuation* continuation,
+                                      BailoutId ast_id) {
+  HBasicBlock* materialize_true = NULL;
+  HBasicBlock* materialize_false = NULL;
+  continuation->Continue(&materialize_true, &materialize_false, NULL);
+  if (continuation->IsTrueReachable()) {
+    owner()->set_current_block(materialize_true);
+    owner()->Push(owner()->graph()->GetConstantTrue());
+    owner()->set_current_block(materialize_true);
+  }
+  if (continuation->IsFalseReachable()) {
+    owner()->set_current_block(materialize_false);
+    owner()->Push(owner()->graph()->GetConstantFalse());
+    owner()->set_current_block(materialize_false);
+  }
+  if (continuation->TrueAndFalseReachable()) {
+    HBasicBlock* join =
+        owner()->CreateJoin(materialize_true, materialize_false, ast_id);
+    owner()->set_current_block(join);
   }
 }
 
 
-void HGraph::SetupInformativeDefinitions() {
-  HPhase phase("H_Setup informative definitions", this);
-  SetupInformativeDefinitionsRecursively(entry_block());
+void TestContext::ReturnInstruction(HInstruction* instr, BailoutId ast_id) {
+  ASSERT(!instr->IsControlInstruction());
+  HOptimizedGraphBuilder* builder = owner();
+  builder->AddInstruction(instr);
+  // We expect a simulate after every expression with side effects, though
+  // this one isn't actually needed (and wouldn't work if it were targeted).
+  if (instr->HasObservableSideEffects()) {
+    builder->Push(instr);
+    builder->AddSimulate(ast_id, REMOVABLE_SIMULATE);
+    builder->Pop();
+  }
+  BuildBranch(instr);
 }
 
 
-// We try to "factor up" HBoundsCheck instructions towards the root of the
-// dominator tree.
-// For now we handle checks where the index is like "exp + int32value".
-// If in the dominator tree we check "exp + v1" and later (dominated)
-// "exp + v2", if v2 <= v1 we can safely remove the second check, and if
-// v2 > v1 we can use v2 in the 1st check and again remove the second.
-// To do so we keep a dictionary of all checks where the key if the pair
-// "exp, length".
-// The class BoundsCheckKey represents this key.
-class BoundsCheckKey : public ZoneObject {
- public:
-  HValue* IndexBase() const { return index_base_; }
-  HValue* Length() const { return length_; }
-
-  uint32_t Hash() {
-    return static_cast<uint32_t>(index_base_->Hashcode() ^ length_->Hashcode());
-  }
+void TestContext::ReturnControl(HControlInstruction* instr, BailoutId ast_id) {
+  ASSERT(!instr->HasObservableSideEffects());
+  HBasicBlock* empty_true = owner()->graph()->CreateBasicBlock();
+  HBasicBlock* empty_false = owner()->graph()->CreateBasicBlock();
+  instr->SetSuccessorAt(0, empty_true);
+  instr->SetSuccessorAt(1, empty_false);
+  owner()->current_block()->Finish(instr);
+  empty_true->Goto(if_true(), owner()->function_state());
+  empty_false->Goto(if_false(), owner()->function_state());
+  owner()->set_current_block(NULL);
+}
 
-  static BoundsCheckKey* Create(Zone* zone,
-                                HBoundsCheck* check,
-                                int32_t* offset) {
-    if (!check->index()->representation().IsInteger32()) return NULL;
 
-    HValue* index_base = NULL;
-    HConstant* constant = NULL;
-    bool is_sub = false;
+void TestContext::ReturnContinuation(HIfContinuation* continuation,
+                                     BailoutId ast_id) {
+  HBasicBlock* true_branch = NULL;
+  HBasicBlock* false_branch = NULL;
+  continuation->Continue(&true_branch, &false_branch, NULL);
+  if (continuation->IsTrueReachable()) {
+    true_branch->Goto(if_true(), owner()->function_state());
+  }
+  if (continuation->IsFalseReachable()) {
+    false_branch->Goto(if_false(), owner()->function_state());
+  }
+  owner()->set_current_block(NULL);
+}
 
-    if (check->index()->IsAdd()) {
-      HAdd* index = HAdd::cast(check->index());
-      if (index->left()->IsConstant()) {
-        constant = HConstant::cast(index->left());
-        index_base = index->right();
-      } else if (index->right()->IsConstant()) {
-        constant = HConstant::cast(index->right());
-        index_base = index->left();
-      }
-    } else if (check->index()->IsSub()) {
-      HSub* index = HSub::cast(check->index());
-      is_sub = true;
-      if (index->left()->IsConstant()) {
-        constant = HConstant::cast(index->left());
-        index_base = index->right();
-      } else if (index->right()->IsConstant()) {
-        constant = HConstant::cast(index->right());
-        index_base = index->left();
-      }
-    }
 
-    if (constant != NULL && constant->HasInteger32Value()) {
-      *offset = is_sub ? - constant->Integer32Value()
-                       : constant->Integer32Value();
+void TestContext::BuildBranch(HValue* value) {
+  // We expect the graph to be in edge-split form: there is no edge that
+  // connects a branch node to a join node.  We conservatively ensure that
+  // property by always adding an empty block on the outgoing edges of this
+  // branch.
+  HOptimizedGraphBuilder* builder = owner();
+  if (value != NULL && value->CheckFlag(HValue::kIsArguments)) {
+    builder->Bailout("arguments object value in a test context");
+  }
+  if (value->IsConstant()) {
+    HConstant* constant_value = HConstant::cast(value);
+    if (constant_value->BooleanValue()) {
+      builder->current_block()->Goto(if_true(), builder->function_state());
     } else {
-      *offset = 0;
-      index_base = check->index();
+      builder->current_block()->Goto(if_false(), builder->function_state());
     }
-
-    return new(zone) BoundsCheckKey(index_base, check->length());
+    builder->set_current_block(NULL);
+    return;
   }
+  HBasicBlock* empty_true = builder->graph()->CreateBasicBlock();
+  HBasicBlock* empty_false = builder->graph()->CreateBasicBlock();
+  TypeFeedbackId test_id = condition()->test_id();
+  ToBooleanStub::Types expected(oracle()->ToBooleanTypes(test_id));
+  HBranch* test = new(zone()) HBranch(value, empty_true, empty_false, expected);
+  builder->current_block()->Finish(test);
 
- private:
-  BoundsCheckKey(HValue* index_base, HValue* length)
+  empty_true->Goto(if_true(), builder->function_state());
+  empty_false->Goto(if_false(), builder->function_state());
+  builder->set_current_block(NULL);
+}
+
+
+// HOptimizedGraphBuilder infrastructure for bailing out and checking bailouts.
+#define CHECK_BAILOUT(call)                     \
+  do {                                          \
+    call;                                       \
+    if (HasStackOverflow()) return;             \
+  } while (false)
+
+
+#define CHECK_ALIVE(call)                                       \
+  do {                                                          \
+    call;                                                       \
+    if (HasStackOverflow() || current_block() == NULL) return;  \
+  } while (false)
+
+
+void HOptimizedGraphBuilder::Bailout(const char* reason) {
+  info()->set_bailout_reason(reason);
+  SetStackOverflow();
+}
+
+
+void HOptimizedGraphBuilder::VisitForEffect(Expression* expr) {
+  EffectContext for_effect(this);
+  Visit(expr);
+}
+
+
+void HOptimizedGraphBuilder::VisitForValue(Expression* expr,
+                                           ArgumentsAllowedFlag flag) {
+  ValueContext for_value(this, flag);
+  Visit(expr);
+}
+
+
+void HOptimizedGraphBuilder::VisitForTypeOf(Expression* expr) {
+  ValueContext for_value(this, ARGUMENTS_NOT_ALLOWED);
+  for_value.set_for_typeof(true);
+  Visit(expr);
+}
+
+
+
+void HOptimizedGraphBuilder::VisitForControl(Expression* expr,
+                                             HBasicBlock* true_block,
+                                             HBasicBlock* false_block) {
+  TestContext for_test(this, expr, oracle(), true_block, false_block);
+  Visit(expr);
+}
+
+
+void HOptimizedGraphBuilder::VisitArgument(Expression* expr) {
+  CHECK_ALIVE(VisitForValue(expr));
+  Push(AddInstruction(new(zone()) HPushArgument(Pop())));
+}
+
+
+void HOptimizedGraphBuilder::VisitArgumentList(
+    ZoneList<Expression*>* arguments) {
+  for (int i = 0; i < arguments->length(); i++) {
+    CHECK_ALIVE(VisitArgument(arguments->at(i)));
+  }
+}
+
+
+void HOptimizedGraphBuilder::VisitExpressions(
+    ZoneList<Expression*>* exprs) {
+  for (int i = 0; i < exprs->length(); ++i) {
+    CHECK_ALIVE(VisitForValue(exprs->at(i)));
+  }
+}
+
+
+bool HOptimizedGraphBuilder::BuildGraph() {
+  if (info()->function()->is_generator()) {
+    Bailout("function is a generator");
+    return false;
+  }
+  Scope* scope = info()->scope();
+  if (scope->HasIllegalRedeclaration()) {
+    Bailout("function with illegal redeclaration");
+    return false;
+  }
+  if (scope->calls_eval()) {
+    Bailout("function calls eval");
+    return false;
+  }
+  SetUpScope(scope);
+
+  // Add an edge to the body entry.  This is warty: the graph's start
+  // environment will be used by the Lithium translation as the initial
+  // environment on graph entry, but it has now been mutated by the
+  // Hydrogen translation of the instructions in the start block.  This
+  // environment uses values which have not been defined yet.  These
+  // Hydrogen instructions will then be replayed by the Lithium
+  // translation, so they cannot have an environment effect.  The edge to
+  // the body's entry block (along with some special logic for the start
+  // block in HInstruction::InsertAfter) seals the start block from
+  // getting unwanted instructions inserted.
+  //
+  // TODO(kmillikin): Fix this.  Stop mutating the initial environment.
+  // Make the Hydrogen instructions in the initial block into Hydrogen
+  // values (but not instructions), present in the initial environment and
+  // not replayed by the Lithium translation.
+  HEnvironment* initial_env = environment()->CopyWithoutHistory();
+  HBasicBlock* body_entry = CreateBasicBlock(initial_env);
+  current_block()->Goto(body_entry);
+  body_entry->SetJoinId(BailoutId::FunctionEntry());
+  set_current_block(body_entry);
+
+  // Handle implicit declaration of the function name in named function
+  // expressions before other declarations.
+  if (scope->is_function_scope() && scope->function() != NULL) {
+    VisitVariableDeclaration(scope->function());
+  }
+  VisitDeclarations(scope->declarations());
+  AddSimulate(BailoutId::Declarations());
+
+  HValue* context = environment()->LookupContext();
+  AddInstruction(
+      new(zone()) HStackCheck(context, HStackCheck::kFunctionEntry));
+
+  VisitStatements(info()->function()->body());
+  if (HasStackOverflow()) return false;
+
+  if (current_block() != NULL) {
+    AddReturn(graph()->GetConstantUndefined());
+    set_current_block(NULL);
+  }
+
+  // If the checksum of the number of type info changes is the same as the
+  // last time this function was compiled, then this recompile is likely not
+  // due to missing/inadequate type feedback, but rather too aggressive
+  // optimization. Disable optimistic LICM in that case.
+  Handle<Code> unoptimized_code(info()->shared_info()->code());
+  ASSERT(unoptimized_code->kind() == Code::FUNCTION);
+  Handle<TypeFeedbackInfo> type_info(
+      TypeFeedbackInfo::cast(unoptimized_code->type_feedback_info()));
+  int checksum = type_info->own_type_change_checksum();
+  int composite_checksum = graph()->update_type_change_checksum(checksum);
+  graph()->set_use_optimistic_licm(
+      !type_info->matches_inlined_type_change_checksum(composite_checksum));
+  type_info->set_inlined_type_change_checksum(composite_checksum);
+
+  return true;
+}
+
+
+// Perform common subexpression elimination and loop-invariant code motion.
+void HGraph::GlobalValueNumbering() {
+  HPhase phase("H_Global value numbering", this);
+  HGlobalValueNumberer gvn(this, info());
+  bool removed_side_effects = gvn.Analyze();
+  // Trigger a second analysis pass to further eliminate duplicate values that
+  // could only be discovered by removing side-effect-generating instructions
+  // during the first pass.
+  if (FLAG_smi_only_arrays && removed_side_effects) {
+    removed_side_effects = gvn.Analyze();
+    ASSERT(!removed_side_effects);
+  }
+}
+
+
+bool HGraph::Optimize(SmartArrayPointer<char>* bailout_reason) {
+  *bailout_reason = SmartArrayPointer<char>();
+  OrderBlocks();
+  AssignDominators();
+
+  // We need to create a HConstant "zero" now so that GVN will fold every
+  // zero-valued constant in the graph together.
+  // The constant is needed to make idef-based bounds check work: the pass
+  // evaluates relations with "zero" and that zero cannot be created after GVN.
+  GetConstant0();
+
+#ifdef DEBUG
+  // Do a full verify after building the graph and computing dominators.
+  Verify(true);
+#endif
+
+  PropagateDeoptimizingMark();
+  if (!CheckConstPhiUses()) {
+    *bailout_reason = SmartArrayPointer<char>(StrDup(
+        "Unsupported phi use of const variable"));
+    return false;
+  }
+  EliminateRedundantPhis();
+  if (!CheckArgumentsPhiUses()) {
+    *bailout_reason = SmartArrayPointer<char>(StrDup(
+        "Unsupported phi use of arguments"));
+    return false;
+  }
+  if (FLAG_eliminate_dead_phis) EliminateUnreachablePhis();
+  CollectPhis();
+
+  if (has_osr_loop_entry()) {
+    const ZoneList<HPhi*>* phis = osr_loop_entry()->phis();
+    for (int j = 0; j < phis->length(); j++) {
+      HPhi* phi = phis->at(j);
+      osr_values()->at(phi->merged_index())->set_incoming_value(phi);
+    }
+  }
+
+  HInferRepresentation rep(this);
+  rep.Analyze();
+
+  // Remove HSimulate instructions that have turned out not to be needed
+  // after all by folding them into the following HSimulate.
+  // This must happen after inferring representations.
+  MergeRemovableSimulates();
+
+  MarkDeoptimizeOnUndefined();
+  InsertRepresentationChanges();
+
+  InitializeInferredTypes();
+
+  // Must be performed before canonicalization to ensure that Canonicalize
+  // will not remove semantically meaningful ToInt32 operations e.g. BIT_OR with
+  // zero.
+  if (FLAG_opt_safe_uint32_operations) ComputeSafeUint32Operations();
+
+  if (FLAG_use_canonicalizing) Canonicalize();
+
+  if (FLAG_use_gvn) GlobalValueNumbering();
+
+  if (FLAG_load_elimination) {
+    HLoadEliminator load_eliminator(this);
+    load_eliminator.Process();
+  }
+
+  if (FLAG_check_elimination) {
+    HCheckEliminator check_eliminator(this);
+    check_eliminator.Process();
+  }
+
+  if (FLAG_use_range) {
+    HRangeAnalysis rangeAnalysis(this);
+    rangeAnalysis.Analyze();
+  }
+  ComputeMinusZeroChecks();
+
+  // Eliminate redundant stack checks on backwards branches.
+  HStackCheckEliminator sce(this);
+  sce.Process();
+
+  if (FLAG_array_bounds_checks_hoisting) HoistBoundsChecksFromLoops();
+
+  if (FLAG_idefs) SetupInformativeDefinitions();
+  if (FLAG_array_bounds_checks_elimination && !FLAG_idefs) {
+    EliminateRedundantBoundsChecks();
+  }
+  if (FLAG_array_index_dehoisting) DehoistSimpleArrayIndexComputations();
+  if (FLAG_dead_code_elimination) DeadCodeElimination();
+
+  RestoreActualValues();
+
+  return true;
+}
+
+
+void HGraph::SetupInformativeDefinitionsInBlock(HBasicBlock* block) {
+  for (int phi_index = 0; phi_index < block->phis()->length(); phi_index++) {
+    HPhi* phi = block->phis()->at(phi_index);
+    phi->AddInformativeDefinitions();
+    phi->SetFlag(HValue::kIDefsProcessingDone);
+    // We do not support phis that "redefine just one operand".
+    ASSERT(!phi->IsInformativeDefinition());
+  }
+
+  for (HInstruction* i = block->first(); i != NULL; i = i->next()) {
+    i->AddInformativeDefinitions();
+    i->SetFlag(HValue::kIDefsProcessingDone);
+    i->UpdateRedefinedUsesWhileSettingUpInformativeDefinitions();
+  }
+}
+
+
+// This method is recursive, so if its stack frame is large it could
+// cause a stack overflow.
+// To keep the individual stack frames small we do the actual work inside
+// SetupInformativeDefinitionsInBlock();
+void HGraph::SetupInformativeDefinitionsRecursively(HBasicBlock* block) {
+  SetupInformativeDefinitionsInBlock(block);
+  for (int i = 0; i < block->dominated_blocks()->length(); ++i) {
+    SetupInformativeDefinitionsRecursively(block->dominated_blocks()->at(i));
+  }
+
+  for (HInstruction* i = block->first(); i != NULL; i = i->next()) {
+    if (i->IsBoundsCheck()) {
+      HBoundsCheck* check = HBoundsCheck::cast(i);
+      check->ApplyIndexChange();
+    }
+  }
+}
+
+
+void HGraph::SetupInformativeDefinitions() {
+  HPhase phase("H_Setup informative definitions", this);
+  SetupInformativeDefinitionsRecursively(entry_block());
+}
+
+
+// We try to "factor up" HBoundsCheck instructions towards the root of the
+// dominator tree.
+// For now we handle checks where the index is like "exp + int32value".
+// If in the dominator tree we check "exp + v1" and later (dominated)
+// "exp + v2", if v2 <= v1 we can safely remove the second check, and if
+// v2 > v1 we can use v2 in the 1st check and again remove the second.
+// To do so we keep a dictionary of all checks where the key if the pair
+// "exp, length".
+// The class BoundsCheckKey represents this key.
+class BoundsCheckKey : public ZoneObject {
+ public:
+  HValue* IndexBase() const { return index_base_; }
+  HValue* Length() const { return length_; }
+
+  uint32_t Hash() {
+    return static_cast<uint32_t>(index_base_->Hashcode() ^ length_->Hashcode());
+  }
+
+  static BoundsCheckKey* Create(Zone* zone,
+                                HBoundsCheck* check,
+                                int32_t* offset) {
+    if (!check->index()->representation().IsInteger32()) return NULL;
+
+    HValue* index_base = NULL;
+    HConstant* constant = NULL;
+    bool is_sub = false;
+
+    if (check->index()->IsAdd()) {
+      HAdd* index = HAdd::cast(check->index());
+      if (index->left()->IsConstant()) {
+        constant = HConstant::cast(index->left());
+        index_base = index->right();
+      } else if (index->right()->IsConstant()) {
+        constant = HConstant::cast(index->right());
+        index_base = index->left();
+      }
+    } else if (check->index()->IsSub()) {
+      HSub* index = HSub::cast(check->index());
+      is_sub = true;
+      if (index->left()->IsConstant()) {
+        constant = HConstant::cast(index->left());
+        index_base = index->right();
+      } else if (index->right()->IsConstant()) {
+        constant = HConstant::cast(index->right());
+        index_base = index->left();
+      }
+    }
+
+    if (constant != NULL && constant->HasInteger32Value()) {
+      *offset = is_sub ? - constant->Integer32Value()
+                       : constant->Integer32Value();
+    } else {
+      *offset = 0;
+      index_base = check->index();
+    }
+
+    return new(zone) BoundsCheckKey(index_base, check->length());
+  }
+
+ private:
+  BoundsCheckKey(HValue* index_base, HValue* length)
     : index_base_(index_base),
       length_(length) { }
 
-  HValue* index_base_;
-  HValue* length_;
-};
+  HValue* index_base_;
+  HValue* length_;
+};
+
+
+// Data about each HBoundsCheck that can be eliminated or moved.
+// It is the "value" in the dictionary indexed by "base-index, length"
+// (the key is BoundsCheckKey).
+// We scan the code with a dominator tree traversal.
+// Traversing the dominator tree we keep a stack (implemented as a singly
+// linked list) of "data" for each basic block that contains a relevant check
+// with the same key (the dictionary holds the head of the list).
+// We also keep all the "data" created for a given basic block in a list, and
+// use it to "clean up" the dictionary when backtracking in the dominator tree
+// traversal.
+// Doing this each dictionary entry always directly points to the check that
+// is dominating the code being examined now.
+// We also track the current "offset" of the index expression and use it to
+// decide if any check is already "covered" (so it can be removed) or not.
+class BoundsCheckBbData: public ZoneObject {
+ public:
+  BoundsCheckKey* Key() const { return key_; }
+  int32_t LowerOffset() const { return lower_offset_; }
+  int32_t UpperOffset() const { return upper_offset_; }
+  HBasicBlock* BasicBlock() const { return basic_block_; }
+  HBoundsCheck* LowerCheck() const { return lower_check_; }
+  HBoundsCheck* UpperCheck() const { return upper_check_; }
+  BoundsCheckBbData* NextInBasicBlock() const { return next_in_bb_; }
+  BoundsCheckBbData* FatherInDominatorTree() const { return father_in_dt_; }
+
+  bool OffsetIsCovered(int32_t offset) const {
+    return offset >= LowerOffset() && offset <= UpperOffset();
+  }
+
+  bool HasSingleCheck() { return lower_check_ == upper_check_; }
+
+  // The goal of this method is to modify either upper_offset_ or
+  // lower_offset_ so that also new_offset is covered (the covered
+  // range grows).
+  //
+  // The precondition is that new_check follows UpperCheck() and
+  // LowerCheck() in the same basic block, and that new_offset is not
+  // covered (otherwise we could simply remove new_check).
+  //
+  // If HasSingleCheck() is true then new_check is added as "second check"
+  // (either upper or lower; note that HasSingleCheck() becomes false).
+  // Otherwise one of the current checks is modified so that it also covers
+  // new_offset, and new_check is removed.
+  //
+  // If the check cannot be modified because the context is unknown it
+  // returns false, otherwise it returns true.
+  bool CoverCheck(HBoundsCheck* new_check,
+                  int32_t new_offset) {
+    ASSERT(new_check->index()->representation().IsInteger32());
+    bool keep_new_check = false;
+
+    if (new_offset > upper_offset_) {
+      upper_offset_ = new_offset;
+      if (HasSingleCheck()) {
+        keep_new_check = true;
+        upper_check_ = new_check;
+      } else {
+        bool result = BuildOffsetAdd(upper_check_,
+                                     &added_upper_index_,
+                                     &added_upper_offset_,
+                                     Key()->IndexBase(),
+                                     new_check->index()->representation(),
+                                     new_offset);
+        if (!result) return false;
+        upper_check_->ReplaceAllUsesWith(upper_check_->index());
+        upper_check_->SetOperandAt(0, added_upper_index_);
+      }
+    } else if (new_offset < lower_offset_) {
+      lower_offset_ = new_offset;
+      if (HasSingleCheck()) {
+        keep_new_check = true;
+        lower_check_ = new_check;
+      } else {
+        bool result = BuildOffsetAdd(lower_check_,
+                                     &added_lower_index_,
+                                     &added_lower_offset_,
+                                     Key()->IndexBase(),
+                                     new_check->index()->representation(),
+                                     new_offset);
+        if (!result) return false;
+        lower_check_->ReplaceAllUsesWith(lower_check_->index());
+        lower_check_->SetOperandAt(0, added_lower_index_);
+      }
+    } else {
+      ASSERT(false);
+    }
+
+    if (!keep_new_check) {
+      new_check->DeleteAndReplaceWith(new_check->ActualValue());
+    }
+
+    return true;
+  }
+
+  void RemoveZeroOperations() {
+    RemoveZeroAdd(&added_lower_index_, &added_lower_offset_);
+    RemoveZeroAdd(&added_upper_index_, &added_upper_offset_);
+  }
+
+  BoundsCheckBbData(BoundsCheckKey* key,
+                    int32_t lower_offset,
+                    int32_t upper_offset,
+                    HBasicBlock* bb,
+                    HBoundsCheck* lower_check,
+                    HBoundsCheck* upper_check,
+                    BoundsCheckBbData* next_in_bb,
+                    BoundsCheckBbData* father_in_dt)
+  : key_(key),
+    lower_offset_(lower_offset),
+    upper_offset_(upper_offset),
+    basic_block_(bb),
+    lower_check_(lower_check),
+    upper_check_(upper_check),
+    added_lower_index_(NULL),
+    added_lower_offset_(NULL),
+    added_upper_index_(NULL),
+    added_upper_offset_(NULL),
+    next_in_bb_(next_in_bb),
+    father_in_dt_(father_in_dt) { }
+
+ private:
+  BoundsCheckKey* key_;
+  int32_t lower_offset_;
+  int32_t upper_offset_;
+  HBasicBlock* basic_block_;
+  HBoundsCheck* lower_check_;
+  HBoundsCheck* upper_check_;
+  HInstruction* added_lower_index_;
+  HConstant* added_lower_offset_;
+  HInstruction* added_upper_index_;
+  HConstant* added_upper_offset_;
+  BoundsCheckBbData* next_in_bb_;
+  BoundsCheckBbData* father_in_dt_;
+
+  // Given an existing add instruction and a bounds check it tries to
+  // find the current context (either of the add or of the check index).
+  HValue* IndexContext(HInstruction* add, HBoundsCheck* check) {
+    if (add != NULL && add->IsAdd()) {
+      return HAdd::cast(add)->context();
+    }
+    if (check->index()->IsBinaryOperation()) {
+      return HBinaryOperation::cast(check->index())->context();
+    }
+    return NULL;
+  }
+
+  // This function returns false if it cannot build the add because the
+  // current context cannot be determined.
+  bool BuildOffsetAdd(HBoundsCheck* check,
+                      HInstruction** add,
+                      HConstant** constant,
+                      HValue* original_value,
+                      Representation representation,
+                      int32_t new_offset) {
+    HValue* index_context = IndexContext(*add, check);
+    if (index_context == NULL) return false;
+
+    HConstant* new_constant = new(BasicBlock()->zone())
+       HConstant(new_offset, Representation::Integer32());
+    if (*add == NULL) {
+      new_constant->InsertBefore(check);
+      (*add) = HAdd::New(
+          BasicBlock()->zone(), index_context, original_value, new_constant);
+      (*add)->AssumeRepresentation(representation);
+      (*add)->InsertBefore(check);
+    } else {
+      new_constant->InsertBefore(*add);
+      (*constant)->DeleteAndReplaceWith(new_constant);
+    }
+    *constant = new_constant;
+    return true;
+  }
+
+  void RemoveZeroAdd(HInstruction** add, HConstant** constant) {
+    if (*add != NULL && (*add)->IsAdd() && (*constant)->Integer32Value() == 0) {
+      (*add)->DeleteAndReplaceWith(HAdd::cast(*add)->left());
+      (*constant)->DeleteAndReplaceWith(NULL);
+    }
+  }
+};
+
+
+static bool BoundsCheckKeyMatch(void* key1, void* key2) {
+  BoundsCheckKey* k1 = static_cast<BoundsCheckKey*>(key1);
+  BoundsCheckKey* k2 = static_cast<BoundsCheckKey*>(key2);
+  return k1->IndexBase() == k2->IndexBase() && k1->Length() == k2->Length();
+}
+
+
+class BoundsCheckTable : private ZoneHashMap {
+ public:
+  BoundsCheckBbData** LookupOrInsert(BoundsCheckKey* key, Zone* zone) {
+    return reinterpret_cast<BoundsCheckBbData**>(
+        &(Lookup(key, key->Hash(), true, ZoneAllocationPolicy(zone))->value));
+  }
+
+  void Insert(BoundsCheckKey* key, BoundsCheckBbData* data, Zone* zone) {
+    Lookup(key, key->Hash(), true, ZoneAllocationPolicy(zone))->value = data;
+  }
+
+  void Delete(BoundsCheckKey* key) {
+    Remove(key, key->Hash());
+  }
+
+  explicit BoundsCheckTable(Zone* zone)
+      : ZoneHashMap(BoundsCheckKeyMatch, ZoneHashMap::kDefaultHashMapCapacity,
+                    ZoneAllocationPolicy(zone)) { }
+};
+
+
+// Eliminates checks in bb and recursively in the dominated blocks.
+// Also replace the results of check instructions with the original value, if
+// the result is used. This is safe now, since we don't do code motion after
+// this point. It enables better register allocation since the value produced
+// by check instructions is really a copy of the original value.
+void HGraph::EliminateRedundantBoundsChecks(HBasicBlock* bb,
+                                            BoundsCheckTable* table) {
+  BoundsCheckBbData* bb_data_list = NULL;
+
+  for (HInstruction* i = bb->first(); i != NULL; i = i->next()) {
+    if (!i->IsBoundsCheck()) continue;
+
+    HBoundsCheck* check = HBoundsCheck::cast(i);
+    int32_t offset;
+    BoundsCheckKey* key =
+        BoundsCheckKey::Create(zone(), check, &offset);
+    if (key == NULL) continue;
+    BoundsCheckBbData** data_p = table->LookupOrInsert(key, zone());
+    BoundsCheckBbData* data = *data_p;
+    if (data == NULL) {
+      bb_data_list = new(zone()) BoundsCheckBbData(key,
+                                                   offset,
+                                                   offset,
+                                                   bb,
+                                                   check,
+                                                   check,
+                                                   bb_data_list,
+                                                   NULL);
+      *data_p = bb_data_list;
+    } else if (data->OffsetIsCovered(offset)) {
+      check->DeleteAndReplaceWith(check->ActualValue());
+    } else if (data->BasicBlock() != bb ||
+               !data->CoverCheck(check, offset)) {
+      // If the check is in the current BB we try to modify it by calling
+      // "CoverCheck", but if also that fails we record the current offsets
+      // in a new data instance because from now on they are covered.
+      int32_t new_lower_offset = offset < data->LowerOffset()
+          ? offset
+          : data->LowerOffset();
+      int32_t new_upper_offset = offset > data->UpperOffset()
+          ? offset
+          : data->UpperOffset();
+      bb_data_list = new(zone()) BoundsCheckBbData(key,
+                                                   new_lower_offset,
+                                                   new_upper_offset,
+                                                   bb,
+                                                   data->LowerCheck(),
+                                                   data->UpperCheck(),
+                                                   bb_data_list,
+                                                   data);
+      table->Insert(key, bb_data_list, zone());
+    }
+  }
+
+  for (int i = 0; i < bb->dominated_blocks()->length(); ++i) {
+    EliminateRedundantBoundsChecks(bb->dominated_blocks()->at(i), table);
+  }
+
+  for (BoundsCheckBbData* data = bb_data_list;
+       data != NULL;
+       data = data->NextInBasicBlock()) {
+    data->RemoveZeroOperations();
+    if (data->FatherInDominatorTree()) {
+      table->Insert(data->Key(), data->FatherInDominatorTree(), zone());
+    } else {
+      table->Delete(data->Key());
+    }
+  }
+}
+
+
+void HGraph::EliminateRedundantBoundsChecks() {
+  HPhase phase("H_Eliminate bounds checks", this);
+  BoundsCheckTable checks_table(zone());
+  EliminateRedundantBoundsChecks(entry_block(), &checks_table);
+}
+
+
+// Bounds check hoisting.
+//
+// A basic induction variable is a loop header phi that enters the loop with
+// some initial value and is changed by a constant step on every iteration.
+// If the loop is controlled by comparing it against a loop invariant limit
+// at the loop header, the range of values it takes in the loop body is known
+// before the loop is entered.  A bounds check in the loop body on the
+// induction variable plus a constant, against a loop invariant length, is
+// then replaced by checks of both ends of that range in the pre-header,
+// which deoptimize before the loop is entered.  The hoisted checks test the
+// first index and the end of the index range (one past the last index)
+// against length + 1, so that they also pass for common loops that are not
+// entered at all, such as a loop over an empty array.
+
+
+// Returns true if the given block belongs to the loop with the given header,
+// including its nested loops.
+static bool IsInLoop(HBasicBlock* block, HBasicBlock* header) {
+  for (HBasicBlock* current = block;
+       current != NULL;
+       current = current->parent_loop_header()) {
+    if (current == header) return true;
+  }
+  return false;
+}
+
+
+// Values defined before the loop header are available in the pre-header.
+static bool IsLoopInvariant(HValue* value, HBasicBlock* header) {
+  return value->block()->block_id() < header->block_id();
+}
+
+
+// Returns true if control can leave the loop other than through the loop
+// condition at its header.  A check hoisted out of such a loop could fail
+// even though the loop always exits before reaching the failing index.
+static bool HasEarlyExit(HGraph* graph,
+                         HBasicBlock* header,
+                         HBasicBlock* body) {
+  const ZoneList<HBasicBlock*>* blocks = graph->blocks();
+  for (int i = header->block_id() + 1; i < blocks->length(); i++) {
+    HBasicBlock* block = blocks->at(i);
+    if (block->IsDeoptimizing()) continue;
+    if (!IsInLoop(block, header)) {
+      if (body->Dominates(block)) return true;
+      continue;
+    }
+    for (HSuccessorIterator it(block->end()); !it.Done(); it.Advance()) {
+      HBasicBlock* successor = it.Current();
+      if (!IsInLoop(successor, header) && !successor->IsDeoptimizing()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+
+// Returns true if |next| is |phi| plus a non-zero constant step that cannot
+// silently wrap around.
+static bool IsInductionStep(HPhi* phi, HValue* next, int32_t* step) {
+  if (!next->representation().IsInteger32()) return false;
+  if (!next->IsAdd() && !next->IsSub()) return false;
+  DecompositionResult decomposition;
+  if (!next->TryDecompose(&decomposition) ||
+      decomposition.base() != phi ||
+      decomposition.scale() != 0 ||
+      decomposition.offset() == 0) {
+    return false;
+  }
+  // The increment either deoptimizes on overflow, or range analysis has
+  // proven that it cannot overflow.
+  if (!next->CheckFlag(HValue::kCanOverflow) &&
+      next->CheckUsesForFlag(HValue::kTruncatingToInt32)) {
+    return false;
+  }
+  *step = decomposition.offset();
+  return true;
+}
+
+
+// Returns true if |index| is |phi| plus an integer constant.
+static bool IsInductionOffset(HPhi* phi, HValue* index, int32_t* offset) {
+  if (index == phi) {
+    *offset = 0;
+    return true;
+  }
+  if (!index->representation().IsInteger32()) return false;
+  DecompositionResult decomposition;
+  if (!index->TryDecompose(&decomposition) ||
+      decomposition.base() != phi ||
+      decomposition.scale() != 0) {
+    return false;
+  }
+  *offset = decomposition.offset();
+  return true;
+}
+
+
+// Emits |value| + |offset| at the end of the given block.
+static HValue* AddConstantAtEnd(HGraph* graph,
+                                HBasicBlock* block,
+                                HValue* value,
+                                int32_t offset) {
+  if (offset == 0) return value;
+  Zone* zone = graph->zone();
+  HConstant* constant =
+      new(zone) HConstant(offset, Representation::Integer32());
+  constant->InsertBefore(block->end());
+  HInstruction* add =
+      HAdd::New(zone, graph->GetInvalidContext(), value, constant);
+  add->InsertBefore(block->end());
+  add->AssumeRepresentation(Representation::Integer32());
+  return add;
+}
+
+
+// Sums two offsets, failing if the result does not fit in an int32.
+static bool AddOffsets(int32_t a, int32_t b, int32_t* result) {
+  int64_t sum = static_cast<int64_t>(a) + b;
+  if (sum < kMinInt || sum > kMaxInt) return false;
+  *result = static_cast<int32_t>(sum);
+  return true;
+}
+
+
+// A check that has been hoisted to the pre-header: the range of the
+// induction variable plus |offset| is known to be within |length|.
+struct HoistedBoundsCheck {
+  HValue* length;
+  int32_t offset;
+};
+
+
+void HGraph::HoistBoundsChecksFromLoop(HBasicBlock* header) {
+  // Only loops with a single entry and a single back edge are handled, which
+  // excludes OSR entries.
+  const ZoneList<HBasicBlock*>* predecessors = header->predecessors();
+  if (predecessors->length() != 2) return;
+  int entry_index =
+      (predecessors->at(0)->block_id() < header->block_id()) ? 0 : 1;
+  HBasicBlock* pre_header = predecessors->at(entry_index);
+  HBasicBlock* back_edge = predecessors->at(1 - entry_index);
+  if (pre_header->block_id() >= header->block_id() ||
+      back_edge->block_id() < header->block_id() ||
+      pre_header->end()->SuccessorCount() != 1) {
+    return;
+  }
+
+  // The loop condition must be tested at the header, so that it holds for
+  // the current value of the induction variable everywhere in the body.
+  if (!header->end()->IsCompareIDAndBranch()) return;
+  HCompareIDAndBranch* compare = HCompareIDAndBranch::cast(header->end());
+  if (!compare->representation().IsInteger32()) return;
+  HBasicBlock* body = compare->SuccessorAt(0);
+  HBasicBlock* exit = compare->SuccessorAt(1);
+  Token::Value token = compare->token();
+  if (!IsInLoop(body, header)) {
+    HBasicBlock* swap = body;
+    body = exit;
+    exit = swap;
+    token = Token::NegateCompareOp(token);
+  }
+  if (!IsInLoop(body, header) || IsInLoop(exit, header)) return;
+  if (HasEarlyExit(this, header, body)) return;
+
+  for (int i = 0; i < header->phis()->length(); i++) {
+    HPhi* phi = header->phis()->at(i);
+    if (!phi->representation().IsInteger32()) continue;
+    int32_t step;
+    if (!IsInductionStep(phi, phi->OperandAt(1 - entry_index), &step)) {
+      continue;
+    }
+
+    HValue* limit;
+    Token::Value op;
+    if (compare->left() == phi && IsLoopInvariant(compare->right(), header)) {
+      limit = compare->right();
+      op = token;
+    } else if (compare->right() == phi &&
+               IsLoopInvariant(compare->left(), header)) {
+      limit = compare->left();
+      op = Token::ReverseCompareOp(token);
+    } else {
+      continue;
+    }
+
+    // In the body the phi lies in [lower + lower_offset,
+    // upper + upper_offset].  One end is its initial value, the other one
+    // comes from the loop condition.
+    HValue* lower;
+    HValue* upper;
+    int32_t lower_offset = 0;
+    int32_t upper_offset = 0;
+    if (step > 0) {
+      lower = phi->OperandAt(entry_index);
+      upper = limit;
+      if (op == Token::LT) {
+        upper_offset = -1;
+      } else if (op != Token::LTE) {
+        continue;
+      }
+    } else {
+      upper = phi->OperandAt(entry_index);
+      lower = limit;
+      if (op == Token::GT) {
+        lower_offset = 1;
+      } else if (op != Token::GTE) {
+        continue;
+      }
+    }
+
+    ZoneList<HoistedBoundsCheck> hoisted(4, zone());
+
+    for (int j = body->block_id(); j <= back_edge->block_id(); j++) {
+      HBasicBlock* block = blocks()->at(j);
+      // Only checks performed on every iteration are hoisted, so that the
+      // hoisted checks do not fail where the original ones would not have
+      // been reached.
+      if ((block != body && !body->Dominates(block)) ||
+          (block != back_edge && !block->Dominates(back_edge))) {
+        continue;
+      }
+      HInstruction* instr = block->first();
+      while (instr != NULL) {
+        HInstruction* next = instr->next();
+        int32_t offset;
+        int32_t first;
+        int32_t end;
+        if (instr->IsBoundsCheck() &&
+            instr->representation().IsInteger32() &&
+            IsLoopInvariant(HBoundsCheck::cast(instr)->length(), header) &&
+            IsInductionOffset(phi, HBoundsCheck::cast(instr)->index(),
+                              &offset) &&
+            AddOffsets(lower_offset, offset, &first) &&
+            AddOffsets(upper_offset, offset, &end) &&
+            AddOffsets(end, 1, &end)) {
+          HBoundsCheck* check = HBoundsCheck::cast(instr);
+          bool already_hoisted = false;
+          for (int k = 0; k < hoisted.length(); k++) {
+            if (hoisted[k].length == check->length() &&
+                hoisted[k].offset == offset) {
+              already_hoisted = true;
+            }
+          }
+          if (!already_hoisted) {
+            HValue* values[] = {
+              AddConstantAtEnd(this, pre_header, lower, first),
+              AddConstantAtEnd(this, pre_header, upper, end)
+            };
+            HValue* length =
+                AddConstantAtEnd(this, pre_header, check->length(), 1);
+            for (int k = 0; k < 2; k++) {
+              HBoundsCheck* hoisted_check = new(zone()) HBoundsCheck(
+                  values[k], length, DONT_ALLOW_SMI_KEY,
+                  Representation::Integer32());
+              hoisted_check->InsertBefore(pre_header->end());
+            }
+            HoistedBoundsCheck entry = { check->length(), offset };
+            hoisted.Add(entry, zone());
+          }
+          if (FLAG_trace_bounds_checks_hoisting) {
+            PrintF("[bounds checks hoisting: hoisting check %d out of the "
+                   "loop at B%d]\n", check->id(), header->block_id());
+          }
+          check->DeleteAndReplaceWith(check->index());
+        }
+        instr = next;
+      }
+    }
+  }
+}
+
+
+void HGraph::HoistBoundsChecksFromLoops() {
+  HPhase phase("H_Hoist bounds checks", this);
+  for (int i = 0; i < blocks()->length(); ++i) {
+    HBasicBlock* block = blocks()->at(i);
+    if (block->IsLoopHeader()) HoistBoundsChecksFromLoop(block);
+  }
+}
+
+
+static void DehoistArrayIndex(ArrayInstructionInterface* array_operation) {
+  HValue* index = array_operation->GetKey()->ActualValue();
+  if (!index->representation().IsInteger32()) return;
+
+  HConstant* constant;
+  HValue* subexpression;
+  int32_t sign;
+  if (index->IsAdd()) {
+    sign = 1;
+    HAdd* add = HAdd::cast(index);
+    if (add->left()->IsConstant()) {
+      subexpression = add->right();
+      constant = HConstant::cast(add->left());
+    } else if (add->right()->IsConstant()) {
+      subexpression = add->left();
+      constant = HConstant::cast(add->right());
+    } else {
+      return;
+    }
+  } else if (index->IsSub()) {
+    sign = -1;
+    HSub* sub = HSub::cast(index);
+    if (sub->left()->IsConstant()) {
+      subexpression = sub->right();
+      constant = HConstant::cast(sub->left());
+    } else if (sub->right()->IsConstant()) {
+      subexpression = sub->left();
+      constant = HConstant::cast(sub->right());
+    } return;
+  } else {
+    return;
+  }
+
+  if (!constant->HasInteger32Value()) return;
+  int32_t value = constant->Integer32Value() * sign;
+  // We limit offset values to 24 bits because that is what HLoadKeyed has
+  // room for, and because we want to avoid the risk of overflows when the
+  // offset is added to the object header size.
+  if (value >= 1 << 24 || value < 0) return;
+  array_operation->SetKey(subexpression);
+  if (index->HasNoUses()) {
+    index->DeleteAndReplaceWith(NULL);
+  }
+  ASSERT(value >= 0);
+  array_operation->SetIndexOffset(static_cast<uint32_t>(value));
+  array_operation->SetDehoisted(true);
+}
+
+
+void HGraph::DehoistSimpleArrayIndexComputations() {
+  HPhase phase("H_Dehoist index computations", this);
+  for (int i = 0; i < blocks()->length(); ++i) {
+    for (HInstruction* instr = blocks()->at(i)->first();
+        instr != NULL;
+        instr = instr->next()) {
+      ArrayInstructionInterface* array_instruction = NULL;
+      if (instr->IsLoadKeyed()) {
+        HLoadKeyed* op = HLoadKeyed::cast(instr);
+        array_instruction = static_cast<ArrayInstructionInterface*>(op);
+      } else if (instr->IsStoreKeyed()) {
+        HStoreKeyed* op = HStoreKeyed::cast(instr);
+        array_instruction = static_cast<ArrayInstructionInterface*>(op);
+      } else {
+        continue;
+      }
+      DehoistArrayIndex(array_instruction);
+    }
+  }
+}
+
+
+void HGraph::DeadCodeElimination() {
+  HPhase phase("H_Dead code elimination", this);
+  ZoneList<HInstruction*> worklist(blocks_.length(), zone());
+  for (int i = 0; i < blocks()->length(); ++i) {
+    for (HInstruction* instr = blocks()->at(i)->first();
+         instr != NULL;
+         instr = instr->next()) {
+      if (instr->IsDead()) worklist.Add(instr, zone());
+    }
+  }
+
+  while (!worklist.is_empty()) {
+    HInstruction* instr = worklist.RemoveLast();
+    // This happens when an instruction is used multiple times as operand. That
+    // in turn could happen through GVN.
+    if (!instr->IsLinked()) continue;
+    if (FLAG_trace_dead_code_elimination) {
+      HeapStringAllocator allocator;
+      StringStream stream(&allocator);
+      instr->PrintNameTo(&stream);
+      stream.Add(" = ");
+      instr->PrintTo(&stream);
+      PrintF("[removing dead instruction %s]\n", *stream.ToCString());
+    }
+    instr->DeleteAndReplaceWith(NULL);
+    for (int i = 0; i < instr->OperandCount(); ++i) {
+      HValue* operand = instr->OperandAt(i);
+      if (operand->IsDead()) worklist.Add(HInstruction::cast(operand), zone());
+    }
+  }
+}
+
+
+void HGraph::RestoreActualValues() {
+  HPhase phase("H_Restore actual values", this);
+
+  for (int block_index = 0; block_index < blocks()->length(); block_index++) {
+    HBasicBlock* block = blocks()->at(block_index);
+
+#ifdef DEBUG
+    for (int i = 0; i < block->phis()->length(); i++) {
+      HPhi* phi = block->phis()->at(i);
+      ASSERT(phi->ActualValue() == phi);
+    }
+#endif
+
+    for (HInstruction* instruction = block->first();
+        instruction != NULL;
+        instruction = instruction->next()) {
+      if (instruction->ActualValue() != instruction) {
+        ASSERT(instruction->IsInformativeDefinition());
+        if (instruction->IsPurelyInformativeDefinition()) {
+          instruction->DeleteAndReplaceWith(instruction->RedefinedOperand());
+        } else {
+          instruction->ReplaceAllUsesWith(instruction->ActualValue());
+        }
+      }
+    }
+  }
+}
+
+
+void HOptimizedGraphBuilder::AddPhi(HPhi* instr) {
+  ASSERT(current_block() != NULL);
+  current_block()->AddPhi(instr);
+}
+
+
+void HOptimizedGraphBuilder::PushAndAdd(HInstruction* instr) {
+  Push(instr);
+  AddInstruction(instr);
+}
+
+
+void HOptimizedGraphBuilder::AddSoftDeoptimize() {
+  if (FLAG_always_opt) return;
+  if (current_block()->IsDeoptimizing()) return;
+  AddInstruction(new(zone()) HSoftDeoptimize());
+  current_block()->MarkAsDeoptimizing();
+  graph()->set_has_soft_deoptimize(true);
+}
+
+
+template <class Instruction>
+HInstruction* HOptimizedGraphBuilder::PreProcessCall(Instruction* call) {
+  int count = call->argument_count();
+  ZoneList<HValue*> arguments(count, zone());
+  for (int i = 0; i < count; ++i) {
+    arguments.Add(Pop(), zone());
+  }
+
+  while (!arguments.is_empty()) {
+    AddInstruction(new(zone()) HPushArgument(arguments.RemoveLast()));
+  }
+  return call;
+}
+
+
+void HOptimizedGraphBuilder::SetUpScope(Scope* scope) {
+  HConstant* undefined_constant = new(zone()) HConstant(
+      isolate()->factory()->undefined_value(), Representation::Tagged());
+  AddInstruction(undefined_constant);
+  graph()->set_undefined_constant(undefined_constant);
+
+  HArgumentsObject* object = new(zone()) HArgumentsObject;
+  AddInstruction(object);
+  graph()->SetArgumentsObject(object);
+
+  // Set the initial values of parameters including "this".  "This" has
+  // parameter index 0.
+  ASSERT_EQ(scope->num_parameters() + 1, environment()->parameter_count());
+
+  for (int i = 0; i < environment()->parameter_count(); ++i) {
+    HInstruction* parameter = AddInstruction(new(zone()) HParameter(i));
+    environment()->Bind(i, parameter);
+  }
+
+  // First special is HContext.
+  HInstruction* context = AddInstruction(new(zone()) HContext);
+  environment()->BindContext(context);
+
+  // Initialize specials and locals to undefined.
+  for (int i = environment()->parameter_count() + 1;
+       i < environment()->length();
+       ++i) {
+    environment()->Bind(i, undefined_constant);
+  }
+
+  // Handle the arguments and arguments shadow variables specially (they do
+  // not have declarations).
+  if (scope->arguments() != NULL) {
+    if (!scope->arguments()->IsStackAllocated()) {
+      return Bailout("context-allocated arguments");
+    }
+
+    environment()->Bind(scope->arguments(),
+                        graph()->GetArgumentsObject());
+  }
+}
+
+
+void HOptimizedGraphBuilder::VisitStatements(ZoneList<Statement*>* statements) {
+  for (int i = 0; i < statements->length(); i++) {
+    CHECK_ALIVE(Visit(statements->at(i)));
+  }
+}
+
+
+void HOptimizedGraphBuilder::Bind(Variable* var, HValue* value) {
+  HTryRegion* region = graph()->try_region();
+  if (region != NULL &&
+      region->HandlerRegion() != NULL &&
+      function_state()->outer() == NULL) {
+    // Every enclosing landing pad picks the variable up from its try slot.
+    int slot = graph()->GetTrySlot(environment()->IndexFor(var));
+    for (HTryRegion* current = region->HandlerRegion();
+         current != NULL;
+         current = current->outer()) {
+      if (current->kind() == HTryRegion::TRY_BLOCK) {
+        current->AddAssignedSlot(slot, zone());
+      }
+    }
+    AddInstruction(new(zone()) HStoreTrySlot(slot, value));
+  }
+  environment()->Bind(var, value);
+}
+
+
+void HOptimizedGraphBuilder::VisitBlock(Block* stmt) {
+  ASSERT(!HasStackOverflow());
+  ASSERT(current_block() != NULL);
+  ASSERT(current_block()->HasPredecessor());
+  if (stmt->scope() != NULL) {
+    return Bailout("ScopedBlock");
+  }
+  BreakAndContinueInfo break_info(stmt);
+  { BreakAndContinueScope push(&break_info, this);
+    CHECK_BAILOUT(VisitStatements(stmt->statements()));
+  }
+  HBasicBlock* break_block = break_info.break_block();
+  if (break_block != NULL) {
+    if (current_block() != NULL) current_block()->Goto(break_block);
+    break_block->SetJoinId(stmt->ExitId());
+    set_current_block(break_block);
+  }
+}
+
+
+void HOptimizedGraphBuilder::VisitExpressionStatement(
+    ExpressionStatement* stmt) {
+  ASSERT(!HasStackOverflow());
+  ASSERT(current_block() != NULL);
+  ASSERT(current_block()->HasPredecessor());
+  VisitForEffect(stmt->expression());
+}
+
+
+void HOptimizedGraphBuilder::VisitEmptyStatement(EmptyStatement* stmt) {
+  ASSERT(!HasStackOverflow());
+  ASSERT(current_block() != NULL);
+  ASSERT(current_block()->HasPredecessor());
+}
+
+
+void HOptimizedGraphBuilder::VisitIfStatement(IfStatement* stmt) {
+  ASSERT(!HasStackOverflow());
+  ASSERT(current_block() != NULL);
+  ASSERT(current_block()->HasPredecessor());
+  if (stmt->condition()->ToBooleanIsTrue()) {
+    AddSimulate(stmt->ThenId());
+    Visit(stmt->then_statement());
+  } else if (stmt->condition()->ToBooleanIsFalse()) {
+    AddSimulate(stmt->ElseId());
+    Visit(stmt->else_statement());
+  } else {
+    HBasicBlock* cond_true = graph()->CreateBasicBlock();
+    HBasicBlock* cond_false = graph()->CreateBasicBlock();
+    CHECK_BAILOUT(VisitForControl(stmt->condition(), cond_true, cond_false));
+
+    if (cond_true->HasPredecessor()) {
+      cond_true->SetJoinId(stmt->ThenId());
+      set_current_block(cond_true);
+      CHECK_BAILOUT(Visit(stmt->then_statement()));
+      cond_true = current_block();
+    } else {
+      cond_true = NULL;
+    }
+
+    if (cond_false->HasPredecessor()) {
+      cond_false->SetJoinId(stmt->ElseId());
+      set_current_block(cond_false);
+      CHECK_BAILOUT(Visit(stmt->else_statement()));
+      cond_false = current_block();
+    } else {
+      cond_false = NULL;
+    }
+
+    HBasicBlock* join = CreateJoin(cond_true, cond_false, stmt->IfId());
+    set_current_block(join);
+  }
+}
+
+
+HBasicBlock* HOptimizedGraphBuilder::BreakAndContinueScope::Get(
+    BreakableStatement* stmt,
+    BreakType type,
+    int* drop_extra) {
+  *drop_extra = 0;
+  BreakAndContinueScope* current = this;
+  while (current != NULL && current->info()->target() != stmt) {
+    *drop_extra += current->info()->drop_extra();
+    current = current->next();
+  }
+  ASSERT(current != NULL);  // Always found (unless stack is malformed).
+
+  if (type == BREAK) {
+    *drop_extra += current->info()->drop_extra();
+  }
+
+  HBasicBlock* block = NULL;
+  switch (type) {
+    case BREAK:
+      block = current->info()->break_block();
+      if (block == NULL) {
+        block = current->owner()->graph()->CreateBasicBlock();
+        block->set_try_region(current->try_region());
+        current->info()->set_break_block(block);
+      }
+      break;
+
+    case CONTINUE:
+      block = current->info()->continue_block();
+      if (block == NULL) {
+        block = current->owner()->graph()->CreateBasicBlock();
+        block->set_try_region(current->try_region());
+        current->info()->set_continue_block(block);
+      }
+      break;
+  }
+
+  return block;
+}
+
+
+void HOptimizedGraphBuilder::VisitContinueStatement(
+    ContinueStatement* stmt) {
+  ASSERT(!HasStackOverflow());
+  ASSERT(current_block() != NULL);
+  ASSERT(current_block()->HasPredecessor());
+  int drop_extra = 0;
+  HBasicBlock* continue_block = break_scope()->Get(stmt->target(),
+                                                   CONTINUE,
+                                                   &drop_extra);
+  if (!LeaveTryRegions(continue_block->try_region())) return;
+  Drop(drop_extra);
+  current_block()->Goto(continue_block);
+  set_current_block(NULL);
+}
+
+
+void HOptimizedGraphBuilder::VisitBreakStatement(BreakStatement* stmt) {
+  ASSERT(!HasStackOverflow());
+  ASSERT(current_block() != NULL);
+  ASSERT(current_block()->HasPredecessor());
+  int drop_extra = 0;
+  HBasicBlock* break_block = break_scope()->Get(stmt->target(),
+                                                BREAK,
+                                                &drop_extra);
+  if (!LeaveTryRegions(break_block->try_region())) return;
+  Drop(drop_extra);
+  current_block()->Goto(break_block);
+  set_current_block(NULL);
+}
+
+
+void HOptimizedGraphBuilder::VisitReturnStatement(ReturnStatement* stmt) {
+  ASSERT(!HasStackOverflow());
+  ASSERT(current_block() != NULL);
+  ASSERT(current_block()->HasPredecessor());
+  FunctionState* state = function_state();
+  AstContext* context = call_context();
+  if (context == NULL) {
+    // Not an inlined return, so an actual one.
+    CHECK_ALIVE(VisitForValue(stmt->expression()));
+    if (!LeaveTryRegions(NULL)) return;
+    HValue* result = environment()->Pop();
+    AddReturn(result);
+  } else if (state->inlining_kind() == CONSTRUCT_CALL_RETURN) {
+    // Return from an inlined construct call. In a test context the return value
+    // will always evaluate to true, in a value context the return value needs
+    // to be a JSObject.
+    if (context->IsTest()) {
+      TestContext* test = TestContext::cast(context);
+      CHECK_ALIVE(VisitForEffect(stmt->expression()));
+      current_block()->Goto(test->if_true(), state);
+    } else if (context->IsEffect()) {
+      CHECK_ALIVE(VisitForEffect(stmt->expression()));
+      current_block()->Goto(function_return(), state);
+    } else {
+      ASSERT(context->IsValue());
+      CHECK_ALIVE(VisitForValue(stmt->expression()));
+      HValue* return_value = Pop();
+      HValue* receiver = environment()->arguments_environment()->Lookup(0);
+      HHasInstanceTypeAndBranch* typecheck =
+          new(zone()) HHasInstanceTypeAndBranch(return_value,
+                                                FIRST_SPEC_OBJECT_TYPE,
+                                                LAST_SPEC_OBJECT_TYPE);
+      HBasicBlock* if_spec_object = graph()->CreateBasicBlock();
+      HBasicBlock* not_spec_object = graph()->CreateBasicBlock();
+      typecheck->SetSuccessorAt(0, if_spec_object);
+      typecheck->SetSuccessorAt(1, not_spec_object);
+      current_block()->Finish(typecheck);
+      if_spec_object->AddLeaveInlined(return_value, state);
+      not_spec_object->AddLeaveInlined(receiver, state);
+    }
+  } else if (state->inlining_kind() == SETTER_CALL_RETURN) {
+    // Return from an inlined setter call. The returned value is never used, the
+    // value of an assignment is always the value of the RHS of the assignment.
+    CHECK_ALIVE(VisitForEffect(stmt->expression()));
+    if (context->IsTest()) {
+      HValue* rhs = environment()->arguments_environment()->Lookup(1);
+      context->ReturnValue(rhs);
+    } else if (context->IsEffect()) {
+      current_block()->Goto(function_return(), state);
+    } else {
+      ASSERT(context->IsValue());
+      HValue* rhs = environment()->arguments_environment()->Lookup(1);
+      current_block()->AddLeaveInlined(rhs, state);
+    }
+  } else {
+    // Return from a normal inlined function. Visit the subexpression in the
+    // expression context of the call.
+    if (context->IsTest()) {
+      TestContext* test = TestContext::cast(context);
+      VisitForControl(stmt->expression(), test->if_true(), test->if_false());
+    } else if (context->IsEffect()) {
+      CHECK_ALIVE(VisitForEffect(stmt->expression()));
+      current_block()->Goto(function_return(), state);
+    } else {
+      ASSERT(context->IsValue());
+      CHECK_ALIVE(VisitForValue(stmt->expression()));
+      current_block()->AddLeaveInlined(Pop(), state);
+    }
+  }
+  set_current_block(NULL);
+}
+
+
+void HOptimizedGraphBuilder::VisitWithStatement(WithStatement* stmt) {
+  ASSERT(!HasStackOverflow());
+  ASSERT(current_block() != NULL);
+  ASSERT(current_block()->HasPredecessor());
+  return Bailout("WithStatement");
+}
+
 
+int HOptimizedGraphBuilder::CompareSwitchCases(const SwitchCase* a,
+                                               const SwitchCase* b) {
+  if (a->value != b->value) return a->value < b->value ? -1 : 1;
+  return a->clause_index - b->clause_index;
+}
 
-// Data about each HBoundsCheck that can be eliminated or moved.
-// It is the "value" in the dictionary indexed by "base-index, length"
-// (the key is BoundsCheckKey).
-// We scan the code with a dominator tree traversal.
-// Traversing the dominator tree we keep a stack (implemented as a singly
-// linked list) of "data" for each basic block that contains a relevant check
-// with the same key (the dictionary holds the head of the list).
-// We also keep all the "data" created for a given basic block in a list, and
-// use it to "clean up" the dictionary when backtracking in the dominator tree
-// traversal.
-// Doing this each dictionary entry always directly points to the check that
-// is dominating the code being examined now.
-// We also track the current "offset" of the index expression and use it to
-// decide if any check is already "covered" (so it can be removed) or not.
-class BoundsCheckBbData: public ZoneObject {
- public:
-  BoundsCheckKey* Key() const { return key_; }
-  int32_t LowerOffset() const { return lower_offset_; }
-  int32_t UpperOffset() const { return upper_offset_; }
-  HBasicBlock* BasicBlock() const { return basic_block_; }
-  HBoundsCheck* LowerCheck() const { return lower_check_; }
-  HBoundsCheck* UpperCheck() const { return upper_check_; }
-  BoundsCheckBbData* NextInBasicBlock() const { return next_in_bb_; }
-  BoundsCheckBbData* FatherInDominatorTree() const { return father_in_dt_; }
 
-  bool OffsetIsCovered(int32_t offset) const {
-    return offset >= LowerOffset() && offset <= UpperOffset();
+void HOptimizedGraphBuilder::GotoSwitchMiss(HBasicBlock** miss) {
+  if (*miss == NULL) *miss = graph()->CreateBasicBlock();
+  current_block()->Goto(*miss);
+  set_current_block(NULL);
+}
+
+
+void HOptimizedGraphBuilder::BuildSmiSwitchDispatch(
+    HValue* tag,
+    const ZoneList<SwitchCase>* cases,
+    int from,
+    int to,
+    ZoneList<HBasicBlock*>* targets,
+    HBasicBlock** miss) {
+  int count = to - from;
+  if (count <= kMaxSwitchLinearSearch) {
+    for (int i = from; i < to; ++i) {
+      HConstant* label = new(zone()) HConstant(cases->at(i).value,
+                                               Representation::Integer32());
+      AddInstruction(label);
+      HBasicBlock* match_block = graph()->CreateBasicBlock();
+      HBasicBlock* next_block = graph()->CreateBasicBlock();
+      HCompareIDAndBranch* compare =
+          new(zone()) HCompareIDAndBranch(tag, label, Token::EQ_STRICT);
+      compare->set_observed_input_representation(
+          Representation::Integer32(), Representation::Integer32());
+      compare->SetSuccessorAt(0, match_block);
+      compare->SetSuccessorAt(1, next_block);
+      current_block()->Finish(compare);
+      targets->Set(cases->at(i).clause_index, match_block);
+      set_current_block(next_block);
+    }
+    GotoSwitchMiss(miss);
+    return;
   }
 
-  bool HasSingleCheck() { return lower_check_ == upper_check_; }
+  int min_value = cases->at(from).value;
+  int max_value = cases->at(to - 1).value;
+  // The difference of two Smis may not fit in an int.
+  double range = static_cast<double>(max_value) - min_value + 1;
+  if (range <= kMaxSwitchTableSize &&
+      range <= count * kMaxSwitchTableSparseness) {
+    HBasicBlock* default_block = graph()->CreateBasicBlock();
+    HSwitchTable* table = new(zone()) HSwitchTable(tag,
+                                                   min_value,
+                                                   static_cast<int>(range),
+                                                   default_block,
+                                                   zone());
+    for (int i = from; i < to; ++i) {
+      HBasicBlock* match_block = graph()->CreateBasicBlock();
+      table->SetEntry(cases->at(i).value - min_value,
+                      table->AddTarget(match_block, zone()));
+      targets->Set(cases->at(i).clause_index, match_block);
+    }
+    current_block()->Finish(table);
+    set_current_block(default_block);
+    GotoSwitchMiss(miss);
+    return;
+  }
 
-  // The goal of this method is to modify either upper_offset_ or
-  // lower_offset_ so that also new_offset is covered (the covered
-  // range grows).
-  //
-  // The precondition is that new_check follows UpperCheck() and
-  // LowerCheck() in the same basic block, and that new_offset is not
-  // covered (otherwise we could simply remove new_check).
-  //
-  // If HasSingleCheck() is true then new_check is added as "second check"
-  // (either upper or lower; note that HasSingleCheck() becomes false).
-  // Otherwise one of the current checks is modified so that it also covers
-  // new_offset, and new_check is removed.
-  //
-  // If the check cannot be modified because the context is unknown it
-  // returns false, otherwise it returns true.
-  bool CoverCheck(HBoundsCheck* new_check,
-                  int32_t new_offset) {
-    ASSERT(new_check->index()->representation().IsInteger32());
-    bool keep_new_check = false;
+  // Split the cases in half on the value of the middle one.
+  int middle = from + count / 2;
+  HConstant* pivot = new(zone()) HConstant(cases->at(middle).value,
+                                           Representation::Integer32());
+  AddInstruction(pivot);
+  HBasicBlock* lower_block = graph()->CreateBasicBlock();
+  HBasicBlock* upper_block = graph()->CreateBasicBlock();
+  HCompareIDAndBranch* compare =
+      new(zone()) HCompareIDAndBranch(tag, pivot, Token::LT);
+  compare->set_observed_input_representation(
+      Representation::Integer32(), Representation::Integer32());
+  compare->SetSuccessorAt(0, lower_block);
+  compare->SetSuccessorAt(1, upper_block);
+  current_block()->Finish(compare);
+  set_current_block(lower_block);
+  BuildSmiSwitchDispatch(tag, cases, from, middle, targets, miss);
+  set_current_block(upper_block);
+  BuildSmiSwitchDispatch(tag, cases, middle, to, targets, miss);
+}
 
-    if (new_offset > upper_offset_) {
-      upper_offset_ = new_offset;
-      if (HasSingleCheck()) {
-        keep_new_check = true;
-        upper_check_ = new_check;
-      } else {
-        bool result = BuildOffsetAdd(upper_check_,
-                                     &added_upper_index_,
-                                     &added_upper_offset_,
-                                     Key()->IndexBase(),
-                                     new_check->index()->representation(),
-                                     new_offset);
-        if (!result) return false;
-        upper_check_->ReplaceAllUsesWith(upper_check_->index());
-        upper_check_->SetOperandAt(0, added_upper_index_);
-      }
-    } else if (new_offset < lower_offset_) {
-      lower_offset_ = new_offset;
-      if (HasSingleCheck()) {
-        keep_new_check = true;
-        lower_check_ = new_check;
+
+void HOptimizedGraphBuilder::BuildStringSwitchDispatch(
+    SwitchStatement* stmt,
+    HValue* context,
+    HValue* tag,
+    ZoneList<HBasicBlock*>* targets,
+    HBasicBlock** miss) {
+  ZoneList<CaseClause*>* clauses = stmt->cases();
+  int clause_count = clauses->length();
+
+  HBasicBlock* string_block = graph()->CreateBasicBlock();
+  HBasicBlock* not_string_block = graph()->CreateBasicBlock();
+  HIsStringAndBranch* string_check = new(zone()) HIsStringAndBranch(tag);
+  string_check->SetSuccessorAt(0, string_block);
+  string_check->SetSuccessorAt(1, not_string_block);
+  current_block()->Finish(string_check);
+  set_current_block(not_string_block);
+  GotoSwitchMiss(miss);
+
+  set_current_block(string_block);
+  HBasicBlock* internalized_block = graph()->CreateBasicBlock();
+  HBasicBlock* other_block = graph()->CreateBasicBlock();
+  HIsInternalizedStringAndBranch* internalized_check =
+      new(zone()) HIsInternalizedStringAndBranch(tag);
+  internalized_check->SetSuccessorAt(0, internalized_block);
+  internalized_check->SetSuccessorAt(1, other_block);
+  current_block()->Finish(internalized_check);
+
+  // The labels are internalized, so an internalized tag is equal to a label
+  // exactly if it is the same string.
+  ZoneList<HBasicBlock*> identity_targets(clause_count, zone());
+  identity_targets.AddBlock(NULL, clause_count, zone());
+  set_current_block(internalized_block);
+  for (int i = 0; i < clause_count; ++i) {
+    CaseClause* clause = clauses->at(i);
+    if (clause->is_default()) continue;
+    Handle<Object> label_handle = clause->label()->AsLiteral()->handle();
+    HConstant* label =
+        new(zone()) HConstant(label_handle, Representation::None());
+    AddInstruction(label);
+    HBasicBlock* match_block = graph()->CreateBasicBlock();
+    HBasicBlock* next_block = graph()->CreateBasicBlock();
+    HCompareObjectEqAndBranch* compare =
+        new(zone()) HCompareObjectEqAndBranch(tag, label);
+    compare->SetSuccessorAt(0, match_block);
+    compare->SetSuccessorAt(1, next_block);
+    current_block()->Finish(compare);
+    identity_targets[i] = match_block;
+    set_current_block(next_block);
+  }
+  GotoSwitchMiss(miss);
+
+  // Other strings have to be compared by their contents.
+  set_current_block(other_block);
+  for (int i = 0; i < clause_count; ++i) {
+    CaseClause* clause = clauses->at(i);
+    if (clause->is_default()) continue;
+    Handle<Object> label_handle = clause->label()->AsLiteral()->handle();
+    HConstant* label =
+        new(zone()) HConstant(label_handle, Representation::None());
+    AddInstruction(label);
+    HBasicBlock* match_block = graph()->CreateBasicBlock();
+    HBasicBlock* next_block = graph()->CreateBasicBlock();
+    HStringCompareAndBranch* compare =
+        new(zone()) HStringCompareAndBranch(context, tag, label,
+                                            Token::EQ_STRICT);
+    compare->SetSuccessorAt(0, match_block);
+    compare->SetSuccessorAt(1, next_block);
+    current_block()->Finish(compare);
+    targets->Set(i, CreateJoin(identity_targets[i],
+                               match_block,
+                               clause->EntryId()));
+    set_current_block(next_block);
+  }
+  GotoSwitchMiss(miss);
+}
+
+
+void HOptimizedGraphBuilder::VisitSwitchStatement(SwitchStatement* stmt) {
+  ASSERT(!HasStackOverflow());
+  ASSERT(current_block() != NULL);
+  ASSERT(current_block()->HasPredecessor());
+  // We only optimize switch statements with smi-literal smi comparisons,
+  // with a bounded number of clauses.  Without a linear chain of
+  // comparisons the bound can be higher.
+  const int kCaseClauseLimit = 128;
+  const int kLoweredCaseClauseLimit = 1024;
+  ZoneList<CaseClause*>* clauses = stmt->cases();
+  int clause_count = clauses->length();
+  if (clause_count > (FLAG_lower_switch_statements ? kLoweredCaseClauseLimit
+                                                   : kCaseClauseLimit)) {
+    return Bailout("SwitchStatement: too many clauses");
+  }
+
+  HValue* context = environment()->LookupContext();
+
+  CHECK_ALIVE(VisitForValue(stmt->tag()));
+  AddSimulate(stmt->EntryId());
+  HValue* tag_value = Pop();
+
+  SwitchType switch_type = UNKNOWN_SWITCH;
+  CaseClause* first_case = NULL;
+  BailoutId default_id = BailoutId::None();
+
+  // 1. Extract clause type
+  for (int i = 0; i < clause_count; ++i) {
+    CaseClause* clause = clauses->at(i);
+    if (clause->is_default()) {
+      default_id = clause->EntryId();
+      continue;
+    }
+    if (first_case == NULL) first_case = clause;
+
+    if (switch_type == UNKNOWN_SWITCH) {
+      if (clause->label()->IsSmiLiteral()) {
+        switch_type = SMI_SWITCH;
+      } else if (clause->label()->IsStringLiteral()) {
+        switch_type = STRING_SWITCH;
       } else {
-        bool result = BuildOffsetAdd(lower_check_,
-                                     &added_lower_index_,
-                                     &added_lower_offset_,
-                                     Key()->IndexBase(),
-                                     new_check->index()->representation(),
-                                     new_offset);
-        if (!result) return false;
-        lower_check_->ReplaceAllUsesWith(lower_check_->index());
-        lower_check_->SetOperandAt(0, added_lower_index_);
+        return Bailout("SwitchStatement: non-literal switch label");
       }
-    } else {
-      ASSERT(false);
+    } else if ((switch_type == STRING_SWITCH &&
+                !clause->label()->IsStringLiteral()) ||
+               (switch_type == SMI_SWITCH &&
+                !clause->label()->IsSmiLiteral())) {
+      return Bailout("SwitchStatement: mixed label types are not supported");
+    }
+    if (switch_type == SMI_SWITCH) {
+      clause->RecordTypeFeedback(oracle());
     }
+  }
 
-    if (!keep_new_check) {
-      new_check->DeleteAndReplaceWith(new_check->ActualValue());
+  // 2. Build the tests.  They leave the block where each clause is entered
+  // when its label matches in targets, or NULL if it can't match, and the
+  // block where no label matched in last_block.  That block is NULL if we
+  // deoptimized.
+  ZoneList<HBasicBlock*> targets(clause_count, zone());
+  targets.AddBlock(NULL, clause_count, zone());
+  HBasicBlock* last_block = NULL;
+  BailoutId join_id = !default_id.IsNone() ? default_id : stmt->ExitId();
+
+  if (FLAG_lower_switch_statements &&
+      switch_type == SMI_SWITCH &&
+      first_case->IsSmiCompare()) {
+    // The first comparison sees every tag, so its type feedback covers
+    // the whole switch.  Duplicate labels only match their first clause.
+    ZoneList<SwitchCase> cases(clause_count, zone());
+    for (int i = 0; i < clause_count; ++i) {
+      CaseClause* clause = clauses->at(i);
+      if (clause->is_default()) continue;
+      SwitchCase switch_case;
+      switch_case.value =
+          Smi::cast(*clause->label()->AsLiteral()->handle())->value();
+      switch_case.clause_index = i;
+      cases.Add(switch_case, zone());
+    }
+    cases.Sort(CompareSwitchCases);
+    int unique_count = 0;
+    for (int i = 0; i < cases.length(); ++i) {
+      if (unique_count > 0 &&
+          cases[unique_count - 1].value == cases[i].value) {
+        continue;
+      }
+      cases[unique_count++] = cases[i];
+    }
+    cases.Rewind(unique_count);
+    BuildSmiSwitchDispatch(tag_value, &cases, 0, unique_count,
+                           &targets, &last_block);
+    last_block->SetJoinId(join_id);
+  } else if (FLAG_lower_switch_statements &&
+             switch_type == STRING_SWITCH) {
+    BuildStringSwitchDispatch(stmt, context, tag_value,
+                              &targets, &last_block);
+    last_block->SetJoinId(join_id);
+  } else {
+    HUnaryControlInstruction* string_check = NULL;
+    HBasicBlock* not_string_block = NULL;
+
+    // Test switch's tag value if all clauses are string literals
+    if (switch_type == STRING_SWITCH) {
+      string_check = new(zone()) HIsStringAndBranch(tag_value);
+      HBasicBlock* first_test_block = graph()->CreateBasicBlock();
+      not_string_block = graph()->CreateBasicBlock();
+
+      string_check->SetSuccessorAt(0, first_test_block);
+      string_check->SetSuccessorAt(1, not_string_block);
+      current_block()->Finish(string_check);
+
+      set_current_block(first_test_block);
     }
 
-    return true;
-  }
+    // A linear chain of tests, with dangling true branches.
+    for (int i = 0; i < clause_count; ++i) {
+      CaseClause* clause = clauses->at(i);
+      if (clause->is_default()) continue;
 
-  void RemoveZeroOperations() {
-    RemoveZeroAdd(&added_lower_index_, &added_lower_offset_);
-    RemoveZeroAdd(&added_upper_index_, &added_upper_offset_);
-  }
+      // Generate a compare and branch.
+      CHECK_ALIVE(VisitForValue(clause->label()));
+      HValue* label_value = Pop();
 
-  BoundsCheckBbData(BoundsCheckKey* key,
-                    int32_t lower_offset,
-                    int32_t upper_offset,
-                    HBasicBlock* bb,
-                    HBoundsCheck* lower_check,
-                    HBoundsCheck* upper_check,
-                    BoundsCheckBbData* next_in_bb,
-                    BoundsCheckBbData* father_in_dt)
-  : key_(key),
-    lower_offset_(lower_offset),
-    upper_offset_(upper_offset),
-    basic_block_(bb),
-    lower_check_(lower_check),
-    upper_check_(upper_check),
-    added_lower_index_(NULL),
-    added_lower_offset_(NULL),
-    added_upper_index_(NULL),
-    added_upper_offset_(NULL),
-    next_in_bb_(next_in_bb),
-    father_in_dt_(father_in_dt) { }
+      HBasicBlock* next_test_block = graph()->CreateBasicBlock();
+      HBasicBlock* body_block = graph()->CreateBasicBlock();
 
- private:
-  BoundsCheckKey* key_;
-  int32_t lower_offset_;
-  int32_t upper_offset_;
-  HBasicBlock* basic_block_;
-  HBoundsCheck* lower_check_;
-  HBoundsCheck* upper_check_;
-  HInstruction* added_lower_index_;
-  HConstant* added_lower_offset_;
-  HInstruction* added_upper_index_;
-  HConstant* added_upper_offset_;
-  BoundsCheckBbData* next_in_bb_;
-  BoundsCheckBbData* father_in_dt_;
+      HControlInstruction* compare;
 
-  // Given an existing add instruction and a bounds check it tries to
-  // find the current context (either of the add or of the check index).
-  HValue* IndexContext(HInstruction* add, HBoundsCheck* check) {
-    if (add != NULL && add->IsAdd()) {
-      return HAdd::cast(add)->context();
+      if (switch_type == SMI_SWITCH) {
+        if (!clause->IsSmiCompare()) {
+          // Finish with deoptimize and add uses of enviroment values to
+          // account for invisible uses.
+          current_block()->FinishExitWithDeoptimization(HDeoptimize::kUseAll);
+          set_current_block(NULL);
+          break;
+        }
+
+        HCompareIDAndBranch* compare_ =
+            new(zone()) HCompareIDAndBranch(tag_value,
+                                            label_value,
+                                            Token::EQ_STRICT);
+        compare_->set_observed_input_representation(
+            Representation::Integer32(), Representation::Integer32());
+        compare = compare_;
+      } else {
+        compare = new(zone()) HStringCompareAndBranch(context, tag_value,
+                                                      label_value,
+                                                      Token::EQ_STRICT);
+      }
+
+      compare->SetSuccessorAt(0, body_block);
+      compare->SetSuccessorAt(1, next_test_block);
+      current_block()->Finish(compare);
+      targets[i] = body_block;
+
+      set_current_block(next_test_block);
     }
-    if (check->index()->IsBinaryOperation()) {
-      return HBinaryOperation::cast(check->index())->context();
+
+    last_block = current_block();
+    if (not_string_block != NULL) {
+      last_block = CreateJoin(last_block, not_string_block, join_id);
     }
-    return NULL;
   }
 
-  // This function returns false if it cannot build the add because the
-  // current context cannot be determined.
-  bool BuildOffsetAdd(HBoundsCheck* check,
-                      HInstruction** add,
-                      HConstant** constant,
-                      HValue* original_value,
-                      Representation representation,
-                      int32_t new_offset) {
-    HValue* index_context = IndexContext(*add, check);
-    if (index_context == NULL) return false;
+  // 3. Loop over the clauses and their targets, translating the clause
+  // bodies.
+  HBasicBlock* fall_through_block = NULL;
+
+  BreakAndContinueInfo break_info(stmt);
+  { BreakAndContinueScope push(&break_info, this);
+    for (int i = 0; i < clause_count; ++i) {
+      CaseClause* clause = clauses->at(i);
+
+      // Identify the block where normal (non-fall-through) control flow
+      // goes to.
+      HBasicBlock* normal_block = NULL;
+      if (clause->is_default()) {
+        if (last_block != NULL) {
+          normal_block = last_block;
+          last_block = NULL;  // Cleared to indicate we've handled it.
+        }
+      } else {
+        normal_block = targets[i];
+      }
+
+      // Identify a block to emit the body into.
+      if (normal_block == NULL) {
+        if (fall_through_block == NULL) {
+          // (a) Unreachable.  Later clause bodies might still be reachable.
+          continue;
+        } else {
+          // (b) Reachable only as fall through.
+          set_current_block(fall_through_block);
+        }
+      } else if (fall_through_block == NULL) {
+        // (c) Reachable only normally.
+        set_current_block(normal_block);
+      } else {
+        // (d) Reachable both ways.
+        HBasicBlock* join = CreateJoin(fall_through_block,
+                                       normal_block,
+                                       clause->EntryId());
+        set_current_block(join);
+      }
 
-    HConstant* new_constant = new(BasicBlock()->zone())
-       HConstant(new_offset, Representation::Integer32());
-    if (*add == NULL) {
-      new_constant->InsertBefore(check);
-      (*add) = HAdd::New(
-          BasicBlock()->zone(), index_context, original_value, new_constant);
-      (*add)->AssumeRepresentation(representation);
-      (*add)->InsertBefore(check);
-    } else {
-      new_constant->InsertBefore(*add);
-      (*constant)->DeleteAndReplaceWith(new_constant);
+      CHECK_BAILOUT(VisitStatements(clause->statements()));
+      fall_through_block = current_block();
     }
-    *constant = new_constant;
-    return true;
   }
 
-  void RemoveZeroAdd(HInstruction** add, HConstant** constant) {
-    if (*add != NULL && (*add)->IsAdd() && (*constant)->Integer32Value() == 0) {
-      (*add)->DeleteAndReplaceWith(HAdd::cast(*add)->left());
-      (*constant)->DeleteAndReplaceWith(NULL);
-    }
+  // Create an up-to-3-way join.  Use the break block if it exists since
+  // it's already a join block.
+  HBasicBlock* break_block = break_info.break_block();
+  if (break_block == NULL) {
+    set_current_block(CreateJoin(fall_through_block,
+                                 last_block,
+                                 stmt->ExitId()));
+  } else {
+    if (fall_through_block != NULL) fall_through_block->Goto(break_block);
+    if (last_block != NULL) last_block->Goto(break_block);
+    break_block->SetJoinId(stmt->ExitId());
+    set_current_block(break_block);
   }
-};
-
-
-static bool BoundsCheckKeyMatch(void* key1, void* key2) {
-  BoundsCheckKey* k1 = static_cast<BoundsCheckKey*>(key1);
-  BoundsCheckKey* k2 = static_cast<BoundsCheckKey*>(key2);
-  return k1->IndexBase() == k2->IndexBase() && k1->Length() == k2->Length();
 }
 
 
-class BoundsCheckTable : private ZoneHashMap {
+// Scans the body of a loop before it is copied by peeling or unrolling.  It
+// counts AST nodes as a size estimate and rejects bodies that contain nested
+// iteration statements (only innermost loops are copied, which also keeps a
+// nested OSR entry from being built twice) or constructs the graph builder
+// does not support.
+class LoopBodyChecker: public AstVisitor {
  public:
-  BoundsCheckBbData** LookupOrInsert(BoundsCheckKey* key, Zone* zone) {
-    return reinterpret_cast<BoundsCheckBbData**>(
-        &(Lookup(key, key->Hash(), true, ZoneAllocationPolicy(zone))->value));
+  LoopBodyChecker()
+      : node_count_(0), is_copyable_(true), has_keyed_property_(false) {
+    InitializeAstVisitor();
   }
 
-  void Insert(BoundsCheckKey* key, BoundsCheckBbData* data, Zone* zone) {
-    Lookup(key, key->Hash(), true, ZoneAllocationPolicy(zone))->value = data;
-  }
+  void Check(IterationStatement* stmt);
 
-  void Delete(BoundsCheckKey* key) {
-    Remove(key, key->Hash());
-  }
+  int node_count() { return node_count_; }
+  bool is_copyable() { return is_copyable_ && !HasStackOverflow(); }
+  bool has_keyed_property() { return has_keyed_property_; }
 
-  explicit BoundsCheckTable(Zone* zone)
-      : ZoneHashMap(BoundsCheckKeyMatch, ZoneHashMap::kDefaultHashMapCapacity,
-                    ZoneAllocationPolicy(zone)) { }
-};
+ private:
+  // AST node visit functions.
+#define DECLARE_VISIT(type) virtual void Visit##type(type* node);
+  AST_NODE_LIST(DECLARE_VISIT)
+#undef DECLARE_VISIT
 
+  void VisitOptional(AstNode* node) {
+    if (node != NULL) Visit(node);
+  }
 
-// Eliminates checks in bb and recursively in the dominated blocks.
-// Also replace the results of check instructions with the original value, if
-// the result is used. This is safe now, since we don't do code motion after
-// this point. It enables better register allocation since the value produced
-// by check instructions is really a copy of the original value.
-void HGraph::EliminateRedundantBoundsChecks(HBasicBlock* bb,
-                                            BoundsCheckTable* table) {
-  BoundsCheckBbData* bb_data_list = NULL;
+  void Reject() { is_copyable_ = false; }
 
-  for (HInstruction* i = bb->first(); i != NULL; i = i->next()) {
-    if (!i->IsBoundsCheck()) continue;
+  int node_count_;
+  bool is_copyable_;
+  bool has_keyed_property_;
 
-    HBoundsCheck* check = HBoundsCheck::cast(i);
-    int32_t offset;
-    BoundsCheckKey* key =
-        BoundsCheckKey::Create(zone(), check, &offset);
-    if (key == NULL) continue;
-    BoundsCheckBbData** data_p = table->LookupOrInsert(key, zone());
-    BoundsCheckBbData* data = *data_p;
-    if (data == NULL) {
-      bb_data_list = new(zone()) BoundsCheckBbData(key,
-                                                   offset,
-                                                   offset,
-                                                   bb,
-                                                   check,
-                                                   check,
-                                                   bb_data_list,
-                                                   NULL);
-      *data_p = bb_data_list;
-    } else if (data->OffsetIsCovered(offset)) {
-      check->DeleteAndReplaceWith(check->ActualValue());
-    } else if (data->BasicBlock() != bb ||
-               !data->CoverCheck(check, offset)) {
-      // If the check is in the current BB we try to modify it by calling
-      // "CoverCheck", but if also that fails we record the current offsets
-      // in a new data instance because from now on they are covered.
-      int32_t new_lower_offset = offset < data->LowerOffset()
-          ? offset
-          : data->LowerOffset();
-      int32_t new_upper_offset = offset > data->UpperOffset()
-          ? offset
-          : data->UpperOffset();
-      bb_data_list = new(zone()) BoundsCheckBbData(key,
-                                                   new_lower_offset,
-                                                   new_upper_offset,
-                                                   bb,
-                                                   data->LowerCheck(),
-                                                   data->UpperCheck(),
-                                                   bb_data_list,
-                                                   data);
-      table->Insert(key, bb_data_list, zone());
-    }
-  }
+  DEFINE_AST_VISITOR_SUBCLASS_MEMBERS();
+  DISALLOW_COPY_AND_ASSIGN(LoopBodyChecker);
+};
 
-  for (int i = 0; i < bb->dominated_blocks()->length(); ++i) {
-    EliminateRedundantBoundsChecks(bb->dominated_blocks()->at(i), table);
-  }
 
-  for (BoundsCheckBbData* data = bb_data_list;
-       data != NULL;
-       data = data->NextInBasicBlock()) {
-    data->RemoveZeroOperations();
-    if (data->FatherInDominatorTree()) {
-      table->Insert(data->Key(), data->FatherInDominatorTree(), zone());
-    } else {
-      table->Delete(data->Key());
-    }
+void LoopBodyChecker::Check(IterationStatement* stmt) {
+  Visit(stmt->body());
+  if (stmt->AsForStatement() != NULL) {
+    VisitOptional(stmt->AsForStatement()->cond());
+    VisitOptional(stmt->AsForStatement()->next());
+  } else if (stmt->AsWhileStatement() != NULL) {
+    Visit(stmt->AsWhileStatement()->cond());
   }
 }
 
 
-void HGraph::EliminateRedundantBoundsChecks() {
-  HPhase phase("H_Eliminate bounds checks", this);
-  BoundsCheckTable checks_table(zone());
-  EliminateRedundantBoundsChecks(entry_block(), &checks_table);
+void LoopBodyChecker::VisitVariableDeclaration(VariableDeclaration* decl) {
+  node_count_++;
 }
 
 
-static void DehoistArrayIndex(ArrayInstructionInterface* array_operation) {
-  HValue* index = array_operation->GetKey()->ActualValue();
-  if (!index->representation().IsInteger32()) return;
+void LoopBodyChecker::VisitFunctionDeclaration(FunctionDeclaration* decl) {
+  node_count_++;
+}
 
-  HConstant* constant;
-  HValue* subexpression;
-  int32_t sign;
-  if (index->IsAdd()) {
-    sign = 1;
-    HAdd* add = HAdd::cast(index);
-    if (add->left()->IsConstant()) {
-      subexpression = add->right();
-      constant = HConstant::cast(add->left());
-    } else if (add->right()->IsConstant()) {
-      subexpression = add->left();
-      constant = HConstant::cast(add->right());
-    } else {
-      return;
-    }
-  } else if (index->IsSub()) {
-    sign = -1;
-    HSub* sub = HSub::cast(index);
-    if (sub->left()->IsConstant()) {
-      subexpression = sub->right();
-      constant = HConstant::cast(sub->left());
-    } else if (sub->right()->IsConstant()) {
-      subexpression = sub->left();
-      constant = HConstant::cast(sub->right());
-    } return;
-  } else {
-    return;
-  }
 
-  if (!constant->HasInteger32Value()) return;
-  int32_t value = constant->Integer32Value() * sign;
-  // We limit offset values to 30 bits because we want to avoid the risk of
-  // overflows when the offset is added to the object header size.
-  if (value >= 1 << 30 || value < 0) return;
-  array_operation->SetKey(subexpression);
-  if (index->HasNoUses()) {
-    index->DeleteAndReplaceWith(NULL);
-  }
-  ASSERT(value >= 0);
-  array_operation->SetIndexOffset(static_cast<uint32_t>(value));
-  array_operation->SetDehoisted(true);
+void LoopBodyChecker::VisitModuleDeclaration(ModuleDeclaration* decl) {
+  Reject();
 }
 
 
-void HGraph::DehoistSimpleArrayIndexComputations() {
-  HPhase phase("H_Dehoist index computations", this);
-  for (int i = 0; i < blocks()->length(); ++i) {
-    for (HInstruction* instr = blocks()->at(i)->first();
-        instr != NULL;
-        instr = instr->next()) {
-      ArrayInstructionInterface* array_instruction = NULL;
-      if (instr->IsLoadKeyed()) {
-        HLoadKeyed* op = HLoadKeyed::cast(instr);
-        array_instruction = static_cast<ArrayInstructionInterface*>(op);
-      } else if (instr->IsStoreKeyed()) {
-        HStoreKeyed* op = HStoreKeyed::cast(instr);
-        array_instruction = static_cast<ArrayInstructionInterface*>(op);
-      } else {
-        continue;
-      }
-      DehoistArrayIndex(array_instruction);
-    }
-  }
+void LoopBodyChecker::VisitImportDeclaration(ImportDeclaration* decl) {
+  Reject();
 }
 
 
-void HGraph::DeadCodeElimination() {
-  HPhase phase("H_Dead code elimination", this);
-  ZoneList<HInstruction*> worklist(blocks_.length(), zone());
-  for (int i = 0; i < blocks()->length(); ++i) {
-    for (HInstruction* instr = blocks()->at(i)->first();
-         instr != NULL;
-         instr = instr->next()) {
-      if (instr->IsDead()) worklist.Add(instr, zone());
-    }
-  }
-
-  while (!worklist.is_empty()) {
-    HInstruction* instr = worklist.RemoveLast();
-    // This happens when an instruction is used multiple times as operand. That
-    // in turn could happen through GVN.
-    if (!instr->IsLinked()) continue;
-    if (FLAG_trace_dead_code_elimination) {
-      HeapStringAllocator allocator;
-      StringStream stream(&allocator);
-      instr->PrintNameTo(&stream);
-      stream.Add(" = ");
-      instr->PrintTo(&stream);
-      PrintF("[removing dead instruction %s]\n", *stream.ToCString());
-    }
-    instr->DeleteAndReplaceWith(NULL);
-    for (int i = 0; i < instr->OperandCount(); ++i) {
-      HValue* operand = instr->OperandAt(i);
-      if (operand->IsDead()) worklist.Add(HInstruction::cast(operand), zone());
-    }
-  }
+void LoopBodyChecker::VisitExportDeclaration(ExportDeclaration* decl) {
+  Reject();
 }
 
 
-void HGraph::RestoreActualValues() {
-  HPhase phase("H_Restore actual values", this);
-
-  for (int block_index = 0; block_index < blocks()->length(); block_index++) {
-    HBasicBlock* block = blocks()->at(block_index);
+void LoopBodyChecker::VisitModuleLiteral(ModuleLiteral* module) {
+  Reject();
+}
 
-#ifdef DEBUG
-    for (int i = 0; i < block->phis()->length(); i++) {
-      HPhi* phi = block->phis()->at(i);
-      ASSERT(phi->ActualValue() == phi);
-    }
-#endif
 
-    for (HInstruction* instruction = block->first();
-        instruction != NULL;
-        instruction = instruction->next()) {
-      if (instruction->ActualValue() != instruction) {
-        ASSERT(instruction->IsInformativeDefinition());
-        if (instruction->IsPurelyInformativeDefinition()) {
-          instruction->DeleteAndReplaceWith(instruction->RedefinedOperand());
-        } else {
-          instruction->ReplaceAllUsesWith(instruction->ActualValue());
-        }
-      }
-    }
-  }
+void LoopBodyChecker::VisitModuleVariable(ModuleVariable* module) {
+  Reject();
 }
 
 
-void HOptimizedGraphBuilder::AddPhi(HPhi* instr) {
-  ASSERT(current_block() != NULL);
-  current_block()->AddPhi(instr);
+void LoopBodyChecker::VisitModulePath(ModulePath* module) {
+  Reject();
 }
 
 
-void HOptimizedGraphBuilder::PushAndAdd(HInstruction* instr) {
-  Push(instr);
-  AddInstruction(instr);
+void LoopBodyChecker::VisitModuleUrl(ModuleUrl* module) {
+  Reject();
 }
 
 
-void HOptimizedGraphBuilder::AddSoftDeoptimize() {
-  if (FLAG_always_opt) return;
-  if (current_block()->IsDeoptimizing()) return;
-  AddInstruction(new(zone()) HSoftDeoptimize());
-  current_block()->MarkAsDeoptimizing();
-  graph()->set_has_soft_deoptimize(true);
+void LoopBodyChecker::VisitModuleStatement(ModuleStatement* stmt) {
+  Reject();
 }
 
 
-template <class Instruction>
-HInstruction* HOptimizedGraphBuilder::PreProcessCall(Instruction* call) {
-  int count = call->argument_count();
-  ZoneList<HValue*> arguments(count, zone());
-  for (int i = 0; i < count; ++i) {
-    arguments.Add(Pop(), zone());
-  }
+void LoopBodyChecker::VisitBlock(Block* stmt) {
+  node_count_++;
+  VisitStatements(stmt->statements());
+}
 
-  while (!arguments.is_empty()) {
-    AddInstruction(new(zone()) HPushArgument(arguments.RemoveLast()));
-  }
-  return call;
+
+void LoopBodyChecker::VisitExpressionStatement(ExpressionStatement* stmt) {
+  node_count_++;
+  Visit(stmt->expression());
 }
 
 
-void HOptimizedGraphBuilder::SetUpScope(Scope* scope) {
-  HConstant* undefined_constant = new(zone()) HConstant(
-      isolate()->factory()->undefined_value(), Representation::Tagged());
-  AddInstruction(undefined_constant);
-  graph()->set_undefined_constant(undefined_constant);
+void LoopBodyChecker::VisitEmptyStatement(EmptyStatement* stmt) {
+}
 
-  HArgumentsObject* object = new(zone()) HArgumentsObject;
-  AddInstruction(object);
-  graph()->SetArgumentsObject(object);
 
-  // Set the initial values of parameters including "this".  "This" has
-  // parameter index 0.
-  ASSERT_EQ(scope->num_parameters() + 1, environment()->parameter_count());
+void LoopBodyChecker::VisitIfStatement(IfStatement* stmt) {
+  node_count_++;
+  Visit(stmt->condition());
+  Visit(stmt->then_statement());
+  Visit(stmt->else_statement());
+}
 
-  for (int i = 0; i < environment()->parameter_count(); ++i) {
-    HInstruction* parameter = AddInstruction(new(zone()) HParameter(i));
-    environment()->Bind(i, parameter);
-  }
 
-  // First special is HContext.
-  HInstruction* context = AddInstruction(new(zone()) HContext);
-  environment()->BindContext(context);
+void LoopBodyChecker::VisitContinueStatement(ContinueStatement* stmt) {
+  node_count_++;
+}
 
-  // Initialize specials and locals to undefined.
-  for (int i = environment()->parameter_count() + 1;
-       i < environment()->length();
-       ++i) {
-    environment()->Bind(i, undefined_constant);
-  }
 
-  // Handle the arguments and arguments shadow variables specially (they do
-  // not have declarations).
-  if (scope->arguments() != NULL) {
-    if (!scope->arguments()->IsStackAllocated()) {
-      return Bailout("context-allocated arguments");
-    }
+void LoopBodyChecker::VisitBreakStatement(BreakStatement* stmt) {
+  node_count_++;
+}
 
-    environment()->Bind(scope->arguments(),
-                        graph()->GetArgumentsObject());
-  }
+
+void LoopBodyChecker::VisitReturnStatement(ReturnStatement* stmt) {
+  node_count_++;
+  Visit(stmt->expression());
 }
 
 
-void HOptimizedGraphBuilder::VisitStatements(ZoneList<Statement*>* statements) {
-  for (int i = 0; i < statements->length(); i++) {
-    CHECK_ALIVE(Visit(statements->at(i)));
-  }
+void LoopBodyChecker::VisitWithStatement(WithStatement* stmt) {
+  Reject();
 }
 
 
-void HOptimizedGraphBuilder::VisitBlock(Block* stmt) {
-  ASSERT(!HasStackOverflow());
-  ASSERT(current_block() != NULL);
-  ASSERT(current_block()->HasPredecessor());
-  if (stmt->scope() != NULL) {
-    return Bailout("ScopedBlock");
-  }
-  BreakAndContinueInfo break_info(stmt);
-  { BreakAndContinueScope push(&break_info, this);
-    CHECK_BAILOUT(VisitStatements(stmt->statements()));
-  }
-  HBasicBlock* break_block = break_info.break_block();
-  if (break_block != NULL) {
-    if (current_block() != NULL) current_block()->Goto(break_block);
-    break_block->SetJoinId(stmt->ExitId());
-    set_current_block(break_block);
+void LoopBodyChecker::VisitSwitchStatement(SwitchStatement* stmt) {
+  node_count_++;
+  Visit(stmt->tag());
+  ZoneList<CaseClause*>* clauses = stmt->cases();
+  for (int i = 0; i < clauses->length(); ++i) {
+    CaseClause* clause = clauses->at(i);
+    if (!clause->is_default()) Visit(clause->label());
+    VisitStatements(clause->statements());
   }
 }
 
 
-void HOptimizedGraphBuilder::VisitExpressionStatement(
-    ExpressionStatement* stmt) {
-  ASSERT(!HasStackOverflow());
-  ASSERT(current_block() != NULL);
-  ASSERT(current_block()->HasPredecessor());
-  VisitForEffect(stmt->expression());
+void LoopBodyChecker::VisitDoWhileStatement(DoWhileStatement* stmt) {
+  Reject();
 }
 
 
-void HOptimizedGraphBuilder::VisitEmptyStatement(EmptyStatement* stmt) {
-  ASSERT(!HasStackOverflow());
-  ASSERT(current_block() != NULL);
-  ASSERT(current_block()->HasPredecessor());
+void LoopBodyChecker::VisitWhileStatement(WhileStatement* stmt) {
+  Reject();
 }
 
 
-void HOptimizedGraphBuilder::VisitIfStatement(IfStatement* stmt) {
-  ASSERT(!HasStackOverflow());
-  ASSERT(current_block() != NULL);
-  ASSERT(current_block()->HasPredecessor());
-  if (stmt->condition()->ToBooleanIsTrue()) {
-    AddSimulate(stmt->ThenId());
-    Visit(stmt->then_statement());
-  } else if (stmt->condition()->ToBooleanIsFalse()) {
-    AddSimulate(stmt->ElseId());
-    Visit(stmt->else_statement());
-  } else {
-    HBasicBlock* cond_true = graph()->CreateBasicBlock();
-    HBasicBlock* cond_false = graph()->CreateBasicBlock();
-    CHECK_BAILOUT(VisitForControl(stmt->condition(), cond_true, cond_false));
+void LoopBodyChecker::VisitForStatement(ForStatement* stmt) {
+  Reject();
+}
 
-    if (cond_true->HasPredecessor()) {
-      cond_true->SetJoinId(stmt->ThenId());
-      set_current_block(cond_true);
-      CHECK_BAILOUT(Visit(stmt->then_statement()));
-      cond_true = current_block();
-    } else {
-      cond_true = NULL;
-    }
 
-    if (cond_false->HasPredecessor()) {
-      cond_false->SetJoinId(stmt->ElseId());
-      set_current_block(cond_false);
-      CHECK_BAILOUT(Visit(stmt->else_statement()));
-      cond_false = current_block();
-    } else {
-      cond_false = NULL;
-    }
+void LoopBodyChecker::VisitForInStatement(ForInStatement* stmt) {
+  Reject();
+}
 
-    HBasicBlock* join = CreateJoin(cond_true, cond_false, stmt->IfId());
-    set_current_block(join);
-  }
+
+void LoopBodyChecker::VisitTryCatchStatement(TryCatchStatement* stmt) {
+  Reject();
 }
 
 
-HBasicBlock* HOptimizedGraphBuilder::BreakAndContinueScope::Get(
-    BreakableStatement* stmt,
-    BreakType type,
-    int* drop_extra) {
-  *drop_extra = 0;
-  BreakAndContinueScope* current = this;
-  while (current != NULL && current->info()->target() != stmt) {
-    *drop_extra += current->info()->drop_extra();
-    current = current->next();
-  }
-  ASSERT(current != NULL);  // Always found (unless stack is malformed).
+void LoopBodyChecker::VisitTryFinallyStatement(TryFinallyStatement* stmt) {
+  Reject();
+}
 
-  if (type == BREAK) {
-    *drop_extra += current->info()->drop_extra();
-  }
 
-  HBasicBlock* block = NULL;
-  switch (type) {
-    case BREAK:
-      block = current->info()->break_block();
-      if (block == NULL) {
-        block = current->owner()->graph()->CreateBasicBlock();
-        current->info()->set_break_block(block);
-      }
-      break;
+void LoopBodyChecker::VisitDebuggerStatement(DebuggerStatement* stmt) {
+  Reject();
+}
 
-    case CONTINUE:
-      block = current->info()->continue_block();
-      if (block == NULL) {
-        block = current->owner()->graph()->CreateBasicBlock();
-        current->info()->set_continue_block(block);
-      }
-      break;
-  }
 
-  return block;
+void LoopBodyChecker::VisitFunctionLiteral(FunctionLiteral* expr) {
+  // The body of a closure is compiled separately and is not copied.
+  node_count_++;
 }
 
 
-void HOptimizedGraphBuilder::VisitContinueStatement(
-    ContinueStatement* stmt) {
-  ASSERT(!HasStackOverflow());
-  ASSERT(current_block() != NULL);
-  ASSERT(current_block()->HasPredecessor());
-  int drop_extra = 0;
-  HBasicBlock* continue_block = break_scope()->Get(stmt->target(),
-                                                   CONTINUE,
-                                                   &drop_extra);
-  Drop(drop_extra);
-  current_block()->Goto(continue_block);
-  set_current_block(NULL);
+void LoopBodyChecker::VisitSharedFunctionInfoLiteral(
+    SharedFunctionInfoLiteral* expr) {
+  node_count_++;
 }
 
 
-void HOptimizedGraphBuilder::VisitBreakStatement(BreakStatement* stmt) {
-  ASSERT(!HasStackOverflow());
-  ASSERT(current_block() != NULL);
-  ASSERT(current_block()->HasPredecessor());
-  int drop_extra = 0;
-  HBasicBlock* break_block = break_scope()->Get(stmt->target(),
-                                                BREAK,
-                                                &drop_extra);
-  Drop(drop_extra);
-  current_block()->Goto(break_block);
-  set_current_block(NULL);
+void LoopBodyChecker::VisitConditional(Conditional* expr) {
+  node_count_++;
+  Visit(expr->condition());
+  Visit(expr->then_expression());
+  Visit(expr->else_expression());
 }
 
 
-void HOptimizedGraphBuilder::VisitReturnStatement(ReturnStatement* stmt) {
-  ASSERT(!HasStackOverflow());
-  ASSERT(current_block() != NULL);
-  ASSERT(current_block()->HasPredecessor());
-  FunctionState* state = function_state();
-  AstContext* context = call_context();
-  if (context == NULL) {
-    // Not an inlined return, so an actual one.
-    CHECK_ALIVE(VisitForValue(stmt->expression()));
-    HValue* result = environment()->Pop();
-    AddReturn(result);
-  } else if (state->inlining_kind() == CONSTRUCT_CALL_RETURN) {
-    // Return from an inlined construct call. In a test context the return value
-    // will always evaluate to true, in a value context the return value needs
-    // to be a JSObject.
-    if (context->IsTest()) {
-      TestContext* test = TestContext::cast(context);
-      CHECK_ALIVE(VisitForEffect(stmt->expression()));
-      current_block()->Goto(test->if_true(), state);
-    } else if (context->IsEffect()) {
-      CHECK_ALIVE(VisitForEffect(stmt->expression()));
-      current_block()->Goto(function_return(), state);
-    } else {
-      ASSERT(context->IsValue());
-      CHECK_ALIVE(VisitForValue(stmt->expression()));
-      HValue* return_value = Pop();
-      HValue* receiver = environment()->arguments_environment()->Lookup(0);
-      HHasInstanceTypeAndBranch* typecheck =
-          new(zone()) HHasInstanceTypeAndBranch(return_value,
-                                                FIRST_SPEC_OBJECT_TYPE,
-                                                LAST_SPEC_OBJECT_TYPE);
-      HBasicBlock* if_spec_object = graph()->CreateBasicBlock();
-      HBasicBlock* not_spec_object = graph()->CreateBasicBlock();
-      typecheck->SetSuccessorAt(0, if_spec_object);
-      typecheck->SetSuccessorAt(1, not_spec_object);
-      current_block()->Finish(typecheck);
-      if_spec_object->AddLeaveInlined(return_value, state);
-      not_spec_object->AddLeaveInlined(receiver, state);
-    }
-  } else if (state->inlining_kind() == SETTER_CALL_RETURN) {
-    // Return from an inlined setter call. The returned value is never used, the
-    // value of an assignment is always the value of the RHS of the assignment.
-    CHECK_ALIVE(VisitForEffect(stmt->expression()));
-    if (context->IsTest()) {
-      HValue* rhs = environment()->arguments_environment()->Lookup(1);
-      context->ReturnValue(rhs);
-    } else if (context->IsEffect()) {
-      current_block()->Goto(function_return(), state);
-    } else {
-      ASSERT(context->IsValue());
-      HValue* rhs = environment()->arguments_environment()->Lookup(1);
-      current_block()->AddLeaveInlined(rhs, state);
-    }
-  } else {
-    // Return from a normal inlined function. Visit the subexpression in the
-    // expression context of the call.
-    if (context->IsTest()) {
-      TestContext* test = TestContext::cast(context);
-      VisitForControl(stmt->expression(), test->if_true(), test->if_false());
-    } else if (context->IsEffect()) {
-      CHECK_ALIVE(VisitForEffect(stmt->expression()));
-      current_block()->Goto(function_return(), state);
-    } else {
-      ASSERT(context->IsValue());
-      CHECK_ALIVE(VisitForValue(stmt->expression()));
-      current_block()->AddLeaveInlined(Pop(), state);
-    }
-  }
-  set_current_block(NULL);
+void LoopBodyChecker::VisitVariableProxy(VariableProxy* expr) {
+  node_count_++;
+}
+
+
+void LoopBodyChecker::VisitLiteral(Literal* expr) {
+  node_count_++;
 }
 
 
-void HOptimizedGraphBuilder::VisitWithStatement(WithStatement* stmt) {
-  ASSERT(!HasStackOverflow());
-  ASSERT(current_block() != NULL);
-  ASSERT(current_block()->HasPredecessor());
-  return Bailout("WithStatement");
+void LoopBodyChecker::VisitRegExpLiteral(RegExpLiteral* expr) {
+  node_count_++;
 }
 
 
-void HOptimizedGraphBuilder::VisitSwitchStatement(SwitchStatement* stmt) {
-  ASSERT(!HasStackOverflow());
-  ASSERT(current_block() != NULL);
-  ASSERT(current_block()->HasPredecessor());
-  // We only optimize switch statements with smi-literal smi comparisons,
-  // with a bounded number of clauses.
-  const int kCaseClauseLimit = 128;
-  ZoneList<CaseClause*>* clauses = stmt->cases();
-  int clause_count = clauses->length();
-  if (clause_count > kCaseClauseLimit) {
-    return Bailout("SwitchStatement: too many clauses");
+void LoopBodyChecker::VisitObjectLiteral(ObjectLiteral* expr) {
+  node_count_++;
+  ZoneList<ObjectLiteral::Property*>* properties = expr->properties();
+  for (int i = 0; i < properties->length(); ++i) {
+    Visit(properties->at(i)->value());
   }
+}
 
-  HValue* context = environment()->LookupContext();
-
-  CHECK_ALIVE(VisitForValue(stmt->tag()));
-  AddSimulate(stmt->EntryId());
-  HValue* tag_value = Pop();
-  HBasicBlock* first_test_block = current_block();
 
-  SwitchType switch_type = UNKNOWN_SWITCH;
+void LoopBodyChecker::VisitArrayLiteral(ArrayLiteral* expr) {
+  node_count_++;
+  VisitExpressions(expr->values());
+}
 
-  // 1. Extract clause type
-  for (int i = 0; i < clause_count; ++i) {
-    CaseClause* clause = clauses->at(i);
-    if (clause->is_default()) continue;
 
-    if (switch_type == UNKNOWN_SWITCH) {
-      if (clause->label()->IsSmiLiteral()) {
-        switch_type = SMI_SWITCH;
-      } else if (clause->label()->IsStringLiteral()) {
-        switch_type = STRING_SWITCH;
-      } else {
-        return Bailout("SwitchStatement: non-literal switch label");
-      }
-    } else if ((switch_type == STRING_SWITCH &&
-                !clause->label()->IsStringLiteral()) ||
-               (switch_type == SMI_SWITCH &&
-                !clause->label()->IsSmiLiteral())) {
-      return Bailout("SwitchStatement: mixed label types are not supported");
-    }
+void LoopBodyChecker::VisitAssignment(Assignment* expr) {
+  // Const initializations inside loops are detected through the phis they
+  // create at the loop header, which a peeled iteration would hide.
+  if (expr->op() == Token::INIT_CONST ||
+      expr->op() == Token::INIT_CONST_HARMONY) {
+    Reject();
   }
+  node_count_++;
+  Visit(expr->target());
+  Visit(expr->value());
+}
 
-  HUnaryControlInstruction* string_check = NULL;
-  HBasicBlock* not_string_block = NULL;
 
-  // Test switch's tag value if all clauses are string literals
-  if (switch_type == STRING_SWITCH) {
-    string_check = new(zone()) HIsStringAndBranch(tag_value);
-    first_test_block = graph()->CreateBasicBlock();
-    not_string_block = graph()->CreateBasicBlock();
+void LoopBodyChecker::VisitYield(Yield* expr) {
+  Reject();
+}
 
-    string_check->SetSuccessorAt(0, first_test_block);
-    string_check->SetSuccessorAt(1, not_string_block);
-    current_block()->Finish(string_check);
 
-    set_current_block(first_test_block);
-  }
+void LoopBodyChecker::VisitThrow(Throw* expr) {
+  node_count_++;
+  Visit(expr->exception());
+}
 
-  // 2. Build all the tests, with dangling true branches
-  BailoutId default_id = BailoutId::None();
-  for (int i = 0; i < clause_count; ++i) {
-    CaseClause* clause = clauses->at(i);
-    if (clause->is_default()) {
-      default_id = clause->EntryId();
-      continue;
-    }
-    if (switch_type == SMI_SWITCH) {
-      clause->RecordTypeFeedback(oracle());
-    }
 
-    // Generate a compare and branch.
-    CHECK_ALIVE(VisitForValue(clause->label()));
-    HValue* label_value = Pop();
+void LoopBodyChecker::VisitProperty(Property* expr) {
+  node_count_++;
+  if (!expr->key()->IsPropertyName()) has_keyed_property_ = true;
+  Visit(expr->obj());
+  Visit(expr->key());
+}
 
-    HBasicBlock* next_test_block = graph()->CreateBasicBlock();
-    HBasicBlock* body_block = graph()->CreateBasicBlock();
 
-    HControlInstruction* compare;
+void LoopBodyChecker::VisitCall(Call* expr) {
+  node_count_++;
+  Visit(expr->expression());
+  VisitExpressions(expr->arguments());
+}
 
-    if (switch_type == SMI_SWITCH) {
-      if (!clause->IsSmiCompare()) {
-        // Finish with deoptimize and add uses of enviroment values to
-        // account for invisible uses.
-        current_block()->FinishExitWithDeoptimization(HDeoptimize::kUseAll);
-        set_current_block(NULL);
-        break;
-      }
 
-      HCompareIDAndBranch* compare_ =
-          new(zone()) HCompareIDAndBranch(tag_value,
-                                          label_value,
-                                          Token::EQ_STRICT);
-      compare_->set_observed_input_representation(
-          Representation::Integer32(), Representation::Integer32());
-      compare = compare_;
-    } else {
-      compare = new(zone()) HStringCompareAndBranch(context, tag_value,
-                                                    label_value,
-                                                    Token::EQ_STRICT);
-    }
+void LoopBodyChecker::VisitCallNew(CallNew* expr) {
+  node_count_++;
+  Visit(expr->expression());
+  VisitExpressions(expr->arguments());
+}
 
-    compare->SetSuccessorAt(0, body_block);
-    compare->SetSuccessorAt(1, next_test_block);
-    current_block()->Finish(compare);
 
-    set_current_block(next_test_block);
-  }
+void LoopBodyChecker::VisitCallRuntime(CallRuntime* expr) {
+  node_count_++;
+  VisitExpressions(expr->arguments());
+}
 
-  // Save the current block to use for the default or to join with the
-  // exit.  This block is NULL if we deoptimized.
-  HBasicBlock* last_block = current_block();
 
-  if (not_string_block != NULL) {
-    BailoutId join_id = !default_id.IsNone() ? default_id : stmt->ExitId();
-    last_block = CreateJoin(last_block, not_string_block, join_id);
-  }
+void LoopBodyChecker::VisitUnaryOperation(UnaryOperation* expr) {
+  node_count_++;
+  Visit(expr->expression());
+}
 
-  // 3. Loop over the clauses and the linked list of tests in lockstep,
-  // translating the clause bodies.
-  HBasicBlock* curr_test_block = first_test_block;
-  HBasicBlock* fall_through_block = NULL;
 
-  BreakAndContinueInfo break_info(stmt);
-  { BreakAndContinueScope push(&break_info, this);
-    for (int i = 0; i < clause_count; ++i) {
-      CaseClause* clause = clauses->at(i);
+void LoopBodyChecker::VisitCountOperation(CountOperation* expr) {
+  node_count_++;
+  Visit(expr->expression());
+}
 
-      // Identify the block where normal (non-fall-through) control flow
-      // goes to.
-      HBasicBlock* normal_block = NULL;
-      if (clause->is_default()) {
-        if (last_block != NULL) {
-          normal_block = last_block;
-          last_block = NULL;  // Cleared to indicate we've handled it.
-        }
-      } else if (!curr_test_block->end()->IsDeoptimize()) {
-        normal_block = curr_test_block->end()->FirstSuccessor();
-        curr_test_block = curr_test_block->end()->SecondSuccessor();
-      }
 
-      // Identify a block to emit the body into.
-      if (normal_block == NULL) {
-        if (fall_through_block == NULL) {
-          // (a) Unreachable.
-          if (clause->is_default()) {
-            continue;  // Might still be reachable clause bodies.
-          } else {
-            break;
-          }
-        } else {
-          // (b) Reachable only as fall through.
-          set_current_block(fall_through_block);
-        }
-      } else if (fall_through_block == NULL) {
-        // (c) Reachable only normally.
-        set_current_block(normal_block);
-      } else {
-        // (d) Reachable both ways.
-        HBasicBlock* join = CreateJoin(fall_through_block,
-                                       normal_block,
-                                       clause->EntryId());
-        set_current_block(join);
-      }
+void LoopBodyChecker::VisitBinaryOperation(BinaryOperation* expr) {
+  node_count_++;
+  Visit(expr->left());
+  Visit(expr->right());
+}
 
-      CHECK_BAILOUT(VisitStatements(clause->statements()));
-      fall_through_block = current_block();
-    }
-  }
 
-  // Create an up-to-3-way join.  Use the break block if it exists since
-  // it's already a join block.
-  HBasicBlock* break_block = break_info.break_block();
-  if (break_block == NULL) {
-    set_current_block(CreateJoin(fall_through_block,
-                                 last_block,
-                                 stmt->ExitId()));
-  } else {
-    if (fall_through_block != NULL) fall_through_block->Goto(break_block);
-    if (last_block != NULL) last_block->Goto(break_block);
-    break_block->SetJoinId(stmt->ExitId());
-    set_current_block(break_block);
-  }
+void LoopBodyChecker::VisitCompareOperation(CompareOperation* expr) {
+  node_count_++;
+  Visit(expr->left());
+  Visit(expr->right());
+}
+
+
+void LoopBodyChecker::VisitThisFunction(ThisFunction* expr) {
+  node_count_++;
 }
 
 
@@ -6008,6 +7734,11 @@ bool HOptimizedGraphBuilder::HasOsrEntryAt(IterationStatement* statement) {
 
 bool HOptimizedGraphBuilder::PreProcessOsrEntry(IterationStatement* statement) {
   if (!HasOsrEntryAt(statement)) return false;
+  // Full code does not patch the back edges of loops in try statements.
+  if (graph()->try_region() != NULL) {
+    Bailout("OSR entry in try statement");
+    return false;
+  }
 
   HBasicBlock* non_osr_entry = graph()->CreateBasicBlock();
   HBasicBlock* osr_entry = graph()->CreateBasicBlock();
@@ -6057,18 +7788,437 @@ bool HOptimizedGraphBuilder::PreProcessOsrEntry(IterationStatement* statement) {
 }
 
 
-void HOptimizedGraphBuilder::VisitLoopBody(IterationStatement* stmt,
-                                           HBasicBlock* loop_entry,
-                                           BreakAndContinueInfo* break_info) {
-  BreakAndContinueScope push(break_info, this);
-  AddSimulate(stmt->StackCheckId());
-  HValue* context = environment()->LookupContext();
-  HStackCheck* stack_check =
-    new(zone()) HStackCheck(context, HStackCheck::kBackwardsBranch);
-  AddInstruction(stack_check);
-  ASSERT(loop_entry->IsLoopHeader());
-  loop_entry->loop_information()->set_stack_check(stack_check);
-  CHECK_BAILOUT(Visit(stmt->body()));
+void HOptimizedGraphBuilder::VisitLoopBody(IterationStatement* stmt,
+                                           HBasicBlock* loop_entry,
+                                           BreakAndContinueInfo* break_info) {
+  BreakAndContinueScope push(break_info, this);
+  AddSimulate(stmt->StackCheckId());
+  HValue* context = environment()->LookupContext();
+  HStackCheck* stack_check =
+    new(zone()) HStackCheck(context, HStackCheck::kBackwardsBranch);
+  AddInstruction(stack_check);
+  ASSERT(loop_entry->IsLoopHeader());
+  loop_entry->loop_information()->set_stack_check(stack_check);
+  CHECK_BAILOUT(Visit(stmt->body()));
+}
+
+
+bool HOptimizedGraphBuilder::IsCopyableLoop(IterationStatement* stmt,
+                                            LoopBodyChecker* checker) {
+  if (!FLAG_loop_peeling && !FLAG_loop_unrolling) return false;
+  // The OSR entry must be built exactly once.
+  if (HasOsrEntryAt(stmt)) return false;
+  checker->Check(stmt);
+  return checker->is_copyable();
+}
+
+
+bool HOptimizedGraphBuilder::ShouldPeelLoop(IterationStatement* stmt,
+                                            LoopBodyChecker* checker) {
+  if (!FLAG_loop_peeling ||
+      checker->node_count() > FLAG_max_peeled_loop_nodes) {
+    return false;
+  }
+  if (FLAG_trace_loop_unrolling) {
+    PrintF("[loop unrolling: peeling loop at %d]\n", stmt->statement_pos());
+  }
+  return true;
+}
+
+
+int HOptimizedGraphBuilder::LoopUnrollingFactor(ForStatement* stmt,
+                                                LoopBodyChecker* checker) {
+  if (!FLAG_loop_unrolling) return 1;
+  // Every copy adds an exit to the loop, while bounds check hoisting needs
+  // the loop condition to be the only one.  Loops indexing into arrays are
+  // left to the latter.
+  if (FLAG_array_bounds_checks_hoisting && checker->has_keyed_property()) {
+    return 1;
+  }
+  // Only unroll counted loops, i.e. loops of the form
+  // for (...; i < n; i++) where the test is a comparison and the update a
+  // count operation or an assignment.
+  if (stmt->cond() == NULL || stmt->cond()->AsCompareOperation() == NULL) {
+    return 1;
+  }
+  if (stmt->next() == NULL) return 1;
+  ExpressionStatement* next = stmt->next()->AsExpressionStatement();
+  if (next == NULL) return 1;
+  if (next->expression()->AsCountOperation() == NULL &&
+      next->expression()->AsAssignment() == NULL) {
+    return 1;
+  }
+  int node_count = Max(checker->node_count(), 1);
+  int factor = Min(FLAG_loop_unrolling_factor,
+                   FLAG_max_unrolled_loop_nodes / node_count);
+  if (factor < 2) return 1;
+  if (FLAG_trace_loop_unrolling) {
+    PrintF("[loop unrolling: unrolling loop at %d %d times]\n",
+           stmt->statement_pos(), factor);
+  }
+  return factor;
+}
+
+
+static Variable* StackVariable(Expression* expr) {
+  VariableProxy* proxy = expr == NULL ? NULL : expr->AsVariableProxy();
+  if (proxy == NULL || !proxy->var()->IsStackAllocated()) return NULL;
+  return proxy->var();
+}
+
+
+// Translates the value stored by a vectorizable loop into the postfix program
+// of an HVectorLoop and collects the arrays and loop invariant values it
+// uses.  Array 0 is the one stored to, arrays 1 and up are loaded from.
+class VectorLoopAnalyzer {
+ public:
+  VectorLoopAnalyzer(Variable* index, TypeFeedbackOracle* oracle, Zone* zone)
+      : index_(index),
+        oracle_(oracle),
+        zone_(zone),
+        elements_kind_(EXTERNAL_DOUBLE_ELEMENTS),
+        array_count_(0),
+        scalar_count_(0),
+        program_length_(0),
+        depth_(0) { }
+
+  // Accepts out[i] = e, where every element access is monomorphic.
+  bool AnalyzeStore(Assignment* assignment);
+
+  ElementsKind elements_kind() const { return elements_kind_; }
+  int array_count() const { return array_count_; }
+  Variable* array(int i) const { return arrays_[i]; }
+  Handle<Map> map(int i) const { return maps_[i]; }
+  int scalar_count() const { return scalar_count_; }
+  Expression* scalar(int i) const { return scalars_[i]; }
+  int program_length() const { return program_length_; }
+  HVectorLoop::Op program_at(int i) const { return program_[i]; }
+
+ private:
+  static const int kMaxArrays = 1 + HVectorLoop::kMaxLoads;
+
+  bool is_int32_kernel() const {
+    return elements_kind_ == EXTERNAL_INT_ELEMENTS;
+  }
+
+  bool IsElementAccess(Property* prop) const {
+    Variable* array = StackVariable(prop->obj());
+    return array != NULL && array != index_ &&
+        StackVariable(prop->key()) == index_;
+  }
+
+  bool AddArray(Variable* array, Handle<Map> map, int* slot);
+  bool AddExpression(Expression* expr);
+  bool AddLoad(Property* prop);
+  bool AddScalar(Expression* expr);
+  bool AddBinaryOperation(BinaryOperation* expr);
+  bool IsNumberOperand(Expression* operand, TypeInfo info);
+  bool Emit(HVectorLoop::Op op, int depth_change);
+
+  Variable* index_;
+  TypeFeedbackOracle* oracle_;
+  Zone* zone_;
+  ElementsKind elements_kind_;
+  int array_count_;
+  Variable* arrays_[kMaxArrays];
+  Handle<Map> maps_[kMaxArrays];
+  int scalar_count_;
+  Expression* scalars_[HVectorLoop::kMaxScalars];
+  int program_length_;
+  HVectorLoop::Op program_[HVectorLoop::kMaxProgramLength];
+  int depth_;
+};
+
+
+bool VectorLoopAnalyzer::AnalyzeStore(Assignment* assignment) {
+  if (assignment->op() != Token::ASSIGN) return false;
+  Property* target = assignment->target()->AsProperty();
+  if (target == NULL || !IsElementAccess(target)) return false;
+  assignment->RecordTypeFeedback(oracle_, zone_);
+  if (!assignment->IsMonomorphic()) return false;
+  int slot;
+  if (!AddArray(StackVariable(target->obj()),
+                assignment->GetMonomorphicReceiverType(),
+                &slot)) {
+    return false;
+  }
+  return AddExpression(assignment->value()) && depth_ == 1;
+}
+
+
+bool VectorLoopAnalyzer::AddArray(Variable* array,
+                                  Handle<Map> map,
+                                  int* slot) {
+  if (map.is_null()) return false;
+  ElementsKind kind = map->elements_kind();
+  if (kind != EXTERNAL_FLOAT_ELEMENTS &&
+      kind != EXTERNAL_DOUBLE_ELEMENTS &&
+      kind != EXTERNAL_INT_ELEMENTS) {
+    return false;
+  }
+  if (array_count_ == 0) {
+    elements_kind_ = kind;
+  } else if (kind != elements_kind_) {
+    return false;
+  }
+  // The stored array always gets a slot of its own, loads share theirs.
+  for (int i = 1; i < array_count_; ++i) {
+    if (arrays_[i] == array) {
+      *slot = i;
+      return maps_[i].is_identical_to(map);
+    }
+  }
+  if (array_count_ == kMaxArrays) return false;
+  arrays_[array_count_] = array;
+  maps_[array_count_] = map;
+  *slot = array_count_++;
+  return true;
+}
+
+
+bool VectorLoopAnalyzer::AddExpression(Expression* expr) {
+  Property* prop = expr->AsProperty();
+  if (prop != NULL) return AddLoad(prop);
+  BinaryOperation* binop = expr->AsBinaryOperation();
+  if (binop != NULL) return AddBinaryOperation(binop);
+  return AddScalar(expr);
+}
+
+
+bool VectorLoopAnalyzer::AddLoad(Property* prop) {
+  if (!IsElementAccess(prop)) return false;
+  prop->RecordTypeFeedback(oracle_, zone_);
+  if (!prop->IsMonomorphic()) return false;
+  int slot;
+  if (!AddArray(StackVariable(prop->obj()),
+                prop->GetMonomorphicReceiverType(),
+                &slot)) {
+    return false;
+  }
+  return Emit(static_cast<HVectorLoop::Op>(HVectorLoop::kLoad0 + slot - 1), 1);
+}
+
+
+bool VectorLoopAnalyzer::AddScalar(Expression* expr) {
+  Variable* var = StackVariable(expr);
+  Literal* literal = expr->AsLiteral();
+  if (literal != NULL) {
+    if (!literal->handle()->IsNumber()) return false;
+    if (is_int32_kernel() && !literal->handle()->IsSmi()) return false;
+  } else if (var == NULL || var == index_) {
+    return false;
+  }
+  int slot = 0;
+  while (slot < scalar_count_ &&
+         (var == NULL || StackVariable(scalars_[slot]) != var)) {
+    ++slot;
+  }
+  if (slot == scalar_count_) {
+    if (scalar_count_ == HVectorLoop::kMaxScalars) return false;
+    scalars_[scalar_count_++] = expr;
+  }
+  return Emit(static_cast<HVectorLoop::Op>(HVectorLoop::kScalar0 + slot), 1);
+}
+
+
+bool VectorLoopAnalyzer::AddBinaryOperation(BinaryOperation* expr) {
+  HVectorLoop::Op op;
+  switch (expr->op()) {
+    case Token::ADD: op = HVectorLoop::kAdd; break;
+    case Token::SUB: op = HVectorLoop::kSub; break;
+    case Token::MUL: op = HVectorLoop::kMul; break;
+    case Token::DIV: op = HVectorLoop::kDiv; break;
+    default: return false;
+  }
+  // Int32 lanes wrap around the same way the final store truncates, but
+  // that only holds while the double result is exact.
+  if (is_int32_kernel() && op != HVectorLoop::kAdd &&
+      op != HVectorLoop::kSub) {
+    return false;
+  }
+  TypeInfo left_info, right_info, result_info;
+  oracle_->BinaryType(expr, &left_info, &right_info, &result_info);
+  return IsNumberOperand(expr->left(), left_info) &&
+      IsNumberOperand(expr->right(), right_info) &&
+      AddExpression(expr->left()) &&
+      AddExpression(expr->right()) &&
+      Emit(op, -1);
+}
+
+
+bool VectorLoopAnalyzer::IsNumberOperand(Expression* operand, TypeInfo info) {
+  if (info.IsUninitialized() || !info.IsNumber()) return false;
+  // Loop invariant values are put into int32 lanes without a conversion.
+  if (is_int32_kernel() && operand->AsProperty() == NULL &&
+      operand->AsBinaryOperation() == NULL) {
+    return info.IsInteger32();
+  }
+  return true;
+}
+
+
+bool VectorLoopAnalyzer::Emit(HVectorLoop::Op op, int depth_change) {
+  if (program_length_ == HVectorLoop::kMaxProgramLength) return false;
+  program_[program_length_++] = op;
+  depth_ += depth_change;
+  return depth_ <= HVectorLoop::kMaxStackDepth;
+}
+
+
+bool HOptimizedGraphBuilder::TryVectorizeLoop(ForStatement* stmt) {
+#if V8_TARGET_ARCH_X64
+  if (!FLAG_vectorize_loops) return false;
+
+  // The loop must be for (...; i < n; i++) or ++i with n a local or a small
+  // integer literal.
+  CompareOperation* cond =
+      stmt->cond() == NULL ? NULL : stmt->cond()->AsCompareOperation();
+  if (cond == NULL || cond->op() != Token::LT) return false;
+  Variable* index = StackVariable(cond->left());
+  if (index == NULL) return false;
+  Variable* bound = StackVariable(cond->right());
+  Literal* bound_literal = cond->right()->AsLiteral();
+  if (bound == index) return false;
+  if (bound == NULL &&
+      (bound_literal == NULL || !bound_literal->handle()->IsSmi())) {
+    return false;
+  }
+  ExpressionStatement* next =
+      stmt->next() == NULL ? NULL : stmt->next()->AsExpressionStatement();
+  CountOperation* increment =
+      next == NULL ? NULL : next->expression()->AsCountOperation();
+  if (increment == NULL || increment->op() != Token::INC ||
+      StackVariable(increment->expression()) != index) {
+    return false;
+  }
+
+  // The body must be a single store out[i] = e.
+  Statement* body = stmt->body();
+  Block* block = body->AsBlock();
+  if (block != NULL) {
+    if (block->scope() != NULL || block->statements()->length() != 1) {
+      return false;
+    }
+    body = block->statements()->at(0);
+  }
+  ExpressionStatement* store = body->AsExpressionStatement();
+  Assignment* assignment =
+      store == NULL ? NULL : store->expression()->AsAssignment();
+  if (assignment == NULL) return false;
+  VectorLoopAnalyzer analyzer(index, oracle(), zone());
+  if (!analyzer.AnalyzeStore(assignment)) return false;
+
+  // Variables in their temporal dead zone are left to the loop to report.
+  HValue* hole = graph()->GetConstantHole();
+  if (environment()->Lookup(index) == hole) return false;
+  if (bound != NULL && environment()->Lookup(bound) == hole) return false;
+  for (int i = 0; i < analyzer.array_count(); ++i) {
+    if (environment()->Lookup(analyzer.array(i)) == hole) return false;
+  }
+  for (int i = 0; i < analyzer.scalar_count(); ++i) {
+    Variable* var = StackVariable(analyzer.scalar(i));
+    if (var != NULL && environment()->Lookup(var) == hole) return false;
+  }
+
+  if (FLAG_trace_vectorization) {
+    PrintF("[vectorizing loop at %d over %s]\n",
+           stmt->statement_pos(),
+           ElementsKindToString(analyzer.elements_kind()));
+  }
+
+  // The kernel stops at the shortest of the arrays, so it needs no bounds
+  // checks.
+  HValue* context = environment()->LookupContext();
+  HValue* limit = bound != NULL
+      ? environment()->Lookup(bound)
+      : AddInstruction(new(zone()) HConstant(bound_literal->handle(),
+                                             Representation::Integer32()));
+  HValue* pointers[1 + HVectorLoop::kMaxLoads];
+  for (int i = 0; i < analyzer.array_count(); ++i) {
+    HValue* array = environment()->Lookup(analyzer.array(i));
+    BuildCheckNonSmi(array);
+    HCheckMaps* check = HCheckMaps::New(array, analyzer.map(i), zone());
+    AddInstruction(check);
+    HValue* elements = AddLoadElements(array, check);
+    HValue* length = AddInstruction(new(zone()) HFixedArrayBaseLength(elements));
+    HInstruction* min = HMathMinMax::New(
+        zone(), context, limit, length, HMathMinMax::kMathMin);
+    min->AssumeRepresentation(Representation::Integer32());
+    limit = AddInstruction(min);
+    pointers[i] =
+        AddInstruction(new(zone()) HLoadExternalArrayPointer(elements));
+  }
+  for (int i = analyzer.array_count(); i <= HVectorLoop::kMaxLoads; ++i) {
+    pointers[i] = pointers[0];
+  }
+  HValue* scalars[HVectorLoop::kMaxScalars];
+  for (int i = 0; i < HVectorLoop::kMaxScalars; ++i) {
+    if (i >= analyzer.scalar_count()) {
+      scalars[i] = graph()->GetConstant0();
+      continue;
+    }
+    Literal* literal = analyzer.scalar(i)->AsLiteral();
+    scalars[i] = literal != NULL
+        ? AddInstruction(new(zone()) HConstant(literal->handle(),
+                                               Representation::None()))
+        : environment()->Lookup(StackVariable(analyzer.scalar(i)));
+  }
+
+  HVectorLoop* kernel = new(zone()) HVectorLoop(
+      environment()->Lookup(index), limit, pointers[0], pointers + 1,
+      scalars, analyzer.elements_kind());
+  for (int i = 0; i < analyzer.program_length(); ++i) {
+    kernel->AddOp(analyzer.program_at(i));
+  }
+  AddInstruction(kernel);
+  // Resume in front of the loop condition, where the loop picks up the
+  // remaining iterations.
+  environment()->Bind(index, kernel);
+  AddSimulate(stmt->ConditionId());
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+void HOptimizedGraphBuilder::VisitLoopIteration(IterationStatement* stmt,
+                                                Expression* cond,
+                                                BailoutId body_id,
+                                                Statement* next,
+                                                HBasicBlock** loop_exit) {
+  if (cond != NULL && !cond->ToBooleanIsTrue()) {
+    HBasicBlock* body_entry = graph()->CreateBasicBlock();
+    HBasicBlock* cond_false = graph()->CreateBasicBlock();
+    CHECK_BAILOUT(VisitForControl(cond, body_entry, cond_false));
+    if (cond_false->HasPredecessor()) {
+      cond_false->SetJoinId(stmt->ExitId());
+      *loop_exit = CreateJoin(*loop_exit, cond_false, stmt->ExitId());
+    }
+    if (!body_entry->HasPredecessor()) {
+      set_current_block(NULL);
+      return;
+    }
+    body_entry->SetJoinId(body_id);
+    set_current_block(body_entry);
+  }
+
+  BreakAndContinueInfo break_info(stmt);
+  { BreakAndContinueScope push(&break_info, this);
+    CHECK_BAILOUT(Visit(stmt->body()));
+  }
+  HBasicBlock* body_exit =
+      JoinContinue(stmt, current_block(), break_info.continue_block());
+  HBasicBlock* break_block = break_info.break_block();
+  if (break_block != NULL) {
+    break_block->SetJoinId(stmt->ExitId());
+    *loop_exit = CreateJoin(*loop_exit, break_block, stmt->ExitId());
+  }
+
+  set_current_block(body_exit);
+  if (next != NULL && body_exit != NULL) {
+    CHECK_BAILOUT(Visit(next));
+  }
 }
 
 
@@ -6120,6 +8270,17 @@ void HOptimizedGraphBuilder::VisitWhileStatement(WhileStatement* stmt) {
   ASSERT(current_block() != NULL);
   ASSERT(current_block()->HasPredecessor());
   ASSERT(current_block() != NULL);
+  HBasicBlock* peeled_exit = NULL;
+  LoopBodyChecker checker;
+  if (IsCopyableLoop(stmt, &checker) && ShouldPeelLoop(stmt, &checker)) {
+    CHECK_BAILOUT(VisitLoopIteration(stmt, stmt->cond(), stmt->BodyId(), NULL,
+                                     &peeled_exit));
+    if (current_block() == NULL) {
+      set_current_block(peeled_exit);
+      return;
+    }
+  }
+
   bool osr_entry = PreProcessOsrEntry(stmt);
   HBasicBlock* loop_entry = CreateLoopHeaderBlock();
   current_block()->Goto(loop_entry);
@@ -6155,7 +8316,7 @@ void HOptimizedGraphBuilder::VisitWhileStatement(WhileStatement* stmt) {
                                       body_exit,
                                       loop_successor,
                                       break_info.break_block());
-  set_current_block(loop_exit);
+  set_current_block(CreateJoin(peeled_exit, loop_exit, stmt->ExitId()));
 }
 
 
@@ -6167,6 +8328,24 @@ void HOptimizedGraphBuilder::VisitForStatement(ForStatement* stmt) {
     CHECK_ALIVE(Visit(stmt->init()));
   }
   ASSERT(current_block() != NULL);
+  HBasicBlock* peeled_exit = NULL;
+  int unrolling_factor = 1;
+  LoopBodyChecker checker;
+  // After a vectorized kernel the loop only runs the last few iterations,
+  // which are not worth copying.
+  bool vectorized = TryVectorizeLoop(stmt);
+  if (!vectorized && IsCopyableLoop(stmt, &checker)) {
+    if (ShouldPeelLoop(stmt, &checker)) {
+      CHECK_BAILOUT(VisitLoopIteration(stmt, stmt->cond(), stmt->BodyId(),
+                                       stmt->next(), &peeled_exit));
+      if (current_block() == NULL) {
+        set_current_block(peeled_exit);
+        return;
+      }
+    }
+    unrolling_factor = LoopUnrollingFactor(stmt, &checker);
+  }
+
   bool osr_entry = PreProcessOsrEntry(stmt);
   HBasicBlock* loop_entry = CreateLoopHeaderBlock();
   current_block()->Goto(loop_entry);
@@ -6202,12 +8381,23 @@ void HOptimizedGraphBuilder::VisitForStatement(ForStatement* stmt) {
     body_exit = current_block();
   }
 
+  // The remaining copies of an unrolled loop each re-test the condition, so
+  // no remainder loop is needed.
+  HBasicBlock* unrolled_exit = NULL;
+  for (int i = 1; i < unrolling_factor && body_exit != NULL; ++i) {
+    set_current_block(body_exit);
+    CHECK_BAILOUT(VisitLoopIteration(stmt, stmt->cond(), stmt->BodyId(),
+                                     stmt->next(), &unrolled_exit));
+    body_exit = current_block();
+  }
+
   HBasicBlock* loop_exit = CreateLoop(stmt,
                                       loop_entry,
                                       body_exit,
                                       loop_successor,
                                       break_info.break_block());
-  set_current_block(loop_exit);
+  loop_exit = CreateJoin(loop_exit, unrolled_exit, stmt->ExitId());
+  set_current_block(CreateJoin(peeled_exit, loop_exit, stmt->ExitId()));
 }
 
 
@@ -6333,11 +8523,118 @@ void HOptimizedGraphBuilder::VisitForInStatement(ForInStatement* stmt) {
 }
 
 
+HEnterTry* HOptimizedGraphBuilder::BuildEnterTry(
+    TryStatement* stmt,
+    StackHandler::Kind kind,
+    BailoutId finally_return_id) {
+  HBasicBlock* try_entry = graph()->CreateBasicBlock();
+  HBasicBlock* landing_pad = graph()->CreateBasicBlock();
+  int handler_height =
+      environment()->length() - environment()->first_expression_index();
+  HEnterTry* entry = new(zone()) HEnterTry(kind,
+                                           stmt->index(),
+                                           handler_height,
+                                           finally_return_id,
+                                           try_entry,
+                                           landing_pad);
+  current_block()->Finish(entry);
+  landing_pad->MarkAsLandingPad();
+  graph()->MarkHasLandingPads();
+
+  HTryRegion* region = new(zone()) HTryRegion(entry,
+                                              HTryRegion::TRY_BLOCK,
+                                              graph()->try_region(),
+                                              zone());
+  try_entry->set_try_region(region);
+  graph()->set_try_region(region);
+  set_current_block(try_entry);
+  AddSimulate(stmt->try_block()->EntryId());
+  return entry;
+}
+
+
+void HOptimizedGraphBuilder::BuildLeaveTry(TryStatement* stmt,
+                                           HEnterTry* entry) {
+  HTryRegion* region = graph()->try_region();
+  ASSERT(region->entry() == entry);
+  ASSERT(region->kind() == HTryRegion::TRY_BLOCK);
+  graph()->set_try_region(region->outer());
+  HBasicBlock* continuation = current_block();
+  BuildLandingPad(stmt, region);
+  set_current_block(continuation);
+  if (current_block() == NULL) return;
+  AddInstruction(new(zone()) HLeaveTry(entry));
+  // Every block lies in a single try region.  The exit block is not a
+  // join, so the goto needs no simulate.
+  HBasicBlock* exit = graph()->CreateBasicBlock();
+  current_block()->Goto(exit, NULL, false);
+  set_current_block(exit);
+}
+
+
+void HOptimizedGraphBuilder::BuildLandingPad(TryStatement* stmt,
+                                            HTryRegion* region) {
+  HEnterTry* entry = region->entry();
+  HBasicBlock* landing_pad = entry->landing_pad();
+  const ZoneList<int>* slots = region->assigned_slots();
+  // The try slots hold the values from the start of the try block until
+  // the variables are assigned.
+  HEnvironment* entry_environment = landing_pad->last_environment();
+  for (int i = 0; i < slots->length(); i++) {
+    int slot = slots->at(i);
+    HValue* value = entry_environment->Lookup(graph()->TrySlotVariable(slot));
+    HStoreTrySlot* store = new(zone()) HStoreTrySlot(slot, value);
+    store->InsertBefore(entry);
+  }
+
+  // The landing pad sees the environment at the start of the try block,
+  // with the assigned variables taken from their try slots.
+  set_current_block(landing_pad);
+  HCatchEntry* exception = new(zone()) HCatchEntry(entry);
+  AddInstruction(exception);
+  for (int i = 0; i < slots->length(); i++) {
+    int slot = slots->at(i);
+    HLoadTrySlot* value = new(zone()) HLoadTrySlot(slot);
+    AddInstruction(value);
+    environment()->Bind(graph()->TrySlotVariable(slot), value);
+  }
+  Push(exception);
+  AddSimulate(stmt->HandlerId());
+  current_block()->FinishExitWithDeoptimization(HDeoptimize::kUseAll);
+  set_current_block(NULL);
+}
+
+
+bool HOptimizedGraphBuilder::LeaveTryRegions(HTryRegion* target) {
+  for (HTryRegion* region = graph()->try_region();
+       region != target;
+       region = region->outer()) {
+    ASSERT(region != NULL);
+    if (region->kind() != HTryRegion::TRY_BLOCK) continue;
+    if (region->entry()->kind() == StackHandler::FINALLY) {
+      Bailout("jump out of try-finally block");
+      return false;
+    }
+    AddInstruction(new(zone()) HLeaveTry(region->entry()));
+  }
+  return true;
+}
+
+
 void HOptimizedGraphBuilder::VisitTryCatchStatement(TryCatchStatement* stmt) {
   ASSERT(!HasStackOverflow());
   ASSERT(current_block() != NULL);
   ASSERT(current_block()->HasPredecessor());
-  return Bailout("TryCatchStatement");
+  if (!FLAG_optimize_try_statements) return Bailout("TryCatchStatement");
+  if (function_state()->outer() != NULL) {
+    return Bailout("TryCatchStatement in inlined function");
+  }
+  HEnterTry* entry = BuildEnterTry(stmt, StackHandler::CATCH,
+                                   BailoutId::None());
+  CHECK_BAILOUT(Visit(stmt->try_block()));
+  BuildLeaveTry(stmt, entry);
+  // The catch block only runs in unoptimized code.
+  if (current_block() != NULL) AddSimulate(stmt->ContinuationId());
 }
 
 
@@ -6346,7 +8643,27 @@ void HOptimizedGraphBuilder::VisitTryFinallyStatement(
   ASSERT(!HasStackOverflow());
   ASSERT(current_block() != NULL);
   ASSERT(current_block()->HasPredecessor());
-  return Bailout("TryFinallyStatement");
+  if (!FLAG_optimize_try_statements) return Bailout("TryFinallyStatement");
+  if (function_state()->outer() != NULL) {
+    return Bailout("TryFinallyStatement in inlined function");
+  }
+  HEnterTry* entry = BuildEnterTry(stmt, StackHandler::FINALLY,
+                                   stmt->ContinuationId());
+  CHECK_BAILOUT(Visit(stmt->try_block()));
+  BuildLeaveTry(stmt, entry);
+  if (current_block() == NULL) return;
+
+  // On the normal exit from the try block the finally block runs inline.
+  // Unoptimized code calls it, so its frame holds the return address and
+  // the saved state of the finally block there.
+  HTryRegion* outer = graph()->try_region();
+  graph()->set_try_region(
+      new(zone()) HTryRegion(entry, HTryRegion::FINALLY_BLOCK, outer, zone()));
+  AddSimulate(stmt->finally_block()->EntryId());
+  CHECK_BAILOUT(Visit(stmt->finally_block()));
+  graph()->set_try_region(outer);
+  if (current_block() == NULL) return;
+  AddSimulate(stmt->ContinuationId());
 }
 
 
@@ -7990,18 +10307,8 @@ HInstruction* HOptimizedGraphBuilder::BuildMonomorphicElementAccess(
     mapcheck->ClearGVNFlag(kDependsOnElementsKind);
   }
 
-  // Loads from a "stock" fast holey double arrays can elide the hole check.
-  LoadKeyedHoleMode load_mode = NEVER_RETURN_HOLE;
-  if (*map == isolate()->get_initial_js_array_map(FAST_HOLEY_DOUBLE_ELEMENTS) &&
-      isolate()->IsFastArrayConstructorPrototypeChainIntact()) {
-    Handle<JSObject> prototype(JSObject::cast(map->prototype()), isolate());
-    Handle<JSObject> object_prototype = isolate()->initial_object_prototype();
-    AddInstruction(
-        new(zone()) HCheckPrototypeMaps(prototype, object_prototype, zone()));
-    load_mode = ALLOW_RETURN_HOLE;
-    graph()->MarkDependsOnEmptyArrayProtoElements();
-  }
-
+  LoadKeyedHoleMode load_mode =
+      is_store ? NEVER_RETURN_HOLE : BuildKeyedHoleMode(map);
   return BuildUncheckedMonomorphicElementAccess(
       object, key, val,
       mapcheck, map->instance_type() == JS_ARRAY_TYPE,
@@ -8009,6 +10316,24 @@ HInstruction* HOptimizedGraphBuilder::BuildMonomorphicElementAccess(
 }
 
 
+LoadKeyedHoleMode HOptimizedGraphBuilder::BuildKeyedHoleMode(
+    Handle<Map> map) {
+  // Holes in fast arrays read as undefined without a hole check as long as
+  // the array protector guarantees an element-free prototype chain.
+  // Double loads keep their hole check: the hole NaN would be tagged as
+  // the hole rather than undefined.
+  if (map->instance_type() == JS_ARRAY_TYPE &&
+      IsFastHoleyElementsKind(map->elements_kind()) &&
+      !IsFastDoubleElementsKind(map->elements_kind()) &&
+      map->prototype() == *isolate()->initial_array_prototype() &&
+      isolate()->IsArrayProtectorIntact()) {
+    graph()->MarkDependsOnArrayProtector();
+    return CONVERT_HOLE_TO_UNDEFINED;
+  }
+  return NEVER_RETURN_HOLE;
+}
+
+
 HInstruction* HOptimizedGraphBuilder::TryBuildConsolidatedElementLoad(
     HValue* object,
     HValue* key,
@@ -8054,13 +10379,27 @@ HInstruction* HOptimizedGraphBuilder::TryBuildConsolidatedElementLoad(
   }
   if (!has_double_maps && !has_smi_or_object_maps) return NULL;
 
+  // Only the most general map can produce holes, but the hole mode derived
+  // from it is valid only if all maps share its prototype.
+  LoadKeyedHoleMode load_mode = NEVER_RETURN_HOLE;
+  bool same_prototype = true;
+  for (int i = 0; i < maps->length(); ++i) {
+    if (maps->at(i)->prototype() !=
+        most_general_consolidated_map->prototype()) {
+      same_prototype = false;
+    }
+  }
+  if (same_prototype) {
+    load_mode = BuildKeyedHoleMode(most_general_consolidated_map);
+  }
+
   HCheckMaps* check_maps = HCheckMaps::New(object, maps, zone());
   AddInstruction(check_maps);
   HInstruction* instr = BuildUncheckedMonomorphicElementAccess(
       object, key, val, check_maps,
       most_general_consolidated_map->instance_type() == JS_ARRAY_TYPE,
       most_general_consolidated_map->elements_kind(),
-      false, NEVER_RETURN_HOLE, STANDARD_STORE);
+      false, load_mode, STANDARD_STORE);
   return instr;
 }
 
@@ -8789,8 +11128,10 @@ bool HOptimizedGraphBuilder::TryInline(CallKind call_kind,
   }
 
 #if !defined(V8_TARGET_ARCH_IA32)
-  // Target must be able to use caller's context.
-  CompilationInfo* outer_info = info();
+  // Target must be able to use caller's context.  Inlined functions run in
+  // the context of the outermost function, which differs from the context
+  // of an inlined builtin calling the target.
+  CompilationInfo* outer_info = graph()->info();
   if (target->context() != outer_info->closure()->context() ||
       outer_info->scope()->contains_with() ||
       outer_info->scope()->num_heap_slots() > 0) {
@@ -8801,17 +11142,9 @@ bool HOptimizedGraphBuilder::TryInline(CallKind call_kind,
 
 
   // Don't inline deeper than kMaxInliningLevels calls.
-  HEnvironment* env = environment();
-  int current_level = 1;
-  while (env->outer() != NULL) {
-    if (current_level == Compiler::kMaxInliningLevels) {
-      TraceInline(target, caller, "inline depth limit reached");
-      return false;
-    }
-    if (env->outer()->frame_type() == JS_FUNCTION) {
-      current_level++;
-    }
-    env = env->outer();
+  if (InliningDepthLimitReached()) {
+    TraceInline(target, caller, "inline depth limit reached");
+    return false;
   }
 
   // Don't inline recursive functions.
@@ -8890,27 +11223,9 @@ bool HOptimizedGraphBuilder::TryInline(CallKind call_kind,
     }
   }
 
-  // Generate the deoptimization data for the unoptimized version of
-  // the target function if we don't already have it.
-  if (!target_shared->has_deoptimization_support()) {
-    // Note that we compile here using the same AST that we will use for
-    // generating the optimized inline code.
-    target_info.EnableDeoptimizationSupport();
-    if (!FullCodeGenerator::MakeCode(&target_info)) {
-      TraceInline(target, caller, "could not generate deoptimization info");
-      return false;
-    }
-    if (target_shared->scope_info() == ScopeInfo::Empty(isolate())) {
-      // The scope info might not have been set if a lazily compiled
-      // function is inlined before being called for the first time.
-      Handle<ScopeInfo> target_scope_info =
-          ScopeInfo::Create(target_info.scope(), zone());
-      target_shared->set_scope_info(*target_scope_info);
-    }
-    target_shared->EnableDeoptimizationSupport(*target_info.code());
-    Compiler::RecordFunctionCompilation(Logger::FUNCTION_TAG,
-                                        &target_info,
-                                        target_shared);
+  if (!EnsureDeoptimizationSupport(&target_info)) {
+    TraceInline(target, caller, "could not generate deoptimization info");
+    return false;
   }
 
   // ----------------------------------------------------------------
@@ -9050,7 +11365,53 @@ bool HOptimizedGraphBuilder::TryInline(CallKind call_kind,
     }
   }
 
-  // Fix up the function exits.
+  FixUpInlinedExits(target_state, ast_id);
+  return true;
+}
+
+
+bool HOptimizedGraphBuilder::InliningDepthLimitReached() {
+  HEnvironment* env = environment();
+  int current_level = 1;
+  while (env->outer() != NULL) {
+    if (current_level == Compiler::kMaxInliningLevels) return true;
+    if (env->outer()->frame_type() == JS_FUNCTION) {
+      current_level++;
+    }
+    env = env->outer();
+  }
+  return false;
+}
+
+
+bool HOptimizedGraphBuilder::EnsureDeoptimizationSupport(
+    CompilationInfo* target_info) {
+  // Generate the deoptimization data for the unoptimized version of
+  // the target function if we don't already have it.
+  Handle<SharedFunctionInfo> target_shared(target_info->closure()->shared());
+  if (target_shared->has_deoptimization_support()) return true;
+
+  // Note that we compile here using the same AST that we will use for
+  // generating the optimized inline code.
+  target_info->EnableDeoptimizationSupport();
+  if (!FullCodeGenerator::MakeCode(target_info)) return false;
+  if (target_shared->scope_info() == ScopeInfo::Empty(isolate())) {
+    // The scope info might not have been set if a lazily compiled
+    // function is inlined before being called for the first time.
+    Handle<ScopeInfo> target_scope_info =
+        ScopeInfo::Create(target_info->scope(), zone());
+    target_shared->set_scope_info(*target_scope_info);
+  }
+  target_shared->EnableDeoptimizationSupport(*target_info->code());
+  Compiler::RecordFunctionCompilation(Logger::FUNCTION_TAG,
+                                      target_info,
+                                      target_shared);
+  return true;
+}
+
+
+void HOptimizedGraphBuilder::FixUpInlinedExits(FunctionState* target_state,
+                                               BailoutId ast_id) {
   if (inlined_test_context() != NULL) {
     HBasicBlock* if_true = inlined_test_context()->if_true();
     HBasicBlock* if_false = inlined_test_context()->if_false();
@@ -9072,7 +11433,7 @@ bool HOptimizedGraphBuilder::TryInline(CallKind call_kind,
       if_false->Goto(false_target, function_state());
     }
     set_current_block(NULL);
-    return true;
+    return;
 
   } else if (function_return()->HasPredecessor()) {
     function_return()->SetJoinId(ast_id);
@@ -9081,7 +11442,6 @@ bool HOptimizedGraphBuilder::TryInline(CallKind call_kind,
     set_current_block(NULL);
   }
   delete target_state;
-  return true;
 }
 
 
@@ -9351,6 +11711,14 @@ bool HOptimizedGraphBuilder::TryInlineBuiltinMethodCall(
         return true;
       }
       break;
+    case kArrayForEach:
+    case kArrayMap:
+    case kArrayFilter:
+    case kArrayReduce:
+      if (check_type == RECEIVER_MAP_CHECK) {
+        return TryInlineArrayIteration(expr, receiver, receiver_map, id);
+      }
+      break;
     default:
       // Not yet supported for inlining.
       break;
@@ -9359,6 +11727,562 @@ bool HOptimizedGraphBuilder::TryInlineBuiltinMethodCall(
 }
 
 
+static Expression* StatementExpression(Statement* stmt) {
+  ExpressionStatement* expression_stmt = stmt->AsExpressionStatement();
+  return expression_stmt == NULL ? NULL : expression_stmt->expression();
+}
+
+
+static bool IsRuntimeCall(Expression* expr, Runtime::FunctionId id) {
+  CallRuntime* call = expr == NULL ? NULL : expr->AsCallRuntime();
+  return call != NULL &&
+      call->function() != NULL &&
+      call->function()->function_id == id;
+}
+
+
+// The iteration builtins in array.js run their loop twice, once with
+// debugger stepping and once without.  Returns the loop without stepping,
+// which is the for statement in the else branch of the top level if.
+static ForStatement* FindIterationLoop(FunctionLiteral* function) {
+  ZoneList<Statement*>* body = function->body();
+  for (int i = 0; i < body->length(); i++) {
+    IfStatement* stmt = body->at(i)->AsIfStatement();
+    if (stmt == NULL || !stmt->HasElseStatement()) continue;
+    Block* block = stmt->else_statement()->AsBlock();
+    if (block == NULL) continue;
+    for (int j = 0; j < block->statements()->length(); j++) {
+      ForStatement* loop = block->statements()->at(j)->AsForStatement();
+      if (loop != NULL) return loop;
+    }
+  }
+  return NULL;
+}
+
+
+// Returns the %_CallFunction of the callback in the loop of an iteration
+// builtin.  For map and filter, assignment is set to the store into the
+// accumulator, for reduce to the assignment to current.
+static CallRuntime* FindIterationCall(ForStatement* loop,
+                                      BuiltinFunctionId id,
+                                      Assignment** assignment) {
+  *assignment = NULL;
+  Block* body = loop->body()->AsBlock();
+  if (body == NULL || body->statements()->length() != 1) return NULL;
+  IfStatement* if_present = body->statements()->at(0)->AsIfStatement();
+  if (if_present == NULL) return NULL;
+  Block* present = if_present->then_statement()->AsBlock();
+  if (present == NULL || present->statements()->is_empty()) return NULL;
+  Statement* last = present->statements()->last();
+
+  Expression* call = NULL;
+  if (id == kArrayForEach) {
+    call = StatementExpression(last);
+  } else if (id == kArrayFilter) {
+    IfStatement* if_kept = last->AsIfStatement();
+    if (if_kept == NULL) return NULL;
+    Block* kept = if_kept->then_statement()->AsBlock();
+    if (kept == NULL || kept->statements()->length() != 1) return NULL;
+    Expression* store = StatementExpression(kept->statements()->at(0));
+    *assignment = store == NULL ? NULL : store->AsAssignment();
+    call = if_kept->condition();
+  } else {
+    Expression* store = StatementExpression(last);
+    *assignment = store == NULL ? NULL : store->AsAssignment();
+    if (*assignment != NULL) call = (*assignment)->value();
+  }
+
+  if (!IsRuntimeCall(call, Runtime::kInlineCallFunction)) return NULL;
+  // Receiver, (current,) element, index, array and the callback.
+  int argument_count = id == kArrayReduce ? 6 : 5;
+  if (call->AsCallRuntime()->arguments()->length() != argument_count) {
+    return NULL;
+  }
+  if (id != kArrayForEach) {
+    if (*assignment == NULL) return NULL;
+    bool is_keyed_store = (*assignment)->target()->AsProperty() != NULL;
+    if (is_keyed_store == (id == kArrayReduce)) return NULL;
+  }
+  return call->AsCallRuntime();
+}
+
+
+// Returns the constructor call initializing a top level variable, as in
+// 'var accumulator = new InternalArray(length)'.
+static CallNew* FindConstructorInitialization(FunctionLiteral* function,
+                                              Variable* var) {
+  ZoneList<Statement*>* body = function->body();
+  for (int i = 0; i < body->length(); i++) {
+    Block* block = body->at(i)->AsBlock();
+    if (block == NULL) continue;
+    for (int j = 0; j < block->statements()->length(); j++) {
+      Expression* expr = StatementExpression(block->statements()->at(j));
+      Assignment* assignment = expr == NULL ? NULL : expr->AsAssignment();
+      if (assignment == NULL) continue;
+      VariableProxy* proxy = assignment->target()->AsVariableProxy();
+      if (proxy != NULL && proxy->var() == var) {
+        return assignment->value()->AsCallNew();
+      }
+    }
+  }
+  return NULL;
+}
+
+
+static CallRuntime* FindRuntimeCallStatement(FunctionLiteral* function,
+                                             Runtime::FunctionId id) {
+  ZoneList<Statement*>* body = function->body();
+  for (int i = 0; i < body->length(); i++) {
+    Expression* expr = StatementExpression(body->at(i));
+    if (IsRuntimeCall(expr, id)) return expr->AsCallRuntime();
+  }
+  return NULL;
+}
+
+
+bool HOptimizedGraphBuilder::TryInlineArrayIteration(
+    Call* expr,
+    HValue* receiver,
+    Handle<Map> receiver_map,
+    BuiltinFunctionId id) {
+  if (!FLAG_inline_array_builtins) return false;
+  // The optional receiver argument of the callback is not supported.
+  int argument_count = expr->arguments()->length();
+  if (argument_count != (id == kArrayReduce ? 2 : 1)) return false;
+  SmallMapList* types = expr->GetReceiverTypes();
+  if (types == NULL || types->length() != 1) return false;
+  ElementsKind kind = receiver_map->elements_kind();
+  if (receiver_map->instance_type() != JS_ARRAY_TYPE ||
+      !IsFastElementsKind(kind)) {
+    return false;
+  }
+  // Holes are skipped like absent elements, which is only correct while
+  // the prototype chain has no elements.  Loading a hole from a double
+  // array deoptimizes instead.
+  bool skip_holes = IsFastHoleyElementsKind(kind) &&
+      !IsFastDoubleElementsKind(kind);
+  if (skip_holes &&
+      (receiver_map->prototype() != *isolate()->initial_array_prototype() ||
+       !isolate()->IsArrayProtectorIntact())) {
+    return false;
+  }
+
+  Handle<JSFunction> target = expr->target();
+  Handle<JSFunction> caller = info()->closure();
+  if (InliningDepthLimitReached()) {
+    TraceInline(target, caller, "inline depth limit reached");
+    return false;
+  }
+
+  // Parse the builtin for the variables and AST ids of its unoptimized
+  // code, in which a deoptimization inside the loop resumes.
+  CompilationInfo target_info(target, zone());
+  if (!Parser::Parse(&target_info) || !Scope::Analyze(&target_info)) {
+    if (target_info.isolate()->has_pending_exception()) {
+      SetStackOverflow();
+    }
+    TraceInline(target, caller, "parse failure");
+    return false;
+  }
+  FunctionLiteral* function = target_info.function();
+  Scope* scope = target_info.scope();
+  Handle<Context> native_context(target->context()->native_context());
+
+  // The variables of the builtin are found from their uses in the loop,
+  // since the natives are minified.
+  ForStatement* loop = FindIterationLoop(function);
+  Assignment* assignment = NULL;
+  CallRuntime* call =
+      loop == NULL ? NULL : FindIterationCall(loop, id, &assignment);
+  Variable* receiver_var = NULL;
+  Variable* current_var = NULL;
+  Variable* element_var = NULL;
+  Variable* index_var = NULL;
+  Variable* array_var = NULL;
+  Variable* length_var = NULL;
+  if (call != NULL) {
+    ZoneList<Expression*>* arguments = call->arguments();
+    int element_index = id == kArrayReduce ? 2 : 1;
+    receiver_var = StackVariable(arguments->at(0));
+    if (id == kArrayReduce) current_var = StackVariable(arguments->at(1));
+    element_var = StackVariable(arguments->at(element_index));
+    index_var = StackVariable(arguments->at(element_index + 1));
+    array_var = StackVariable(arguments->at(element_index + 2));
+    CompareOperation* compare =
+        loop->cond() == NULL ? NULL : loop->cond()->AsCompareOperation();
+    if (compare != NULL &&
+        compare->op() == Token::LT &&
+        StackVariable(compare->left()) == index_var) {
+      length_var = StackVariable(compare->right());
+    }
+  }
+  bool has_expected_shape = scope->num_heap_slots() == 0 &&
+      receiver_var != NULL &&
+      (id != kArrayReduce || current_var != NULL) &&
+      element_var != NULL &&
+      index_var != NULL &&
+      array_var != NULL &&
+      length_var != NULL;
+
+  // Map and filter collect their results in an internal array, whose
+  // contents are moved into the result array after the loop.
+  Variable* result_var = NULL;
+  Variable* accumulator_var = NULL;
+  Variable* accumulator_length_var = NULL;
+  CallNew* result_init = NULL;
+  CallNew* accumulator_init = NULL;
+  CallRuntime* move_contents = NULL;
+  Handle<Map> accumulator_map(
+      native_context->internal_array_function()->initial_map());
+  if (has_expected_shape && (id == kArrayMap || id == kArrayFilter)) {
+    Property* store = assignment->target()->AsProperty();
+    accumulator_var = StackVariable(store->obj());
+    if (id == kArrayFilter) {
+      CountOperation* count = store->key()->AsCountOperation();
+      if (count != NULL && count->is_postfix()) {
+        accumulator_length_var = StackVariable(count->expression());
+      }
+    } else if (StackVariable(store->key()) != index_var) {
+      accumulator_var = NULL;
+    }
+    move_contents =
+        FindRuntimeCallStatement(function, Runtime::kMoveArrayContents);
+    if (move_contents != NULL &&
+        StackVariable(move_contents->arguments()->at(0)) == accumulator_var) {
+      result_var = StackVariable(move_contents->arguments()->at(1));
+    }
+    if (result_var != NULL && accumulator_var != NULL) {
+      result_init = FindConstructorInitialization(function, result_var);
+      accumulator_init =
+          FindConstructorInitialization(function, accumulator_var);
+    }
+    has_expected_shape =
+        (id == kArrayMap || accumulator_length_var != NULL) &&
+        result_init != NULL &&
+        result_init->arguments()->is_empty() &&
+        accumulator_init != NULL &&
+        accumulator_init->arguments()->length() == (id == kArrayMap ? 1 : 0) &&
+        accumulator_map->elements_kind() == FAST_HOLEY_ELEMENTS;
+  }
+
+  if (!has_expected_shape) {
+    TraceInline(target, caller, "unexpected builtin structure");
+    return false;
+  }
+
+  if (!EnsureDeoptimizationSupport(&target_info)) {
+    TraceInline(target, caller, "could not generate deoptimization info");
+    return false;
+  }
+
+  // ----------------------------------------------------------------
+  // After this point, we've made a decision to inline the builtin.
+
+  // Check the receiver and the callback in the calling function.
+  AddCheckConstantFunction(expr->holder(), receiver, receiver_map);
+  if (skip_holes) graph()->MarkDependsOnArrayProtector();
+  HValue* callback = environment()->ExpressionStackAt(argument_count - 1);
+  Handle<JSFunction> known_callback;
+  if (callback->IsConstant() &&
+      HConstant::cast(callback)->handle()->IsJSFunction()) {
+    known_callback =
+        Handle<JSFunction>::cast(HConstant::cast(callback)->handle());
+  } else if (callback->IsLoadGlobalCell() &&
+             HLoadGlobalCell::cast(callback)->cell()->value()->IsJSFunction()) {
+    // A callback that is a global function is expected to stay the same.
+    known_callback = Handle<JSFunction>(JSFunction::cast(
+        HLoadGlobalCell::cast(callback)->cell()->value()));
+    AddInstruction(new(zone()) HCheckFunction(callback, known_callback));
+  } else {
+    BuildCheckNonSmi(callback);
+    AddInstruction(HCheckInstanceType::NewIsJSFunction(callback, zone()));
+  }
+  HConstant* undefined = graph()->GetConstantUndefined();
+  HInstruction* callback_receiver =
+      AddInstruction(new(zone()) HWrapReceiver(undefined, callback));
+  HInstruction* length = AddInstruction(
+      HLoadNamedField::NewArrayLength(zone(), receiver, NULL, HType::Smi()));
+
+  ASSERT(target->shared()->has_deoptimization_support());
+  Handle<Code> unoptimized_code(target->shared()->code());
+  TypeFeedbackOracle target_oracle(
+      unoptimized_code, native_context, isolate(), zone());
+  FunctionState* target_state = new FunctionState(
+      this, &target_info, &target_oracle, NORMAL_RETURN);
+
+  HEnvironment* inner_env =
+      environment()->CopyForInlining(target,
+                                     argument_count,
+                                     function,
+                                     undefined,
+                                     function_state()->inlining_kind(),
+                                     false);
+#ifdef V8_TARGET_ARCH_IA32
+  HConstant* target_context =
+      new(zone()) HConstant(Handle<Context>(target->context()),
+                            Representation::Tagged());
+  AddInstruction(target_context);
+  inner_env->BindContext(target_context);
+#endif
+
+  AddSimulate(expr->ReturnId());
+  current_block()->UpdateEnvironment(inner_env);
+  HEnterInlined* enter_inlined =
+      new(zone()) HEnterInlined(target,
+                                argument_count,
+                                function,
+                                function_state()->inlining_kind(),
+                                NULL,
+                                NULL,
+                                false);
+  function_state()->set_entry(enter_inlined);
+  AddInstruction(enter_inlined);
+
+  // The receiver of the callback is what %GetDefaultReceiver computes.
+  Bind(array_var, receiver);
+  Bind(length_var, length);
+  Bind(receiver_var, callback_receiver);
+
+  HCheckMaps* accumulator_check = NULL;
+  if (result_var != NULL) {
+    Bind(result_var, BuildInlinedConstruct(
+        result_init, Handle<JSFunction>(native_context->array_function()),
+        NULL));
+    HValue* accumulator = BuildInlinedConstruct(
+        accumulator_init,
+        Handle<JSFunction>(native_context->internal_array_function()),
+        id == kArrayMap ? length : NULL);
+    Bind(accumulator_var, accumulator);
+    // The accumulator does not escape to the callback, so its map is
+    // stable during the loop.
+    accumulator_check = HCheckMaps::New(accumulator, accumulator_map, zone());
+    AddInstruction(accumulator_check);
+    if (id == kArrayFilter) {
+      Bind(accumulator_length_var, graph()->GetConstant0());
+    }
+  }
+
+  Bind(index_var, graph()->GetConstant0());
+  HBasicBlock* loop_entry = CreateLoopHeaderBlock();
+  current_block()->Goto(loop_entry);
+  set_current_block(loop_entry);
+
+  HCompareIDAndBranch* compare = new(zone()) HCompareIDAndBranch(
+      environment()->Lookup(index_var), length, Token::LT);
+  compare->set_observed_input_representation(Representation::Integer32(),
+                                             Representation::Integer32());
+  HBasicBlock* if_in_bounds = graph()->CreateBasicBlock();
+  HBasicBlock* if_done = graph()->CreateBasicBlock();
+  compare->SetSuccessorAt(0, if_in_bounds);
+  compare->SetSuccessorAt(1, if_done);
+  current_block()->Finish(compare);
+  HBasicBlock* body_entry = graph()->CreateBasicBlock();
+  HBasicBlock* loop_successor = graph()->CreateBasicBlock();
+  if_in_bounds->Goto(body_entry);
+  if_done->Goto(loop_successor);
+  body_entry->SetJoinId(loop->BodyId());
+  loop_successor->SetJoinId(loop->ExitId());
+
+  set_current_block(body_entry);
+  AddSimulate(loop->StackCheckId());
+  HValue* context = environment()->LookupContext();
+  HStackCheck* stack_check =
+      new(zone()) HStackCheck(context, HStackCheck::kBackwardsBranch);
+  AddInstruction(stack_check);
+  loop_entry->loop_information()->set_stack_check(stack_check);
+
+  // The callback may change the elements kind of the array or shrink it,
+  // both of which deoptimize to the unoptimized loop.
+  HCheckMaps* array_check = HCheckMaps::New(receiver, receiver_map, zone());
+  AddInstruction(array_check);
+  HInstruction* element = BuildUncheckedMonomorphicElementAccess(
+      receiver, environment()->Lookup(index_var), NULL, array_check, true,
+      kind, false, skip_holes ? ALLOW_RETURN_HOLE : NEVER_RETURN_HOLE,
+      STANDARD_STORE);
+  HBasicBlock* continue_block = NULL;
+  if (skip_holes) {
+    HBasicBlock* if_hole = graph()->CreateBasicBlock();
+    HBasicBlock* if_element = graph()->CreateBasicBlock();
+    HCompareObjectEqAndBranch* hole_check =
+        new(zone()) HCompareObjectEqAndBranch(element,
+                                              graph()->GetConstantHole());
+    hole_check->SetSuccessorAt(0, if_hole);
+    hole_check->SetSuccessorAt(1, if_element);
+    current_block()->Finish(hole_check);
+    continue_block = graph()->CreateBasicBlock();
+    if_hole->Goto(continue_block);
+    set_current_block(if_element);
+  }
+  Bind(element_var, element);
+
+  if (id == kArrayMap) {
+    // The object and key of the store into the accumulator.
+    Push(environment()->Lookup(accumulator_var));
+    Push(environment()->Lookup(index_var));
+  }
+  // The callback is called in the same ast context as in the builtin, an
+  // effect context for forEach and a value context otherwise.
+  if (id == kArrayForEach) {
+    EffectContext for_effect(this);
+    Push(environment()->Lookup(receiver_var));
+    Push(element);
+    Push(environment()->Lookup(index_var));
+    Push(receiver);
+    BuildIterationCallbackCall(call, callback, known_callback);
+  } else {
+    ValueContext for_value(this, ARGUMENTS_NOT_ALLOWED);
+    Push(environment()->Lookup(receiver_var));
+    if (id == kArrayReduce) Push(environment()->Lookup(current_var));
+    Push(element);
+    Push(environment()->Lookup(index_var));
+    Push(receiver);
+    BuildIterationCallbackCall(call, callback, known_callback);
+  }
+  if (HasStackOverflow()) {
+    delete target_state;
+    return true;
+  }
+
+  if (current_block() != NULL) {
+    if (id == kArrayMap) {
+      HValue* value = Pop();
+      HValue* key = Pop();
+      HValue* accumulator = Pop();
+      BuildUncheckedMonomorphicElementAccess(
+          accumulator, key, value, accumulator_check, true,
+          FAST_HOLEY_ELEMENTS, true, NEVER_RETURN_HOLE, STANDARD_STORE);
+      Push(value);
+      AddSimulate(assignment->AssignmentId(), REMOVABLE_SIMULATE);
+      Drop(1);
+    } else if (id == kArrayFilter) {
+      HValue* keep = Pop();
+      HBasicBlock* if_keep = graph()->CreateBasicBlock();
+      HBasicBlock* if_drop = graph()->CreateBasicBlock();
+      current_block()->Finish(new(zone()) HBranch(keep, if_keep, if_drop));
+      if (continue_block == NULL) continue_block = graph()->CreateBasicBlock();
+      if_drop->Goto(continue_block);
+
+      set_current_block(if_keep);
+      HValue* accumulator = environment()->Lookup(accumulator_var);
+      HValue* key = environment()->Lookup(accumulator_length_var);
+      HInstruction* new_length =
+          HAdd::New(zone(), context, key, graph()->GetConstant1());
+      new_length->ClearFlag(HValue::kCanOverflow);
+      new_length->AssumeRepresentation(Representation::Integer32());
+      AddInstruction(new_length);
+      Bind(accumulator_length_var, new_length);
+      BuildUncheckedMonomorphicElementAccess(
+          accumulator, key, element, accumulator_check, true,
+          FAST_HOLEY_ELEMENTS, true, NEVER_RETURN_HOLE,
+          STORE_AND_GROW_NO_TRANSITION);
+      Push(element);
+      AddSimulate(assignment->AssignmentId(), REMOVABLE_SIMULATE);
+      Drop(1);
+    } else if (id == kArrayReduce) {
+      Bind(current_var, Pop());
+    }
+  }
+
+  HBasicBlock* body_exit = JoinContinue(loop, current_block(), continue_block);
+  if (body_exit != NULL) {
+    set_current_block(body_exit);
+    HInstruction* next_index = HAdd::New(
+        zone(), context, environment()->Lookup(index_var),
+        graph()->GetConstant1());
+    next_index->ClearFlag(HValue::kCanOverflow);
+    next_index->AssumeRepresentation(Representation::Integer32());
+    AddInstruction(next_index);
+    Bind(index_var, next_index);
+    body_exit = current_block();
+  }
+  set_current_block(CreateLoop(loop, loop_entry, body_exit, loop_successor,
+                               NULL));
+
+  HValue* return_value = undefined;
+  if (id == kArrayReduce) {
+    return_value = environment()->Lookup(current_var);
+  } else if (result_var != NULL) {
+    HValue* accumulator = environment()->Lookup(accumulator_var);
+    return_value = environment()->Lookup(result_var);
+    Push(AddInstruction(new(zone()) HPushArgument(accumulator)));
+    Push(AddInstruction(new(zone()) HPushArgument(return_value)));
+    HCallRuntime* move = new(zone()) HCallRuntime(
+        environment()->LookupContext(), move_contents->name(),
+        move_contents->function(), 2);
+    Drop(2);
+    AddInstruction(move);
+    AddSimulate(move_contents->id());
+  }
+
+  TraceInline(target, caller, NULL);
+
+  FunctionState* state = function_state();
+  if (call_context()->IsTest()) {
+    if (id == kArrayForEach) {
+      current_block()->Goto(inlined_test_context()->if_false(), state);
+    } else {
+      inlined_test_context()->ReturnValue(return_value);
+    }
+  } else if (call_context()->IsEffect()) {
+    current_block()->Goto(function_return(), state);
+  } else {
+    ASSERT(call_context()->IsValue());
+    current_block()->AddLeaveInlined(return_value, state);
+  }
+  FixUpInlinedExits(target_state, expr->id());
+  return true;
+}
+
+
+HValue* HOptimizedGraphBuilder::BuildInlinedConstruct(
+    CallNew* expr,
+    Handle<JSFunction> constructor,
+    HValue* argument) {
+  HValue* context = environment()->LookupContext();
+  HValue* function = AddInstruction(
+      new(zone()) HConstant(constructor, Representation::Tagged()));
+  Push(AddInstruction(new(zone()) HPushArgument(function)));
+  int argument_count = 1;  // The constructor.
+  if (argument != NULL) {
+    Push(AddInstruction(new(zone()) HPushArgument(argument)));
+    argument_count++;
+  }
+  HInstruction* call =
+      new(zone()) HCallNew(context, function, argument_count);
+  Drop(argument_count);
+  AddInstruction(call);
+  Push(call);
+  AddSimulate(expr->id());
+  return Pop();
+}
+
+
+// Calls the callback of an inlined iteration builtin with the receiver
+// and arguments on the expression stack, inlining it if it is known.
+void HOptimizedGraphBuilder::BuildIterationCallbackCall(
+    CallRuntime* call,
+    HValue* callback,
+    Handle<JSFunction> known_callback) {
+  // The callback itself is the last argument of %_CallFunction.
+  int argument_count = call->arguments()->length() - 1;
+  if (!known_callback.is_null() &&
+      TryInline(CALL_AS_METHOD,
+                known_callback,
+                argument_count - 1,  // Not counting the receiver.
+                NULL,
+                call->id(),
+                call->ReturnId(),
+                NORMAL_RETURN)) {
+    return;
+  }
+  HValue* context = environment()->LookupContext();
+  HInstruction* invoke = PreProcessCall(
+      new(zone()) HInvokeFunction(context, callback, known_callback,
+                                  argument_count));
+  ast_context()->ReturnInstruction(invoke, call->id());
+}
+
+
 bool HOptimizedGraphBuilder::TryCallApply(Call* expr) {
   Expression* callee = expr->expression();
   Property* prop = callee->AsProperty();
@@ -9727,9 +12651,15 @@ void HOptimizedGraphBuilder::VisitCall(Call* expr) {
 
 // Checks whether allocation using the given constructor can be inlined.
 static bool IsAllocationInlineable(Handle<JSFunction> constructor) {
-  return constructor->has_initial_map() &&
-      constructor->initial_map()->instance_type() == JS_OBJECT_TYPE &&
-      constructor->initial_map()->instance_size() < HAllocateObject::kMaxSize;
+  if (!constructor->has_initial_map()) return false;
+  Map* initial_map = constructor->initial_map();
+  // Objects that need an out-of-object properties backing store right away
+  // are left to the construct stub.
+  return initial_map->instance_type() == JS_OBJECT_TYPE &&
+      initial_map->instance_size() < HAllocate::kMaxInlineSize &&
+      initial_map->pre_allocated_property_fields() +
+          initial_map->unused_property_fields() -
+          initial_map->inobject_properties() == 0;
 }
 
 
@@ -9759,20 +12689,73 @@ void HOptimizedGraphBuilder::VisitCallNew(CallNew* expr) {
       constructor->shared()->CompleteInobjectSlackTracking();
     }
 
-    // Replace the constructor function with a newly allocated receiver.
-    HInstruction* receiver = new(zone()) HAllocateObject(context, constructor);
+    // Allocate the receiver in optimized code and initialize it the way
+    // the construct stub would, so that allocations in the inlined
+    // constructor body can be folded into it and stores into the fresh
+    // receiver need no write barrier.
+    Handle<Map> initial_map(constructor->initial_map());
+    ASSERT(initial_map->instance_type() == JS_OBJECT_TYPE);
+    ASSERT(initial_map->pre_allocated_property_fields() +
+           initial_map->unused_property_fields() -
+           initial_map->inobject_properties() == 0);
+    HValue* size_in_bytes = AddInstruction(new(zone()) HConstant(
+        initial_map->instance_size(), Representation::Integer32()));
+    HAllocate* receiver = new(zone()) HAllocate(
+        context, size_in_bytes, HType::JSObject(), HAllocate::DefaultFlags());
+    receiver->set_known_initial_map(initial_map);
+    AddInstruction(receiver);
+
+    // The initial map is loaded from the constructor at run time, since
+    // setting the constructor's prototype replaces it.
+    HValue* constructor_value = AddInstruction(
+        new(zone()) HConstant(constructor, Representation::Tagged()));
+    HInstruction* initial_map_value = AddInstruction(
+        new(zone()) HLoadNamedField(constructor_value, true,
+                                    Representation::Tagged(),
+                                    JSFunction::kPrototypeOrInitialMapOffset));
+
+    {
+      NoObservableSideEffectsScope no_effects(this);
+      Factory* factory = isolate()->factory();
+      BuildStoreMap(receiver, initial_map_value);
+      HValue* empty_fixed_array = AddInstruction(new(zone()) HConstant(
+          factory->empty_fixed_array(), Representation::Tagged()));
+      AddInstruction(new(zone()) HStoreNamedField(
+          receiver, factory->properties_field_symbol(), empty_fixed_array,
+          true, Representation::Tagged(), JSObject::kPropertiesOffset));
+      HInstruction* elements_store = AddInstruction(new(zone()) HStoreNamedField(
+          receiver, factory->elements_field_string(), empty_fixed_array,
+          true, Representation::Tagged(), JSObject::kElementsOffset));
+      elements_store->SetGVNFlag(kChangesElementsPointer);
+      HValue* undefined = graph()->GetConstantUndefined();
+      for (int i = 0; i < initial_map->inobject_properties(); i++) {
+        int property_offset = JSObject::kHeaderSize + i * kPointerSize;
+        AddInstruction(new(zone()) HStoreNamedField(
+            receiver, factory->empty_string(), undefined,
+            true, Representation::Tagged(), property_offset));
+      }
+    }
+
+    // Replace the constructor function with the newly allocated receiver.
     // Index of the receiver from the top of the expression stack.
     const int receiver_index = argument_count - 1;
-    AddInstruction(receiver);
     ASSERT(environment()->ExpressionStackAt(receiver_index) == function);
     environment()->SetExpressionStackAt(receiver_index, receiver);
 
     if (TryInlineConstruct(expr, receiver)) return;
 
-    // TODO(mstarzinger): For now we remove the previous HAllocateObject and
-    // add HPushArgument for the arguments in case inlining failed.  What we
-    // actually should do is emit HInvokeFunction on the constructor instead
-    // of using HCallNew as a fallback.
+    // TODO(mstarzinger): For now we remove the previous HAllocate and the
+    // instructions initializing it, and add HPushArgument for the arguments
+    // in case inlining failed.  What we actually should do is emit
+    // HInvokeFunction on the constructor instead of using HCallNew as a
+    // fallback.
+    HInstruction* instr = current_block()->last();
+    while (instr != initial_map_value) {
+      HInstruction* prev_instr = instr->previous();
+      instr->DeleteAndReplaceWith(NULL);
+      instr = prev_instr;
+    }
+    initial_map_value->DeleteAndReplaceWith(NULL);
     receiver->DeleteAndReplaceWith(NULL);
     check->DeleteAndReplaceWith(NULL);
     environment()->SetExpressionStackAt(receiver_index, function);
@@ -11783,6 +14766,7 @@ HEnvironment::HEnvironment(HEnvironment* outer,
       pop_count_(0),
       push_count_(0),
       ast_id_(BailoutId::None()),
+      try_region_(NULL),
       zone_(zone) {
   Initialize(scope->num_parameters() + 1, scope->num_stack_slots(), 0);
 }
@@ -11799,6 +14783,7 @@ HEnvironment::HEnvironment(Zone* zone, int parameter_count)
       pop_count_(0),
       push_count_(0),
       ast_id_(BailoutId::None()),
+      try_region_(NULL),
       zone_(zone) {
   Initialize(parameter_count, 0, 0);
 }
@@ -11815,6 +14800,7 @@ HEnvironment::HEnvironment(const HEnvironment* other, Zone* zone)
       pop_count_(0),
       push_count_(0),
       ast_id_(other->ast_id()),
+      try_region_(other->try_region()),
       zone_(zone) {
   Initialize(other);
 }
@@ -11835,6 +14821,7 @@ HEnvironment::HEnvironment(HEnvironment* outer,
       pop_count_(0),
       push_count_(0),
       ast_id_(BailoutId::None()),
+      try_region_(NULL),
       zone_(zone) {
 }
 
@@ -11865,6 +14852,7 @@ void HEnvironment::Initialize(const HEnvironment* other) {
   push_count_ = other->push_count_;
   specials_count_ = other->specials_count_;
   ast_id_ = other->ast_id_;
+  try_region_ = other->try_region_;
 }
 
 
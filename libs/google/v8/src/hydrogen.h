@@ -47,10 +47,12 @@ class FunctionState;
 class HEnvironment;
 class HGraph;
 class HLoopInformation;
+class HTryRegion;
 class HTracer;
 class LAllocator;
 class LChunk;
 class LiveRange;
+class LoopBodyChecker;
 
 
 class HBasicBlock: public ZoneObject {
@@ -96,6 +98,14 @@ class HBasicBlock: public ZoneObject {
   bool is_osr_entry() { return is_osr_entry_; }
   void set_osr_entry() { is_osr_entry_ = true; }
 
+  // The try statements enclosing this block, or NULL.
+  HTryRegion* try_region() const { return try_region_; }
+  void set_try_region(HTryRegion* region) { try_region_ = region; }
+  // The landing pad of a try statement is entered through its stack handler
+  // only, never by a jump.
+  bool IsLandingPad() const { return is_landing_pad_; }
+  void MarkAsLandingPad() { is_landing_pad_ = true; }
+
   void AttachLoopInformation();
   void DetachLoopInformation();
   bool IsLoopHeader() const { return loop_information() != NULL; }
@@ -199,10 +209,12 @@ class HBasicBlock: public ZoneObject {
   int last_instruction_index_;
   ZoneList<int> deleted_phis_;
   HBasicBlock* parent_loop_header_;
+  HTryRegion* try_region_;
   bool is_inline_return_target_;
   bool is_deoptimizing_;
   bool dominates_loop_successors_;
   bool is_osr_entry_;
+  bool is_landing_pad_;
 };
 
 
@@ -221,6 +233,41 @@ class HPredecessorIterator BASE_EMBEDDED {
 };
 
 
+// A try statement that encloses a basic block, linked to the enclosing ones.
+// Inside the try block the stack handler of the statement is linked; inside
+// the finally block that runs after the try block completed normally, the
+// unoptimized frame holds the saved state of the finally block instead.
+class HTryRegion: public ZoneObject {
+ public:
+  enum Kind { TRY_BLOCK, FINALLY_BLOCK };
+
+  HTryRegion(HEnterTry* entry, Kind kind, HTryRegion* outer, Zone* zone)
+      : entry_(entry), kind_(kind), outer_(outer), assigned_slots_(0, zone) { }
+
+  HEnterTry* entry() const { return entry_; }
+  Kind kind() const { return kind_; }
+  HTryRegion* outer() const { return outer_; }
+
+  // The try slots of the variables assigned in a try block.
+  const ZoneList<int>* assigned_slots() const { return &assigned_slots_; }
+  void AddAssignedSlot(int slot, Zone* zone) {
+    if (!assigned_slots_.Contains(slot)) assigned_slots_.Add(slot, zone);
+  }
+
+  // The innermost try block in this chain of regions, whose landing pad
+  // receives the exceptions, or NULL.
+  HTryRegion* HandlerRegion();
+  // The number of stack handlers linked in this chain of regions.
+  int HandlerCount();
+
+ private:
+  HEnterTry* entry_;
+  Kind kind_;
+  HTryRegion* outer_;
+  ZoneList<int> assigned_slots_;
+};
+
+
 class HLoopInformation: public ZoneObject {
  public:
   HLoopInformation(HBasicBlock* loop_header, Zone* zone)
@@ -282,10 +329,12 @@ class HGraph: public ZoneObject {
   void OrderBlocks();
   void AssignDominators();
   void SetupInformativeDefinitions();
+  void HoistBoundsChecksFromLoops();
   void EliminateRedundantBoundsChecks();
   void DehoistSimpleArrayIndexComputations();
   void DeadCodeElimination();
   void RestoreActualValues();
+  void OrderLandingPads();
   void PropagateDeoptimizingMark();
   void EliminateUnusedInstructions();
 
@@ -314,7 +363,18 @@ class HGraph: public ZoneObject {
   HConstant* GetConstantNull();
   HConstant* GetInvalidContext();
 
+  // New blocks are created in the current try region.
   HBasicBlock* CreateBasicBlock();
+  HTryRegion* try_region() const { return try_region_; }
+  void set_try_region(HTryRegion* region) { try_region_ = region; }
+  bool has_landing_pads() const { return has_landing_pads_; }
+  void MarkHasLandingPads() { has_landing_pads_ = true; }
+
+  // Stack-allocated variables assigned in try blocks get a try slot each.
+  int GetTrySlot(int variable_index);
+  int try_slot_count() const { return try_slot_variables_.length(); }
+  int TrySlotVariable(int slot) const { return try_slot_variables_[slot]; }
+
   HArgumentsObject* GetArgumentsObject() const {
     return arguments_object_.get();
   }
@@ -389,12 +449,12 @@ class HGraph: public ZoneObject {
     return is_recursive_;
   }
 
-  void MarkDependsOnEmptyArrayProtoElements() {
-    depends_on_empty_array_proto_elements_ = true;
+  void MarkDependsOnArrayProtector() {
+    depends_on_array_protector_ = true;
   }
 
-  bool depends_on_empty_array_proto_elements() {
-    return depends_on_empty_array_proto_elements_;
+  bool depends_on_array_protector() {
+    return depends_on_array_protector_;
   }
 
   void RecordUint32Instruction(HInstruction* instr) {
@@ -425,6 +485,7 @@ class HGraph: public ZoneObject {
   void CheckForBackEdge(HBasicBlock* block, HBasicBlock* successor);
   void SetupInformativeDefinitionsInBlock(HBasicBlock* block);
   void SetupInformativeDefinitionsRecursively(HBasicBlock* block);
+  void HoistBoundsChecksFromLoop(HBasicBlock* header);
   void EliminateRedundantBoundsChecks(HBasicBlock* bb, BoundsCheckTable* table);
 
   Isolate* isolate_;
@@ -450,14 +511,17 @@ class HGraph: public ZoneObject {
 
   SetOncePointer<HBasicBlock> osr_loop_entry_;
   SetOncePointer<ZoneList<HUnknownOSRValue*> > osr_values_;
+  HTryRegion* try_region_;
+  ZoneList<int> try_slot_variables_;
 
   CompilationInfo* info_;
   Zone* zone_;
 
+  bool has_landing_pads_;
   bool is_recursive_;
   bool use_optimistic_licm_;
   bool has_soft_deoptimize_;
-  bool depends_on_empty_array_proto_elements_;
+  bool depends_on_array_protector_;
   int type_change_checksum_;
 
   DISALLOW_COPY_AND_ASSIGN(HGraph);
@@ -508,6 +572,11 @@ class HEnvironment: public ZoneObject {
   BailoutId ast_id() const { return ast_id_; }
   void set_ast_id(BailoutId id) { ast_id_ = id; }
 
+  // The try statements around the ast id, tracked for the outermost
+  // environment only.
+  HTryRegion* try_region() const { return try_region_; }
+  void set_try_region(HTryRegion* region) { try_region_ = region; }
+
   HEnterInlined* entry() const { return entry_; }
   void set_entry(HEnterInlined* entry) { entry_ = entry; }
 
@@ -534,6 +603,17 @@ class HEnvironment: public ZoneObject {
     return Lookup(IndexFor(variable));
   }
 
+  // Map a variable to an environment index.  Parameter indices are shifted
+  // by 1 (receiver is parameter index -1 but environment index 0).
+  // Stack-allocated local indices are shifted by the number of parameters.
+  int IndexFor(Variable* variable) const {
+    ASSERT(variable->IsStackAllocated());
+    int shift = variable->IsParameter()
+        ? 1
+        : parameter_count_ + specials_count_;
+    return variable->index() + shift;
+  }
+
   HValue* Lookup(int index) const {
     HValue* result = values_[index];
     ASSERT(result != NULL);
@@ -644,17 +724,6 @@ class HEnvironment: public ZoneObject {
   void Initialize(int parameter_count, int local_count, int stack_height);
   void Initialize(const HEnvironment* other);
 
-  // Map a variable to an environment index.  Parameter indices are shifted
-  // by 1 (receiver is parameter index -1 but environment index 0).
-  // Stack-allocated local indices are shifted by the number of parameters.
-  int IndexFor(Variable* variable) const {
-    ASSERT(variable->IsStackAllocated());
-    int shift = variable->IsParameter()
-        ? 1
-        : parameter_count_ + specials_count_;
-    return variable->index() + shift;
-  }
-
   Handle<JSFunction> closure_;
   // Value array [parameters] [specials] [locals] [temporaries].
   ZoneList<HValue*> values_;
@@ -668,6 +737,7 @@ class HEnvironment: public ZoneObject {
   int pop_count_;
   int push_count_;
   BailoutId ast_id_;
+  HTryRegion* try_region_;
   Zone* zone_;
 };
 
@@ -1385,7 +1455,10 @@ class HOptimizedGraphBuilder: public HGraphBuilder, public AstVisitor {
    public:
     BreakAndContinueScope(BreakAndContinueInfo* info,
                           HOptimizedGraphBuilder* owner)
-        : info_(info), owner_(owner), next_(owner->break_scope()) {
+        : info_(info),
+          owner_(owner),
+          next_(owner->break_scope()),
+          try_region_(owner->graph()->try_region()) {
       owner->set_break_scope(this);
     }
 
@@ -1394,6 +1467,8 @@ class HOptimizedGraphBuilder: public HGraphBuilder, public AstVisitor {
     BreakAndContinueInfo* info() { return info_; }
     HOptimizedGraphBuilder* owner() { return owner_; }
     BreakAndContinueScope* next() { return next_; }
+    // The try region of the breakable statement.
+    HTryRegion* try_region() { return try_region_; }
 
     // Search the break stack for a break or continue target.
     HBasicBlock* Get(BreakableStatement* stmt, BreakType type, int* drop_extra);
@@ -1402,6 +1477,7 @@ class HOptimizedGraphBuilder: public HGraphBuilder, public AstVisitor {
     BreakAndContinueInfo* info_;
     HOptimizedGraphBuilder* owner_;
     BreakAndContinueScope* next_;
+    HTryRegion* try_region_;
   };
 
   HOptimizedGraphBuilder(CompilationInfo* info, TypeFeedbackOracle* oracle);
@@ -1450,6 +1526,14 @@ class HOptimizedGraphBuilder: public HGraphBuilder, public AstVisitor {
   static const int kMaxLoadPolymorphism = 4;
   static const int kMaxStorePolymorphism = 4;
 
+  // Limits for the dispatch of switch statements.  A range of cases is
+  // searched linearly up to kMaxSwitchLinearSearch cases, and goes through
+  // a jump table if the table has at most kMaxSwitchTableSparseness entries
+  // per case.
+  static const int kMaxSwitchLinearSearch = 3;
+  static const int kMaxSwitchTableSize = 1024;
+  static const int kMaxSwitchTableSparseness = 3;
+
   // Even in the 'unlimited' case we have to have some limit in order not to
   // overflow the stack.
   static const int kUnlimitedMaxInlinedSourceSize = 100000;
@@ -1514,6 +1598,26 @@ class HOptimizedGraphBuilder: public HGraphBuilder, public AstVisitor {
                      HBasicBlock* loop_entry,
                      BreakAndContinueInfo* break_info);
 
+  // Loop peeling and unrolling re-visit the AST of an innermost loop to
+  // build extra copies of its iterations, in front of the loop or inside
+  // its body respectively.
+  bool IsCopyableLoop(IterationStatement* stmt, LoopBodyChecker* checker);
+  bool ShouldPeelLoop(IterationStatement* stmt, LoopBodyChecker* checker);
+  int LoopUnrollingFactor(ForStatement* stmt, LoopBodyChecker* checker);
+  // Build a packed SSE2 kernel in front of a loop storing an element-wise
+  // expression of typed arrays into another one.  The kernel runs as many
+  // iterations as fill whole vectors and leaves the rest to the loop.
+  // Returns false if the loop does not have that form.
+  bool TryVectorizeLoop(ForStatement* stmt);
+  // Build a single iteration of the loop: test cond (if any), visit the body
+  // and then next (if any).  Exits from the iteration are joined into
+  // loop_exit, and the current block is left at the end of the iteration.
+  void VisitLoopIteration(IterationStatement* stmt,
+                          Expression* cond,
+                          BailoutId body_id,
+                          Statement* next,
+                          HBasicBlock** loop_exit);
+
   // Create a back edge in the flow graph.  body_exit is the predecessor
   // block and loop_entry is the successor block.  loop_successor is the
   // block where control flow exits the loop normally (e.g., via failure of
@@ -1533,7 +1637,46 @@ class HOptimizedGraphBuilder: public HGraphBuilder, public AstVisitor {
 
   HValue* Top() const { return environment()->Top(); }
   void Drop(int n) { environment()->Drop(n); }
-  void Bind(Variable* var, HValue* value) { environment()->Bind(var, value); }
+  void Bind(Variable* var, HValue* value);
+
+  // Try statements link a stack handler for their try block, whose landing
+  // pad deoptimizes to the handler code of the unoptimized function.  The
+  // catch block, and the finally block on the exceptional path, always run
+  // in unoptimized code.
+  // Stack-allocated variables assigned in a try block are kept in try slots
+  // for the landing pad, which is only built when the try block is done.
+  HEnterTry* BuildEnterTry(TryStatement* stmt,
+                           StackHandler::Kind kind,
+                           BailoutId finally_return_id);
+  void BuildLeaveTry(TryStatement* stmt, HEnterTry* entry);
+  void BuildLandingPad(TryStatement* stmt, HTryRegion* region);
+  // Unlink the stack handlers of the try regions that a jump to a block in
+  // the target region leaves.  Bails out and returns false if one of them
+  // is a try-finally, whose finally block would have to run first.
+  bool LeaveTryRegions(HTryRegion* target);
+
+  // Switch statements over Smi labels dispatch through a jump table where
+  // the case values are dense and through a binary search elsewhere.
+  // String switches compare internalized tags by identity, and only compare
+  // the contents of other strings.  Each clause that can match gets a target
+  // block, and every value that matches no clause goes to the miss block.
+  struct SwitchCase {
+    int value;
+    int clause_index;
+  };
+  static int CompareSwitchCases(const SwitchCase* a, const SwitchCase* b);
+  void BuildSmiSwitchDispatch(HValue* tag,
+                              const ZoneList<SwitchCase>* cases,
+                              int from,
+                              int to,
+                              ZoneList<HBasicBlock*>* targets,
+                              HBasicBlock** miss);
+  void BuildStringSwitchDispatch(SwitchStatement* stmt,
+                                 HValue* context,
+                                 HValue* tag,
+                                 ZoneList<HBasicBlock*>* targets,
+                                 HBasicBlock** miss);
+  void GotoSwitchMiss(HBasicBlock** miss);
 
   // The value of the arguments object is allowed in some but not most value
   // contexts.  (It's allowed in all effect contexts and disallowed in all
@@ -1595,6 +1738,16 @@ class HOptimizedGraphBuilder: public HGraphBuilder, public AstVisitor {
                  BailoutId return_id,
                  InliningKind inlining_kind);
 
+  // Returns true if another inlined function would exceed
+  // Compiler::kMaxInliningLevels.
+  bool InliningDepthLimitReached();
+  // Compiles the unoptimized code of an inlining target with deoptimization
+  // support from the AST in target_info, unless it already has it.
+  bool EnsureDeoptimizationSupport(CompilationInfo* target_info);
+  // Forwards the exits of an inlined function to the calling context and
+  // deletes its function state.
+  void FixUpInlinedExits(FunctionState* target_state, BailoutId ast_id);
+
   bool TryInlineCall(Call* expr, bool drop_extra = false);
   bool TryInlineConstruct(CallNew* expr, HValue* implicit_return_value);
   bool TryInlineGetter(Handle<JSFunction> getter, Property* prop);
@@ -1609,6 +1762,19 @@ class HOptimizedGraphBuilder: public HGraphBuilder, public AstVisitor {
                                   Handle<Map> receiver_map,
                                   CheckType check_type);
   bool TryInlineBuiltinFunctionCall(Call* expr, bool drop_extra);
+  // Inlines Array.prototype.forEach, map, filter and reduce on a fast
+  // array as a loop in an inlined frame of the builtin, so that the
+  // callback can be inlined into the loop.
+  bool TryInlineArrayIteration(Call* expr,
+                               HValue* receiver,
+                               Handle<Map> receiver_map,
+                               BuiltinFunctionId id);
+  HValue* BuildInlinedConstruct(CallNew* expr,
+                                Handle<JSFunction> constructor,
+                                HValue* argument);
+  void BuildIterationCallbackCall(CallRuntime* call,
+                                  HValue* callback,
+                                  Handle<JSFunction> known_callback);
 
   // If --trace-inlining, print a line of the inlining trace.  Inlining
   // succeeded if the reason string is NULL and failed if there is a
@@ -1659,6 +1825,8 @@ class HOptimizedGraphBuilder: public HGraphBuilder, public AstVisitor {
   HInstruction* BuildLoadKeyedGeneric(HValue* object,
                                       HValue* key);
 
+  LoadKeyedHoleMode BuildKeyedHoleMode(Handle<Map> map);
+
   HInstruction* TryBuildConsolidatedElementLoad(HValue* object,
                                                 HValue* key,
                                                 HValue* val,
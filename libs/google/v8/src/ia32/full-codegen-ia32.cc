@@ -3592,7 +3592,6 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   ParameterCount count(arg_count);
   __ InvokeFunction(edi, count, CALL_FUNCTION,
                     NullCallWrapper(), CALL_AS_METHOD);
-  __ mov(esi, Operand(ebp, StandardFrameConstants::kContextOffset));
   __ jmp(&done);
 
   __ bind(&runtime);
@@ -3600,6 +3599,10 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   __ CallRuntime(Runtime::kCall, args->length());
   __ bind(&done);
 
+  // Record the return site before restoring the context so that a caller
+  // inlined into optimized code resumes here with its own context.
+  PrepareForBailoutForId(expr->ReturnId(), TOS_REG);
+  __ mov(esi, Operand(ebp, StandardFrameConstants::kContextOffset));
   context()->Plug(eax);
 }
 
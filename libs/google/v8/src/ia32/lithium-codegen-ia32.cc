@@ -106,6 +106,7 @@ void LCodeGen::FinishCode(Handle<Code> code) {
     RegisterDependentCodeForEmbeddedMaps(code);
   }
   PopulateDeoptimizationData(code);
+  PopulateHandlerTable(code);
   if (!info()->IsStub()) {
     Deoptimizer::EnsureRelocSpaceForLazyDeoptimization(code);
   }
@@ -117,11 +118,8 @@ void LCodeGen::FinishCode(Handle<Code> code) {
     transition_maps_.at(i)->AddDependentCode(
         DependentCode::kTransitionGroup, code);
   }
-  if (graph()->depends_on_empty_array_proto_elements()) {
-    isolate()->initial_object_prototype()->map()->AddDependentCode(
-        DependentCode::kElementsCantBeAddedGroup, code);
-    isolate()->initial_array_prototype()->map()->AddDependentCode(
-        DependentCode::kElementsCantBeAddedGroup, code);
+  if (graph()->depends_on_array_protector()) {
+    code->set_depends_on_array_protector(true);
   }
 }
 
@@ -622,6 +620,20 @@ Operand LCodeGen::HighOperand(LOperand* op) {
 }
 
 
+// The unoptimized frame keeps a stack handler for each enclosing try block
+// and the saved state for each enclosing finally block on its expression
+// stack.  Both take five words.
+static void WriteTryRegion(HTryRegion* region, Translation* translation) {
+  STATIC_ASSERT(StackHandlerConstants::kSlotCount ==
+                Translation::kFinallyStateSize);
+  if (region->kind() == HTryRegion::TRY_BLOCK) {
+    translation->StoreStackHandler(region->entry()->handler_state());
+  } else {
+    translation->StoreFinallyState(region->entry()->finally_return_id());
+  }
+}
+
+
 void LCodeGen::WriteTranslation(LEnvironment* environment,
                                 Translation* translation,
                                 int* pushed_arguments_index,
@@ -633,6 +645,15 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
   // The output frame height does not include the parameters.
   int height = translation_size - environment->parameter_count();
 
+  // Innermost first.
+  ZoneList<HTryRegion*> try_regions(0, zone());
+  for (HTryRegion* region = environment->try_region();
+       region != NULL;
+       region = region->outer()) {
+    try_regions.Add(region, zone());
+  }
+  height += try_regions.length() * StackHandlerConstants::kSlotCount;
+
   // Function parameters are arguments to the outermost environment. The
   // arguments index points to the first element of a sequence of tagged
   // values on the stack that represent the arguments. This needs to be
@@ -693,7 +714,13 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
     }
   }
 
+  int next_region = try_regions.length() - 1;
   for (int i = 0; i < translation_size; ++i) {
+    while (next_region >= 0 &&
+           environment->first_expression_index() +
+               try_regions[next_region]->entry()->handler_height() <= i) {
+      WriteTryRegion(try_regions[next_region--], translation);
+    }
     LOperand* value = environment->values()->at(i);
     // spilled_registers_ and spilled_double_registers_ are either
     // both NULL or both set.
@@ -731,6 +758,9 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
                      arguments_index,
                      arguments_count);
   }
+  while (next_region >= 0) {
+    WriteTryRegion(try_regions[next_region--], translation);
+  }
 }
 
 
@@ -1122,11 +1152,15 @@ void LCodeGen::RecordPosition(int position) {
 static const char* LabelType(LLabel* label) {
   if (label->is_loop_header()) return " (loop header)";
   if (label->is_osr_entry()) return " (OSR entry)";
+  if (label->is_landing_pad()) return " (landing pad)";
   return "";
 }
 
 
 void LCodeGen::DoLabel(LLabel* label) {
+  // Unwinding jumps to the landing pad even after the code has been
+  // patched for lazy deoptimization, so keep the patches clear of it.
+  if (label->is_landing_pad()) EnsureSpaceForLazyDeopt();
   Comment(";;; <@%d,#%d> -------------------- B%d%s --------------------",
           current_instruction_,
           label->hydrogen_value()->id(),
@@ -1134,10 +1168,42 @@ void LCodeGen::DoLabel(LLabel* label) {
           LabelType(label));
   __ bind(label->label());
   current_block_ = label->block_id();
+  if (label->is_landing_pad()) EmitLandingPad(label);
   DoGap(label);
 }
 
 
+void LCodeGen::EmitLandingPad(LLabel* label) {
+  HEnterTry* entry =
+      HEnterTry::cast(label->block()->predecessors()->at(0)->end());
+  handler_table_.Add(HandlerTableEntry(entry->handler_index(),
+                                       masm()->pc_offset()),
+                     zone());
+  // Unwinding restored ebp and esi and left the exception in eax.  Drop
+  // whatever was pushed in the try block and save the exception before the
+  // gap moves run.
+  __ lea(esp, Operand(ebp, JavaScriptFrameConstants::kFunctionOffset -
+                               GetStackSlotCount() * kPointerSize));
+  __ mov(Operand(ebp, StackSlotOffset(label->exception_slot())), eax);
+}
+
+
+void LCodeGen::PopulateHandlerTable(Handle<Code> code) {
+  if (handler_table_.is_empty()) return;
+  int length = 0;
+  for (int i = 0; i < handler_table_.length(); i++) {
+    length = Max(length, handler_table_[i].handler_index + 1);
+  }
+  Handle<FixedArray> handler_table =
+      factory()->NewFixedArray(length, TENURED);
+  for (int i = 0; i < handler_table_.length(); i++) {
+    handler_table->set(handler_table_[i].handler_index,
+                       Smi::FromInt(handler_table_[i].pc_offset));
+  }
+  code->set_handler_table(*handler_table);
+}
+
+
 void LCodeGen::DoParallelMove(LParallelMove* move) {
   resolver_.Resolve(move);
 }
@@ -2213,6 +2279,91 @@ void LCodeGen::DoGoto(LGoto* instr) {
 }
 
 
+void LCodeGen::DoSwitchTable(LSwitchTable* instr) {
+  // The table is a sequence of fixed-size jmp instructions, one per value
+  // in [min_value, min_value + size). Dispatch computes the address of the
+  // entry relative to the start of the code object.
+  static const int kEntrySize = 8;
+  HSwitchTable* hswitch = instr->hydrogen();
+  Register value = ToRegister(instr->value());
+  Register index = ToRegister(instr->temp());
+  Label* default_label = chunk_->GetAssemblyLabel(
+      chunk_->LookupDestination(hswitch->SuccessorAt(0)->block_id()));
+
+  Label table, dispatch;
+  __ mov(index, value);
+  if (hswitch->min_value() != 0) {
+    __ sub(index, Immediate(hswitch->min_value()));
+  }
+  __ cmp(index, Immediate(hswitch->size()));
+  __ j(below, &dispatch);
+  __ jmp(default_label);
+
+  __ bind(&table);
+  for (int i = 0; i < hswitch->size(); i++) {
+    int entry_start = masm()->pc_offset();
+    HBasicBlock* target = hswitch->SuccessorAt(hswitch->EntryAt(i));
+    __ jmp(chunk_->GetAssemblyLabel(
+        chunk_->LookupDestination(target->block_id())));
+    int padding = kEntrySize - (masm()->pc_offset() - entry_start);
+    ASSERT(padding >= 0);
+    if (padding > 0) __ Nop(padding);
+  }
+
+  __ bind(&dispatch);
+  __ lea(index, Operand(index, times_8,
+                        table.pos() + Code::kHeaderSize - kHeapObjectTag));
+  __ add(index, Immediate(masm()->CodeObject()));
+  __ jmp(index);
+}
+
+
+void LCodeGen::DoEnterTry(LEnterTry* instr) {
+  // Build the stack handler in its spill slots the way PushTryHandler
+  // builds it on the stack, and link it into the handler chain.
+  STATIC_ASSERT(StackHandlerConstants::kSize == 5 * kPointerSize);
+  int offset = StackSlotOffset(instr->handler_slot());
+  __ mov(Operand(ebp, offset + StackHandlerConstants::kFPOffset), ebp);
+  __ mov(eax, Operand(ebp, StandardFrameConstants::kContextOffset));
+  __ mov(Operand(ebp, offset + StackHandlerConstants::kContextOffset), eax);
+  __ mov(Operand(ebp, offset + StackHandlerConstants::kStateOffset),
+         Immediate(instr->hydrogen()->handler_state()));
+  __ mov(Operand(ebp, offset + StackHandlerConstants::kCodeOffset),
+         Immediate(masm()->CodeObject()));
+  ExternalReference handler_address(Isolate::kHandlerAddress, isolate());
+  __ mov(eax, Operand::StaticVariable(handler_address));
+  __ mov(Operand(ebp, offset + StackHandlerConstants::kNextOffset), eax);
+  __ lea(eax, Operand(ebp, offset));
+  __ mov(Operand::StaticVariable(handler_address), eax);
+  EmitGoto(instr->hydrogen()->try_entry()->block_id());
+}
+
+
+void LCodeGen::DoLeaveTry(LLeaveTry* instr) {
+  Register scratch = ToRegister(instr->temp());
+  ExternalReference handler_address(Isolate::kHandlerAddress, isolate());
+  __ mov(scratch, Operand::StaticVariable(handler_address));
+  __ mov(scratch, Operand(scratch, StackHandlerConstants::kNextOffset));
+  __ mov(Operand::StaticVariable(handler_address), scratch);
+}
+
+
+void LCodeGen::DoCatchEntry(LCatchEntry* instr) {
+  // Nothing to do, the landing pad has stored the exception.
+}
+
+
+void LCodeGen::DoStoreTrySlot(LStoreTrySlot* instr) {
+  Register value = ToRegister(instr->value());
+  __ mov(Operand(ebp, StackSlotOffset(instr->spill_index())), value);
+}
+
+
+void LCodeGen::DoLoadTrySlot(LLoadTrySlot* instr) {
+  // Nothing to do, the value is in its try slot.
+}
+
+
 Condition LCodeGen::TokenToCondition(Token::Value op, bool is_unsigned) {
   Condition cond = no_condition;
   switch (op) {
@@ -2407,6 +2558,25 @@ void LCodeGen::DoIsStringAndBranch(LIsStringAndBranch* instr) {
 }
 
 
+void LCodeGen::DoIsInternalizedStringAndBranch(
+    LIsInternalizedStringAndBranch* instr) {
+  Register reg = ToRegister(instr->value());
+  Register temp = ToRegister(instr->temp());
+
+  int true_block = chunk_->LookupDestination(instr->true_block_id());
+  int false_block = chunk_->LookupDestination(instr->false_block_id());
+  Label* false_label = chunk_->GetAssemblyLabel(false_block);
+
+  __ JumpIfSmi(reg, false_label);
+  __ mov(temp, FieldOperand(reg, HeapObject::kMapOffset));
+  __ movzx_b(temp, FieldOperand(temp, Map::kInstanceTypeOffset));
+  __ and_(temp, kIsNotStringMask | kIsInternalizedMask);
+  __ cmp(temp, kStringTag | kInternalizedTag);
+
+  EmitBranch(true_block, false_block, equal);
+}
+
+
 void LCodeGen::DoIsSmiAndBranch(LIsSmiAndBranch* instr) {
   Operand input = ToOperand(instr->value());
 
@@ -3323,6 +3493,12 @@ void LCodeGen::DoLoadKeyedFixedArray(LLoadKeyed* instr) {
       __ cmp(result, factory()->the_hole_value());
       DeoptimizeIf(equal, instr->environment());
     }
+  } else if (instr->hydrogen()->hole_mode() == CONVERT_HOLE_TO_UNDEFINED) {
+    Label is_not_hole;
+    __ cmp(result, factory()->the_hole_value());
+    __ j(not_equal, &is_not_hole, Label::kNear);
+    __ mov(result, factory()->undefined_value());
+    __ bind(&is_not_hole);
   }
 }
 
@@ -5932,95 +6108,6 @@ void LCodeGen::DoCheckPrototypeMaps(LCheckPrototypeMaps* instr) {
 }
 
 
-void LCodeGen::DoAllocateObject(LAllocateObject* instr) {
-  class DeferredAllocateObject: public LDeferredCode {
-   public:
-    DeferredAllocateObject(LCodeGen* codegen, LAllocateObject* instr)
-        : LDeferredCode(codegen), instr_(instr) { }
-    virtual void Generate() { codegen()->DoDeferredAllocateObject(instr_); }
-    virtual LInstruction* instr() { return instr_; }
-   private:
-    LAllocateObject* instr_;
-  };
-
-  DeferredAllocateObject* deferred =
-      new(zone()) DeferredAllocateObject(this, instr);
-
-  Register result = ToRegister(instr->result());
-  Register scratch = ToRegister(instr->temp());
-  Handle<JSFunction> constructor = instr->hydrogen()->constructor();
-  Handle<Map> initial_map = instr->hydrogen()->constructor_initial_map();
-  int instance_size = initial_map->instance_size();
-  ASSERT(initial_map->pre_allocated_property_fields() +
-         initial_map->unused_property_fields() -
-         initial_map->inobject_properties() == 0);
-
-  __ Allocate(instance_size, result, no_reg, scratch, deferred->entry(),
-              TAG_OBJECT);
-
-  __ bind(deferred->exit());
-  if (FLAG_debug_code) {
-    Label is_in_new_space;
-    __ JumpIfInNewSpace(result, scratch, &is_in_new_space);
-    __ Abort("Allocated object is not in new-space");
-    __ bind(&is_in_new_space);
-  }
-
-  // Load the initial map.
-  Register map = scratch;
-  __ LoadHeapObject(scratch, constructor);
-  __ mov(map, FieldOperand(scratch, JSFunction::kPrototypeOrInitialMapOffset));
-
-  if (FLAG_debug_code) {
-    __ AssertNotSmi(map);
-    __ cmpb(FieldOperand(map, Map::kInstanceSizeOffset),
-            instance_size >> kPointerSizeLog2);
-    __ Assert(equal, "Unexpected instance size");
-    __ cmpb(FieldOperand(map, Map::kPreAllocatedPropertyFieldsOffset),
-            initial_map->pre_allocated_property_fields());
-    __ Assert(equal, "Unexpected pre-allocated property fields count");
-    __ cmpb(FieldOperand(map, Map::kUnusedPropertyFieldsOffset),
-            initial_map->unused_property_fields());
-    __ Assert(equal, "Unexpected unused property fields count");
-    __ cmpb(FieldOperand(map, Map::kInObjectPropertiesOffset),
-            initial_map->inobject_properties());
-    __ Assert(equal, "Unexpected in-object property fields count");
-  }
-
-  // Initialize map and fields of the newly allocated object.
-  ASSERT(initial_map->instance_type() == JS_OBJECT_TYPE);
-  __ mov(FieldOperand(result, JSObject::kMapOffset), map);
-  __ mov(scratch, factory()->empty_fixed_array());
-  __ mov(FieldOperand(result, JSObject::kElementsOffset), scratch);
-  __ mov(FieldOperand(result, JSObject::kPropertiesOffset), scratch);
-  if (initial_map->inobject_properties() != 0) {
-    __ mov(scratch, factory()->undefined_value());
-    for (int i = 0; i < initial_map->inobject_properties(); i++) {
-      int property_offset = JSObject::kHeaderSize + i * kPointerSize;
-      __ mov(FieldOperand(result, property_offset), scratch);
-    }
-  }
-}
-
-
-void LCodeGen::DoDeferredAllocateObject(LAllocateObject* instr) {
-  Register result = ToRegister(instr->result());
-  Handle<Map> initial_map = instr->hydrogen()->constructor_initial_map();
-  int instance_size = initial_map->instance_size();
-
-  // TODO(3095996): Get rid of this. For now, we need to make the
-  // result register contain a valid pointer because it is already
-  // contained in the register pointer map.
-  __ Set(result, Immediate(0));
-
-  PushSafepointRegistersScope scope(this);
-  __ push(Immediate(Smi::FromInt(instance_size)));
-  CallRuntimeFromDeferred(
-      Runtime::kAllocateInNewSpace, 1, instr, instr->context());
-  __ StoreToSafepointRegisterSlot(result, eax);
-}
-
-
 void LCodeGen::DoAllocate(LAllocate* instr) {
   class DeferredAllocate: public LDeferredCode {
    public:
@@ -6055,6 +6142,21 @@ void LCodeGen::DoAllocate(LAllocate* instr) {
   }
 
   __ bind(deferred->exit());
+
+  if (instr->hydrogen()->MustPrefillWithFiller()) {
+    // Fill the space of the allocations folded into this one with
+    // one-pointer fillers until their objects are initialized.
+    int32_t size = ToInteger32(LConstantOperand::cast(instr->size()));
+    int32_t offset = instr->hydrogen()->folded_offset();
+    Label loop;
+    __ mov(temp, Immediate((size - offset) / kPointerSize));
+    __ bind(&loop);
+    __ mov(FieldOperand(result, temp, times_pointer_size,
+                        offset - kPointerSize),
+           Immediate(isolate()->factory()->one_pointer_filler_map()));
+    __ dec(temp);
+    __ j(not_zero, &loop);
+  }
 }
 
 
@@ -6316,6 +6418,20 @@ void LCodeGen::DoLazyBailout(LLazyBailout* instr) {
 
 
 void LCodeGen::DoDeoptimize(LDeoptimize* instr) {
+  if (instr->hydrogen_value()->block()->IsLandingPad()) {
+    // Catching an exception is no reason to throw away the code, so the
+    // landing pad leaves through the lazy deoptimization entry.
+    LEnvironment* env = instr->environment();
+    RegisterEnvironmentForDeoptimization(env, Safepoint::kNoLazyDeopt);
+    Address entry = Deoptimizer::GetDeoptimizationEntry(
+        isolate(), env->deoptimization_index(), Deoptimizer::LAZY);
+    if (entry == NULL) {
+      Abort("bailout was not prepared");
+      return;
+    }
+    __ call(entry, RelocInfo::RUNTIME_ENTRY);
+    return;
+  }
   DeoptimizeIf(no_condition, instr->environment());
 }
 
@@ -57,6 +57,7 @@ class LCodeGen BASE_EMBEDDED {
         instructions_(chunk->instructions()),
         deoptimizations_(4, info->zone()),
         jump_table_(4, info->zone()),
+        handler_table_(0, info->zone()),
         deoptimization_literals_(8, info->zone()),
         prototype_maps_(0, info->zone()),
         transition_maps_(0, info->zone()),
@@ -155,7 +156,6 @@ class LCodeGen BASE_EMBEDDED {
   void DoDeferredRandom(LRandom* instr);
   void DoDeferredStringCharCodeAt(LStringCharCodeAt* instr);
   void DoDeferredStringCharFromCode(LStringCharFromCode* instr);
-  void DoDeferredAllocateObject(LAllocateObject* instr);
   void DoDeferredAllocate(LAllocate* instr);
   void DoDeferredInstanceOfKnownGlobal(LInstanceOfKnownGlobal* instr,
                                        Label* map_check);
@@ -378,6 +378,18 @@ class LCodeGen BASE_EMBEDDED {
                     int* offset,
                     AllocationSiteMode mode);
 
+  // Maps the handler index of a try statement to its landing pad.
+  struct HandlerTableEntry {
+    inline HandlerTableEntry(int index, int offset)
+        : handler_index(index),
+          pc_offset(offset) { }
+    int handler_index;
+    int pc_offset;
+  };
+
+  void EmitLandingPad(LLabel* label);
+  void PopulateHandlerTable(Handle<Code> code);
+
   void EnsureSpaceForLazyDeopt();
   void DoLoadKeyedExternalArray(LLoadKeyed* instr);
   void DoLoadKeyedFixedDoubleArray(LLoadKeyed* instr);
@@ -414,6 +426,7 @@ class LCodeGen BASE_EMBEDDED {
   const ZoneList<LInstruction*>* instructions_;
   ZoneList<LEnvironment*> deoptimizations_;
   ZoneList<JumpTableEntry> jump_table_;
+  ZoneList<HandlerTableEntry> handler_table_;
   ZoneList<Handle<Object> > deoptimization_literals_;
   ZoneList<Handle<Map> > prototype_maps_;
   ZoneList<Handle<Map> > transition_maps_;
@@ -144,6 +144,29 @@ void LInstruction::PrintOutputOperandTo(StringStream* stream) {
 }
 
 
+void LStoreTrySlot::PrintDataTo(StringStream* stream) {
+  stream->Add("[stack:%d] <- ", spill_index());
+  value()->PrintTo(stream);
+}
+
+
+void LSwitchTable::PrintDataTo(StringStream* stream) {
+  value()->PrintTo(stream);
+  stream->Add(" [%d..%d] else B%d",
+              hydrogen()->min_value(),
+              hydrogen()->min_value() + hydrogen()->size() - 1,
+              hydrogen()->SuccessorAt(0)->block_id());
+}
+
+
+void LEnterTry::PrintDataTo(StringStream* stream) {
+  stream->Add("B%d, handler in [slot %d], landing pad B%d",
+              hydrogen()->try_entry()->block_id(),
+              handler_slot(),
+              hydrogen()->landing_pad()->block_id());
+}
+
+
 void LLabel::PrintDataTo(StringStream* stream) {
   LGap::PrintDataTo(stream);
   LLabel* rep = replacement();
@@ -258,6 +281,13 @@ void LIsStringAndBranch::PrintDataTo(StringStream* stream) {
 }
 
 
+void LIsInternalizedStringAndBranch::PrintDataTo(StringStream* stream) {
+  stream->Add("if is_internalized_string(");
+  value()->PrintTo(stream);
+  stream->Add(") then B%d else B%d", true_block_id(), false_block_id());
+}
+
+
 void LIsSmiAndBranch::PrintDataTo(StringStream* stream) {
   stream->Add("if is_smi(");
   value()->PrintTo(stream);
@@ -494,6 +524,17 @@ LPlatformChunk* LChunkBuilder::Build() {
     USE(alignment_state_index);
   }
 
+  // Reserve the try slots before the spill slots of the stack handlers.
+  int try_slot_count = graph()->try_slot_count();
+  for (int i = 0; i < try_slot_count; i++) {
+    int spill_index = chunk()->GetNextSpillIndex(false);
+    if (i == 0) first_try_slot_ = spill_index;
+    if (spill_index > LUnallocated::kMaxFixedSlotIndex) {
+      Abort("Too many spill slots needed for try statement");
+      return NULL;
+    }
+  }
+
   const ZoneList<HBasicBlock*>* blocks = graph()->blocks();
   for (int i = 0; i < blocks->length(); i++) {
     HBasicBlock* next = NULL;
@@ -725,7 +766,20 @@ LInstruction* LChunkBuilder::MarkAsCall(LInstruction* instr,
 
 LInstruction* LChunkBuilder::AssignPointerMap(LInstruction* instr) {
   ASSERT(!instr->HasPointerMap());
-  instr->set_pointer_map(new(zone()) LPointerMap(position_, zone()));
+  LPointerMap* pointer_map = new(zone()) LPointerMap(position_, zone());
+  // The try slots of the enclosing try blocks hold tagged values from the
+  // entry of the try block on.
+  for (HTryRegion* region = current_block_->try_region();
+       region != NULL;
+       region = region->outer()) {
+    if (region->kind() != HTryRegion::TRY_BLOCK) continue;
+    const ZoneList<int>* slots = region->assigned_slots();
+    for (int i = 0; i < slots->length(); i++) {
+      pointer_map->RecordPointer(
+          LStackSlot::Create(first_try_slot_ + slots->at(i), zone()), zone());
+    }
+  }
+  instr->set_pointer_map(pointer_map);
   return instr;
 }
 
@@ -879,9 +933,11 @@ void LChunkBuilder::DoBasicBlock(HBasicBlock* block, HBasicBlock* next_block) {
     if (pred->end()->SecondSuccessor() == NULL) {
       ASSERT(pred->end()->FirstSuccessor() == block);
     } else {
-      if (pred->end()->FirstSuccessor()->block_id() > block->block_id() ||
-          pred->end()->SecondSuccessor()->block_id() > block->block_id()) {
-        last_environment = last_environment->Copy();
+      for (HSuccessorIterator it(pred->end()); !it.Done(); it.Advance()) {
+        if (it.Current()->block_id() > block->block_id()) {
+          last_environment = last_environment->Copy();
+          break;
+        }
       }
     }
     block->UpdateEnvironment(last_environment);
@@ -1020,6 +1076,14 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
     *argument_index_accumulator = argument_index;
   }
 
+  if (hydrogen_env->outer() == NULL) {
+    // Contexts are not part of the translation, so the expression stack
+    // starts right after the locals.
+    result->set_try_region(hydrogen_env->try_region(),
+                           hydrogen_env->parameter_count() +
+                               hydrogen_env->local_count());
+  }
+
   return result;
 }
 
@@ -1754,6 +1818,15 @@ LInstruction* LChunkBuilder::DoIsStringAndBranch(HIsStringAndBranch* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoIsInternalizedStringAndBranch(
+    HIsInternalizedStringAndBranch* instr) {
+  ASSERT(instr->value()->representation().IsTagged());
+  LOperand* temp = TempRegister();
+  return new(zone()) LIsInternalizedStringAndBranch(
+      UseRegister(instr->value()), temp);
+}
+
+
 LInstruction* LChunkBuilder::DoIsSmiAndBranch(HIsSmiAndBranch* instr) {
   ASSERT(instr->value()->representation().IsTagged());
   return new(zone()) LIsSmiAndBranch(Use(instr->value()));
@@ -1844,6 +1917,13 @@ LInstruction* LChunkBuilder::DoValueOf(HValueOf* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoVectorLoop(HVectorLoop* instr) {
+  // Loops are only vectorized on x64.
+  UNREACHABLE();
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoDateField(HDateField* instr) {
   LOperand* date = UseFixed(instr->value(), eax);
   LDateField* result =
@@ -2512,15 +2592,6 @@ LInstruction* LChunkBuilder::DoStringLength(HStringLength* instr) {
 }
 
 
-LInstruction* LChunkBuilder::DoAllocateObject(HAllocateObject* instr) {
-  info()->MarkAsDeferredCalling();
-  LOperand* context = UseAny(instr->context());
-  LOperand* temp = TempRegister();
-  LAllocateObject* result = new(zone()) LAllocateObject(context, temp);
-  return AssignPointerMap(DefineAsRegister(result));
-}
-
-
 LInstruction* LChunkBuilder::DoAllocate(HAllocate* instr) {
   info()->MarkAsDeferredCalling();
   LOperand* context = UseAny(instr->context());
@@ -2590,6 +2661,66 @@ LInstruction* LChunkBuilder::DoUnknownOSRValue(HUnknownOSRValue* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoEnterTry(HEnterTry* instr) {
+  // The stack handler takes five consecutive spill slots.  The slot with
+  // the highest index is at the lowest address and holds the next field.
+  int spill_index = 0;
+  for (int i = 0; i < StackHandlerConstants::kSlotCount; i++) {
+    spill_index = chunk()->GetNextSpillIndex(false);
+  }
+  if (spill_index > LUnallocated::kMaxFixedSlotIndex) {
+    Abort("Too many spill slots needed for try statement");
+    spill_index = 0;
+  }
+  // Marking the instruction as a call spills every value that is live
+  // into the try block, so the landing pad finds them in their spill
+  // slots whatever the try block clobbered.
+  LInstruction* result = new(zone()) LEnterTry(spill_index);
+  result->MarkAsCall();
+  return result;
+}
+
+
+LInstruction* LChunkBuilder::DoSwitchTable(HSwitchTable* instr) {
+  ASSERT(instr->value()->representation().IsInteger32());
+  LOperand* temp = TempRegister();
+  return new(zone()) LSwitchTable(UseRegister(instr->value()), temp);
+}
+
+
+LInstruction* LChunkBuilder::DoLeaveTry(HLeaveTry* instr) {
+  return new(zone()) LLeaveTry(TempRegister());
+}
+
+
+LInstruction* LChunkBuilder::DoCatchEntry(HCatchEntry* instr) {
+  int spill_index = chunk()->GetNextSpillIndex(false);  // Not double-width.
+  if (spill_index > LUnallocated::kMaxFixedSlotIndex) {
+    Abort("Too many spill slots needed for try statement");
+    spill_index = 0;
+  }
+  // The catch entry directly follows the label of the landing pad and its
+  // gap.  The label saves the exception before any gap moves can clobber it.
+  const ZoneList<LInstruction*>* instructions = chunk()->instructions();
+  LLabel* label = LLabel::cast(instructions->at(instructions->length() - 2));
+  ASSERT(label->block() == current_block_);
+  label->set_exception_slot(spill_index);
+  return DefineAsSpilled(new(zone()) LCatchEntry, spill_index);
+}
+
+
+LInstruction* LChunkBuilder::DoStoreTrySlot(HStoreTrySlot* instr) {
+  LOperand* value = UseRegisterAtStart(instr->value());
+  return new(zone()) LStoreTrySlot(value, first_try_slot_ + instr->slot());
+}
+
+
+LInstruction* LChunkBuilder::DoLoadTrySlot(HLoadTrySlot* instr) {
+  return DefineAsSpilled(new(zone()) LLoadTrySlot,
+                         first_try_slot_ + instr->slot());
+}
+
+
 LInstruction* LChunkBuilder::DoCallStub(HCallStub* instr) {
   LOperand* context = UseFixed(instr->context(), esi);
   argument_count_ -= instr->argument_count();
@@ -2654,6 +2785,7 @@ LInstruction* LChunkBuilder::DoSimulate(HSimulate* instr) {
   ASSERT(env != NULL);
 
   env->set_ast_id(instr->ast_id());
+  env->set_try_region(instr->try_region());
 
   env->Drop(instr->pop_count());
   for (int i = instr->values()->length() - 1; i >= 0; --i) {
@@ -44,7 +44,6 @@ class LCodeGen;
   V(AccessArgumentsAt)                          \
   V(AddI)                                       \
   V(Allocate)                                   \
-  V(AllocateObject)                             \
   V(ApplyArguments)                             \
   V(ArgumentsElements)                          \
   V(ArgumentsLength)                            \
@@ -64,6 +63,7 @@ class LCodeGen;
   V(CallNewArray)                               \
   V(CallRuntime)                                \
   V(CallStub)                                   \
+  V(CatchEntry)                                 \
   V(CheckFunction)                              \
   V(CheckInstanceType)                          \
   V(CheckMaps)                                  \
@@ -91,6 +91,7 @@ class LCodeGen;
   V(DoubleToI)                                  \
   V(DummyUse)                                   \
   V(ElementsKind)                               \
+  V(EnterTry)                                   \
   V(FixedArrayBaseLength)                       \
   V(FunctionLiteral)                            \
   V(GetCachedArrayIndex)                        \
@@ -108,6 +109,7 @@ class LCodeGen;
   V(Uint32ToDouble)                             \
   V(InvokeFunction)                             \
   V(IsConstructCallAndBranch)                   \
+  V(IsInternalizedStringAndBranch)              \
   V(IsNilAndBranch)                             \
   V(IsObjectAndBranch)                          \
   V(IsStringAndBranch)                          \
@@ -115,6 +117,7 @@ class LCodeGen;
   V(IsUndetectableAndBranch)                    \
   V(Label)                                      \
   V(LazyBailout)                                \
+  V(LeaveTry)                                   \
   V(LoadContextSlot)                            \
   V(LoadExternalArrayPointer)                   \
   V(LoadFunctionPrototype)                      \
@@ -125,6 +128,7 @@ class LCodeGen;
   V(LoadNamedField)                             \
   V(LoadNamedFieldPolymorphic)                  \
   V(LoadNamedGeneric)                           \
+  V(LoadTrySlot)                                \
   V(MapEnumLength)                              \
   V(MathAbs)                                    \
   V(MathCos)                                    \
@@ -164,12 +168,14 @@ class LCodeGen;
   V(StoreKeyedGeneric)                          \
   V(StoreNamedField)                            \
   V(StoreNamedGeneric)                          \
+  V(StoreTrySlot)                               \
   V(StringAdd)                                  \
   V(StringCharCodeAt)                           \
   V(StringCharFromCode)                         \
   V(StringCompareAndBranch)                     \
   V(StringLength)                               \
   V(SubI)                                       \
+  V(SwitchTable)                                \
   V(TaggedToI)                                  \
   V(TaggedToINoSSE2)                            \
   V(ThisFunction)                               \
@@ -425,7 +431,7 @@ class LDeoptimize: public LTemplateInstruction<0, 0, 0> {
 class LLabel: public LGap {
  public:
   explicit LLabel(HBasicBlock* block)
-      : LGap(block), replacement_(NULL) { }
+      : LGap(block), replacement_(NULL), exception_slot_(-1) { }
 
   virtual bool HasInterestingComment(LCodeGen* gen) const { return false; }
   DECLARE_CONCRETE_INSTRUCTION(Label, "label")
@@ -435,14 +441,19 @@ class LLabel: public LGap {
   int block_id() const { return block()->block_id(); }
   bool is_loop_header() const { return block()->IsLoopHeader(); }
   bool is_osr_entry() const { return block()->is_osr_entry(); }
+  bool is_landing_pad() const { return block()->IsLandingPad(); }
   Label* label() { return &label_; }
   LLabel* replacement() const { return replacement_; }
   void set_replacement(LLabel* label) { replacement_ = label; }
   bool HasReplacement() const { return replacement_ != NULL; }
+  // The spill slot that receives the exception at a landing pad.
+  int exception_slot() const { return exception_slot_; }
+  void set_exception_slot(int index) { exception_slot_ = index; }
 
  private:
   Label label_;
   LLabel* replacement_;
+  int exception_slot_;
 };
 
 
@@ -494,6 +505,85 @@ class LControlInstruction: public LTemplateInstruction<0, I, T> {
 };
 
 
+class LEnterTry: public LControlInstruction<0, 0> {
+ public:
+  explicit LEnterTry(int handler_slot) : handler_slot_(handler_slot) { }
+
+  DECLARE_CONCRETE_INSTRUCTION(EnterTry, "enter-try")
+  DECLARE_HYDROGEN_ACCESSOR(EnterTry)
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  // The spill slot of the lowest word of the stack handler.
+  int handler_slot() const { return handler_slot_; }
+
+ private:
+  int handler_slot_;
+};
+
+
+class LSwitchTable: public LControlInstruction<1, 1> {
+ public:
+  LSwitchTable(LOperand* value, LOperand* temp) {
+    inputs_[0] = value;
+    temps_[0] = temp;
+  }
+
+  LOperand* value() { return inputs_[0]; }
+  LOperand* temp() { return temps_[0]; }
+
+  DECLARE_CONCRETE_INSTRUCTION(SwitchTable, "switch-table")
+  DECLARE_HYDROGEN_ACCESSOR(SwitchTable)
+
+  virtual void PrintDataTo(StringStream* stream);
+};
+
+
+class LLeaveTry: public LTemplateInstruction<0, 0, 1> {
+ public:
+  explicit LLeaveTry(LOperand* temp) {
+    temps_[0] = temp;
+  }
+
+  LOperand* temp() { return temps_[0]; }
+
+  DECLARE_CONCRETE_INSTRUCTION(LeaveTry, "leave-try")
+};
+
+
+class LCatchEntry: public LTemplateInstruction<1, 0, 0> {
+ public:
+  virtual bool HasInterestingComment(LCodeGen* gen) const { return false; }
+  DECLARE_CONCRETE_INSTRUCTION(CatchEntry, "catch-entry")
+};
+
+
+class LStoreTrySlot: public LTemplateInstruction<0, 1, 0> {
+ public:
+  LStoreTrySlot(LOperand* value, int spill_index)
+      : spill_index_(spill_index) {
+    inputs_[0] = value;
+  }
+
+  LOperand* value() { return inputs_[0]; }
+  int spill_index() const { return spill_index_; }
+
+  DECLARE_CONCRETE_INSTRUCTION(StoreTrySlot, "store-try-slot")
+
+  virtual void PrintDataTo(StringStream* stream);
+
+ private:
+  int spill_index_;
+};
+
+
+class LLoadTrySlot: public LTemplateInstruction<1, 0, 0> {
+ public:
+  virtual bool HasInterestingComment(LCodeGen* gen) const { return false; }
+  DECLARE_CONCRETE_INSTRUCTION(LoadTrySlot, "load-try-slot")
+};
+
+
 class LWrapReceiver: public LTemplateInstruction<1, 2, 1> {
  public:
   LWrapReceiver(LOperand* receiver,
@@ -884,6 +974,23 @@ class LIsStringAndBranch: public LControlInstruction<1, 1> {
 };
 
 
+class LIsInternalizedStringAndBranch: public LControlInstruction<1, 1> {
+ public:
+  LIsInternalizedStringAndBranch(LOperand* value, LOperand* temp) {
+    inputs_[0] = value;
+    temps_[0] = temp;
+  }
+
+  LOperand* value() { return inputs_[0]; }
+  LOperand* temp() { return temps_[0]; }
+
+  DECLARE_CONCRETE_INSTRUCTION(IsInternalizedStringAndBranch,
+                               "is-internalized-string-and-branch")
+
+  virtual void PrintDataTo(StringStream* stream);
+};
+
+
 class LIsSmiAndBranch: public LControlInstruction<1, 0> {
  public:
   explicit LIsSmiAndBranch(LOperand* value) {
@@ -2531,21 +2638,6 @@ class LCheckNonSmi: public LTemplateInstruction<0, 1, 0> {
 };
 
 
-class LAllocateObject: public LTemplateInstruction<1, 1, 1> {
- public:
-  LAllocateObject(LOperand* context, LOperand* temp) {
-    inputs_[0] = context;
-    temps_[0] = temp;
-  }
-
-  LOperand* context() { return inputs_[0]; }
-  LOperand* temp() { return temps_[0]; }
-
-  DECLARE_CONCRETE_INSTRUCTION(AllocateObject, "allocate-object")
-  DECLARE_HYDROGEN_ACCESSOR(AllocateObject)
-};
-
-
 class LAllocate: public LTemplateInstruction<1, 2, 1> {
  public:
   LAllocate(LOperand* context, LOperand* size, LOperand* temp) {
@@ -2798,7 +2890,8 @@ class LChunkBuilder BASE_EMBEDDED {
         allocator_(allocator),
         position_(RelocInfo::kNoPosition),
         instruction_pending_deoptimization_environment_(NULL),
-        pending_deoptimization_ast_id_(BailoutId::None()) { }
+        pending_deoptimization_ast_id_(BailoutId::None()),
+        first_try_slot_(0) { }
 
   // Build the sequence for the graph.
   LPlatformChunk* Build();
@@ -2956,6 +3049,8 @@ class LChunkBuilder BASE_EMBEDDED {
   int position_;
   LInstruction* instruction_pending_deoptimization_environment_;
   BailoutId pending_deoptimization_ast_id_;
+  // The spill index of the first try slot.
+  int first_try_slot_;
 
   DISALLOW_COPY_AND_ASSIGN(LChunkBuilder);
 };
@@ -144,6 +144,9 @@ int SystemThreadManager::NumberOfParallelSystemThreads(
     return number_of_threads - 1;
   } else if (type == PARALLEL_MARKING) {
     return number_of_threads;
+  } else if (type == PARALLEL_RECOMPILATION) {
+    // Leave one core for the execution thread.
+    return number_of_threads - 1;
   }
   return 1;
 }
@@ -1780,7 +1783,6 @@ Isolate::Isolate()
   memset(code_kind_statistics_, 0,
          sizeof(code_kind_statistics_[0]) * Code::NUMBER_OF_KINDS);
 
-  compiler_thread_handle_deref_state_ = HandleDereferenceGuard::ALLOW;
   execution_thread_handle_deref_state_ = HandleDereferenceGuard::ALLOW;
 #endif
 
@@ -2247,7 +2249,18 @@ bool Isolate::Init(Deserializer* des) {
     ArrayConstructorStubBase::InstallDescriptors(this);
   }
 
-  if (FLAG_parallel_recompilation) optimizing_compiler_thread_.Start();
+  if (FLAG_parallel_recompilation && FLAG_parallel_recompilation_threads == 0) {
+    FLAG_parallel_recompilation_threads = SystemThreadManager::
+        NumberOfParallelSystemThreads(
+            SystemThreadManager::PARALLEL_RECOMPILATION);
+  }
+  if (FLAG_parallel_recompilation_threads > 0) {
+    if (FLAG_parallel_recompilation) {
+      optimizing_compiler_thread_.Start(FLAG_parallel_recompilation_threads);
+    }
+  } else {
+    FLAG_parallel_recompilation = false;
+  }
 
   if (FLAG_parallel_marking && FLAG_marking_threads == 0) {
     FLAG_marking_threads = SystemThreadManager::
@@ -2285,11 +2298,6 @@ bool Isolate::Init(Deserializer* des) {
     FLAG_concurrent_sweeping = false;
     FLAG_parallel_sweeping = false;
   }
-  if (FLAG_parallel_recompilation &&
-      SystemThreadManager::NumberOfParallelSystemThreads(
-          SystemThreadManager::PARALLEL_RECOMPILATION) == 0) {
-    FLAG_parallel_recompilation = false;
-  }
   return true;
 }
 
@@ -2405,14 +2413,8 @@ void Isolate::UnlinkDeferredHandles(DeferredHandles* deferred) {
 
 #ifdef DEBUG
 HandleDereferenceGuard::State Isolate::HandleDereferenceGuardState() {
-  if (execution_thread_handle_deref_state_ == HandleDereferenceGuard::ALLOW &&
-      compiler_thread_handle_deref_state_ == HandleDereferenceGuard::ALLOW) {
-    // Short-cut to avoid polling thread id.
-    return HandleDereferenceGuard::ALLOW;
-  }
-  if (FLAG_parallel_recompilation &&
-      optimizing_compiler_thread()->IsOptimizerThread()) {
-    return compiler_thread_handle_deref_state_;
+  if (optimizing_compiler_thread()->IsOptimizerThread()) {
+    return optimizing_compiler_thread()->HandleDereferenceGuardState();
   } else {
     return execution_thread_handle_deref_state_;
   }
@@ -2421,9 +2423,8 @@ HandleDereferenceGuard::State Isolate::HandleDereferenceGuardState() {
 
 void Isolate::SetHandleDereferenceGuardState(
     HandleDereferenceGuard::State state) {
-  if (FLAG_parallel_recompilation &&
-      optimizing_compiler_thread()->IsOptimizerThread()) {
-    compiler_thread_handle_deref_state_ = state;
+  if (optimizing_compiler_thread()->IsOptimizerThread()) {
+    optimizing_compiler_thread()->SetHandleDereferenceGuardState(state);
   } else {
     execution_thread_handle_deref_state_ = state;
   }
@@ -2457,27 +2458,47 @@ Map* Isolate::get_initial_js_array_map(ElementsKind kind) {
 }
 
 
-bool Isolate::IsFastArrayConstructorPrototypeChainIntact() {
-  Map* root_array_map =
-      get_initial_js_array_map(GetInitialFastElementsKind());
-  ASSERT(root_array_map != NULL);
-  JSObject* initial_array_proto = JSObject::cast(*initial_array_prototype());
+bool Isolate::IsArrayProtectorIntact() {
+  Object* value = heap()->array_protector()->value();
+  return value == Smi::FromInt(kArrayProtectorValid);
+}
+
 
-  // Check that the array prototype hasn't been altered WRT empty elements.
-  if (root_array_map->prototype() != initial_array_proto) return false;
-  if (initial_array_proto->elements() != heap()->empty_fixed_array()) {
-    return false;
+bool Isolate::IsInitialArrayOrObjectPrototype(JSObject* object) {
+  Object* context = heap()->native_contexts_list();
+  while (!context->IsUndefined()) {
+    Context* native_context = Context::cast(context);
+    if (native_context->initial_array_prototype() == object ||
+        native_context->initial_object_prototype() == object) {
+      return true;
+    }
+    context = native_context->get(Context::NEXT_CONTEXT_LINK);
   }
+  return false;
+}
 
-  // Check that the object prototype hasn't been altered WRT empty elements.
-  JSObject* initial_object_proto = JSObject::cast(*initial_object_prototype());
-  Object* root_array_map_proto = initial_array_proto->GetPrototype();
-  if (root_array_map_proto != initial_object_proto) return false;
-  if (initial_object_proto->elements() != heap()->empty_fixed_array()) {
-    return false;
+
+void Isolate::UpdateArrayProtectorOnSetElement(JSObject* object) {
+  if (IsArrayProtectorIntact() && IsInitialArrayOrObjectPrototype(object)) {
+    InvalidateArrayProtector();
+  }
+}
+
+
+class DependsOnArrayProtectorFilter : public OptimizedFunctionFilter {
+ public:
+  virtual bool TakeFunction(JSFunction* function) {
+    return function->code()->depends_on_array_protector();
   }
+};
+
 
-  return initial_object_proto->GetPrototype()->IsNull();
+void Isolate::InvalidateArrayProtector() {
+  ASSERT(IsArrayProtectorIntact());
+  heap()->array_protector()->set_value(
+      Smi::FromInt(kArrayProtectorInvalid));
+  DependsOnArrayProtectorFilter filter;
+  Deoptimizer::DeoptimizeAllFunctionsWith(this, &filter);
 }
 
 
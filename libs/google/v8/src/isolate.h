@@ -1072,7 +1072,18 @@ class Isolate {
 
   Map* get_initial_js_array_map(ElementsKind kind);
 
-  bool IsFastArrayConstructorPrototypeChainIntact();
+  // The array protector stays valid as long as the initial Array.prototype
+  // and Object.prototype of every native context have no elements and keep
+  // their original prototype chain. Optimized code that treats holes in
+  // fast arrays as undefined depends on it and is deoptimized as soon as
+  // the protector is invalidated.
+  static const int kArrayProtectorValid = 1;
+  static const int kArrayProtectorInvalid = 0;
+
+  bool IsArrayProtectorIntact();
+  bool IsInitialArrayOrObjectPrototype(JSObject* object);
+  void UpdateArrayProtectorOnSetElement(JSObject* object);
+  void InvalidateArrayProtector();
 
   CodeStubInterfaceDescriptor*
       code_stub_interface_descriptor(int index);
@@ -1303,7 +1314,6 @@ class Isolate {
   JSObject::SpillInformation js_spill_information_;
   int code_kind_statistics_[Code::NUMBER_OF_KINDS];
 
-  HandleDereferenceGuard::State compiler_thread_handle_deref_state_;
   HandleDereferenceGuard::State execution_thread_handle_deref_state_;
 #endif
 
@@ -557,7 +557,11 @@ LAllocator::LAllocator(int num_values, HGraph* graph)
       num_registers_(-1),
       graph_(graph),
       has_osr_entry_(false),
-      allocation_ok_(true) { }
+      allocation_ok_(true),
+      split_count_(0),
+      spill_count_(0),
+      spill_slot_count_(0),
+      reused_spill_slot_count_(0) { }
 
 
 void LAllocator::InitializeLivenessAnalysis() {
@@ -593,6 +597,16 @@ BitVector* LAllocator::ComputeLiveOut(HBasicBlock* block) {
     }
   }
 
+  // An exception thrown in a try block enters the landing pad of the
+  // innermost try statement, which comes later in the block order.
+  HTryRegion* region = block->try_region();
+  if (region != NULL && region->HandlerRegion() != NULL) {
+    HBasicBlock* landing_pad =
+        region->HandlerRegion()->entry()->landing_pad();
+    ASSERT(landing_pad->block_id() > block->block_id());
+    live_out->Union(*live_in_sets_[landing_pad->block_id()]);
+  }
+
   return live_out;
 }
 
@@ -1096,6 +1110,7 @@ bool LAllocator::Allocate(LChunk* chunk) {
   if (has_osr_entry_) ProcessOsrEntry();
   ConnectRanges();
   ResolveControlFlow();
+  if (FLAG_trace_alloc) TraceStatistics();
   return true;
 }
 
@@ -1727,28 +1742,26 @@ bool LAllocator::UnhandledIsSorted() {
 }
 
 
-void LAllocator::FreeSpillSlot(LiveRange* range) {
-  // Check that we are the last range.
-  if (range->next() != NULL) return;
-
-  if (!range->TopLevel()->HasAllocatedSpillOperand()) return;
-
-  int index = range->TopLevel()->GetSpillOperand()->index();
-  if (index >= 0) {
-    reusable_slots_.Add(range, zone());
-  }
-}
-
-
 LOperand* LAllocator::TryReuseSpillSlot(LiveRange* range) {
-  if (reusable_slots_.is_empty()) return NULL;
-  if (reusable_slots_.first()->End().Value() >
-      range->TopLevel()->Start().Value()) {
-    return NULL;
+  LiveRange* top_level = range->TopLevel();
+  for (int i = 0; i < reusable_slots_.length(); ++i) {
+    LiveRange* owner = reusable_slots_[i];
+    LiveRange* last = owner;
+    while (last->next() != NULL) last = last->next();
+    // The slot holds the owner's value from its definition to its end,
+    // whether the owner ends up in a register or spilled.  A use at the
+    // very end may still read the slot in the gap where the new range is
+    // spilled, so the ranges must not touch.
+    if (last->End().Value() < top_level->Start().Value()) {
+      TraceAlloc("Reusing spill slot of live range %d for live range %d\n",
+                 owner->id(),
+                 top_level->id());
+      reusable_slots_[i] = top_level;
+      reused_spill_slot_count_++;
+      return owner->GetSpillOperand();
+    }
   }
-  LOperand* result = reusable_slots_.first()->TopLevel()->GetSpillOperand();
-  reusable_slots_.Remove(0);
-  return result;
+  return NULL;
 }
 
 
@@ -1756,7 +1769,6 @@ void LAllocator::ActiveToHandled(LiveRange* range) {
   ASSERT(active_live_ranges_.Contains(range));
   active_live_ranges_.RemoveElement(range);
   TraceAlloc("Moving live range %d from active to handled\n", range->id());
-  FreeSpillSlot(range);
 }
 
 
@@ -1772,7 +1784,6 @@ void LAllocator::InactiveToHandled(LiveRange* range) {
   ASSERT(inactive_live_ranges_.Contains(range));
   inactive_live_ranges_.RemoveElement(range);
   TraceAlloc("Moving live range %d from inactive to handled\n", range->id());
-  FreeSpillSlot(range);
 }
 
 
@@ -2061,6 +2072,7 @@ LiveRange* LAllocator::SplitRangeAt(LiveRange* range, LifetimePosition pos) {
   if (!AllocationOk()) return NULL;
   LiveRange* result = LiveRangeFor(vreg);
   range->SplitAt(pos, result, zone_);
+  split_count_++;
   return result;
 }
 
@@ -2163,12 +2175,62 @@ void LAllocator::Spill(LiveRange* range) {
   TraceAlloc("Spilling live range %d\n", range->id());
   LiveRange* first = range->TopLevel();
 
+  // Ranges produced in fixed stack slots keep them; only slots taken from
+  // the chunk here can be shared with ranges that do not overlap.
   if (!first->HasAllocatedSpillOperand()) {
     LOperand* op = TryReuseSpillSlot(range);
-    if (op == NULL) op = chunk_->GetNextSpillSlot(mode_ == DOUBLE_REGISTERS);
+    if (op == NULL) {
+      op = chunk_->GetNextSpillSlot(mode_ == DOUBLE_REGISTERS);
+      reusable_slots_.Add(first, zone());
+      spill_slot_count_++;
+    }
     first->SetSpillOperand(op);
   }
   range->MakeSpilled(zone_);
+  spill_count_++;
+}
+
+
+void LAllocator::TraceStatistics() {
+  int move_count = 0;
+  const ZoneList<HBasicBlock*>* blocks = graph_->blocks();
+  for (int block_id = 0; block_id < blocks->length(); ++block_id) {
+    HBasicBlock* block = blocks->at(block_id);
+    int block_moves = 0;
+    for (int index = block->first_instruction_index();
+         index <= block->last_instruction_index();
+         ++index) {
+      if (!IsGapAt(index)) continue;
+      LGap* gap = GapAt(index);
+      for (int i = LGap::FIRST_INNER_POSITION;
+           i <= LGap::LAST_INNER_POSITION;
+           i++) {
+        LParallelMove* move =
+            gap->GetParallelMove(static_cast<LGap::InnerPosition>(i));
+        if (move == NULL) continue;
+        const ZoneList<LMoveOperands>* moves = move->move_operands();
+        for (int j = 0; j < moves->length(); ++j) {
+          if (!moves->at(j).IsRedundant()) block_moves++;
+        }
+      }
+    }
+    if (block_moves > 0) {
+      PrintF("  B%d (loop depth %d): %d moves\n",
+             block_id,
+             block->LoopNestingDepth(),
+             block_moves);
+    }
+    move_count += block_moves;
+  }
+  PrintF("Register allocation: %d splits, %d spilled ranges, "
+         "%d spill slots allocated, %d spill slots reused, "
+         "%d moves in %d blocks\n",
+         split_count_,
+         spill_count_,
+         spill_slot_count_,
+         reused_spill_slot_count_,
+         move_count,
+         blocks->length());
 }
 
 
@@ -476,6 +476,7 @@ class LAllocator BASE_EMBEDDED {
   void PopulatePointerMaps();
   void ProcessOsrEntry();
   void AllocateRegisters();
+  void TraceStatistics();
   bool CanEagerlyResolveControlFlow(HBasicBlock* block) const;
   inline bool SafePointsAreInOrder() const;
 
@@ -511,7 +512,6 @@ class LAllocator BASE_EMBEDDED {
   void ActiveToInactive(LiveRange* range);
   void InactiveToHandled(LiveRange* range);
   void InactiveToActive(LiveRange* range);
-  void FreeSpillSlot(LiveRange* range);
   LOperand* TryReuseSpillSlot(LiveRange* range);
 
   // Helper methods for allocating registers.
@@ -618,6 +618,8 @@ class LAllocator BASE_EMBEDDED {
   ZoneList<LiveRange*> unhandled_live_ranges_;
   ZoneList<LiveRange*> active_live_ranges_;
   ZoneList<LiveRange*> inactive_live_ranges_;
+  // Live ranges owning the spill slots allocated by Spill().  A slot is
+  // handed over to another range once the lifetime of its owner has ended.
   ZoneList<LiveRange*> reusable_slots_;
 
   // Next virtual register number to be assigned to temporaries.
@@ -638,6 +640,12 @@ class LAllocator BASE_EMBEDDED {
   // Indicates success or failure during register allocation.
   bool allocation_ok_;
 
+  // Statistics reported under --trace-alloc.
+  int split_count_;
+  int spill_count_;
+  int spill_slot_count_;
+  int reused_spill_slot_count_;
+
 #ifdef DEBUG
   LifetimePosition allocation_finger_;
 #endif
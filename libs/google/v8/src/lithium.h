@@ -536,6 +536,8 @@ class LEnvironment: public ZoneObject {
         spilled_double_registers_(NULL),
         outer_(outer),
         entry_(entry),
+        try_region_(NULL),
+        first_expression_index_(-1),
         zone_(zone) { }
 
   Handle<JSFunction> closure() const { return closure_; }
@@ -554,6 +556,17 @@ class LEnvironment: public ZoneObject {
   LEnvironment* outer() const { return outer_; }
   HEnterInlined* entry() { return entry_; }
 
+  // The try statements enclosing the deoptimization point in the outermost
+  // environment.  Their stack handlers, or the saved state of their finally
+  // blocks, sit on the expression stack of the unoptimized frame.
+  HTryRegion* try_region() const { return try_region_; }
+  // The index of the first expression stack value.
+  int first_expression_index() const { return first_expression_index_; }
+  void set_try_region(HTryRegion* region, int first_expression_index) {
+    try_region_ = region;
+    first_expression_index_ = first_expression_index;
+  }
+
   void AddValue(LOperand* operand,
                 Representation representation,
                 bool is_uint32) {
@@ -619,6 +632,8 @@ class LEnvironment: public ZoneObject {
 
   LEnvironment* outer_;
   HEnterInlined* entry_;
+  HTryRegion* try_region_;
+  int first_expression_index_;
 
   Zone* zone_;
 };
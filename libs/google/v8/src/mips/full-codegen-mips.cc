@@ -3651,7 +3651,6 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   ParameterCount count(arg_count);
   __ InvokeFunction(a1, count, CALL_FUNCTION,
                     NullCallWrapper(), CALL_AS_METHOD);
-  __ lw(cp, MemOperand(fp, StandardFrameConstants::kContextOffset));
   __ jmp(&done);
 
   __ bind(&runtime);
@@ -3659,6 +3658,10 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   __ CallRuntime(Runtime::kCall, args->length());
   __ bind(&done);
 
+  // Record the return site before restoring the context so that a caller
+  // inlined into optimized code resumes here with its own context.
+  PrepareForBailoutForId(expr->ReturnId(), TOS_REG);
+  __ lw(cp, MemOperand(fp, StandardFrameConstants::kContextOffset));
   context()->Plug(v0);
 }
 
@@ -4018,6 +4018,21 @@ void Code::set_marked_for_deoptimization(bool flag) {
 }
 
 
+bool Code::depends_on_array_protector() {
+  ASSERT(kind() == OPTIMIZED_FUNCTION);
+  return DependsOnArrayProtectorField::decode(
+      READ_UINT32_FIELD(this, kKindSpecificFlags1Offset));
+}
+
+
+void Code::set_depends_on_array_protector(bool flag) {
+  ASSERT(kind() == OPTIMIZED_FUNCTION);
+  int previous = READ_UINT32_FIELD(this, kKindSpecificFlags1Offset);
+  int updated = DependsOnArrayProtectorField::update(previous, flag);
+  WRITE_UINT32_FIELD(this, kKindSpecificFlags1Offset, updated);
+}
+
+
 bool Code::is_inline_cache_stub() {
   Kind kind = this->kind();
   return kind >= FIRST_IC_KIND && kind <= LAST_IC_KIND;
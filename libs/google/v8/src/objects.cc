@@ -5761,6 +5761,7 @@ bool JSObject::CanSetCallback(Name* name) {
 MaybeObject* JSObject::SetElementCallback(uint32_t index,
                                           Object* structure,
                                           PropertyAttributes attributes) {
+  GetIsolate()->UpdateArrayProtectorOnSetElement(this);
   PropertyDetails details = PropertyDetails(attributes, CALLBACKS, 0);
 
   // Normalize elements to make this operation simple.
@@ -10337,6 +10338,20 @@ void DeoptimizationInputData::DeoptimizationInputDataPrint(FILE* out) {
                  args_index, args_length, args_known);
           break;
         }
+
+        case Translation::STACK_HANDLER: {
+          unsigned state = iterator.Next();
+          int offset = iterator.Next();
+          PrintF(out, "{state=%u, offset=%d}", state, offset);
+          break;
+        }
+
+        case Translation::FINALLY_STATE: {
+          int return_id = iterator.Next();
+          int index = iterator.Next();
+          PrintF(out, "{return_id=%d, index=%d}", return_id, index);
+          break;
+        }
       }
       PrintF(out, "\n");
     }
@@ -10674,6 +10689,9 @@ static bool GetOldValue(Isolate* isolate,
 MaybeObject* JSArray::SetElementsLength(Object* len) {
   // We should never end in here with a pixel or external array.
   ASSERT(AllowsSetElementsLength());
+  // Growing the initial Array.prototype gives it a backing store that
+  // stores can fill without going through SetElement.
+  GetIsolate()->UpdateArrayProtectorOnSetElement(this);
   if (!(FLAG_harmony_observation && map()->is_observed()))
     return GetElementsAccessor()->SetLength(this, len);
 
@@ -10979,6 +10997,11 @@ MaybeObject* JSReceiver::SetPrototype(Object* value,
   // Nothing to do if prototype is already set.
   if (map->prototype() == value) return value;
 
+  // The new prototype chain of an initial prototype could contain elements.
+  if (real_receiver->IsJSObject()) {
+    isolate->UpdateArrayProtectorOnSetElement(JSObject::cast(real_receiver));
+  }
+
   if (value->IsJSObject()) {
     MaybeObject* ok = JSObject::cast(value)->OptimizeAsPrototype();
     if (ok->IsFailure()) return ok;
@@ -11267,18 +11290,6 @@ MaybeObject* JSObject::SetFastElement(uint32_t index,
   ASSERT(HasFastSmiOrObjectElements() ||
          HasFastArgumentsElements());
 
-  // Array optimizations rely on the prototype lookups of Array objects always
-  // returning undefined. If there is a store to the initial prototype object,
-  // make sure all of these optimizations are invalidated.
-  Isolate* isolate(GetIsolate());
-  if (isolate->is_initial_object_prototype(this) ||
-      isolate->is_initial_array_prototype(this)) {
-    HandleScope scope(GetIsolate());
-    map()->dependent_code()->DeoptimizeDependentCodeGroup(
-        GetIsolate(),
-        DependentCode::kElementsCantBeAddedGroup);
-  }
-
   FixedArray* backing_store = FixedArray::cast(elements());
   if (backing_store->map() == GetHeap()->non_strict_arguments_elements_map()) {
     backing_store = FixedArray::cast(backing_store->get(1));
@@ -11820,6 +11831,8 @@ MaybeObject* JSObject::SetElementWithoutInterceptor(uint32_t index,
       CheckArrayAbuse(this, "elements write", index, true);
     }
   }
+  // Prototype lookups of fast arrays are assumed to never find elements.
+  isolate->UpdateArrayProtectorOnSetElement(this);
   switch (GetElementsKind()) {
     case FAST_SMI_ELEMENTS:
     case FAST_ELEMENTS:
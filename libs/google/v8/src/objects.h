@@ -4633,6 +4633,12 @@ class Code: public HeapObject {
   inline bool marked_for_deoptimization();
   inline void set_marked_for_deoptimization(bool flag);
 
+  // [depends_on_array_protector]: For kind OPTIMIZED_FUNCTION tells whether
+  // the code omits hole checks on the strength of the array protector and
+  // has to be deoptimized when the protector is invalidated.
+  inline bool depends_on_array_protector();
+  inline void set_depends_on_array_protector(bool flag);
+
   bool allowed_in_shared_map_code_cache();
 
   // Get the safepoint entry for the given pc.
@@ -4794,6 +4800,10 @@ class Code: public HeapObject {
   // nesting that is deeper than 5 levels into account.
   static const int kMaxLoopNestingMarker = 6;
 
+  // Loop nesting marker of back edges that are never patched for OSR, like
+  // the ones of loops inside try statements.
+  static const int kNoOsrLoopNestingMarker = kMaxLoopNestingMarker + 1;
+
   // Layout description.
   static const int kInstructionSizeOffset = HeapObject::kHeaderSize;
   static const int kRelocationInfoOffset = kInstructionSizeOffset + kIntSize;
@@ -4858,6 +4868,9 @@ class Code: public HeapObject {
   static const int kMarkedForDeoptimizationFirstBit =
       kStackSlotsFirstBit + kStackSlotsBitCount + 1;
   static const int kMarkedForDeoptimizationBitCount = 1;
+  static const int kDependsOnArrayProtectorFirstBit =
+      kMarkedForDeoptimizationFirstBit + kMarkedForDeoptimizationBitCount;
+  static const int kDependsOnArrayProtectorBitCount = 1;
 
   STATIC_ASSERT(kStackSlotsFirstBit + kStackSlotsBitCount <= 32);
   STATIC_ASSERT(kUnaryOpTypeFirstBit + kUnaryOpTypeBitCount <= 32);
@@ -4865,6 +4878,8 @@ class Code: public HeapObject {
   STATIC_ASSERT(kHasFunctionCacheFirstBit + kHasFunctionCacheBitCount <= 32);
   STATIC_ASSERT(kMarkedForDeoptimizationFirstBit +
                 kMarkedForDeoptimizationBitCount <= 32);
+  STATIC_ASSERT(kDependsOnArrayProtectorFirstBit +
+                kDependsOnArrayProtectorBitCount <= 32);
 
   class StackSlotsField: public BitField<int,
       kStackSlotsFirstBit, kStackSlotsBitCount> {};  // NOLINT
@@ -4877,6 +4892,9 @@ class Code: public HeapObject {
   class MarkedForDeoptimizationField: public BitField<bool,
       kMarkedForDeoptimizationFirstBit,
       kMarkedForDeoptimizationBitCount> {};  // NOLINT
+  class DependsOnArrayProtectorField: public BitField<bool,
+      kDependsOnArrayProtectorFirstBit,
+      kDependsOnArrayProtectorBitCount> {};  // NOLINT
 
   // KindSpecificFlags2 layout (ALL)
   static const int kIsCrankshaftedBit = 0;
@@ -4977,10 +4995,7 @@ class DependentCode: public FixedArray {
     // described by this map changes shape (and transitions to a new map),
     // possibly invalidating the assumptions embedded in the code.
     kPrototypeCheckGroup,
-    // Group of code that depends on elements not being added to objects with
-    // this map.
-    kElementsCantBeAddedGroup,
-    kGroupCount = kElementsCantBeAddedGroup + 1
+    kGroupCount = kPrototypeCheckGroup + 1
   };
 
   // Array for holding the index of the first code object of each group.
@@ -5759,6 +5774,10 @@ class Script: public Struct {
 #define FUNCTIONS_WITH_ID_LIST(V)                   \
   V(Array.prototype, push, ArrayPush)               \
   V(Array.prototype, pop, ArrayPop)                 \
+  V(Array.prototype, forEach, ArrayForEach)         \
+  V(Array.prototype, map, ArrayMap)                 \
+  V(Array.prototype, filter, ArrayFilter)           \
+  V(Array.prototype, reduce, ArrayReduce)           \
   V(Function.prototype, apply, FunctionApply)       \
   V(String.prototype, charCodeAt, StringCharCodeAt) \
   V(String.prototype, charAt, StringCharAt)         \
@@ -25,10 +25,12 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-#include "optimizing-compiler-thread.h"
-
 #include "v8.h"
 
+#include "optimizing-compiler-thread.h"
+
+#include "code-stubs.h"
+#include "deoptimizer.h"
 #include "hydrogen.h"
 #include "isolate.h"
 #include "v8threads.h"
@@ -37,36 +39,37 @@ namespace v8 {
 namespace internal {
 
 
-void OptimizingCompilerThread::Run() {
+void OptimizingCompilerThread::CompilerThread::Run() {
 #ifdef DEBUG
   thread_id_ = ThreadId::Current().ToInteger();
 #endif
-  Isolate::SetIsolateThreadLocals(isolate_, NULL);
+  Isolate* isolate = pool_->isolate_;
+  Isolate::SetIsolateThreadLocals(isolate, NULL);
 
   int64_t epoch = 0;
   if (FLAG_trace_parallel_recompilation) epoch = OS::Ticks();
 
   while (true) {
-    input_queue_semaphore_->Wait();
+    pool_->input_queue_semaphore_->Wait();
     Logger::TimerEventScope timer(
-        isolate_, Logger::TimerEventScope::v8_recompile_parallel);
+        isolate, Logger::TimerEventScope::v8_recompile_parallel);
 
     if (FLAG_parallel_recompilation_delay != 0) {
       OS::Sleep(FLAG_parallel_recompilation_delay);
     }
 
-    if (Acquire_Load(&stop_thread_)) {
-      stop_semaphore_->Signal();
+    if (Acquire_Load(&pool_->stop_thread_)) {
       if (FLAG_trace_parallel_recompilation) {
         time_spent_total_ = OS::Ticks() - epoch;
       }
+      pool_->stop_semaphore_->Signal();
       return;
     }
 
     int64_t compiling_start = 0;
     if (FLAG_trace_parallel_recompilation) compiling_start = OS::Ticks();
 
-    CompileNext();
+    pool_->CompileNext();
 
     if (FLAG_trace_parallel_recompilation) {
       time_spent_compiling_ += OS::Ticks() - compiling_start;
@@ -75,9 +78,28 @@ void OptimizingCompilerThread::Run() {
 }
 
 
+void OptimizingCompilerThread::Start(int thread_count) {
+  ASSERT(thread_count > 0);
+  thread_count_ = thread_count;
+  threads_ = new CompilerThread*[thread_count_];
+  for (int i = 0; i < thread_count_; i++) {
+    threads_[i] = new CompilerThread(this);
+    threads_[i]->Start();
+  }
+}
+
+
 void OptimizingCompilerThread::CompileNext() {
   OptimizingCompiler* optimizing_compiler = NULL;
-  input_queue_.Dequeue(&optimizing_compiler);
+  { ScopedLock lock(input_queue_mutex_);
+    input_queue_.Dequeue(&optimizing_compiler);
+    // The counters are not thread-safe, so they are updated while holding
+    // the input queue lock.
+    Counters* counters = isolate_->counters();
+    counters->parallel_recompilation_jobs()->Increment();
+    counters->parallel_recompilation_queue_wait()->Increment(
+        static_cast<int>(OS::Ticks() - optimizing_compiler->time_queued()));
+  }
   Barrier_AtomicIncrement(&queue_length_, static_cast<Atomic32>(-1));
 
   // The function may have already been optimized by OSR.  Simply continue.
@@ -85,21 +107,34 @@ void OptimizingCompilerThread::CompileNext() {
   USE(status);   // Prevent an unused-variable error in release mode.
   ASSERT(status != OptimizingCompiler::FAILED);
 
-  // The function may have already been optimized by OSR.  Simply continue.
-  // Mark it for installing before queuing so that we can be sure of the write
-  // order: marking first and (after being queued) installing code second.
-  { Heap::RelocationLock relocation_lock(isolate_->heap());
-    optimizing_compiler->info()->closure()->MarkForInstallingRecompiledCode();
+  if (!optimizing_compiler->info()->osr_ast_id().IsNone()) {
+    // OSR jobs leave the function's code alone.
+    ScopedLock lock(output_queue_mutex_);
+    osr_output_queue_.Enqueue(optimizing_compiler);
+  } else {
+    // The function may have already been optimized by OSR.  Simply continue.
+    // Mark it for installing before queuing so that we can be sure of the
+    // write order: marking first and (after being queued) installing code
+    // second.
+    { Heap::RelocationLock relocation_lock(isolate_->heap());
+      optimizing_compiler->info()->closure()->MarkForInstallingRecompiledCode();
+    }
+    ScopedLock lock(output_queue_mutex_);
+    output_queue_.Enqueue(optimizing_compiler);
   }
-  output_queue_.Enqueue(optimizing_compiler);
+  // Have the execution thread install the finished jobs at the next stack
+  // guard interrupt.  Requests made before it gets there are coalesced, so
+  // that jobs finishing close together are installed in one batch.
+  isolate_->stack_guard()->RequestInstallCode();
 }
 
 
 void OptimizingCompilerThread::Stop() {
   ASSERT(!IsOptimizerThread());
   Release_Store(&stop_thread_, static_cast<AtomicWord>(true));
-  input_queue_semaphore_->Signal();
-  stop_semaphore_->Wait();
+  for (int i = 0; i < thread_count_; i++) input_queue_semaphore_->Signal();
+  for (int i = 0; i < thread_count_; i++) stop_semaphore_->Wait();
+  for (int i = 0; i < thread_count_; i++) threads_[i]->Join();
 
   if (FLAG_parallel_recompilation_delay != 0) {
     InstallOptimizedFunctions();
@@ -112,10 +147,15 @@ void OptimizingCompilerThread::Stop() {
   }
 
   if (FLAG_trace_parallel_recompilation) {
-    double compile_time = static_cast<double>(time_spent_compiling_);
-    double total_time = static_cast<double>(time_spent_total_);
+    double compile_time = 0;
+    double total_time = 0;
+    for (int i = 0; i < thread_count_; i++) {
+      compile_time += static_cast<double>(threads_[i]->time_spent_compiling_);
+      total_time += static_cast<double>(threads_[i]->time_spent_total_);
+    }
     double percentage = (compile_time * 100) / total_time;
-    PrintF("  ** Compiler thread did %.2f%% useful work\n", percentage);
+    PrintF("  ** %d compiler thread(s) did %.2f%% useful work\n",
+           thread_count_, percentage);
   }
 }
 
@@ -124,12 +164,85 @@ void OptimizingCompilerThread::InstallOptimizedFunctions() {
   ASSERT(!IsOptimizerThread());
   HandleScope handle_scope(isolate_);
   int functions_installed = 0;
+  // The execution thread is the only consumer of the output queue, so it
+  // does not need the lock to dequeue.
   while (!output_queue_.IsEmpty()) {
     OptimizingCompiler* compiler;
     output_queue_.Dequeue(&compiler);
     Compiler::InstallOptimizedCode(compiler);
     functions_installed++;
   }
+  while (!osr_output_queue_.IsEmpty()) {
+    OptimizingCompiler* compiler;
+    osr_output_queue_.Dequeue(&compiler);
+    pending_osr_jobs_.RemoveElement(compiler);
+    AddReadyOSRJob(compiler);
+  }
+}
+
+
+void OptimizingCompilerThread::AddReadyOSRJob(
+    OptimizingCompiler* optimizing_compiler) {
+  if (ready_osr_jobs_.length() == kMaxReadyOSRJobs) {
+    // The oldest job has not been picked up in time, probably because its
+    // loop has been left.  Drop it.
+    delete ready_osr_jobs_.Remove(0)->info();
+  }
+  ready_osr_jobs_.Add(optimizing_compiler);
+
+  // Have the next back edge of the OSR entry's loop ask for the code.
+  CompilationInfo* info = optimizing_compiler->info();
+  Code* unoptimized_code = info->shared_info()->code();
+  Code* interrupt_code = NULL;
+  InterruptStub interrupt_stub;
+  if (unoptimized_code->kind() == Code::FUNCTION &&
+      interrupt_stub.FindCodeInCache(&interrupt_code, isolate_)) {
+    Code* replacement_code =
+        isolate_->builtins()->builtin(Builtins::kOnStackReplacement);
+    Deoptimizer::PatchInterruptCodeForOsrEntry(
+        unoptimized_code, info->osr_ast_id(), interrupt_code,
+        replacement_code);
+  }
+}
+
+
+bool OptimizingCompilerThread::IsQueuedForOSR(Handle<JSFunction> function,
+                                              BailoutId osr_ast_id) {
+  ASSERT(!IsOptimizerThread());
+  for (int i = 0; i < pending_osr_jobs_.length(); i++) {
+    CompilationInfo* info = pending_osr_jobs_[i]->info();
+    if (info->closure().is_identical_to(function) &&
+        info->osr_ast_id() == osr_ast_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+bool OptimizingCompilerThread::IsQueuedForOSR(JSFunction* function) {
+  ASSERT(!IsOptimizerThread());
+  for (int i = 0; i < pending_osr_jobs_.length(); i++) {
+    if (*pending_osr_jobs_[i]->info()->closure() == function) return true;
+  }
+  for (int i = 0; i < ready_osr_jobs_.length(); i++) {
+    if (*ready_osr_jobs_[i]->info()->closure() == function) return true;
+  }
+  return false;
+}
+
+
+OptimizingCompiler* OptimizingCompilerThread::FindReadyOSRCandidate(
+    Handle<JSFunction> function, BailoutId osr_ast_id) {
+  ASSERT(!IsOptimizerThread());
+  for (int i = 0; i < ready_osr_jobs_.length(); i++) {
+    CompilationInfo* info = ready_osr_jobs_[i]->info();
+    if (info->closure().is_identical_to(function) &&
+        info->osr_ast_id() == osr_ast_id) {
+      return ready_osr_jobs_.Remove(i);
+    }
+  }
+  return NULL;
 }
 
 
@@ -138,16 +251,57 @@ void OptimizingCompilerThread::QueueForOptimization(
   ASSERT(IsQueueAvailable());
   ASSERT(!IsOptimizerThread());
   Barrier_AtomicIncrement(&queue_length_, static_cast<Atomic32>(1));
-  optimizing_compiler->info()->closure()->MarkInRecompileQueue();
+  if (optimizing_compiler->info()->osr_ast_id().IsNone()) {
+    optimizing_compiler->info()->closure()->MarkInRecompileQueue();
+  } else {
+    pending_osr_jobs_.Add(optimizing_compiler);
+  }
+  optimizing_compiler->set_time_queued(OS::Ticks());
   input_queue_.Enqueue(optimizing_compiler);
   input_queue_semaphore_->Signal();
 }
 
 
+OptimizingCompilerThread::~OptimizingCompilerThread() {
+  for (int i = 0; i < thread_count_; i++) delete threads_[i];
+  delete[] threads_;
+  delete output_queue_mutex_;
+  delete input_queue_mutex_;
+  delete input_queue_semaphore_;
+  delete stop_semaphore_;
+}
+
+
 #ifdef DEBUG
+OptimizingCompilerThread::CompilerThread*
+    OptimizingCompilerThread::CurrentCompilerThread() {
+  int thread_id = ThreadId::Current().ToInteger();
+  for (int i = 0; i < thread_count_; i++) {
+    if (threads_[i]->thread_id_ == thread_id) return threads_[i];
+  }
+  return NULL;
+}
+
+
 bool OptimizingCompilerThread::IsOptimizerThread() {
   if (!FLAG_parallel_recompilation) return false;
-  return ThreadId::Current().ToInteger() == thread_id_;
+  return CurrentCompilerThread() != NULL;
+}
+
+
+HandleDereferenceGuard::State
+    OptimizingCompilerThread::HandleDereferenceGuardState() {
+  CompilerThread* thread = CurrentCompilerThread();
+  ASSERT(thread != NULL);
+  return thread->handle_deref_state_;
+}
+
+
+void OptimizingCompilerThread::SetHandleDereferenceGuardState(
+    HandleDereferenceGuard::State state) {
+  CompilerThread* thread = CurrentCompilerThread();
+  ASSERT(thread != NULL);
+  thread->handle_deref_state_ = state;
 }
 #endif
 
@@ -30,6 +30,7 @@
 
 #include "atomicops.h"
 #include "flags.h"
+#include "list.h"
 #include "platform.h"
 #include "unbound-queue.h"
 
@@ -37,31 +38,49 @@ namespace v8 {
 namespace internal {
 
 class HOptimizedGraphBuilder;
+class JSFunction;
 class OptimizingCompiler;
 class SharedFunctionInfo;
 
-class OptimizingCompilerThread : public Thread {
+// Runs the graph optimization and Lithium phases of parallel recompilation
+// jobs on a pool of background threads.  All compiler threads take jobs from
+// one shared input queue.  Every job owns the zone it is compiled in, so the
+// threads do not share any compiler state.  Finished jobs are handed back
+// through the output queue and installed in batches by the execution thread,
+// at the next stack guard interrupt or runtime profiler tick.  Jobs compiling
+// OSR code are handed back separately, see FindReadyOSRCandidate.
+class OptimizingCompilerThread {
  public:
   explicit OptimizingCompilerThread(Isolate *isolate) :
-      Thread("OptimizingCompilerThread"),
-#ifdef DEBUG
-      thread_id_(0),
-#endif
       isolate_(isolate),
+      thread_count_(0),
+      threads_(NULL),
       stop_semaphore_(OS::CreateSemaphore(0)),
       input_queue_semaphore_(OS::CreateSemaphore(0)),
-      time_spent_compiling_(0),
-      time_spent_total_(0) {
+      input_queue_mutex_(OS::CreateMutex()),
+      output_queue_mutex_(OS::CreateMutex()) {
     NoBarrier_Store(&stop_thread_, static_cast<AtomicWord>(false));
     NoBarrier_Store(&queue_length_, static_cast<AtomicWord>(0));
   }
 
-  void Run();
+  // Starts the given number of compiler threads.
+  void Start(int thread_count);
   void Stop();
   void CompileNext();
   void QueueForOptimization(OptimizingCompiler* optimizing_compiler);
   void InstallOptimizedFunctions();
 
+  // Jobs compiling OSR code are not installed when they finish.  Instead the
+  // back edges of the function are patched again, and the job is picked up
+  // by the next on-stack replacement attempt for its OSR entry.
+  bool IsQueuedForOSR(Handle<JSFunction> function, BailoutId osr_ast_id);
+  // Returns whether any OSR job for the function has not been picked up.
+  bool IsQueuedForOSR(JSFunction* function);
+  // Returns the finished job for the given OSR entry, or NULL.  The caller
+  // is responsible for installing it.
+  OptimizingCompiler* FindReadyOSRCandidate(Handle<JSFunction> function,
+                                            BailoutId osr_ast_id);
+
   inline bool IsQueueAvailable() {
     // We don't need a barrier since we have a data dependency right
     // after.
@@ -73,32 +92,77 @@ class OptimizingCompilerThread : public Thread {
     // only one thread can run inside an Isolate at one time, a direct
     // doesn't introduce a race -- queue_length_ may decreased in
     // meantime, but not increased.
-    return (current_length < FLAG_parallel_recompilation_queue_length);
+    // The queue grows with the number of compiler threads, so that all of
+    // them can be kept busy.
+    return (current_length <
+            FLAG_parallel_recompilation_queue_length * thread_count_);
   }
 
 #ifdef DEBUG
   bool IsOptimizerThread();
+
+  // Every compiler thread has its own handle dereference state.  These may
+  // only be called on a compiler thread.
+  HandleDereferenceGuard::State HandleDereferenceGuardState();
+  void SetHandleDereferenceGuardState(HandleDereferenceGuard::State state);
 #endif
 
-  ~OptimizingCompilerThread() {
-    delete input_queue_semaphore_;
-    delete stop_semaphore_;
-  }
+  ~OptimizingCompilerThread();
 
  private:
+  class CompilerThread : public Thread {
+   public:
+    explicit CompilerThread(OptimizingCompilerThread* pool) :
+        Thread("OptimizingCompilerThread"),
+#ifdef DEBUG
+        thread_id_(0),
+        handle_deref_state_(HandleDereferenceGuard::ALLOW),
+#endif
+        pool_(pool),
+        time_spent_compiling_(0),
+        time_spent_total_(0) { }
+
+    void Run();
+
+#ifdef DEBUG
+    int thread_id_;
+    HandleDereferenceGuard::State handle_deref_state_;
+#endif
+    OptimizingCompilerThread* pool_;
+    int64_t time_spent_compiling_;
+    int64_t time_spent_total_;
+  };
+
+  // Finished OSR jobs that have not been picked up are dropped, oldest first,
+  // beyond this limit.
+  static const int kMaxReadyOSRJobs = 4;
+
+  void AddReadyOSRJob(OptimizingCompiler* optimizing_compiler);
+
 #ifdef DEBUG
-  int thread_id_;
+  // Returns the compiler thread the caller is running on, or NULL.
+  CompilerThread* CurrentCompilerThread();
 #endif
 
   Isolate* isolate_;
+  int thread_count_;
+  CompilerThread** threads_;
   Semaphore* stop_semaphore_;
   Semaphore* input_queue_semaphore_;
+  // The input queue has a single producer, the execution thread, but one
+  // consumer per compiler thread, which take turns through this mutex.  The
+  // output queue is the other way around.
+  Mutex* input_queue_mutex_;
+  Mutex* output_queue_mutex_;
   UnboundQueue<OptimizingCompiler*> input_queue_;
   UnboundQueue<OptimizingCompiler*> output_queue_;
+  UnboundQueue<OptimizingCompiler*> osr_output_queue_;
+  // OSR jobs that are still compiling, and those that have finished.  Only
+  // accessed by the execution thread.
+  List<OptimizingCompiler*> pending_osr_jobs_;
+  List<OptimizingCompiler*> ready_osr_jobs_;
   volatile AtomicWord stop_thread_;
   volatile Atomic32 queue_length_;
-  int64_t time_spent_compiling_;
-  int64_t time_spent_total_;
 };
 
 } }  // namespace v8::internal
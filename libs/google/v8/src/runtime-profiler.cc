@@ -267,6 +267,11 @@ void RuntimeProfiler::OptimizeNow() {
 
     if (shared_code->kind() != Code::FUNCTION) continue;
     if (function->IsInRecompileQueue()) continue;
+    // Do not move OSR to another loop while the code for one is compiling.
+    if (FLAG_parallel_recompilation && FLAG_concurrent_osr &&
+        isolate_->optimizing_compiler_thread()->IsQueuedForOSR(function)) {
+      continue;
+    }
 
     // Attempt OSR if we are still running unoptimized code even though the
     // the function has long been marked or even already been optimized.
@@ -8094,8 +8094,13 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_WaitUntilOptimized) {
   ASSERT(args.length() == 1);
   CONVERT_ARG_HANDLE_CHECKED(JSFunction, function, 0);
   if (FLAG_parallel_recompilation) {
-    if (V8::UseCrankshaft() && function->IsOptimizable()) {
-      while (!function->IsOptimized()) OS::Sleep(50);
+    // Finished jobs are only installed by this thread, so install them
+    // while waiting instead of waiting for the next stack guard interrupt.
+    OptimizingCompilerThread* thread = isolate->optimizing_compiler_thread();
+    while (function->IsInRecompileQueue() ||
+           function->IsMarkedForInstallingRecompiledCode()) {
+      OS::Sleep(50);
+      thread->InstallOptimizedFunctions();
     }
   }
   return isolate->heap()->undefined_value();
@@ -8163,6 +8168,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_CompileForOnStackReplacement) {
   }
 
   BailoutId ast_id = BailoutId::None();
+  OptimizingCompiler* osr_job = NULL;
   if (succeeded) {
     // The top JS function is this one, the PC is somewhere in the
     // unoptimized code.
@@ -8198,11 +8204,38 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_CompileForOnStackReplacement) {
       PrintF("]\n");
     }
 
-    // Try to compile the optimized code.  A true return value from
-    // CompileOptimized means that compilation succeeded, not necessarily
-    // that optimization succeeded.
-    if (JSFunction::CompileOptimized(function, ast_id, CLEAR_EXCEPTION) &&
-        function->IsOptimized()) {
+    if (FLAG_parallel_recompilation && FLAG_concurrent_osr) {
+      OptimizingCompilerThread* thread = isolate->optimizing_compiler_thread();
+      osr_job = thread->FindReadyOSRCandidate(function, ast_id);
+      if (osr_job == NULL) {
+        // Compile the OSR code on the compiler thread and keep running the
+        // unoptimized code meanwhile.  The back edges are patched again
+        // once the job has finished.
+        if (!thread->IsQueuedForOSR(function, ast_id) &&
+            Compiler::RecompileParallel(function, ast_id)) {
+          isolate->counters()->osr_parallel_compiles()->Increment();
+          if (FLAG_trace_osr) {
+            PrintF("[queued for parallel on-stack replacement]\n");
+          }
+        }
+        succeeded = false;
+      }
+    }
+  }
+
+  if (succeeded) {
+    // Try to compile the optimized code, or install the code compiled on
+    // the compiler thread.  A true result means that compilation succeeded,
+    // not necessarily that optimization succeeded.
+    bool compiled = true;
+    if (osr_job != NULL) {
+      Compiler::InstallOptimizedCode(osr_job);
+    } else {
+      isolate->counters()->osr_compile_stalls()->Increment();
+      compiled = JSFunction::CompileOptimized(function, ast_id,
+                                              CLEAR_EXCEPTION);
+    }
+    if (compiled && function->IsOptimized()) {
       DeoptimizationInputData* data = DeoptimizationInputData::cast(
           function->code()->deoptimization_data());
       if (data->OsrPcOffset()->value() >= 0) {
@@ -243,6 +243,12 @@ namespace internal {
   SC(fast_new_closure_total, V8.FastNewClosureTotal)                  \
   SC(fast_new_closure_try_optimized, V8.FastNewClosureTryOptimized)   \
   SC(fast_new_closure_install_optimized, V8.FastNewClosureInstallOptimized) \
+  SC(parallel_recompilation_jobs, V8.ParallelRecompilationJobs)       \
+  /* Microseconds jobs spent waiting for a compiler thread. */        \
+  SC(parallel_recompilation_queue_wait, V8.ParallelRecompilationQueueWait) \
+  /* OSR compiles blocking the execution thread. */                   \
+  SC(osr_compile_stalls, V8.OSRCompileStalls)                         \
+  SC(osr_parallel_compiles, V8.OSRParallelCompiles)                   \
   SC(string_add_runtime, V8.StringAddRuntime)                         \
   SC(string_add_native, V8.StringAddNative)                           \
   SC(string_add_runtime_ext_to_ascii, V8.StringAddRuntimeExtToAscii)  \
@@ -424,6 +424,8 @@ enum CpuImplementer {
 // On X86/X64, values below 32 are bits in EDX, values above 32 are bits in ECX.
 enum CpuFeature { SSE4_1 = 32 + 19,  // x86
                   SSE3 = 32 + 0,     // x86
+                  AVX = 32 + 28,     // x86
+                  FMA3 = 32 + 12,    // x86
                   SSE2 = 26,   // x86
                   CMOV = 15,   // x86
                   RDTSC = 4,   // x86
@@ -0,0 +1,215 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "warm-start-profile.h"
+
+#include "heap.h"
+#include "platform.h"
+
+namespace v8 {
+namespace internal {
+
+static const char kHeader[] = "# v8 warm-start profile 1";
+
+
+static bool IntegerKeysMatch(void* key1, void* key2) {
+  return key1 == key2;
+}
+
+
+static void* IntegerKey(int value) {
+  return reinterpret_cast<void*>(static_cast<intptr_t>(value));
+}
+
+
+WarmStartProfile::WarmStartProfile()
+    : entries_(0),
+      positions_(IntegerKeysMatch),
+      script_hashes_(IntegerKeysMatch) {
+}
+
+
+uint32_t WarmStartProfile::HashSource(Script* script) {
+  // The string hash of the source cannot be used since it is seeded per
+  // heap and is trivial for long strings.  Use Jenkins' one-at-a-time hash
+  // over the whole source instead.
+  String* source = String::cast(script->source());
+  ConsStringIteratorOp op;
+  StringCharacterStream stream(source, &op);
+  uint32_t hash = source->length();
+  while (stream.HasMore()) {
+    hash += stream.GetNext();
+    hash += hash << 10;
+    hash ^= hash >> 6;
+  }
+  hash += hash << 3;
+  hash ^= hash >> 11;
+  hash += hash << 15;
+  return hash;
+}
+
+
+uint32_t WarmStartProfile::ScriptHash(Script* script) {
+  int id = Smi::cast(script->id())->value();
+  HashMap::Entry* entry =
+      script_hashes_.Lookup(IntegerKey(id), ComputeIntegerHash(id, 0), true);
+  if (entry->value == NULL) {
+    // The low bit is always set so that NULL means "not computed yet".
+    entry->value = IntegerKey(static_cast<int>(HashSource(script)) | 1);
+  }
+  return static_cast<uint32_t>(reinterpret_cast<intptr_t>(entry->value));
+}
+
+
+static bool HasProfilableScript(SharedFunctionInfo* shared) {
+  if (!shared->script()->IsScript()) return false;
+  Script* script = Script::cast(shared->script());
+  return script->type()->value() == Script::TYPE_NORMAL &&
+      script->HasValidSource() &&
+      script->source()->IsString();
+}
+
+
+bool WarmStartProfile::Write(Isolate* isolate, const char* filename) {
+  FILE* file = OS::FOpen(filename, "w");
+  if (file == NULL) return false;
+  fprintf(file, "%s\n", kHeader);
+
+  WarmStartProfile hashes;
+  HeapIterator iterator(isolate->heap());
+  AssertNoAllocation no_allocation;
+  int count = 0;
+  for (HeapObject* obj = iterator.next(); obj != NULL; obj = iterator.next()) {
+    if (!obj->IsSharedFunctionInfo()) continue;
+    SharedFunctionInfo* shared = SharedFunctionInfo::cast(obj);
+    if (!shared->is_compiled() || !HasProfilableScript(shared)) continue;
+    int ticks = shared->profiler_ticks();
+    if (ticks == 0 && shared->opt_count() == 0 &&
+        shared->deopt_count() == 0) {
+      continue;
+    }
+    int ic_with_type_info_count = 0;
+    int ic_total_count = 0;
+    Object* raw_info = shared->code()->type_feedback_info();
+    if (raw_info->IsTypeFeedbackInfo()) {
+      TypeFeedbackInfo* info = TypeFeedbackInfo::cast(raw_info);
+      ic_with_type_info_count = info->ic_with_type_info_count();
+      ic_total_count = info->ic_total_count();
+    }
+    fprintf(file, "%08x %d %d %d %d %d %d %d %d\n",
+            hashes.ScriptHash(Script::cast(shared->script())),
+            shared->start_position(),
+            shared->end_position(),
+            ticks,
+            shared->opt_count(),
+            shared->deopt_count(),
+            shared->optimization_disabled() ? 1 : 0,
+            ic_with_type_info_count,
+            ic_total_count);
+    count++;
+  }
+  fclose(file);
+  if (FLAG_trace_warm_start) {
+    PrintF("[warm-start profile: wrote %d functions to %s]\n",
+           count, filename);
+  }
+  return true;
+}
+
+
+bool WarmStartProfile::Read(const char* filename) {
+  FILE* file = OS::FOpen(filename, "r");
+  if (file == NULL) return false;
+  char header[sizeof(kHeader) + 1];
+  if (fgets(header, sizeof(header), file) == NULL ||
+      strncmp(header, kHeader, sizeof(kHeader) - 1) != 0) {
+    fclose(file);
+    return false;
+  }
+  bool ok = true;
+  while (true) {
+    Entry entry;
+    int disabled;
+    int fields = fscanf(file, "%x %d %d %d %d %d %d %d %d",
+                        &entry.script_hash,
+                        &entry.start_position,
+                        &entry.end_position,
+                        &entry.ticks,
+                        &entry.opt_count,
+                        &entry.deopt_count,
+                        &disabled,
+                        &entry.ic_with_type_info_count,
+                        &entry.ic_total_count);
+    if (fields == EOF) break;
+    if (fields != 9) {
+      ok = false;
+      break;
+    }
+    entry.optimization_disabled = disabled != 0;
+    HashMap::Entry* first =
+        positions_.Lookup(IntegerKey(entry.start_position),
+                          ComputeIntegerHash(entry.start_position, 0),
+                          true);
+    // Indices are stored biased by one so that NULL means "no entry".
+    entry.next = static_cast<int>(reinterpret_cast<intptr_t>(first->value)) - 1;
+    first->value = IntegerKey(entries_.length() + 1);
+    entries_.Add(entry);
+  }
+  fclose(file);
+  if (FLAG_trace_warm_start) {
+    PrintF("[warm-start profile: read %d functions from %s%s]\n",
+           entries_.length(), filename, ok ? "" : ", file is malformed");
+  }
+  return ok;
+}
+
+
+const WarmStartProfile::Entry* WarmStartProfile::Lookup(
+    SharedFunctionInfo* shared) {
+  if (!HasProfilableScript(shared)) return NULL;
+  int start_position = shared->start_position();
+  HashMap::Entry* first =
+      positions_.Lookup(IntegerKey(start_position),
+                        ComputeIntegerHash(start_position, 0),
+                        false);
+  if (first == NULL) return NULL;
+  uint32_t script_hash = ScriptHash(Script::cast(shared->script()));
+  int index = static_cast<int>(reinterpret_cast<intptr_t>(first->value)) - 1;
+  while (index >= 0) {
+    const Entry* entry = &entries_[index];
+    if (entry->script_hash == script_hash &&
+        entry->end_position == shared->end_position()) {
+      return entry;
+    }
+    index = entry->next;
+  }
+  return NULL;
+}
+
+} }  // namespace v8::internal
@@ -0,0 +1,101 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_WARM_START_PROFILE_H_
+#define V8_WARM_START_PROFILE_H_
+
+#include "allocation.h"
+#include "hashmap.h"
+#include "list.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class Script;
+class SharedFunctionInfo;
+
+// A warm-start profile records what the runtime profiler learned about the
+// functions of one process (how hot they got, how much type feedback their
+// ICs collected and how often they were optimized and deoptimized) so that
+// a later process running the same scripts does not have to rediscover it.
+// Functions are identified by a hash of their script's source, which is
+// stable across processes, and their position in that source.
+class WarmStartProfile {
+ public:
+  struct Entry {
+    uint32_t script_hash;
+    int start_position;
+    int end_position;
+    int ticks;
+    int opt_count;
+    int deopt_count;
+    bool optimization_disabled;
+    int ic_with_type_info_count;
+    int ic_total_count;
+    // Index of the next entry with the same start position, or -1.
+    int next;
+  };
+
+  WarmStartProfile();
+
+  // Writes the profile of all functions in the isolate's heap that were
+  // seen by the runtime profiler to the given file.
+  static bool Write(Isolate* isolate, const char* filename);
+
+  // Reads a profile written by Write.  Returns false if the file could not
+  // be opened or is malformed.
+  bool Read(const char* filename);
+
+  // Returns the entry recorded for the given function, or NULL.
+  const Entry* Lookup(SharedFunctionInfo* shared);
+
+  // Whether the entry describes a function that was optimized in the
+  // profiled process and still had optimization enabled at the end.
+  static bool IsHot(const Entry* entry) {
+    return entry->opt_count > 0 && !entry->optimization_disabled;
+  }
+
+  int length() const { return entries_.length(); }
+
+ private:
+  static uint32_t HashSource(Script* script);
+  uint32_t ScriptHash(Script* script);
+
+  List<Entry> entries_;
+  // Maps start positions to the index of the first entry with that start
+  // position.
+  HashMap positions_;
+  // Caches the source hashes of the scripts seen so far by script id.
+  HashMap script_hashes_;
+
+  DISALLOW_COPY_AND_ASSIGN(WarmStartProfile);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_WARM_START_PROFILE_H_
@@ -110,6 +110,25 @@ void CpuFeatures::Probe() {
   supported_ = kDefaultCpuFeatures | (1 << CPUID);
   { CpuFeatureScope fscope(&assm, CPUID);
     __ cpuid();
+
+    // AVX and FMA3 also need the OS to save the upper halves of the ymm
+    // registers, which XGETBV reports once OSXSAVE is set.
+    Label no_ymm_state, ymm_state;
+    __ testl(rcx, Immediate(1 << 27));
+    __ j(zero, &no_ymm_state);
+    __ push(rdx);
+    __ push(rcx);
+    __ xorl(rcx, rcx);
+    __ xgetbv();
+    __ andl(rax, Immediate(0x6));
+    __ cmpl(rax, Immediate(0x6));
+    __ pop(rcx);
+    __ pop(rdx);
+    __ j(equal, &ymm_state);
+    __ bind(&no_ymm_state);
+    __ andl(rcx, Immediate(~((1 << (AVX - 32)) | (1 << (FMA3 - 32)))));
+    __ bind(&ymm_state);
+
     // Move the result from ecx:edx to rdi.
     __ movl(rdi, rdx);  // Zero-extended to 64 bits.
     __ shl(rcx, Immediate(32));
@@ -995,6 +1014,14 @@ void Assembler::cpuid() {
 }
 
 
+void Assembler::xgetbv() {
+  EnsureSpace ensure_space(this);
+  emit(0x0F);
+  emit(0x01);
+  emit(0xD0);
+}
+
+
 void Assembler::cqo() {
   EnsureSpace ensure_space(this);
   emit_rex_64();
@@ -2922,6 +2949,106 @@ void Assembler::divsd(XMMRegister dst, XMMRegister src) {
 }
 
 
+void Assembler::addpd(XMMRegister dst, XMMRegister src) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0x58);
+  emit_sse_operand(dst, src);
+}
+
+
+void Assembler::subpd(XMMRegister dst, XMMRegister src) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0x5C);
+  emit_sse_operand(dst, src);
+}
+
+
+void Assembler::mulpd(XMMRegister dst, XMMRegister src) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0x59);
+  emit_sse_operand(dst, src);
+}
+
+
+void Assembler::divpd(XMMRegister dst, XMMRegister src) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0x5E);
+  emit_sse_operand(dst, src);
+}
+
+
+void Assembler::cvtps2pd(XMMRegister dst, XMMRegister src) {
+  EnsureSpace ensure_space(this);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0x5A);
+  emit_sse_operand(dst, src);
+}
+
+
+void Assembler::cvtpd2ps(XMMRegister dst, XMMRegister src) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0x5A);
+  emit_sse_operand(dst, src);
+}
+
+
+void Assembler::unpcklpd(XMMRegister dst, XMMRegister src) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0x14);
+  emit_sse_operand(dst, src);
+}
+
+
+void Assembler::paddd(XMMRegister dst, XMMRegister src) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0xFE);
+  emit_sse_operand(dst, src);
+}
+
+
+void Assembler::psubd(XMMRegister dst, XMMRegister src) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0xFA);
+  emit_sse_operand(dst, src);
+}
+
+
+void Assembler::pshufd(XMMRegister dst, XMMRegister src, byte shuffle) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0x70);
+  emit_sse_operand(dst, src);
+  emit(shuffle);
+}
+
+
 void Assembler::andpd(XMMRegister dst, XMMRegister src) {
   EnsureSpace ensure_space(this);
   emit(0x66);
@@ -3006,6 +3133,62 @@ void Assembler::roundsd(XMMRegister dst, XMMRegister src,
 }
 
 
+void Assembler::emit_vex_prefix(XMMRegister reg,
+                                XMMRegister vreg,
+                                byte rm_rex,
+                                SIMDPrefix pp,
+                                LeadingOpcode mm,
+                                VexW w) {
+  // The register fields of the prefix are stored inverted.
+  byte vvvv = (~vreg.code() & 0xF) << 3;
+  if ((rm_rex & 0x3) == 0 && mm == k0F && w == kW0) {
+    emit(0xC5);
+    emit((reg.high_bit() ? 0x00 : 0x80) | vvvv | pp);
+  } else {
+    byte rxb = (reg.high_bit() << 2) | (rm_rex & 0x3);
+    emit(0xC4);
+    emit(((~rxb & 0x7) << 5) | mm);
+    emit(w | vvvv | pp);
+  }
+}
+
+
+void Assembler::vsd(byte op,
+                    XMMRegister dst,
+                    XMMRegister src1,
+                    XMMRegister src2) {
+  ASSERT(IsEnabled(AVX));
+  EnsureSpace ensure_space(this);
+  emit_vex_prefix(dst, src1, src2.high_bit(), kF2, k0F, kW0);
+  emit(op);
+  emit_sse_operand(dst, src2);
+}
+
+
+void Assembler::vsd(byte op,
+                    XMMRegister dst,
+                    XMMRegister src1,
+                    const Operand& src2) {
+  ASSERT(IsEnabled(AVX));
+  EnsureSpace ensure_space(this);
+  emit_vex_prefix(dst, src1, src2.rex_, kF2, k0F, kW0);
+  emit(op);
+  emit_sse_operand(dst, src2);
+}
+
+
+void Assembler::vfmasd(byte op,
+                       XMMRegister dst,
+                       XMMRegister src1,
+                       XMMRegister src2) {
+  ASSERT(IsEnabled(FMA3));
+  EnsureSpace ensure_space(this);
+  emit_vex_prefix(dst, src1, src2.high_bit(), k66, k0F38, kW1);
+  emit(op);
+  emit_sse_operand(dst, src2);
+}
+
+
 void Assembler::movmskpd(Register dst, XMMRegister src) {
   EnsureSpace ensure_space(this);
   emit(0x66);
@@ -425,6 +425,7 @@ class DisassemblerX64 {
   int PrintImmediateOp(byte* data);
   const char* TwoByteMnemonic(byte opcode);
   int TwoByteOpcodeInstruction(byte* data);
+  int AVXInstruction(byte* data);
   int F6F7Instruction(byte* data);
   int ShiftInstruction(byte* data);
   int JumpShort(byte* data);
@@ -1089,6 +1090,11 @@ int DisassemblerX64::TwoByteOpcodeInstruction(byte* data) {
       } else if (opcode == 0x50) {
         AppendToBuffer("movmskpd %s,", NameOfCPURegister(regop));
         current += PrintRightXMMOperand(current);
+      } else if (opcode == 0x70) {
+        AppendToBuffer("pshufd %s,", NameOfXMMRegister(regop));
+        current += PrintRightXMMOperand(current);
+        AppendToBuffer(",0x%x", *current);
+        current += 1;
       } else {
         const char* mnemonic = "?";
         if (opcode == 0x54) {
@@ -1101,6 +1107,22 @@ int DisassemblerX64::TwoByteOpcodeInstruction(byte* data) {
           mnemonic = "ucomisd";
         } else if (opcode == 0x2F) {
           mnemonic = "comisd";
+        } else if (opcode == 0x14) {
+          mnemonic = "unpcklpd";
+        } else if (opcode == 0x58) {
+          mnemonic = "addpd";
+        } else if (opcode == 0x59) {
+          mnemonic = "mulpd";
+        } else if (opcode == 0x5A) {
+          mnemonic = "cvtpd2ps";
+        } else if (opcode == 0x5C) {
+          mnemonic = "subpd";
+        } else if (opcode == 0x5E) {
+          mnemonic = "divpd";
+        } else if (opcode == 0xFA) {
+          mnemonic = "psubd";
+        } else if (opcode == 0xFE) {
+          mnemonic = "paddd";
         } else {
           UnimplementedInstruction();
         }
@@ -1193,6 +1215,17 @@ int DisassemblerX64::TwoByteOpcodeInstruction(byte* data) {
       get_modrm(*current, &mod, &regop, &rm);
       AppendToBuffer("movq %s, ", NameOfXMMRegister(regop));
       current += PrintRightXMMOperand(current);
+    } else if (opcode == 0x6F) {
+      int mod, regop, rm;
+      get_modrm(*current, &mod, &regop, &rm);
+      AppendToBuffer("movdqu %s,", NameOfXMMRegister(regop));
+      current += PrintRightXMMOperand(current);
+    } else if (opcode == 0x7F) {
+      int mod, regop, rm;
+      get_modrm(*current, &mod, &regop, &rm);
+      AppendToBuffer("movdqu ");
+      current += PrintRightXMMOperand(current);
+      AppendToBuffer(", %s", NameOfXMMRegister(regop));
     } else {
       UnimplementedInstruction();
     }
@@ -1244,6 +1277,13 @@ int DisassemblerX64::TwoByteOpcodeInstruction(byte* data) {
     AppendToBuffer("xorps %s, ", NameOfXMMRegister(regop));
     current += PrintRightXMMOperand(current);
 
+  } else if (opcode == 0x5A) {
+    // cvtps2pd xmm, xmm/m64
+    int mod, regop, rm;
+    get_modrm(*current, &mod, &regop, &rm);
+    AppendToBuffer("cvtps2pd %s, ", NameOfXMMRegister(regop));
+    current += PrintRightXMMOperand(current);
+
   } else if (opcode == 0x50) {
     // movmskps reg, xmm
     int mod, regop, rm;
@@ -1282,6 +1322,59 @@ int DisassemblerX64::TwoByteOpcodeInstruction(byte* data) {
 }
 
 
+// Handles the VEX encoded AVX and FMA3 instructions the assembler emits.
+int DisassemblerX64::AVXInstruction(byte* data) {
+  byte* current = data + 1;
+  int opcode_map, vvvv, pp;
+  bool vex_w;
+  if (*data == 0xC5) {
+    opcode_map = 1;  // 0x0F.
+    setRex(0x40 | ((~*current >> 5) & 0x4));
+    vvvv = (~*current >> 3) & 0xF;
+    pp = *current & 0x3;
+    vex_w = false;
+    current += 1;
+  } else {
+    opcode_map = *current & 0x1F;
+    setRex(0x40 | ((~*current >> 5) & 0x7));
+    vex_w = (*(current + 1) & 0x80) != 0;
+    vvvv = (~*(current + 1) >> 3) & 0xF;
+    pp = *(current + 1) & 0x3;
+    current += 2;
+  }
+  byte opcode = *current++;
+  const char* mnemonic = NULL;
+  if (opcode_map == 1 && pp == 3) {  // F2 0F.
+    switch (opcode) {
+      case 0x51: mnemonic = "vsqrtsd"; break;
+      case 0x58: mnemonic = "vaddsd"; break;
+      case 0x59: mnemonic = "vmulsd"; break;
+      case 0x5C: mnemonic = "vsubsd"; break;
+      case 0x5E: mnemonic = "vdivsd"; break;
+    }
+  } else if (opcode_map == 2 && pp == 1 && vex_w) {  // 66 0F 38 W1.
+    switch (opcode) {
+      case 0x99: mnemonic = "vfmadd132sd"; break;
+      case 0xA9: mnemonic = "vfmadd213sd"; break;
+      case 0xB9: mnemonic = "vfmadd231sd"; break;
+      case 0x9B: mnemonic = "vfmsub132sd"; break;
+      case 0xAB: mnemonic = "vfmsub213sd"; break;
+      case 0xBB: mnemonic = "vfmsub231sd"; break;
+    }
+  }
+  if (mnemonic == NULL) {
+    UnimplementedInstruction();
+    return static_cast<int>(current - data);
+  }
+  int mod, regop, rm;
+  get_modrm(*current, &mod, &regop, &rm);
+  AppendToBuffer("%s %s,%s,", mnemonic, NameOfXMMRegister(regop),
+                 NameOfXMMRegister(vvvv));
+  current += PrintRightXMMOperand(current);
+  return static_cast<int>(current - data);
+}
+
+
 // Mnemonics for two-byte opcode instructions starting with 0x0F.
 // The argument is the second byte of the two-byte opcode.
 // Returns NULL if the instruction is not handled here.
@@ -1444,6 +1537,11 @@ int DisassemblerX64::InstructionDecode(v8::internal::Vector<char> out_buffer,
   // need to do special processing on it.
   if (!processed) {
     switch (*data) {
+      case 0xC4:  // Three byte VEX prefix.
+      case 0xC5:  // Two byte VEX prefix.
+        data += AVXInstruction(data);
+        break;
+
       case 0xC2:
         AppendToBuffer("ret 0x%x", *reinterpret_cast<uint16_t*>(data + 1));
         data += 3;
@@ -3557,7 +3557,6 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   ParameterCount count(arg_count);
   __ InvokeFunction(rdi, count, CALL_FUNCTION,
                     NullCallWrapper(), CALL_AS_METHOD);
-  __ movq(rsi, Operand(rbp, StandardFrameConstants::kContextOffset));
   __ jmp(&done);
 
   __ bind(&runtime);
@@ -3565,6 +3564,10 @@ void FullCodeGenerator::EmitCallFunction(CallRuntime* expr) {
   __ CallRuntime(Runtime::kCall, args->length());
   __ bind(&done);
 
+  // Record the return site before restoring the context so that a caller
+  // inlined into optimized code resumes here with its own context.
+  PrepareForBailoutForId(expr->ReturnId(), TOS_REG);
+  __ movq(rsi, Operand(rbp, StandardFrameConstants::kContextOffset));
   context()->Plug(rax);
 }
 
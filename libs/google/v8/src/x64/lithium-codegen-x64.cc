@@ -92,6 +92,7 @@ void LCodeGen::FinishCode(Handle<Code> code) {
     RegisterDependentCodeForEmbeddedMaps(code);
   }
   PopulateDeoptimizationData(code);
+  PopulateHandlerTable(code);
   for (int i = 0 ; i < prototype_maps_.length(); i++) {
     prototype_maps_.at(i)->AddDependentCode(
         DependentCode::kPrototypeCheckGroup, code);
@@ -100,11 +101,8 @@ void LCodeGen::FinishCode(Handle<Code> code) {
     transition_maps_.at(i)->AddDependentCode(
         DependentCode::kTransitionGroup, code);
   }
-  if (graph()->depends_on_empty_array_proto_elements()) {
-    isolate()->initial_object_prototype()->map()->AddDependentCode(
-        DependentCode::kElementsCantBeAddedGroup, code);
-    isolate()->initial_array_prototype()->map()->AddDependentCode(
-        DependentCode::kElementsCantBeAddedGroup, code);
+  if (graph()->depends_on_array_protector()) {
+    code->set_depends_on_array_protector(true);
   }
 }
 
@@ -470,6 +468,20 @@ Operand LCodeGen::ToOperand(LOperand* op) const {
 }
 
 
+// The unoptimized frame keeps a stack handler for each enclosing try block
+// and the saved state for each enclosing finally block on its expression
+// stack.  Both take five words.
+static void WriteTryRegion(HTryRegion* region, Translation* translation) {
+  STATIC_ASSERT(StackHandlerConstants::kSlotCount ==
+                Translation::kFinallyStateSize);
+  if (region->kind() == HTryRegion::TRY_BLOCK) {
+    translation->StoreStackHandler(region->entry()->handler_state());
+  } else {
+    translation->StoreFinallyState(region->entry()->finally_return_id());
+  }
+}
+
+
 void LCodeGen::WriteTranslation(LEnvironment* environment,
                                 Translation* translation,
                                 int* pushed_arguments_index,
@@ -481,6 +493,15 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
   // The output frame height does not include the parameters.
   int height = translation_size - environment->parameter_count();
 
+  // Innermost first.
+  ZoneList<HTryRegion*> try_regions(0, zone());
+  for (HTryRegion* region = environment->try_region();
+       region != NULL;
+       region = region->outer()) {
+    try_regions.Add(region, zone());
+  }
+  height += try_regions.length() * StackHandlerConstants::kSlotCount;
+
   // Function parameters are arguments to the outermost environment. The
   // arguments index points to the first element of a sequence of tagged
   // values on the stack that represent the arguments. This needs to be
@@ -540,7 +561,13 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
     }
   }
 
+  int next_region = try_regions.length() - 1;
   for (int i = 0; i < translation_size; ++i) {
+    while (next_region >= 0 &&
+           environment->first_expression_index() +
+               try_regions[next_region]->entry()->handler_height() <= i) {
+      WriteTryRegion(try_regions[next_region--], translation);
+    }
     LOperand* value = environment->values()->at(i);
     // spilled_registers_ and spilled_double_registers_ are either
     // both NULL or both set.
@@ -578,6 +605,9 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
                      arguments_index,
                      arguments_count);
   }
+  while (next_region >= 0) {
+    WriteTryRegion(try_regions[next_region--], translation);
+  }
 }
 
 
@@ -926,11 +956,17 @@ void LCodeGen::RecordPosition(int position) {
 static const char* LabelType(LLabel* label) {
   if (label->is_loop_header()) return " (loop header)";
   if (label->is_osr_entry()) return " (OSR entry)";
+  if (label->is_landing_pad()) return " (landing pad)";
   return "";
 }
 
 
 void LCodeGen::DoLabel(LLabel* label) {
+  // Unwinding jumps to the landing pad even after the code has been
+  // patched for lazy deoptimization, so keep the patches clear of it.
+  if (label->is_landing_pad()) {
+    EnsureSpaceForLazyDeopt(Deoptimizer::patch_size());
+  }
   Comment(";;; <@%d,#%d> -------------------- B%d%s --------------------",
           current_instruction_,
           label->hydrogen_value()->id(),
@@ -938,10 +974,42 @@ void LCodeGen::DoLabel(LLabel* label) {
           LabelType(label));
   __ bind(label->label());
   current_block_ = label->block_id();
+  if (label->is_landing_pad()) EmitLandingPad(label);
   DoGap(label);
 }
 
 
+void LCodeGen::EmitLandingPad(LLabel* label) {
+  HEnterTry* entry =
+      HEnterTry::cast(label->block()->predecessors()->at(0)->end());
+  handler_table_.Add(HandlerTableEntry(entry->handler_index(),
+                                       masm()->pc_offset()),
+                     zone());
+  // Unwinding restored rbp and rsi and left the exception in rax.  Drop
+  // whatever was pushed in the try block and save the exception before the
+  // gap moves run.
+  __ lea(rsp, Operand(rbp, JavaScriptFrameConstants::kFunctionOffset -
+                               GetStackSlotCount() * kPointerSize));
+  __ movq(Operand(rbp, StackSlotOffset(label->exception_slot())), rax);
+}
+
+
+void LCodeGen::PopulateHandlerTable(Handle<Code> code) {
+  if (handler_table_.is_empty()) return;
+  int length = 0;
+  for (int i = 0; i < handler_table_.length(); i++) {
+    length = Max(length, handler_table_[i].handler_index + 1);
+  }
+  Handle<FixedArray> handler_table =
+      factory()->NewFixedArray(length, TENURED);
+  for (int i = 0; i < handler_table_.length(); i++) {
+    handler_table->set(handler_table_[i].handler_index,
+                       Smi::FromInt(handler_table_[i].pc_offset));
+  }
+  code->set_handler_table(*handler_table);
+}
+
+
 void LCodeGen::DoParallelMove(LParallelMove* move) {
   resolver_.Resolve(move);
 }
@@ -1612,6 +1680,116 @@ void LCodeGen::DoValueOf(LValueOf* instr) {
 }
 
 
+void LCodeGen::DoVectorLoop(LVectorLoop* instr) {
+  HVectorLoop* hinstr = instr->hydrogen();
+  ElementsKind kind = hinstr->elements_kind();
+  Register limit = ToRegister(instr->limit());
+  Register store_pointer = ToRegister(instr->store_pointer());
+  Register result = ToRegister(instr->result());
+  ASSERT(result.is(rax));
+  // Float32 elements are widened into the two double lanes of a register,
+  // double elements fill both of them and int32 elements all four lanes.
+  bool int32_lanes = kind == EXTERNAL_INT_ELEMENTS;
+  int lanes = int32_lanes ? 4 : 2;
+  int shift_size = ElementsKindToShiftSize(kind);
+  ScaleFactor scale = static_cast<ScaleFactor>(shift_size);
+  int vector_size = lanes << shift_size;
+  Label loop, done;
+
+  __ movsxlq(result, ToRegister(instr->index()));
+  __ testq(result, result);
+  __ j(negative, &done);
+
+  // An array starting less than a vector below the stored one would be read
+  // after the scalar loop had already overwritten some of its elements.
+  for (int i = 0; i < HVectorLoop::kMaxLoads; ++i) {
+    __ movq(kScratchRegister, store_pointer);
+    __ subq(kScratchRegister, ToRegister(instr->load_pointer(i)));
+    __ decq(kScratchRegister);
+    __ cmpq(kScratchRegister, Immediate(vector_size - 1));
+    __ j(below, &done);
+  }
+
+  XMMRegister scalars[] = { xmm11, xmm12 };
+  for (int i = 0; i < HVectorLoop::kMaxScalars; ++i) {
+    if (int32_lanes) {
+      __ movd(scalars[i], ToRegister(instr->scalar(i)));
+      __ pshufd(scalars[i], scalars[i], 0);
+    } else {
+      __ movaps(scalars[i], ToDoubleRegister(instr->scalar(i)));
+      __ unpcklpd(scalars[i], scalars[i]);
+    }
+  }
+
+  // Run while a whole vector fits below the limit.
+  __ movsxlq(limit, limit);
+  __ subq(limit, Immediate(lanes));
+  __ bind(&loop);
+  __ cmpq(result, limit);
+  __ j(greater, &done);
+  XMMRegister stack[] = {
+    xmm3, xmm4, xmm5, xmm6, xmm7, xmm8, xmm9, xmm10
+  };
+  STATIC_ASSERT(ARRAY_SIZE(stack) == HVectorLoop::kMaxStackDepth);
+  int depth = 0;
+  for (int i = 0; i < hinstr->program_length(); ++i) {
+    HVectorLoop::Op op = hinstr->program_at(i);
+    switch (op) {
+      case HVectorLoop::kLoad0:
+      case HVectorLoop::kLoad1:
+      case HVectorLoop::kLoad2: {
+        XMMRegister dst = stack[depth++];
+        Operand src(ToRegister(instr->load_pointer(op - HVectorLoop::kLoad0)),
+                    result, scale, 0);
+        if (kind == EXTERNAL_FLOAT_ELEMENTS) {
+          __ movsd(dst, src);
+          __ cvtps2pd(dst, dst);
+        } else {
+          __ movdqu(dst, src);
+        }
+        break;
+      }
+      case HVectorLoop::kScalar0:
+      case HVectorLoop::kScalar1:
+        __ movaps(stack[depth++], scalars[op - HVectorLoop::kScalar0]);
+        break;
+      default: {
+        XMMRegister right = stack[--depth];
+        XMMRegister left = stack[depth - 1];
+        if (int32_lanes) {
+          ASSERT(op == HVectorLoop::kAdd || op == HVectorLoop::kSub);
+          if (op == HVectorLoop::kAdd) {
+            __ paddd(left, right);
+          } else {
+            __ psubd(left, right);
+          }
+          break;
+        }
+        switch (op) {
+          case HVectorLoop::kAdd: __ addpd(left, right); break;
+          case HVectorLoop::kSub: __ subpd(left, right); break;
+          case HVectorLoop::kMul: __ mulpd(left, right); break;
+          case HVectorLoop::kDiv: __ divpd(left, right); break;
+          default: UNREACHABLE();
+        }
+        break;
+      }
+    }
+  }
+  ASSERT(depth == 1);
+  Operand dst(store_pointer, result, scale, 0);
+  if (kind == EXTERNAL_FLOAT_ELEMENTS) {
+    __ cvtpd2ps(stack[0], stack[0]);
+    __ movsd(dst, stack[0]);
+  } else {
+    __ movdqu(dst, stack[0]);
+  }
+  __ addq(result, Immediate(lanes));
+  __ jmp(&loop);
+  __ bind(&done);
+}
+
+
 void LCodeGen::DoDateField(LDateField* instr) {
   Register object = ToRegister(instr->date());
   Register result = ToRegister(instr->result());
@@ -1775,7 +1953,28 @@ void LCodeGen::DoArithmeticD(LArithmeticD* instr) {
   XMMRegister left = ToDoubleRegister(instr->left());
   XMMRegister right = ToDoubleRegister(instr->right());
   XMMRegister result = ToDoubleRegister(instr->result());
-  // All operations except MOD are computed in-place.
+  if (instr->op() != Token::MOD && CpuFeatures::IsSupported(AVX)) {
+    CpuFeatureScope scope(masm(), AVX);
+    switch (instr->op()) {
+      case Token::ADD:
+        __ vaddsd(result, left, right);
+        break;
+      case Token::SUB:
+        __ vsubsd(result, left, right);
+        break;
+      case Token::MUL:
+        __ vmulsd(result, left, right);
+        break;
+      case Token::DIV:
+        __ vdivsd(result, left, right);
+        break;
+      default:
+        UNREACHABLE();
+        break;
+    }
+    return;
+  }
+  // Without AVX all operations except MOD are computed in-place.
   ASSERT(instr->op() == Token::MOD || left.is(result));
   switch (instr->op()) {
     case Token::ADD:
@@ -1970,6 +2169,94 @@ void LCodeGen::DoGoto(LGoto* instr) {
 }
 
 
+void LCodeGen::DoSwitchTable(LSwitchTable* instr) {
+  // The table is a sequence of fixed-size jmp instructions, one per value
+  // in [min_value, min_value + size). Dispatch computes the address of the
+  // entry relative to the start of the code object.
+  static const int kEntrySize = 8;
+  HSwitchTable* hswitch = instr->hydrogen();
+  Register value = ToRegister(instr->value());
+  Register index = ToRegister(instr->temp());
+  Label* default_label = chunk_->GetAssemblyLabel(
+      chunk_->LookupDestination(hswitch->SuccessorAt(0)->block_id()));
+
+  Label table, dispatch;
+  __ movl(index, value);
+  if (hswitch->min_value() != 0) {
+    __ subl(index, Immediate(hswitch->min_value()));
+  }
+  __ cmpl(index, Immediate(hswitch->size()));
+  __ j(below, &dispatch);
+  __ jmp(default_label);
+
+  __ bind(&table);
+  for (int i = 0; i < hswitch->size(); i++) {
+    int entry_start = masm()->pc_offset();
+    HBasicBlock* target = hswitch->SuccessorAt(hswitch->EntryAt(i));
+    __ jmp(chunk_->GetAssemblyLabel(
+        chunk_->LookupDestination(target->block_id())));
+    int padding = kEntrySize - (masm()->pc_offset() - entry_start);
+    ASSERT(padding >= 0);
+    if (padding > 0) __ Nop(padding);
+  }
+
+  __ bind(&dispatch);
+  __ Move(kScratchRegister, masm()->CodeObject());
+  __ lea(kScratchRegister,
+         Operand(kScratchRegister, index, times_8,
+                 table.pos() + Code::kHeaderSize - kHeapObjectTag));
+  __ jmp(kScratchRegister);
+}
+
+
+void LCodeGen::DoEnterTry(LEnterTry* instr) {
+  // Build the stack handler in its spill slots the way PushTryHandler
+  // builds it on the stack, and link it into the handler chain.
+  STATIC_ASSERT(StackHandlerConstants::kSize == 5 * kPointerSize);
+  int offset = StackSlotOffset(instr->handler_slot());
+  __ movq(Operand(rbp, offset + StackHandlerConstants::kFPOffset), rbp);
+  __ movq(rax, Operand(rbp, StandardFrameConstants::kContextOffset));
+  __ movq(Operand(rbp, offset + StackHandlerConstants::kContextOffset), rax);
+  __ movq(Operand(rbp, offset + StackHandlerConstants::kStateOffset),
+          Immediate(instr->hydrogen()->handler_state()));
+  __ Move(rax, masm()->CodeObject());
+  __ movq(Operand(rbp, offset + StackHandlerConstants::kCodeOffset), rax);
+  ExternalReference handler_address(Isolate::kHandlerAddress, isolate());
+  Operand handler_operand = masm()->ExternalOperand(handler_address);
+  __ movq(rax, handler_operand);
+  __ movq(Operand(rbp, offset + StackHandlerConstants::kNextOffset), rax);
+  __ lea(rax, Operand(rbp, offset));
+  __ movq(handler_operand, rax);
+  EmitGoto(instr->hydrogen()->try_entry()->block_id());
+}
+
+
+void LCodeGen::DoLeaveTry(LLeaveTry* instr) {
+  Register scratch = ToRegister(instr->temp());
+  ExternalReference handler_address(Isolate::kHandlerAddress, isolate());
+  Operand handler_operand = masm()->ExternalOperand(handler_address);
+  __ movq(scratch, handler_operand);
+  __ movq(scratch, Operand(scratch, StackHandlerConstants::kNextOffset));
+  __ movq(handler_operand, scratch);
+}
+
+
+void LCodeGen::DoCatchEntry(LCatchEntry* instr) {
+  // Nothing to do, the landing pad has stored the exception.
+}
+
+
+void LCodeGen::DoStoreTrySlot(LStoreTrySlot* instr) {
+  Register value = ToRegister(instr->value());
+  __ movq(Operand(rbp, StackSlotOffset(instr->spill_index())), value);
+}
+
+
+void LCodeGen::DoLoadTrySlot(LLoadTrySlot* instr) {
+  // Nothing to do, the value is in its try slot.
+}
+
+
 inline Condition LCodeGen::TokenToCondition(Token::Value op, bool is_unsigned) {
   Condition cond = no_condition;
   switch (op) {
@@ -2173,6 +2460,25 @@ void LCodeGen::DoIsStringAndBranch(LIsStringAndBranch* instr) {
 }
 
 
+void LCodeGen::DoIsInternalizedStringAndBranch(
+    LIsInternalizedStringAndBranch* instr) {
+  Register reg = ToRegister(instr->value());
+  Register temp = ToRegister(instr->temp());
+
+  int true_block = chunk_->LookupDestination(instr->true_block_id());
+  int false_block = chunk_->LookupDestination(instr->false_block_id());
+  Label* false_label = chunk_->GetAssemblyLabel(false_block);
+
+  __ JumpIfSmi(reg, false_label);
+  __ movq(temp, FieldOperand(reg, HeapObject::kMapOffset));
+  __ movzxbl(temp, FieldOperand(temp, Map::kInstanceTypeOffset));
+  __ andl(temp, Immediate(kIsNotStringMask | kIsInternalizedMask));
+  __ cmpl(temp, Immediate(kStringTag | kInternalizedTag));
+
+  EmitBranch(true_block, false_block, equal);
+}
+
+
 void LCodeGen::DoIsSmiAndBranch(LIsSmiAndBranch* instr) {
   int true_block = chunk_->LookupDestination(instr->true_block_id());
   int false_block = chunk_->LookupDestination(instr->false_block_id());
@@ -3045,6 +3351,12 @@ void LCodeGen::DoLoadKeyedFixedArray(LLoadKeyed* instr) {
       __ CompareRoot(result, Heap::kTheHoleValueRootIndex);
       DeoptimizeIf(equal, instr->environment());
     }
+  } else if (instr->hydrogen()->hole_mode() == CONVERT_HOLE_TO_UNDEFINED) {
+    Label is_not_hole;
+    __ CompareRoot(result, Heap::kTheHoleValueRootIndex);
+    __ j(not_equal, &is_not_hole, Label::kNear);
+    __ LoadRoot(result, Heap::kUndefinedValueRootIndex);
+    __ bind(&is_not_hole);
   }
 }
 
@@ -3579,7 +3891,13 @@ void LCodeGen::DoMathRound(LMathRound* instr) {
 
 void LCodeGen::DoMathSqrt(LMathSqrt* instr) {
   XMMRegister input_reg = ToDoubleRegister(instr->value());
-  ASSERT(ToDoubleRegister(instr->result()).is(input_reg));
+  XMMRegister result_reg = ToDoubleRegister(instr->result());
+  if (CpuFeatures::IsSupported(AVX)) {
+    CpuFeatureScope scope(masm(), AVX);
+    __ vsqrtsd(result_reg, input_reg, input_reg);
+    return;
+  }
+  ASSERT(result_reg.is(input_reg));
   __ sqrtsd(input_reg, input_reg);
 }
 
@@ -5016,94 +5334,6 @@ void LCodeGen::DoCheckPrototypeMaps(LCheckPrototypeMaps* instr) {
 }
 
 
-void LCodeGen::DoAllocateObject(LAllocateObject* instr) {
-  class DeferredAllocateObject: public LDeferredCode {
-   public:
-    DeferredAllocateObject(LCodeGen* codegen, LAllocateObject* instr)
-        : LDeferredCode(codegen), instr_(instr) { }
-    virtual void Generate() { codegen()->DoDeferredAllocateObject(instr_); }
-    virtual LInstruction* instr() { return instr_; }
-   private:
-    LAllocateObject* instr_;
-  };
-
-  DeferredAllocateObject* deferred =
-      new(zone()) DeferredAllocateObject(this, instr);
-
-  Register result = ToRegister(instr->result());
-  Register scratch = ToRegister(instr->temp());
-  Handle<JSFunction> constructor = instr->hydrogen()->constructor();
-  Handle<Map> initial_map = instr->hydrogen()->constructor_initial_map();
-  int instance_size = initial_map->instance_size();
-  ASSERT(initial_map->pre_allocated_property_fields() +
-         initial_map->unused_property_fields() -
-         initial_map->inobject_properties() == 0);
-
-  __ Allocate(instance_size, result, no_reg, scratch, deferred->entry(),
-              TAG_OBJECT);
-
-  __ bind(deferred->exit());
-  if (FLAG_debug_code) {
-    Label is_in_new_space;
-    __ JumpIfInNewSpace(result, scratch, &is_in_new_space);
-    __ Abort("Allocated object is not in new-space");
-    __ bind(&is_in_new_space);
-  }
-
-  // Load the initial map.
-  Register map = scratch;
-  __ LoadHeapObject(scratch, constructor);
-  __ movq(map, FieldOperand(scratch, JSFunction::kPrototypeOrInitialMapOffset));
-
-  if (FLAG_debug_code) {
-    __ AssertNotSmi(map);
-    __ cmpb(FieldOperand(map, Map::kInstanceSizeOffset),
-            Immediate(instance_size >> kPointerSizeLog2));
-    __ Assert(equal, "Unexpected instance size");
-    __ cmpb(FieldOperand(map, Map::kPreAllocatedPropertyFieldsOffset),
-            Immediate(initial_map->pre_allocated_property_fields()));
-    __ Assert(equal, "Unexpected pre-allocated property fields count");
-    __ cmpb(FieldOperand(map, Map::kUnusedPropertyFieldsOffset),
-            Immediate(initial_map->unused_property_fields()));
-    __ Assert(equal, "Unexpected unused property fields count");
-    __ cmpb(FieldOperand(map, Map::kInObjectPropertiesOffset),
-            Immediate(initial_map->inobject_properties()));
-    __ Assert(equal, "Unexpected in-object property fields count");
-  }
-
-  // Initialize map and fields of the newly allocated object.
-  ASSERT(initial_map->instance_type() == JS_OBJECT_TYPE);
-  __ movq(FieldOperand(result, JSObject::kMapOffset), map);
-  __ LoadRoot(scratch, Heap::kEmptyFixedArrayRootIndex);
-  __ movq(FieldOperand(result, JSObject::kElementsOffset), scratch);
-  __ movq(FieldOperand(result, JSObject::kPropertiesOffset), scratch);
-  if (initial_map->inobject_properties() != 0) {
-    __ LoadRoot(scratch, Heap::kUndefinedValueRootIndex);
-    for (int i = 0; i < initial_map->inobject_properties(); i++) {
-      int property_offset = JSObject::kHeaderSize + i * kPointerSize;
-      __ movq(FieldOperand(result, property_offset), scratch);
-    }
-  }
-}
-
-
-void LCodeGen::DoDeferredAllocateObject(LAllocateObject* instr) {
-  Register result = ToRegister(instr->result());
-  Handle<Map> initial_map = instr->hydrogen()->constructor_initial_map();
-  int instance_size = initial_map->instance_size();
-
-  // TODO(3095996): Get rid of this. For now, we need to make the
-  // result register contain a valid pointer because it is already
-  // contained in the register pointer map.
-  __ Set(result, 0);
-
-  PushSafepointRegistersScope scope(this);
-  __ Push(Smi::FromInt(instance_size));
-  CallRuntimeFromDeferred(Runtime::kAllocateInNewSpace, 1, instr);
-  __ StoreToSafepointRegisterSlot(result, rax);
-}
-
-
 void LCodeGen::DoAllocate(LAllocate* instr) {
   class DeferredAllocate: public LDeferredCode {
    public:
@@ -5138,6 +5368,22 @@ void LCodeGen::DoAllocate(LAllocate* instr) {
   }
 
   __ bind(deferred->exit());
+
+  if (instr->hydrogen()->MustPrefillWithFiller()) {
+    // Fill the space of the allocations folded into this one with
+    // one-pointer fillers until their objects are initialized.
+    int32_t size = ToInteger32(LConstantOperand::cast(instr->size()));
+    int32_t offset = instr->hydrogen()->folded_offset();
+    Label loop;
+    __ movl(temp, Immediate((size - offset) / kPointerSize));
+    __ LoadRoot(kScratchRegister, Heap::kOnePointerFillerMapRootIndex);
+    __ bind(&loop);
+    __ movq(FieldOperand(result, temp, times_pointer_size,
+                         offset - kPointerSize),
+            kScratchRegister);
+    __ decl(temp);
+    __ j(not_zero, &loop);
+  }
 }
 
 
@@ -5414,6 +5660,20 @@ void LCodeGen::DoLazyBailout(LLazyBailout* instr) {
 
 
 void LCodeGen::DoDeoptimize(LDeoptimize* instr) {
+  if (instr->hydrogen_value()->block()->IsLandingPad()) {
+    // Catching an exception is no reason to throw away the code, so the
+    // landing pad leaves through the lazy deoptimization entry.
+    LEnvironment* env = instr->environment();
+    RegisterEnvironmentForDeoptimization(env, Safepoint::kNoLazyDeopt);
+    Address entry = Deoptimizer::GetDeoptimizationEntry(
+        isolate(), env->deoptimization_index(), Deoptimizer::LAZY);
+    if (entry == NULL) {
+      Abort("bailout was not prepared");
+      return;
+    }
+    __ call(entry, RelocInfo::RUNTIME_ENTRY);
+    return;
+  }
   DeoptimizeIf(no_condition, instr->environment());
 }
 
@@ -128,6 +128,29 @@ void LInstruction::PrintOutputOperandTo(StringStream* stream) {
 }
 
 
+void LStoreTrySlot::PrintDataTo(StringStream* stream) {
+  stream->Add("[stack:%d] <- ", spill_index());
+  value()->PrintTo(stream);
+}
+
+
+void LSwitchTable::PrintDataTo(StringStream* stream) {
+  value()->PrintTo(stream);
+  stream->Add(" [%d..%d] else B%d",
+              hydrogen()->min_value(),
+              hydrogen()->min_value() + hydrogen()->size() - 1,
+              hydrogen()->SuccessorAt(0)->block_id());
+}
+
+
+void LEnterTry::PrintDataTo(StringStream* stream) {
+  stream->Add("B%d, handler in [slot %d], landing pad B%d",
+              hydrogen()->try_entry()->block_id(),
+              handler_slot(),
+              hydrogen()->landing_pad()->block_id());
+}
+
+
 void LLabel::PrintDataTo(StringStream* stream) {
   LGap::PrintDataTo(stream);
   LLabel* rep = replacement();
@@ -242,6 +265,13 @@ void LIsStringAndBranch::PrintDataTo(StringStream* stream) {
 }
 
 
+void LIsInternalizedStringAndBranch::PrintDataTo(StringStream* stream) {
+  stream->Add("if is_internalized_string(");
+  value()->PrintTo(stream);
+  stream->Add(") then B%d else B%d", true_block_id(), false_block_id());
+}
+
+
 void LIsSmiAndBranch::PrintDataTo(StringStream* stream) {
   stream->Add("if is_smi(");
   value()->PrintTo(stream);
@@ -461,6 +491,18 @@ LPlatformChunk* LChunkBuilder::Build() {
   chunk_ = new(zone()) LPlatformChunk(info(), graph());
   HPhase phase("L_Building chunk", chunk_);
   status_ = BUILDING;
+
+  // Reserve the try slots before the spill slots of the stack handlers.
+  int try_slot_count = graph()->try_slot_count();
+  for (int i = 0; i < try_slot_count; i++) {
+    int spill_index = chunk()->GetNextSpillIndex(false);
+    if (i == 0) first_try_slot_ = spill_index;
+    if (spill_index > LUnallocated::kMaxFixedSlotIndex) {
+      Abort("Too many spill slots needed for try statement");
+      return NULL;
+    }
+  }
+
   const ZoneList<HBasicBlock*>* blocks = graph()->blocks();
   for (int i = 0; i < blocks->length(); i++) {
     HBasicBlock* next = NULL;
@@ -674,7 +716,20 @@ LInstruction* LChunkBuilder::MarkAsCall(LInstruction* instr,
 
 LInstruction* LChunkBuilder::AssignPointerMap(LInstruction* instr) {
   ASSERT(!instr->HasPointerMap());
-  instr->set_pointer_map(new(zone()) LPointerMap(position_, zone()));
+  LPointerMap* pointer_map = new(zone()) LPointerMap(position_, zone());
+  // The try slots of the enclosing try blocks hold tagged values from the
+  // entry of the try block on.
+  for (HTryRegion* region = current_block_->try_region();
+       region != NULL;
+       region = region->outer()) {
+    if (region->kind() != HTryRegion::TRY_BLOCK) continue;
+    const ZoneList<int>* slots = region->assigned_slots();
+    for (int i = 0; i < slots->length(); i++) {
+      pointer_map->RecordPointer(
+          LStackSlot::Create(first_try_slot_ + slots->at(i), zone()), zone());
+    }
+  }
+  instr->set_pointer_map(pointer_map);
   return instr;
 }
 
@@ -785,6 +840,9 @@ LInstruction* LChunkBuilder::DoArithmeticD(Token::Value op,
   LOperand* left = UseRegisterAtStart(instr->BetterLeftOperand());
   LOperand* right = UseRegisterAtStart(instr->BetterRightOperand());
   LArithmeticD* result = new(zone()) LArithmeticD(op, left, right);
+  // The AVX forms leave the left operand intact, which saves the register
+  // allocator a move whenever that operand is still live.
+  if (CpuFeatures::IsSupported(AVX)) return DefineAsRegister(result);
   return DefineSameAsFirst(result);
 }
 
@@ -826,9 +884,11 @@ void LChunkBuilder::DoBasicBlock(HBasicBlock* block, HBasicBlock* next_block) {
     if (pred->end()->SecondSuccessor() == NULL) {
       ASSERT(pred->end()->FirstSuccessor() == block);
     } else {
-      if (pred->end()->FirstSuccessor()->block_id() > block->block_id() ||
-          pred->end()->SecondSuccessor()->block_id() > block->block_id()) {
-        last_environment = last_environment->Copy();
+      for (HSuccessorIterator it(pred->end()); !it.Done(); it.Advance()) {
+        if (it.Current()->block_id() > block->block_id()) {
+          last_environment = last_environment->Copy();
+          break;
+        }
       }
     }
     block->UpdateEnvironment(last_environment);
@@ -967,6 +1027,14 @@ LEnvironment* LChunkBuilder::CreateEnvironment(
     *argument_index_accumulator = argument_index;
   }
 
+  if (hydrogen_env->outer() == NULL) {
+    // Contexts are not part of the translation, so the expression stack
+    // starts right after the locals.
+    result->set_try_region(hydrogen_env->try_region(),
+                           hydrogen_env->parameter_count() +
+                               hydrogen_env->local_count());
+  }
+
   return result;
 }
 
@@ -1215,6 +1283,7 @@ LInstruction* LChunkBuilder::DoMathExp(HUnaryMathOperation* instr) {
 LInstruction* LChunkBuilder::DoMathSqrt(HUnaryMathOperation* instr) {
   LOperand* input = UseRegisterAtStart(instr->value());
   LMathSqrt* result = new(zone()) LMathSqrt(input);
+  if (CpuFeatures::IsSupported(AVX)) return DefineAsRegister(result);
   return DefineSameAsFirst(result);
 }
 
@@ -1662,6 +1731,15 @@ LInstruction* LChunkBuilder::DoIsStringAndBranch(HIsStringAndBranch* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoIsInternalizedStringAndBranch(
+    HIsInternalizedStringAndBranch* instr) {
+  ASSERT(instr->value()->representation().IsTagged());
+  LOperand* value = UseRegisterAtStart(instr->value());
+  LOperand* temp = TempRegister();
+  return new(zone()) LIsInternalizedStringAndBranch(value, temp);
+}
+
+
 LInstruction* LChunkBuilder::DoIsSmiAndBranch(HIsSmiAndBranch* instr) {
   ASSERT(instr->value()->representation().IsTagged());
   return new(zone()) LIsSmiAndBranch(Use(instr->value()));
@@ -1751,6 +1829,32 @@ LInstruction* LChunkBuilder::DoValueOf(HValueOf* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoVectorLoop(HVectorLoop* instr) {
+  // The kernel uses most of the general purpose and xmm registers, so it is
+  // treated as a call and takes its operands in fixed registers.
+  Register load_registers[] = { rcx, r8, r9 };
+  Register scalar_registers[] = { r11, r14 };
+  XMMRegister double_scalar_registers[] = { xmm1, xmm2 };
+  bool double_lanes = instr->scalar_representation().IsDouble();
+  LOperand* index = UseFixed(instr->index(), rbx);
+  LOperand* limit = UseFixed(instr->limit(), rdx);
+  LOperand* store_pointer = UseFixed(instr->store_pointer(), rdi);
+  LOperand* load_pointers[HVectorLoop::kMaxLoads];
+  for (int i = 0; i < HVectorLoop::kMaxLoads; ++i) {
+    load_pointers[i] = UseFixed(instr->load_pointer(i), load_registers[i]);
+  }
+  LOperand* scalars[HVectorLoop::kMaxScalars];
+  for (int i = 0; i < HVectorLoop::kMaxScalars; ++i) {
+    scalars[i] = double_lanes
+        ? UseFixedDouble(instr->scalar(i), double_scalar_registers[i])
+        : UseFixed(instr->scalar(i), scalar_registers[i]);
+  }
+  LVectorLoop* result = new(zone()) LVectorLoop(
+      index, limit, store_pointer, load_pointers, scalars);
+  return MarkAsCall(DefineFixed(result, rax), instr);
+}
+
+
 LInstruction* LChunkBuilder::DoDateField(HDateField* instr) {
   LOperand* object = UseFixed(instr->value(), rax);
   LDateField* result = new(zone()) LDateField(object, instr->index());
@@ -2320,13 +2424,6 @@ LInstruction* LChunkBuilder::DoStringLength(HStringLength* instr) {
 }
 
 
-LInstruction* LChunkBuilder::DoAllocateObject(HAllocateObject* instr) {
-  info()->MarkAsDeferredCalling();
-  LAllocateObject* result = new(zone()) LAllocateObject(TempRegister());
-  return AssignPointerMap(DefineAsRegister(result));
-}
-
-
 LInstruction* LChunkBuilder::DoAllocate(HAllocate* instr) {
   info()->MarkAsDeferredCalling();
   LOperand* size = instr->size()->IsConstant()
@@ -2390,6 +2487,67 @@ LInstruction* LChunkBuilder::DoUnknownOSRValue(HUnknownOSRValue* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoEnterTry(HEnterTry* instr) {
+  // The stack handler takes five consecutive spill slots.  The slot with
+  // the highest index is at the lowest address and holds the next field.
+  int spill_index = 0;
+  for (int i = 0; i < StackHandlerConstants::kSlotCount; i++) {
+    spill_index = chunk()->GetNextSpillIndex(false);
+  }
+  if (spill_index > LUnallocated::kMaxFixedSlotIndex) {
+    Abort("Too many spill slots needed for try statement");
+    spill_index = 0;
+  }
+  // Marking the instruction as a call spills every value that is live
+  // into the try block, so the landing pad finds them in their spill
+  // slots whatever the try block clobbered.
+  LInstruction* result = new(zone()) LEnterTry(spill_index);
+  result->MarkAsCall();
+  return result;
+}
+
+
+LInstruction* LChunkBuilder::DoSwitchTable(HSwitchTable* instr) {
+  ASSERT(instr->value()->representation().IsInteger32());
+  LOperand* value = UseRegisterAtStart(instr->value());
+  LOperand* temp = TempRegister();
+  return new(zone()) LSwitchTable(value, temp);
+}
+
+
+LInstruction* LChunkBuilder::DoLeaveTry(HLeaveTry* instr) {
+  return new(zone()) LLeaveTry(TempRegister());
+}
+
+
+LInstruction* LChunkBuilder::DoCatchEntry(HCatchEntry* instr) {
+  int spill_index = chunk()->GetNextSpillIndex(false);  // Not double-width.
+  if (spill_index > LUnallocated::kMaxFixedSlotIndex) {
+    Abort("Too many spill slots needed for try statement");
+    spill_index = 0;
+  }
+  // The catch entry directly follows the label of the landing pad and its
+  // gap.  The label saves the exception before any gap moves can clobber it.
+  const ZoneList<LInstruction*>* instructions = chunk()->instructions();
+  LLabel* label = LLabel::cast(instructions->at(instructions->length() - 2));
+  ASSERT(label->block() == current_block_);
+  label->set_exception_slot(spill_index);
+  return DefineAsSpilled(new(zone()) LCatchEntry, spill_index);
+}
+
+
+LInstruction* LChunkBuilder::DoStoreTrySlot(HStoreTrySlot* instr) {
+  LOperand* value = UseRegisterAtStart(instr->value());
+  return new(zone()) LStoreTrySlot(value, first_try_slot_ + instr->slot());
+}
+
+
+LInstruction* LChunkBuilder::DoLoadTrySlot(HLoadTrySlot* instr) {
+  return DefineAsSpilled(new(zone()) LLoadTrySlot,
+                         first_try_slot_ + instr->slot());
+}
+
+
 LInstruction* LChunkBuilder::DoCallStub(HCallStub* instr) {
   argument_count_ -= instr->argument_count();
   return MarkAsCall(DefineFixed(new(zone()) LCallStub, rax), instr);
@@ -2450,6 +2608,7 @@ LInstruction* LChunkBuilder::DoSimulate(HSimulate* instr) {
   ASSERT(env != NULL);
 
   env->set_ast_id(instr->ast_id());
+  env->set_try_region(instr->try_region());
 
   env->Drop(instr->pop_count());
   for (int i = instr->values()->length() - 1; i >= 0; --i) {
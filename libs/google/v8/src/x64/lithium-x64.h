@@ -50,7 +50,6 @@ class LCodeGen;
   V(AccessArgumentsAt)                          \
   V(AddI)                                       \
   V(Allocate)                                   \
-  V(AllocateObject)                             \
   V(ApplyArguments)                             \
   V(ArgumentsElements)                          \
   V(ArgumentsLength)                            \
@@ -70,6 +69,7 @@ class LCodeGen;
   V(CallNewArray)                               \
   V(CallRuntime)                                \
   V(CallStub)                                   \
+  V(CatchEntry)                                 \
   V(CheckFunction)                              \
   V(CheckInstanceType)                          \
   V(CheckMaps)                                  \
@@ -96,6 +96,7 @@ class LCodeGen;
   V(DoubleToI)                                  \
   V(DummyUse)                                   \
   V(ElementsKind)                               \
+  V(EnterTry)                                   \
   V(FixedArrayBaseLength)                       \
   V(MapEnumLength)                              \
   V(FunctionLiteral)                            \
@@ -114,6 +115,7 @@ class LCodeGen;
   V(Uint32ToDouble)                             \
   V(InvokeFunction)                             \
   V(IsConstructCallAndBranch)                   \
+  V(IsInternalizedStringAndBranch)              \
   V(IsNilAndBranch)                             \
   V(IsObjectAndBranch)                          \
   V(IsStringAndBranch)                          \
@@ -121,6 +123,7 @@ class LCodeGen;
   V(IsUndetectableAndBranch)                    \
   V(Label)                                      \
   V(LazyBailout)                                \
+  V(LeaveTry)                                   \
   V(LoadContextSlot)                            \
   V(LoadExternalArrayPointer)                   \
   V(LoadFunctionPrototype)                      \
@@ -131,6 +134,7 @@ class LCodeGen;
   V(LoadNamedField)                             \
   V(LoadNamedFieldPolymorphic)                  \
   V(LoadNamedGeneric)                           \
+  V(LoadTrySlot)                                \
   V(MathAbs)                                    \
   V(MathCos)                                    \
   V(MathExp)                                    \
@@ -169,12 +173,14 @@ class LCodeGen;
   V(StoreKeyedGeneric)                          \
   V(StoreNamedField)                            \
   V(StoreNamedGeneric)                          \
+  V(StoreTrySlot)                               \
   V(StringAdd)                                  \
   V(StringCharCodeAt)                           \
   V(StringCharFromCode)                         \
   V(StringCompareAndBranch)                     \
   V(StringLength)                               \
   V(SubI)                                       \
+  V(SwitchTable)                                \
   V(TaggedToI)                                  \
   V(ThisFunction)                               \
   V(Throw)                                      \
@@ -185,6 +191,7 @@ class LCodeGen;
   V(TypeofIsAndBranch)                          \
   V(UnknownOSRValue)                            \
   V(ValueOf)                                    \
+  V(VectorLoop)                                 \
   V(ForInPrepareMap)                            \
   V(ForInCacheArray)                            \
   V(CheckMapValue)                              \
@@ -438,7 +445,7 @@ class LDeoptimize: public LTemplateInstruction<0, 0, 0> {
 class LLabel: public LGap {
  public:
   explicit LLabel(HBasicBlock* block)
-      : LGap(block), replacement_(NULL) { }
+      : LGap(block), replacement_(NULL), exception_slot_(-1) { }
 
   virtual bool HasInterestingComment(LCodeGen* gen) const { return false; }
   DECLARE_CONCRETE_INSTRUCTION(Label, "label")
@@ -448,14 +455,19 @@ class LLabel: public LGap {
   int block_id() const { return block()->block_id(); }
   bool is_loop_header() const { return block()->IsLoopHeader(); }
   bool is_osr_entry() const { return block()->is_osr_entry(); }
+  bool is_landing_pad() const { return block()->IsLandingPad(); }
   Label* label() { return &label_; }
   LLabel* replacement() const { return replacement_; }
   void set_replacement(LLabel* label) { replacement_ = label; }
   bool HasReplacement() const { return replacement_ != NULL; }
+  // The spill slot that receives the exception at a landing pad.
+  int exception_slot() const { return exception_slot_; }
+  void set_exception_slot(int index) { exception_slot_ = index; }
 
  private:
   Label label_;
   LLabel* replacement_;
+  int exception_slot_;
 };
 
 
@@ -501,6 +513,85 @@ class LControlInstruction: public LTemplateInstruction<0, I, T> {
 };
 
 
+class LEnterTry: public LControlInstruction<0, 0> {
+ public:
+  explicit LEnterTry(int handler_slot) : handler_slot_(handler_slot) { }
+
+  DECLARE_CONCRETE_INSTRUCTION(EnterTry, "enter-try")
+  DECLARE_HYDROGEN_ACCESSOR(EnterTry)
+
+  virtual void PrintDataTo(StringStream* stream);
+
+  // The spill slot of the lowest word of the stack handler.
+  int handler_slot() const { return handler_slot_; }
+
+ private:
+  int handler_slot_;
+};
+
+
+class LSwitchTable: public LControlInstruction<1, 1> {
+ public:
+  LSwitchTable(LOperand* value, LOperand* temp) {
+    inputs_[0] = value;
+    temps_[0] = temp;
+  }
+
+  LOperand* value() { return inputs_[0]; }
+  LOperand* temp() { return temps_[0]; }
+
+  DECLARE_CONCRETE_INSTRUCTION(SwitchTable, "switch-table")
+  DECLARE_HYDROGEN_ACCESSOR(SwitchTable)
+
+  virtual void PrintDataTo(StringStream* stream);
+};
+
+
+class LLeaveTry: public LTemplateInstruction<0, 0, 1> {
+ public:
+  explicit LLeaveTry(LOperand* temp) {
+    temps_[0] = temp;
+  }
+
+  LOperand* temp() { return temps_[0]; }
+
+  DECLARE_CONCRETE_INSTRUCTION(LeaveTry, "leave-try")
+};
+
+
+class LCatchEntry: public LTemplateInstruction<1, 0, 0> {
+ public:
+  virtual bool HasInterestingComment(LCodeGen* gen) const { return false; }
+  DECLARE_CONCRETE_INSTRUCTION(CatchEntry, "catch-entry")
+};
+
+
+class LStoreTrySlot: public LTemplateInstruction<0, 1, 0> {
+ public:
+  LStoreTrySlot(LOperand* value, int spill_index)
+      : spill_index_(spill_index) {
+    inputs_[0] = value;
+  }
+
+  LOperand* value() { return inputs_[0]; }
+  int spill_index() const { return spill_index_; }
+
+  DECLARE_CONCRETE_INSTRUCTION(StoreTrySlot, "store-try-slot")
+
+  virtual void PrintDataTo(StringStream* stream);
+
+ private:
+  int spill_index_;
+};
+
+
+class LLoadTrySlot: public LTemplateInstruction<1, 0, 0> {
+ public:
+  virtual bool HasInterestingComment(LCodeGen* gen) const { return false; }
+  DECLARE_CONCRETE_INSTRUCTION(LoadTrySlot, "load-try-slot")
+};
+
+
 class LWrapReceiver: public LTemplateInstruction<1, 2, 0> {
  public:
   LWrapReceiver(LOperand* receiver, LOperand* function) {
@@ -874,6 +965,24 @@ class LIsStringAndBranch: public LControlInstruction<1, 1> {
 };
 
 
+class LIsInternalizedStringAndBranch: public LControlInstruction<1, 1> {
+ public:
+  LIsInternalizedStringAndBranch(LOperand* value, LOperand* temp) {
+    inputs_[0] = value;
+    temps_[0] = temp;
+  }
+
+  LOperand* value() { return inputs_[0]; }
+  LOperand* temp() { return temps_[0]; }
+
+  DECLARE_CONCRETE_INSTRUCTION(IsInternalizedStringAndBranch,
+                               "is-internalized-string-and-branch")
+  DECLARE_HYDROGEN_ACCESSOR(IsInternalizedStringAndBranch)
+
+  virtual void PrintDataTo(StringStream* stream);
+};
+
+
 class LIsSmiAndBranch: public LControlInstruction<1, 0> {
  public:
   explicit LIsSmiAndBranch(LOperand* value) {
@@ -1268,6 +1377,37 @@ class LValueOf: public LTemplateInstruction<1, 1, 0> {
 };
 
 
+class LVectorLoop: public LTemplateInstruction<1, 8, 0> {
+ public:
+  LVectorLoop(LOperand* index,
+              LOperand* limit,
+              LOperand* store_pointer,
+              LOperand** load_pointers,
+              LOperand** scalars) {
+    inputs_[0] = index;
+    inputs_[1] = limit;
+    inputs_[2] = store_pointer;
+    for (int i = 0; i < HVectorLoop::kMaxLoads; ++i) {
+      inputs_[3 + i] = load_pointers[i];
+    }
+    for (int i = 0; i < HVectorLoop::kMaxScalars; ++i) {
+      inputs_[3 + HVectorLoop::kMaxLoads + i] = scalars[i];
+    }
+  }
+
+  LOperand* index() { return inputs_[0]; }
+  LOperand* limit() { return inputs_[1]; }
+  LOperand* store_pointer() { return inputs_[2]; }
+  LOperand* load_pointer(int i) { return inputs_[3 + i]; }
+  LOperand* scalar(int i) {
+    return inputs_[3 + HVectorLoop::kMaxLoads + i];
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(VectorLoop, "vector-loop")
+  DECLARE_HYDROGEN_ACCESSOR(VectorLoop)
+};
+
+
 class LDateField: public LTemplateInstruction<1, 1, 0> {
  public:
   LDateField(LOperand* date, Smi* index) : index_(index) {
@@ -2342,19 +2482,6 @@ class LCheckNonSmi: public LTemplateInstruction<0, 1, 0> {
 };
 
 
-class LAllocateObject: public LTemplateInstruction<1, 0, 1> {
- public:
-  explicit LAllocateObject(LOperand* temp) {
-    temps_[0] = temp;
-  }
-
-  LOperand* temp() { return temps_[0]; }
-
-  DECLARE_CONCRETE_INSTRUCTION(AllocateObject, "allocate-object")
-  DECLARE_HYDROGEN_ACCESSOR(AllocateObject)
-};
-
-
 class LAllocate: public LTemplateInstruction<1, 1, 1> {
  public:
   LAllocate(LOperand* size, LOperand* temp) {
@@ -2573,7 +2700,8 @@ class LChunkBuilder BASE_EMBEDDED {
         allocator_(allocator),
         position_(RelocInfo::kNoPosition),
         instruction_pending_deoptimization_environment_(NULL),
-        pending_deoptimization_ast_id_(BailoutId::None()) { }
+        pending_deoptimization_ast_id_(BailoutId::None()),
+        first_try_slot_(0) { }
 
   // Build the sequence for the graph.
   LPlatformChunk* Build();
@@ -2725,6 +2853,8 @@ class LChunkBuilder BASE_EMBEDDED {
   int position_;
   LInstruction* instruction_pending_deoptimization_environment_;
   BailoutId pending_deoptimization_ast_id_;
+  // The spill index of the first try slot.
+  int first_try_slot_;
 
   DISALLOW_COPY_AND_ASSIGN(LChunkBuilder);
 };
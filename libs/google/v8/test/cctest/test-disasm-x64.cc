@@ -397,6 +397,47 @@ TEST(DisasmX64) {
     }
   }
 
+  // Packed operations.
+  {
+    if (CpuFeatures::IsSupported(SSE2)) {
+      CpuFeatures::Scope fscope(SSE2);
+      __ addpd(xmm1, xmm0);
+      __ subpd(xmm1, xmm0);
+      __ mulpd(xmm9, xmm0);
+      __ divpd(xmm1, xmm10);
+      __ cvtps2pd(xmm1, xmm0);
+      __ cvtpd2ps(xmm1, xmm0);
+      __ unpcklpd(xmm1, xmm1);
+      __ paddd(xmm1, xmm0);
+      __ psubd(xmm1, xmm0);
+      __ pshufd(xmm1, xmm0, 0);
+      __ movdqu(xmm0, Operand(rbx, rcx, times_4, 10000));
+      __ movdqu(Operand(rbx, rcx, times_4, 10000), xmm0);
+    }
+  }
+
+  // AVX and FMA3 instructions.
+  {
+    if (CpuFeatures::IsSupported(AVX)) {
+      CpuFeatures::Scope fscope(AVX);
+      __ vaddsd(xmm1, xmm2, xmm3);
+      __ vaddsd(xmm9, xmm10, Operand(rbx, rcx, times_4, 10000));
+      __ vsubsd(xmm1, xmm12, xmm3);
+      __ vmulsd(xmm1, xmm2, Operand(r8, 8));
+      __ vdivsd(xmm1, xmm2, xmm11);
+      __ vsqrtsd(xmm1, xmm2, xmm2);
+    }
+    if (CpuFeatures::IsSupported(FMA3)) {
+      CpuFeatures::Scope fscope(FMA3);
+      __ vfmadd132sd(xmm1, xmm2, xmm3);
+      __ vfmadd213sd(xmm9, xmm2, xmm3);
+      __ vfmadd231sd(xmm1, xmm10, xmm11);
+      __ vfmsub132sd(xmm1, xmm2, xmm3);
+      __ vfmsub213sd(xmm1, xmm2, xmm3);
+      __ vfmsub231sd(xmm1, xmm2, xmm3);
+    }
+  }
+
   // Nop instructions
   for (int i = 0; i < 16; i++) {
     __ Nop(i);
@@ -0,0 +1,76 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --expose-gc --verify-heap
+
+// Test folding of consecutive new space allocations into one.
+
+function nested(x) {
+  var a = {p: x, q: 1};
+  var b = {r: a, s: 2};
+  var c = {t: b, u: a};
+  return c;
+}
+
+function checkNested(x, c) {
+  assertEquals(x, c.t.r.p);
+  assertEquals(1, c.t.r.q);
+  assertEquals(2, c.t.s);
+  assertSame(c.t.r, c.u);
+}
+
+checkNested(1, nested(1));
+checkNested(2, nested(2));
+%OptimizeFunctionOnNextCall(nested);
+checkNested(3, nested(3));
+for (var i = 0; i < 10000; i++) checkNested(i, nested(i));
+gc();
+checkNested(4, nested(4));
+
+
+// Deoptimize between the folded allocation and the initialization of the
+// inner objects. The space reserved for them must stay iterable.
+function interrupted(o) {
+  var a = {p: 1, q: 2};
+  var v = o.value;
+  var b = {r: a, s: v};
+  return b;
+}
+
+var o1 = {value: 1};
+var o2 = {other: 0, value: 2};
+assertEquals(1, interrupted(o1).s);
+assertEquals(1, interrupted(o1).s);
+%OptimizeFunctionOnNextCall(interrupted);
+assertEquals(1, interrupted(o1).s);
+// Start from freshly collected new space, so that the reserved space does
+// not happen to contain stale but valid objects.
+gc();
+gc();
+assertEquals(2, interrupted(o2).s);
+gc();
+assertEquals(2, interrupted(o2).s);
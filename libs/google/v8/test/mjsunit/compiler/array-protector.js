@@ -0,0 +1,107 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax
+
+// Test that optimized loads from holey arrays, which read holes as
+// undefined while the array protector is intact, notice elements added to
+// Array.prototype or Object.prototype later on.
+
+function holeySmis(step) {
+  var a = new Array(8);
+  for (var i = 0; i < 8; i += step) a[i] = i;
+  return a;
+}
+
+function holeyObjects(step) {
+  var a = new Array(8);
+  for (var i = 0; i < 8; i += step) a[i] = { value: i };
+  return a;
+}
+
+function sum(a) {
+  var result = 0;
+  for (var i = 0; i < a.length; i++) {
+    if (a[i] !== undefined) result += a[i];
+  }
+  return result;
+}
+
+function count(a) {
+  var result = 0;
+  for (var i = 0; i < a.length; i++) {
+    if (a[i] === undefined) result++;
+  }
+  return result;
+}
+
+function load(a, i) {
+  return a[i];
+}
+
+// Warm up on holey arrays without actual holes, so that the keyed loads
+// stay monomorphic.
+for (var i = 0; i < 3; i++) {
+  assertEquals(28, sum(holeySmis(1)));
+  assertEquals(0, count(holeyObjects(1)));
+  assertEquals(1, load(holeySmis(1), 1));
+}
+%OptimizeFunctionOnNextCall(sum);
+%OptimizeFunctionOnNextCall(count);
+%OptimizeFunctionOnNextCall(load);
+var smis = holeySmis(2);
+var objects = holeyObjects(2);
+assertEquals(12, sum(smis));
+assertEquals(4, count(objects));
+assertEquals(undefined, load(smis, 1));
+assertEquals(6, load(smis, 6));
+assertEquals(undefined, load(smis, 7));
+
+// Holes in arrays read through the prototype chain once it has elements.
+Array.prototype[1] = 100;
+assertEquals(112, sum(smis));
+assertEquals(3, count(objects));
+assertEquals(100, load(smis, 1));
+assertEquals(undefined, load(smis, 3));
+
+Object.prototype[3] = 1000;
+assertEquals(1112, sum(smis));
+assertEquals(2, count(objects));
+assertEquals(1000, load(smis, 3));
+
+// Reoptimizing does not bring back the unchecked loads.
+%OptimizeFunctionOnNextCall(sum);
+%OptimizeFunctionOnNextCall(load);
+assertEquals(1112, sum(smis));
+assertEquals(100, load(smis, 1));
+assertEquals(1000, load(smis, 3));
+assertEquals(undefined, load(smis, 5));
+
+delete Array.prototype[1];
+delete Object.prototype[3];
+assertEquals(12, sum(smis));
+assertEquals(undefined, load(smis, 1));
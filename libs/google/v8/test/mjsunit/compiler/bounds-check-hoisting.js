@@ -0,0 +1,126 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --array-bounds-checks-hoisting
+
+// Test that bounds checks hoisted out of loops still catch out-of-bounds
+// accesses, by deoptimizing before the loop is entered.
+
+function sum(a, n) {
+  var result = 0;
+  for (var i = 0; i < n; i++) {
+    result += a[i];
+  }
+  return result;
+}
+
+var typed = new Int32Array([1, 2, 3, 4, 5, 6, 7, 8]);
+sum(typed, 8);
+sum(typed, 8);
+%OptimizeFunctionOnNextCall(sum);
+assertEquals(36, sum(typed, 8));
+assertEquals(10, sum(typed, 4));
+assertEquals(0, sum(typed, 0));
+assertEquals(0, sum(typed, -5));
+assertEquals(NaN, sum(typed, 9));
+assertEquals(36, sum(typed, 8));
+
+function sum_all(a) {
+  var result = 0;
+  for (var i = 0; i < a.length; i++) {
+    result += a[i];
+  }
+  return result;
+}
+
+sum_all([1, 2, 3]);
+sum_all([1, 2, 3]);
+%OptimizeFunctionOnNextCall(sum_all);
+assertEquals(6, sum_all([1, 2, 3]));
+assertEquals(0, sum_all([]));
+assertTrue(2 != %GetOptimizationStatus(sum_all));
+assertEquals(15, sum_all([1, 2, 3, 4, 5]));
+
+function pairs(a, n) {
+  var result = 0;
+  for (var i = 0; i < n; i++) {
+    result += a[i] * a[i + 1];
+  }
+  return result;
+}
+
+pairs(typed, 7);
+pairs(typed, 7);
+%OptimizeFunctionOnNextCall(pairs);
+assertEquals(2 + 6 + 12 + 20 + 30 + 42 + 56, pairs(typed, 7));
+assertEquals(NaN, pairs(typed, 8));
+
+function backwards(a, start) {
+  var result = 0;
+  for (var i = start; i >= 0; i--) {
+    result = result * 10 + a[i];
+  }
+  return result;
+}
+
+backwards(typed, 3);
+backwards(typed, 3);
+%OptimizeFunctionOnNextCall(backwards);
+assertEquals(4321, backwards(typed, 3));
+assertEquals(0, backwards(typed, -1));
+assertEquals(NaN, backwards(typed, 8));
+
+function early_exit(a, n) {
+  var result = 0;
+  for (var i = 0; i < n; i++) {
+    if (i >= a.length) break;
+    result += a[i];
+  }
+  return result;
+}
+
+early_exit(typed, 8);
+early_exit(typed, 8);
+%OptimizeFunctionOnNextCall(early_exit);
+assertEquals(36, early_exit(typed, 100));
+assertTrue(2 != %GetOptimizationStatus(early_exit));
+
+function store(a, n, v) {
+  for (var i = 0; i < n; i++) {
+    a[i] = v;
+  }
+}
+
+var target = new Int32Array(4);
+store(target, 4, 1);
+store(target, 4, 2);
+%OptimizeFunctionOnNextCall(store);
+store(target, 4, 3);
+assertEquals([3, 3, 3, 3], Array.prototype.slice.call(target));
+store(target, 6, 4);
+assertEquals([4, 4, 4, 4], Array.prototype.slice.call(target));
+assertEquals(undefined, target[4]);
@@ -0,0 +1,125 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --check-elimination
+
+// Test that map and type checks are only eliminated when a dominating check
+// still holds, and that the optimized code deoptimizes correctly otherwise.
+
+function A(x) { this.x = x; }
+function B(x) { this.y = 0; this.x = x; }
+
+function repeated(o) {
+  return o.x + o.x + o.x;
+}
+
+repeated(new A(1));
+repeated(new A(2));
+%OptimizeFunctionOnNextCall(repeated);
+assertEquals(9, repeated(new A(3)));
+assertEquals(12, repeated(new B(4)));
+
+function merge(o, c) {
+  var r;
+  if (c) {
+    r = o.x;
+  } else {
+    r = o.x + 1;
+  }
+  return r + o.x;
+}
+
+merge(new A(1), true);
+merge(new A(1), false);
+%OptimizeFunctionOnNextCall(merge);
+assertEquals(2, merge(new A(1), true));
+assertEquals(3, merge(new A(1), false));
+assertEquals(5, merge(new B(2), false));
+
+function map_change(o, p) {
+  var r = o.x;
+  p.z = 1;
+  return r + o.x;
+}
+
+map_change(new A(1), new A(2));
+map_change(new A(1), new A(2));
+%OptimizeFunctionOnNextCall(map_change);
+assertEquals(2, map_change(new A(1), new A(2)));
+var a = new A(3);
+assertEquals(6, map_change(a, a));
+assertEquals(1, a.z);
+
+function loop(o, n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    sum += o.x;
+  }
+  return sum;
+}
+
+loop(new A(1), 3);
+loop(new A(1), 3);
+%OptimizeFunctionOnNextCall(loop);
+assertEquals(10, loop(new A(2), 5));
+assertEquals(10, loop(new B(2), 5));
+
+function loop_transition(o, n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    sum += o.x;
+    if (i == 1) o.w = i;
+  }
+  return sum;
+}
+
+loop_transition(new A(1), 3);
+loop_transition(new A(1), 3);
+%OptimizeFunctionOnNextCall(loop_transition);
+assertEquals(5, loop_transition(new A(1), 5));
+
+function elements(a, v) {
+  var r = a[0];
+  a[1] = v;
+  return r + a[0];
+}
+
+elements([1, 2], 3);
+elements([1, 2], 3);
+%OptimizeFunctionOnNextCall(elements);
+assertEquals(2, elements([1, 2], 3));
+assertEquals(2, elements([1, 2], 0.5));
+
+function string_length(s) {
+  return s.length + s.length;
+}
+
+string_length("abc");
+string_length("abcd");
+%OptimizeFunctionOnNextCall(string_length);
+assertEquals(6, string_length("abc"));
+assertEquals(undefined + undefined, string_length({}));
@@ -0,0 +1,54 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --parallel-recompilation --concurrent-osr
+// Flags: --parallel-recompilation-threads=1
+
+// Long running loops keep running unoptimized while their OSR code is
+// compiled on the compiler thread, and enter it at a later back edge.
+
+function nested(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    for (var j = 0; j < 10; j++) sum += i & 7;
+  }
+  return sum;
+}
+
+function sequential(n) {
+  var a = 0;
+  for (var i = 0; i < n; i++) a += i & 3;
+  var b = 0;
+  for (var i = 0; i < n; i++) b += i & 1;
+  return a + b;
+}
+
+assertEquals(35 * 1000000, nested(1000000));
+assertEquals(2 * 4000000, sequential(4000000));
+// Run again, possibly entering code from a stale OSR job.
+assertEquals(35 * 1000, nested(1000));
+assertEquals(2 * 4000, sequential(4000));
@@ -0,0 +1,66 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax
+
+// Keep many doubles live at once so that the three operand (AVX) forms of
+// the double arithmetic are used with all xmm registers, and check the
+// results against the unoptimized code.
+
+function many(a, b) {
+  var x0 = a + b, x1 = a - b, x2 = a * b, x3 = a / b;
+  var x4 = x0 * x1, x5 = x2 - x3, x6 = x0 / x2, x7 = x1 + x3;
+  var x8 = x4 - x6, x9 = x5 * x7, x10 = x8 / x9, x11 = x4 + x5;
+  var x12 = x6 * x7, x13 = x10 - x11, x14 = Math.sqrt(x2 * x2 + x12 * x12);
+  return [x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14,
+          x0 + x1 + x2 + x3 + x4 + x5 + x6 + x7 + x8 + x9 + x10 + x11 +
+          x12 + x13 + x14];
+}
+
+var inputs = [[1.5, 2.25], [-3, 0.125], [1e300, 1e-300], [0, -0], [7, 3],
+              [Infinity, 2], [NaN, 1], [-0.5, -0.75]];
+var expected = [];
+for (var i = 0; i < inputs.length; i++) {
+  expected.push(many(inputs[i][0], inputs[i][1]));
+}
+%OptimizeFunctionOnNextCall(many);
+for (var i = 0; i < inputs.length; i++) {
+  assertEquals(expected[i], many(inputs[i][0], inputs[i][1]));
+}
+
+
+// Left operands that stay live after the operation.
+function live(a, b) {
+  var s = a * b;
+  var d = a - b;
+  var q = a / b;
+  return a + b + s + d + q + Math.sqrt(a) + a * a;
+}
+
+var live_expected = [live(2, 3), live(0.5, 8), live(16, -2)];
+%OptimizeFunctionOnNextCall(live);
+assertEquals(live_expected, [live(2, 3), live(0.5, 8), live(16, -2)]);
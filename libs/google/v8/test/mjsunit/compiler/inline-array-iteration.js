@@ -0,0 +1,155 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Flags: --allow-natives-syntax --inline-array-builtins
+
+// Test inlining of Array.prototype.forEach, map, filter and reduce.
+
+function add(sum, x) { return sum + x; }
+function double(x) { return x * 2; }
+function odd(x) { return x % 2 == 1; }
+
+var visited;
+function visit(x, i, array) { visited.push(x, i, array.length); }
+
+function forEachSum(a) { visited = []; a.forEach(visit); return visited; }
+function mapDouble(a) { return a.map(double); }
+function filterOdd(a) { return a.filter(odd); }
+function reduceSum(a) { return a.reduce(add, 0); }
+
+function TestIteration(packed, holey) {
+  for (var i = 0; i < 2; i++) {
+    assertEquals([1, 0, 3, 2, 1, 3, 3, 2, 3], forEachSum(packed));
+    assertEquals([2, 4, 6], mapDouble(packed));
+    assertEquals([1, 3], filterOdd(packed));
+    assertEquals(6, reduceSum(packed));
+    // Holes are skipped, and map keeps them in its result.
+    assertEquals([1, 0, 4, 3, 3, 4], forEachSum(holey));
+    var doubled = mapDouble(holey);
+    assertEquals(4, doubled.length);
+    assertFalse(1 in doubled);
+    assertFalse(2 in doubled);
+    assertEquals(6, doubled[3]);
+    assertEquals([1, 3], filterOdd(holey));
+    assertEquals(4, reduceSum(holey));
+    %OptimizeFunctionOnNextCall(forEachSum);
+    %OptimizeFunctionOnNextCall(mapDouble);
+    %OptimizeFunctionOnNextCall(filterOdd);
+    %OptimizeFunctionOnNextCall(reduceSum);
+  }
+}
+
+function WithObjectElements(a) {
+  a.push({});
+  a.length--;
+  return a;
+}
+
+TestIteration([1, 2, 3], [1, , , 3]);
+TestIteration(WithObjectElements([1, 2, 3]), WithObjectElements([1, , , 3]));
+
+
+// The callback receives the global receiver in sloppy mode and undefined
+// in strict mode.
+var receivers;
+function sloppy() { receivers.push(this); }
+function strict() { "use strict"; receivers.push(this); }
+function callBoth(a) { a.forEach(sloppy); a.forEach(strict); }
+for (var i = 0; i < 3; i++) {
+  receivers = [];
+  callBoth([1]);
+  assertSame(this, receivers[0]);
+  assertSame(undefined, receivers[1]);
+  if (i == 1) %OptimizeFunctionOnNextCall(callBoth);
+}
+
+
+// The callback may change the elements kind of the array, shrink or grow
+// it.  The loop still visits the elements up to the original length that
+// are present when they are reached.
+var mutate;
+function mutating(x, i, array) {
+  if (i == 0) mutate(array);
+  return x;
+}
+function mapMutating(a) { return a.map(mutating); }
+function TestMutation(f, expected) {
+  for (var i = 0; i < 3; i++) {
+    mutate = function() {};
+    assertEquals([1, 2, 3], mapMutating([1, 2, 3]));
+    if (i == 1) %OptimizeFunctionOnNextCall(mapMutating);
+  }
+  mutate = f;
+  assertEquals(expected, mapMutating([1, 2, 3]));
+}
+TestMutation(function(a) { a[2] = 0.5; }, [1, 2, 0.5]);
+TestMutation(function(a) { a[2] = "x"; }, [1, 2, "x"]);
+TestMutation(function(a) { a.push(4); }, [1, 2, 3]);
+var shrunk = [1];
+shrunk.length = 3;
+TestMutation(function(a) { a.length = 1; }, shrunk);
+
+
+// Deoptimization inside the callback resumes in the builtin.
+var deopt = false;
+function deopting(sum, x) {
+  if (deopt) %DeoptimizeFunction(reduceDeopting);
+  return sum + x;
+}
+function reduceDeopting(a) { return a.reduce(deopting, 10); }
+for (var i = 0; i < 3; i++) {
+  assertEquals(16, reduceDeopting([1, 2, 3]));
+  if (i == 1) %OptimizeFunctionOnNextCall(reduceDeopting);
+}
+deopt = true;
+assertEquals(16, reduceDeopting([1, 2, 3]));
+
+
+// Callbacks that are not known functions are called.
+function filterWith(a, f) { return a.filter(f); }
+for (var i = 0; i < 3; i++) {
+  assertEquals([1, 3], filterWith([1, 2, 3], odd));
+  assertEquals([2], filterWith([1, 2, 3], function(x) { return x == 2; }));
+  if (i == 1) %OptimizeFunctionOnNextCall(filterWith);
+}
+assertThrows(function() { filterWith([1], 1); }, TypeError);
+
+
+// The result is used in effect and test contexts.
+function inTest(a) { return a.reduce(add, 0) ? "yes" : "no"; }
+function inEffect(a) { a.forEach(visit); a.map(double); return visited; }
+for (var i = 0; i < 3; i++) {
+  assertEquals("yes", inTest([1, 2]));
+  assertEquals("no", inTest([1, -1]));
+  visited = [];
+  assertEquals([5, 0, 1], inEffect([5]));
+  if (i == 1) {
+    %OptimizeFunctionOnNextCall(inTest);
+    %OptimizeFunctionOnNextCall(inEffect);
+  }
+}
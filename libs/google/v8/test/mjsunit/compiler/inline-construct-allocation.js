@@ -0,0 +1,90 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --expose-gc --verify-heap
+
+// Test that receivers of inlined constructors are allocated and
+// initialized in optimized code, and that stores into them (and into
+// objects folded into them) stay visible to the garbage collector.
+
+function Inner(v) {
+  this.v = v;
+}
+
+function Outer(x) {
+  this.a = { k: x };
+  this.b = new Inner(x);
+  this.c = x;
+}
+
+function make(x) {
+  return new Outer(x);
+}
+
+function check(o, x) {
+  assertSame(x, o.a.k);
+  assertSame(x, o.b.v);
+  assertSame(x, o.c);
+  assertSame(Outer.prototype, Object.getPrototypeOf(o));
+  assertSame(Inner.prototype, Object.getPrototypeOf(o.b));
+}
+
+for (var i = 0; i < 5; i++) check(make(i), i);
+%OptimizeFunctionOnNextCall(make);
+check(make(7), 7);
+
+// Store young objects into the fresh receivers across GCs.
+var objects = [];
+for (var i = 0; i < 1000; i++) {
+  var x = { z: i };
+  objects.push(make(x));
+  if (i % 100 == 0) gc();
+}
+gc();
+for (var i = 0; i < objects.length; i++) {
+  check(objects[i], objects[i].c);
+  assertEquals(i, objects[i].c.z);
+}
+
+// Replacing the prototype after optimization must be observed.
+function F(x) {
+  this.x = x;
+}
+
+function makeF(x) {
+  return new F(x);
+}
+
+for (var i = 0; i < 5; i++) makeF(i);
+%OptimizeFunctionOnNextCall(makeF);
+assertEquals(3, makeF(3).x);
+var proto = { hello: function() { return 42; } };
+F.prototype = proto;
+var f = makeF(4);
+assertSame(proto, Object.getPrototypeOf(f));
+assertEquals(42, f.hello());
+assertEquals(4, f.x);
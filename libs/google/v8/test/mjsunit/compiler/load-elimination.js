@@ -0,0 +1,99 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --load-elimination
+
+// Test that loads and stores of named fields are only eliminated when no
+// aliasing store or call can change the field in between.
+
+function Point(x, y) {
+  this.x = x;
+  this.y = y;
+}
+
+function forward(p, v) {
+  p.x = v;
+  return p.x + p.x;
+}
+
+function aliased(p, q, v) {
+  p.x = v;
+  q.x = 7;
+  return p.x;
+}
+
+function fresh(p) {
+  var o = new Point(1, 2);
+  p.x = 5;
+  return o.x + p.x;
+}
+
+function redundant(p) {
+  var x = p.x;
+  p.x = x;
+  p.y = 3;
+  p.x = x;
+  return p.x + p.y;
+}
+
+function call_kills(p, f) {
+  var a = p.x;
+  f(p);
+  return a + p.x;
+}
+
+function branch(p, c) {
+  p.x = 10;
+  if (c) return p.x;
+  p.x = 11;
+  return p.x;
+}
+
+function test() {
+  var p = new Point(1, 2);
+  var q = new Point(3, 4);
+  assertEquals(8, forward(p, 4));
+  assertEquals(5, aliased(p, q, 5));
+  assertEquals(7, aliased(p, p, 5));
+  assertEquals(6, fresh(p));
+  p.x = 1;
+  assertEquals(4, redundant(p));
+  p.x = 1;
+  assertEquals(3, call_kills(p, function(o) { o.x = 2; }));
+  assertEquals(10, branch(p, true));
+  assertEquals(11, branch(p, false));
+}
+
+test();
+test();
+%OptimizeFunctionOnNextCall(forward);
+%OptimizeFunctionOnNextCall(aliased);
+%OptimizeFunctionOnNextCall(fresh);
+%OptimizeFunctionOnNextCall(redundant);
+%OptimizeFunctionOnNextCall(call_kills);
+%OptimizeFunctionOnNextCall(branch);
+test();
@@ -0,0 +1,161 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --loop-peeling --loop-unrolling
+
+// Test peeling and unrolling of innermost loops.
+
+function sum(a) {
+  var s = 0;
+  for (var i = 0; i < a.length; i++) {
+    s += a[i];
+  }
+  return s;
+}
+
+var arrays = [[], [1], [1, 2], [1, 2, 3], [1, 2, 3, 4], [1, 2, 3, 4, 5],
+              [1, 2, 3, 4, 5, 6, 7, 8, 9]];
+function test_sum() {
+  for (var i = 0; i < arrays.length; i++) {
+    var expected = arrays[i].length * (arrays[i].length + 1) / 2;
+    assertEquals(expected, sum(arrays[i]));
+  }
+}
+test_sum();
+test_sum();
+%OptimizeFunctionOnNextCall(sum);
+test_sum();
+
+
+// Breaks and continues in every copy of the body.
+function break_continue(n, stop) {
+  var s = 0;
+  for (var i = 0; i < n; i++) {
+    if (i == stop) break;
+    if (i % 3 == 1) continue;
+    s += i;
+  }
+  return s;
+}
+
+function test_break_continue() {
+  for (var n = 0; n < 12; n++) {
+    for (var stop = 0; stop < 12; stop++) {
+      var expected = 0;
+      for (var i = 0; i < Math.min(n, stop); i++) {
+        if (i % 3 != 1) expected += i;
+      }
+      assertEquals(expected, break_continue(n, stop));
+    }
+  }
+}
+test_break_continue();
+test_break_continue();
+%OptimizeFunctionOnNextCall(break_continue);
+test_break_continue();
+
+
+// Labeled continue and break from a peeled while loop.
+function labeled(n) {
+  var s = 0;
+  var i = 0;
+  outer: while (i < n) {
+    i++;
+    if (i == 2) continue outer;
+    if (i == 7) break outer;
+    s += i;
+  }
+  return s;
+}
+
+function test_labeled() {
+  assertEquals(0, labeled(0));
+  assertEquals(1, labeled(1));
+  assertEquals(1, labeled(2));
+  assertEquals(19, labeled(6));
+  assertEquals(19, labeled(10));
+}
+test_labeled();
+test_labeled();
+%OptimizeFunctionOnNextCall(labeled);
+test_labeled();
+
+
+// Deoptimization from the peeled iteration and from an unrolled copy.
+function deopt(a) {
+  var s = 0;
+  for (var i = 0; i < a.length; i++) {
+    s = s + a[i];
+  }
+  return s;
+}
+
+assertEquals(10, deopt([1, 2, 3, 4]));
+assertEquals(10, deopt([1, 2, 3, 4]));
+%OptimizeFunctionOnNextCall(deopt);
+assertEquals(10, deopt([1, 2, 3, 4]));
+assertEquals("0a234", deopt(["a", 2, 3, 4]));
+assertEquals("3a4", deopt([1, 0, 2, "a", 4]));
+assertEquals(3.5, deopt([1, 2, 0.5]));
+
+function deopt_unrolled(n, x) {
+  var s = 0;
+  for (var i = 0; i < n; i++) {
+    s = s + x;
+  }
+  return s;
+}
+
+assertEquals(6, deopt_unrolled(3, 2));
+assertEquals(6, deopt_unrolled(3, 2));
+%OptimizeFunctionOnNextCall(deopt_unrolled);
+assertEquals(10, deopt_unrolled(5, 2));
+assertEquals("0aaaaaa", deopt_unrolled(6, "a"));
+assertEquals(3.5, deopt_unrolled(7, 0.5));
+
+
+// Loops that are entered via on-stack replacement are not copied, but other
+// loops in the same function still are.
+function osr(n) {
+  var s = 0;
+  for (var i = 0; i < 3; i++) s += i;
+  for (var j = 0; j < n; j++) {
+    s += j & 7;
+  }
+  for (var k = 0; k < 5; k++) s += k;
+  return s;
+}
+
+function osr_expected(n) {
+  var s = 13;
+  for (var j = 0; j < n; j++) s += j & 7;
+  return s;
+}
+
+assertEquals(osr_expected(500000), osr(500000));
+assertEquals(osr_expected(3), osr(3));
+assertEquals(osr_expected(0), osr(0));
@@ -0,0 +1,174 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax
+
+// Test optimized switch statements dispatched through jump tables,
+// binary search and string identity checks.
+
+function dense(x) {
+  switch (x) {
+    case 0: return "zero";
+    case 1: return "one";
+    case 2: return "two";
+    case 3: return "three";
+    case 4: return "four";
+    case 5: return "five";
+    case 7: return "seven";
+    default: return "other";
+  }
+}
+
+function testDense() {
+  assertEquals("zero", dense(0));
+  assertEquals("one", dense(1));
+  assertEquals("two", dense(2));
+  assertEquals("three", dense(3));
+  assertEquals("four", dense(4));
+  assertEquals("five", dense(5));
+  assertEquals("other", dense(6));
+  assertEquals("seven", dense(7));
+  assertEquals("other", dense(8));
+  assertEquals("other", dense(-1));
+  assertEquals("other", dense(1 << 30));
+  assertEquals("other", dense(-(1 << 30)));
+}
+
+testDense();
+testDense();
+%OptimizeFunctionOnNextCall(dense);
+assertEquals("three", dense(3));
+testDense();
+assertEquals("three", dense(3.0));
+assertEquals("other", dense(2.5));
+assertEquals("other", dense("2"));
+
+
+function sparse(x) {
+  switch (x) {
+    case -1000: return 1;
+    case -5: return 2;
+    case 0: return 3;
+    case 17: return 4;
+    case 300: return 5;
+    case 4096: return 6;
+    case 100000: return 7;
+    case 1 << 29: return 8;
+  }
+  return 0;
+}
+
+function testSparse() {
+  assertEquals(1, sparse(-1000));
+  assertEquals(2, sparse(-5));
+  assertEquals(3, sparse(0));
+  assertEquals(4, sparse(17));
+  assertEquals(5, sparse(300));
+  assertEquals(6, sparse(4096));
+  assertEquals(7, sparse(100000));
+  assertEquals(8, sparse(1 << 29));
+  assertEquals(0, sparse(-4));
+  assertEquals(0, sparse(18));
+  assertEquals(0, sparse(4095));
+  assertEquals(0, sparse(99999));
+}
+
+testSparse();
+testSparse();
+%OptimizeFunctionOnNextCall(sparse);
+assertEquals(4, sparse(17));
+testSparse();
+
+
+// Dense runs separated by sparse values, duplicate labels (the first one
+// wins), fall-through and a default clause in the middle.
+function mixed(x) {
+  var r = "";
+  switch (x) {
+    case 10: r += "a";
+    case 11: r += "b"; break;
+    case 12: r += "c"; break;
+    case 13: r += "d"; break;
+    case 11: r += "never"; break;
+    default: r += "x";
+    case 1000: r += "e"; break;
+    case 1001: r += "f"; break;
+    case 1002: r += "g"; break;
+    case 1003: r += "h"; break;
+  }
+  return r;
+}
+
+function testMixed() {
+  assertEquals("ab", mixed(10));
+  assertEquals("b", mixed(11));
+  assertEquals("c", mixed(12));
+  assertEquals("d", mixed(13));
+  assertEquals("xe", mixed(14));
+  assertEquals("e", mixed(1000));
+  assertEquals("f", mixed(1001));
+  assertEquals("g", mixed(1002));
+  assertEquals("h", mixed(1003));
+  assertEquals("xe", mixed(500));
+}
+
+testMixed();
+testMixed();
+%OptimizeFunctionOnNextCall(mixed);
+assertEquals("c", mixed(12));
+testMixed();
+
+
+function strings(s) {
+  switch (s) {
+    case "apple": return 1;
+    case "banana": return 2;
+    case "cherry": return 3;
+    case "date": return 4;
+    default: return 0;
+  }
+}
+
+function testStrings() {
+  assertEquals(1, strings("apple"));
+  assertEquals(2, strings("banana"));
+  assertEquals(3, strings("cherry"));
+  assertEquals(4, strings("date"));
+  assertEquals(0, strings("elderberry"));
+  // Strings that are not internalized take the content comparison path.
+  assertEquals(1, strings("app" + String.fromCharCode(108) + "e"));
+  assertEquals(3, strings("xcherryx".substring(1, 7)));
+  assertEquals(0, strings("cherr" + "ies".substring(0, 1)));
+}
+
+testStrings();
+testStrings();
+%OptimizeFunctionOnNextCall(strings);
+assertEquals(2, strings("banana"));
+testStrings();
+assertEquals(0, strings(1));
+assertEquals(0, strings({}));
@@ -0,0 +1,224 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --expose-gc
+
+// Test optimized functions containing try/catch and try/finally.
+
+function thrower(x) {
+  if (x < 0) throw "negative";
+  return x;
+}
+
+function catcher(x) {
+  var result = 0;
+  try {
+    result = thrower(x) + 1;
+  } catch (e) {
+    return e;
+  }
+  return result;
+}
+
+assertEquals(2, catcher(1));
+assertEquals("negative", catcher(-1));
+%OptimizeFunctionOnNextCall(catcher);
+assertEquals(3, catcher(2));
+assertEquals("negative", catcher(-1));
+assertEquals(4, catcher(3));
+
+
+function returnFromTry(x) {
+  try {
+    return thrower(x);
+  } catch (e) {
+    return "caught " + e;
+  }
+}
+
+assertEquals(1, returnFromTry(1));
+%OptimizeFunctionOnNextCall(returnFromTry);
+assertEquals(2, returnFromTry(2));
+assertEquals("caught negative", returnFromTry(-2));
+assertEquals(5, returnFromTry(5));
+
+
+var log;
+function finallyBlock(x) {
+  try {
+    log.push(thrower(x));
+  } finally {
+    log.push("finally");
+  }
+  return log.length;
+}
+
+log = [];
+assertEquals(2, finallyBlock(1));
+%OptimizeFunctionOnNextCall(finallyBlock);
+log = [];
+assertEquals(2, finallyBlock(2));
+assertEquals([2, "finally"], log);
+log = [];
+assertThrows(function() { finallyBlock(-1); });
+assertEquals(["finally"], log);
+log = [];
+assertEquals(2, finallyBlock(3));
+assertEquals([3, "finally"], log);
+
+
+function nested(x, y) {
+  var a = x + y;
+  try {
+    try {
+      thrower(x);
+    } finally {
+      thrower(y);
+    }
+  } catch (e) {
+    return e + a;
+  }
+  return a;
+}
+
+assertEquals(3, nested(1, 2));
+%OptimizeFunctionOnNextCall(nested);
+assertEquals(7, nested(3, 4));
+assertEquals("negative3", nested(-1, 4));
+assertEquals("negative-3", nested(1, -4));
+assertEquals(7, nested(3, 4));
+
+
+function deoptInTry(o) {
+  var sum = 1;
+  try {
+    sum = o.x + thrower(o.y);
+  } catch (e) {
+    sum = e;
+  }
+  return sum;
+}
+
+assertEquals(3, deoptInTry({x: 1, y: 2}));
+%OptimizeFunctionOnNextCall(deoptInTry);
+assertEquals(5, deoptInTry({x: 2, y: 3}));
+assertEquals("negative", deoptInTry({x: 2, y: -3}));
+assertEquals(7, deoptInTry({y: 3, x: 4}));
+assertEquals("negative", deoptInTry({y: -3, x: 4}));
+
+
+function deoptInFinally(o) {
+  var result;
+  try {
+    result = thrower(1);
+  } finally {
+    result = o.x;
+  }
+  return result;
+}
+
+assertEquals(1, deoptInFinally({x: 1}));
+%OptimizeFunctionOnNextCall(deoptInFinally);
+assertEquals(2, deoptInFinally({x: 2}));
+assertEquals(3, deoptInFinally({y: 0, x: 3}));
+
+
+function gcInTry(x) {
+  var o = {value: 0};
+  try {
+    o = {value: x};
+    gc();
+    thrower(x);
+  } catch (e) {
+    gc();
+    return o.value + e;
+  }
+  return o.value;
+}
+
+assertEquals(1, gcInTry(1));
+%OptimizeFunctionOnNextCall(gcInTry);
+assertEquals(2, gcInTry(2));
+assertEquals("-1negative", gcInTry(-1));
+
+
+function loopInTry(n) {
+  var sum = 0;
+  try {
+    for (var i = 0; i < n; i++) {
+      sum += thrower(4 - i);
+    }
+  } catch (e) {
+    return sum + e;
+  }
+  return sum;
+}
+
+assertEquals("10negative", loopInTry(10));
+%OptimizeFunctionOnNextCall(loopInTry);
+assertEquals("10negative", loopInTry(10));
+assertEquals(9, loopInTry(3));
+assertEquals("10negative", loopInTry(6));
+
+
+function breakOutOfTry(a) {
+  var o = {count: 0};
+  for (var i = 0; i < a.length; i++) {
+    try {
+      if (a[i] == 0) break;
+      if (a[i] == 1) continue;
+      thrower(a[i]);
+      o.count++;
+    } catch (e) {
+      o.count += 100;
+    }
+  }
+  return o.count;
+}
+
+assertEquals(102, breakOutOfTry([2, 1, -1, 3, 0, 5]));
+%OptimizeFunctionOnNextCall(breakOutOfTry);
+assertEquals(102, breakOutOfTry([2, 1, -1, 3, 0, 5]));
+assertEquals(201, breakOutOfTry([-1, -1, 1, 4]));
+
+
+function Thrower() { throw new Error("construct"); }
+
+function catchFromCallee(f) {
+  try {
+    return f();
+  } catch (e) {
+    return e.message;
+  }
+}
+
+assertEquals(1, catchFromCallee(function() { return 1; }));
+%OptimizeFunctionOnNextCall(catchFromCallee);
+assertEquals(2, catchFromCallee(function() { return 2; }));
+assertEquals("construct", catchFromCallee(function() { return new Thrower(); }));
+assertEquals("construct", catchFromCallee(function() { new Thrower(); }));
+assertEquals(3, catchFromCallee(function() { return 3; }));
@@ -0,0 +1,165 @@
+// Copyright 2013 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+/// Flags: --allow-natives-syntax --vectorize-loops
+
+// Element-wise loops over typed arrays must produce the same results as the
+// scalar loop, including for the iterations that do not fill a vector.
+
+function saxpy(out, a, b, k, n) {
+  for (var i = 0; i < n; i++) out[i] = a[i] * k + b[i];
+}
+
+function checkSaxpy(Type, n) {
+  var a = new Type(n), b = new Type(n), out = new Type(n);
+  var expected = new Type(n);
+  for (var i = 0; i < n; i++) {
+    a[i] = i * 1.25 - 3;
+    b[i] = 7 - i / 3;
+    expected[i] = a[i] * 2.5 + b[i];
+  }
+  saxpy(out, a, b, 2.5, n);
+  for (var i = 0; i < n; i++) assertEquals(expected[i], out[i]);
+}
+
+for (var n = 0; n < 12; n++) checkSaxpy(Float64Array, n);
+%OptimizeFunctionOnNextCall(saxpy);
+for (var n = 0; n < 12; n++) checkSaxpy(Float64Array, n);
+checkSaxpy(Float64Array, 1001);
+
+
+function mix(out, a, b, c, n) {
+  for (var i = 0; i < n; ++i) {
+    out[i] = (a[i] - b[i]) / (c[i] + 0.5) * 3;
+  }
+}
+
+function checkMix(n) {
+  var a = new Float32Array(n), b = new Float32Array(n);
+  var c = new Float32Array(n), out = new Float32Array(n);
+  var expected = new Float32Array(n);
+  for (var i = 0; i < n; i++) {
+    a[i] = Math.sin(i) * 100;
+    b[i] = i / 7;
+    c[i] = i % 5 - 2;
+    expected[i] = (a[i] - b[i]) / (c[i] + 0.5) * 3;
+  }
+  mix(out, a, b, c, n);
+  for (var i = 0; i < n; i++) assertEquals(expected[i], out[i]);
+}
+
+for (var n = 0; n < 10; n++) checkMix(n);
+%OptimizeFunctionOnNextCall(mix);
+for (var n = 0; n < 10; n++) checkMix(n);
+checkMix(333);
+
+
+// Int32 lanes wrap around like the stores truncate.
+function sum(out, a, b, k, n) {
+  for (var i = 0; i < n; i++) out[i] = a[i] + b[i] - k;
+}
+
+function checkSum(n) {
+  var a = new Int32Array(n), b = new Int32Array(n), out = new Int32Array(n);
+  var expected = new Int32Array(n);
+  for (var i = 0; i < n; i++) {
+    a[i] = 0x7fffff00 + i * 17;
+    b[i] = i * 0x10000000;
+    expected[i] = a[i] + b[i] - 5;
+  }
+  sum(out, a, b, 5, n);
+  for (var i = 0; i < n; i++) assertEquals(expected[i], out[i]);
+}
+
+for (var n = 0; n < 10; n++) checkSum(n);
+%OptimizeFunctionOnNextCall(sum);
+for (var n = 0; n < 10; n++) checkSum(n);
+checkSum(99);
+
+
+// Overlapping views of one buffer must see the stores of earlier iterations.
+function shift(out, a, n) {
+  for (var i = 0; i < n; i++) out[i] = a[i] + 1;
+}
+
+function checkShift(offset, n) {
+  var buffer = new ArrayBuffer(8 * (n + 4));
+  var out = new Float64Array(buffer, 8 * offset);
+  var a = new Float64Array(buffer);
+  var expected = [];
+  for (var i = 0; i < n + 4; i++) a[i] = expected[i] = i;
+  for (var i = 0; i < n; i++) expected[i + offset] = expected[i] + 1;
+  shift(out, a, n);
+  for (var i = 0; i < n + 4; i++) assertEquals(expected[i], a[i]);
+}
+
+for (var offset = 0; offset < 4; offset++) checkShift(offset, 9);
+%OptimizeFunctionOnNextCall(shift);
+for (var offset = 0; offset < 4; offset++) checkShift(offset, 9);
+
+
+// In-place updates, a bound past the end of the arrays and a negative start.
+function scale(a, from, to) {
+  for (var i = from; i < to; i++) a[i] = a[i] * 2;
+}
+
+function checkScale(from, to) {
+  var a = new Float64Array(7);
+  for (var i = 0; i < 7; i++) a[i] = i;
+  scale(a, from, to);
+  for (var i = 0; i < 7; i++) {
+    assertEquals(i >= from && i < to ? 2 * i : i, a[i]);
+  }
+}
+
+checkScale(0, 7);
+checkScale(2, 5);
+%OptimizeFunctionOnNextCall(scale);
+checkScale(0, 7);
+checkScale(2, 5);
+checkScale(3, 100);
+checkScale(-2, 4);
+checkScale(5, 1);
+
+
+// A loop invariant value that is not a number deoptimizes.
+function offsetBy(out, a, k, n) {
+  for (var i = 0; i < n; i++) out[i] = a[i] + k;
+}
+
+var a = new Float64Array([1, 2, 3, 4, 5]);
+var out = new Float64Array(5);
+offsetBy(out, a, 1, 5);
+offsetBy(out, a, 1.5, 5);
+%OptimizeFunctionOnNextCall(offsetBy);
+offsetBy(out, a, 0.5, 5);
+assertEquals(5.5, out[4]);
+offsetBy(out, a, undefined, 5);
+assertTrue(isNaN(out[0]));
+offsetBy(out, a, 1, 5);
+assertEquals(6, out[4]);